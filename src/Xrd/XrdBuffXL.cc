@@ -101,6 +101,7 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
    XrdBuffer *bp;
    char *memp;
    int mk, buffSz, bindex = 0;
+   bool mapped;
 
 // Make sure the request is within our limits
 //
@@ -132,12 +133,15 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
 
 // Allocate a chunk of aligned memory
 //
-   if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;
+   if (!(memp = XrdBuffer::Memory(buffSz, pagsz, mapped))) return 0;
 
 // Wrap the memory with a buffer object
 //
-   if (!(bp = new XrdBuffer(memp, buffSz, bindex|isBigBuff)))
-      {free(memp); return 0;}
+   if (!(bp = new XrdBuffer(memp, buffSz, bindex|isBigBuff, mapped)))
+      {if (mapped) munmap(memp, buffSz);
+          else free(memp);
+       return 0;
+      }
 
 // Update statistics
 //
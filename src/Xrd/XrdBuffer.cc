@@ -31,6 +31,8 @@
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -58,11 +60,89 @@ void *XrdReshaper(void *pp)
 
 const char *XrdBuffManager::TraceID = "BuffManager";
 
+int         XrdBuffer::hugepg = 0;
+
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+static const int hugeSz    = 2*1024*1024; // Huge page size we assume
+static const int magBigIx  = 6;           // Buckets past 64K hold fewer buffers
+static const int magAcct   = 64;          // Requests between profile updates
+
+// Magazines outlive the buffer manager they belong to when a thread exits
+// after the manager was deleted (e.g. during static destruction). So, live
+// managers are kept in a list that a magazine checks before draining. The
+// mutex is never destroyed so that it can be used at any time.
+//
+XrdBuffManager  *mgrList  = 0;
+pthread_mutex_t  mgrMutex = PTHREAD_MUTEX_INITIALIZER;
 }
 
+/******************************************************************************/
+/*                    C l a s s   X r d B u f f e r                           */
+/******************************************************************************/
+
+char *XrdBuffer::Memory(int sz, int align, bool &mp)
+{
+   char *memp;
+
+// Use huge pages if so wanted and the buffer covers whole huge pages. Explicit
+// huge pages must have been reserved by the administrator so when none are
+// left we fall back to transparent huge pages.
+//
+   mp = false;
+#ifdef __linux__
+   if (hugepg && sz >= hugeSz && !(sz & (hugeSz-1)))
+      {if (hugepg > 1)
+          {memp = (char *)mmap(0, sz, PROT_READ|PROT_WRITE,
+                               MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+           if (memp != MAP_FAILED) {mp = true; return memp;}
+          }
+       if (!posix_memalign((void **)&memp, hugeSz, sz))
+          {madvise(memp, sz, MADV_HUGEPAGE);
+           return memp;
+          }
+      }
+#endif
+
+// Allocate a chunk of aligned memory the usual way
+//
+   if (posix_memalign((void **)&memp, align, sz)) return 0;
+   return memp;
+}
+
+/******************************************************************************/
+/*                 C l a s s   X r d B u f f M a n a g e r                    */
+/******************************************************************************/
+
+// A magazine is a small per-thread stash of buffers sitting in front of the
+// shared buckets. Obtain() and Release() use it without taking any lock and
+// only go to the shared buckets, moving several buffers at a time, when the
+// magazine runs empty or overflows. The request profile used by the reshaper
+// is kept here as well and folded into the buckets every so often.
+//
+struct XrdBuffManager::Magazine
+{
+XrdBuffManager *owner;
+XrdBuffer      *bnext[XRD_BUCKETS];
+int             numbuf[XRD_BUCKETS];
+int             numreq[XRD_BUCKETS];
+int             totreq;
+int             gen;
+long long       hits;
+long long       misses;
+
+                Magazine() : owner(0), totreq(0), gen(0), hits(0), misses(0)
+                           {memset(bnext,  0, sizeof(bnext));
+                            memset(numbuf, 0, sizeof(numbuf));
+                            memset(numreq, 0, sizeof(numreq));
+                           }
+
+               ~Magazine() {if (owner) XrdBuffManager::Retire(*this);}
+};
+
+thread_local XrdBuffManager::Magazine XrdBuffManager::myMag;
+
 namespace XrdGlobal
 {
        XrdBuffXL   xlBuff;
@@ -97,7 +177,18 @@ XrdBuffManager::XrdBuffManager(int minrst) :
 #endif
    rsinprog = 0;
    minrsw   = minrst;
+   magsz    = 0;
+   maghit   = 0;
+   magmiss  = 0;
+   maggen   = 0;
    memset(static_cast<void *>(bucket), 0, sizeof(bucket));
+
+// Add ourselves to the list of live managers
+//
+   pthread_mutex_lock(&mgrMutex);
+   mgrNext = mgrList;
+   mgrList = this;
+   pthread_mutex_unlock(&mgrMutex);
 }
 
 /******************************************************************************/
@@ -106,8 +197,17 @@ XrdBuffManager::XrdBuffManager(int minrst) :
   
 XrdBuffManager::~XrdBuffManager()
 {
+   XrdBuffManager **mpp;
    XrdBuffer *bP;
 
+// Remove ourselves from the list of live managers so that magazines of threads
+// that are still running no longer drain into us.
+//
+   pthread_mutex_lock(&mgrMutex);
+   for (mpp = &mgrList; *mpp; mpp = &((*mpp)->mgrNext))
+       if (*mpp == this) {*mpp = mgrNext; break;}
+   pthread_mutex_unlock(&mgrMutex);
+
    for (int i = 0; i < XRD_BUCKETS; i++)
        {while((bP = bucket[i].bnext))
              {bucket[i].bnext = bP->next;
@@ -117,6 +217,68 @@ XrdBuffManager::~XrdBuffManager()
        }
 }
 
+/******************************************************************************/
+/*                               A c c o u n t                                */
+/******************************************************************************/
+
+// The caller must hold the Reshaper lock.
+//
+void XrdBuffManager::Account(XrdBuffManager::Magazine &mag)
+{
+   for (int i = 0; i < slots; i++)
+       {bucket[i].numreq += mag.numreq[i];
+        mag.numreq[i] = 0;
+       }
+   totreq     += mag.totreq;
+   maghit     += mag.hits;
+   magmiss    += mag.misses;
+   mag.totreq  = 0;
+   mag.hits    = 0;
+   mag.misses  = 0;
+}
+
+/******************************************************************************/
+/*                              C a p a c i t y                               */
+/******************************************************************************/
+
+// Small buffers are cheap so a magazine may hold magsz of them. Past 64K the
+// number is halved for each bucket so that idle threads do not sit on much
+// memory the reshaper cannot get to.
+//
+int XrdBuffManager::Capacity(int bindex)
+{
+   int n;
+
+   if (bindex <= magBigIx) return magsz;
+   n = magsz >> (bindex - magBigIx);
+   return (n ? n : 1);
+}
+
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+void XrdBuffManager::Drain(XrdBuffManager::Magazine &mag)
+{
+   XrdBuffer *bp;
+
+// Return every buffer in the magazine to the shared buckets
+//
+   Reshaper.Lock();
+   Account(mag);
+   for (int i = 0; i < slots; i++)
+       {while((bp = mag.bnext[i]))
+             {mag.bnext[i] = bp->next;
+              bp->next = bucket[i].bnext;
+              bucket[i].bnext = bp;
+              bucket[i].numbuf++;
+             }
+        mag.numbuf[i] = 0;
+       }
+   mag.gen = maggen;
+   Reshaper.UnLock();
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -133,15 +295,41 @@ void XrdBuffManager::Init()
       Log.Emsg("BuffManager", rc, "create reshaper thread");
 }
   
+/******************************************************************************/
+/*                            M y M a g a z i n e                             */
+/******************************************************************************/
+
+XrdBuffManager::Magazine *XrdBuffManager::MyMagazine()
+{
+   Magazine &mag = myMag;
+
+// Magazines may be turned off and a thread only has one magazine which goes to
+// the first buffer manager it uses (there really is only one in practice).
+//
+   if (magsz <= 0) return 0;
+   if (mag.owner != this)
+      {if (mag.owner) return 0;
+       mag.owner = this;
+       mag.gen   = maggen;
+      }
+
+// If the reshaper asked for buffers back, return what we have
+//
+   if (mag.gen != maggen) Drain(mag);
+   return &mag;
+}
+
 /******************************************************************************/
 /*                                O b t a i n                                 */
 /******************************************************************************/
   
 XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
+   Magazine *mag;
    XrdBuffer *bp;
    char *memp;
    int mk, pk, bindex;
+   bool mapped;
 
 // Make sure the request is within our limits
 //
@@ -156,13 +344,31 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
-// Obtain a lock on the bucket array and try to give away an existing buffer
+// Try to give away a buffer from this thread's magazine without any locking.
+// The request counts are only added to the profile every so often.
+//
+   if ((mag = MyMagazine()))
+      {mag->numreq[bindex]++; mag->totreq++;
+       if ((bp = mag->bnext[bindex]))
+          {mag->bnext[bindex] = bp->next; mag->numbuf[bindex]--;
+           mag->hits++;
+           if (mag->totreq >= magAcct)
+              {Reshaper.Lock(); Account(*mag); Reshaper.UnLock();}
+           return bp;
+          }
+       mag->misses++;
+      }
+
+// Obtain a lock on the bucket array and try to give away an existing buffer.
+// As we have the lock anyway, restock the magazine from the same bucket.
 //
     Reshaper.Lock();
-    totreq++;
-    bucket[bindex].numreq++;
+    if (mag) Account(*mag);
+       else {totreq++; bucket[bindex].numreq++;}
     if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
+       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;
+        if (mag) Refill(*mag, bindex);
+       }
     Reshaper.UnLock();
 
 // Check if we really allocated a buffer
@@ -172,11 +378,15 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 // Allocate a chunk of aligned memory
 //
    pk = (mk < pagsz ? mk : pagsz);
-   if (posix_memalign((void **)&memp, pk, mk)) return 0;
+   if (!(memp = XrdBuffer::Memory(mk, pk, mapped))) return 0;
 
 // Wrap the memory with a buffer object
 //
-   if (!(bp = new XrdBuffer(memp, mk, bindex))) {free(memp); return 0;}
+   if (!(bp = new XrdBuffer(memp, mk, bindex, mapped)))
+      {if (mapped) munmap(memp, mk);
+          else free(memp);
+       return 0;
+      }
 
 // Update statistics
 //
@@ -214,18 +424,50 @@ int XrdBuffManager::Recalc(int sz)
    return mk;
 }
 
+/******************************************************************************/
+/*                                R e f i l l                                 */
+/******************************************************************************/
+
+// The caller must hold the Reshaper lock.
+//
+void XrdBuffManager::Refill(XrdBuffManager::Magazine &mag, int bindex)
+{
+   XrdBuffer *bp;
+   int n = Capacity(bindex)/2 - mag.numbuf[bindex];
+
+   while(n-- > 0 && (bp = bucket[bindex].bnext))
+        {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;
+         bp->next = mag.bnext[bindex];
+         mag.bnext[bindex] = bp;
+         mag.numbuf[bindex]++;
+        }
+}
+
 /******************************************************************************/
 /*                               R e l e a s e                                */
 /******************************************************************************/
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
+   Magazine *mag;
    int bindex = bp->bindex;
 
 // Check if we should release this via the big buffer object
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
+// Keep the buffer in this thread's magazine. Should it be full, move half of
+// it to the shared bucket to make room.
+//
+   if ((mag = MyMagazine()))
+      {if (mag->numbuf[bindex] >= Capacity(bindex))
+          {Reshaper.Lock(); Spill(*mag, bindex); Reshaper.UnLock();}
+       bp->next = mag->bnext[bindex];
+       mag->bnext[bindex] = bp;
+       mag->numbuf[bindex]++;
+       return;
+      }
+
 // Obtain a lock on the bucket array and reclaim the buffer
 //
     Reshaper.Lock();
@@ -271,6 +513,11 @@ while(1)
               }
           totreq = 0; memhave = totalo;
          } else memhave = 0;
+
+      // Buffers sitting in magazines are out of our reach, so have the
+      // threads hand them back if we are over target.
+      //
+      if (memhave > memtarget) maggen++;
       Reshaper.UnLock();
 
       // Reshape the buffer pool to agree with the request profile
@@ -307,15 +554,71 @@ while(1)
   
 void XrdBuffManager::Set(int maxmem, int minw)
 {
+   Set(maxmem, minw, -1, -1);
+}
 
-// Obtain a lock and set the values
+void XrdBuffManager::Set(int maxmem, int minw, int msz, int hpmode)
+{
+
+// Obtain a lock and set the values. Magazines are normally set up before any
+// buffers are handed out; should they be turned off later, any magazine that
+// still holds buffers keeps them until its thread goes away.
 //
    Reshaper.Lock();
    if (maxmem > 0) maxalo = (long long)maxmem;
    if (minw   > 0) minrsw = minw;
+   if (msz   >= 0) {magsz = msz; maggen++;}
+   if (hpmode >= 0) XrdBuffer::hugepg = hpmode;
    Reshaper.UnLock();
 }
  
+/******************************************************************************/
+/*                                R e t i r e                                 */
+/******************************************************************************/
+
+// Called when a thread goes away. The magazine is drained into its manager if
+// that one still exists; otherwise, nobody can use its buffers and they are
+// simply freed. The list mutex keeps the manager alive while we drain.
+//
+void XrdBuffManager::Retire(XrdBuffManager::Magazine &mag)
+{
+   XrdBuffManager *mp;
+   XrdBuffer *bp;
+
+   pthread_mutex_lock(&mgrMutex);
+   for (mp = mgrList; mp && mp != mag.owner; mp = mp->mgrNext) {}
+   if (mp) mp->Drain(mag);
+      else for (int i = 0; i < XRD_BUCKETS; i++)
+               {while((bp = mag.bnext[i]))
+                     {mag.bnext[i] = bp->next;
+                      delete bp;
+                     }
+                mag.numbuf[i] = 0;
+               }
+   mag.owner = 0;
+   pthread_mutex_unlock(&mgrMutex);
+}
+
+/******************************************************************************/
+/*                                 S p i l l                                  */
+/******************************************************************************/
+
+// The caller must hold the Reshaper lock.
+//
+void XrdBuffManager::Spill(XrdBuffManager::Magazine &mag, int bindex)
+{
+   XrdBuffer *bp;
+   int n = mag.numbuf[bindex] - Capacity(bindex)/2;
+
+   Account(mag);
+   while(n-- > 0 && (bp = mag.bnext[bindex]))
+        {mag.bnext[bindex] = bp->next; mag.numbuf[bindex]--;
+         bp->next = bucket[bindex].bnext;
+         bucket[bindex].bnext = bp;
+         bucket[bindex].numbuf++;
+        }
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -323,19 +626,21 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static const char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>"
+                "<maghit>%lld</maghit><magmiss>%lld</magmiss>%s</stats>";
     char xlStats[1024];
     int nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*6 + xlBuff.Stats(0,0);
 
 // Return formatted stats
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,
+                   maghit,magmiss,xlStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
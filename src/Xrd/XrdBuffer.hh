@@ -29,8 +29,10 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cstdlib>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include "XrdSys/XrdSysPthread.hh"
 
@@ -45,18 +47,28 @@ public:
 char *   buff;     // -> buffer
 int      bsize;    // size of this buffer
 
-         XrdBuffer(char *bp, int sz, int ix)
-                      {buff = bp; bsize = sz; bindex = ix; next = 0;}
+         XrdBuffer(char *bp, int sz, int ix, bool mp=false)
+                      {buff = bp; bsize = sz; bindex = ix; next = 0;
+                       mapped = mp;
+                      }
 
-        ~XrdBuffer() {if (buff) free(buff);}
+        ~XrdBuffer() {if (buff)
+                         {if (mapped) munmap(buff, bsize);
+                             else free(buff);
+                         }
+                     }
 
          friend class XrdBuffManager;
          friend class XrdBuffXL;
 private:
 
+static char *Memory(int sz, int align, bool &mp);
+
 int        bindex;
 XrdBuffer *next;
+bool       mapped;   // Memory came from mmap() and not posix_memalign()
 static int pagesz;
+static int hugepg;   // Huge page mode (see XrdBuffManager::Set)
 };
   
 /******************************************************************************/
@@ -84,8 +96,19 @@ int         MaxSize() {return maxsz;}
 
 void        Reshape();
 
+// Set the maximum memory and reshape interval.
+//
 void        Set(int maxmem=-1, int minw=-1);
 
+// As above and also set the number of buffers per bucket that each thread
+// may keep to itself (0, the default, turns off per-thread magazines) and,
+// optionally, the huge page mode: 0 - off, 1 - transparent huge pages, 2 -
+// explicit huge pages falling back to transparent ones. Huge pages are only
+// used for buffers of at least the huge page size. A value of -1 leaves the
+// setting unchanged.
+//
+void        Set(int maxmem, int minw, int magsz, int hpmode=-1);
+
 int         Stats(char *buff, int blen, int do_sync=0);
 
             XrdBuffManager(int minrst=20*60);
@@ -94,6 +117,17 @@ int         Stats(char *buff, int blen, int do_sync=0);
 
 private:
 
+struct Magazine;
+
+void       Account(Magazine &mag);
+int        Capacity(int bindex);
+void       Drain(Magazine &mag);
+Magazine  *MyMagazine();
+void       Refill(Magazine &mag, int bindex);
+static
+void       Retire(Magazine &mag);
+void       Spill(Magazine &mag, int bindex);
+
 const int  slots;
 const int  shift;
 const int  pagsz;
@@ -111,8 +145,14 @@ long long maxalo;
 int       minrsw;
 int       rsinprog;
 int       totadj;
+int       magsz;                       // Max buffers per magazine bucket
+long long maghit;                      // Buffers obtained from a magazine
+long long magmiss;                     // Buffers that were not
+std::atomic<int> maggen;               // Bumped to have magazines drained
 
 XrdSysCondVar      Reshaper;
+XrdBuffManager    *mgrNext;            // Next live buffer manager
 static const char *TraceID;
+static thread_local Magazine myMag;
 };
 #endif
@@ -1654,35 +1654,77 @@ int XrdConfig::xhpath(XrdSysError *eDest, XrdOucStream &Config)
 
 /* Function: xbuf
 
-   Purpose:  To parse the directive: buffers [maxbsz <bsz>] <memsz> [<rint>]
+   Purpose:  To parse the directive: buffers [maxbsz <bsz>] [magazine <n>]
+                                             [hugepages {off | thp | on}]
+                                             <memsz> [<rint>]
 
              <bsz>      maximum size of an individualbuffer. The default is 2m.
                         Specify any value 2m < bsz <= 1g; if specified, it must
                         appear before the <memsz> and <memsz> becomes optional.
+             <n>        the number of buffers of a given size each thread may
+                        keep for itself without going to the shared pool. The
+                        default is 0 (off). Larger buffers are kept in
+                        proportionally smaller numbers. Buffers kept by a
+                        thread that has become idle are only given back when
+                        the thread next asks for or releases a buffer.
+             hugepages  back buffers of 2m and more with huge pages: thp uses
+                        transparent huge pages, on uses explicitly reserved
+                        huge pages and falls back to transparent ones. The
+                        default is off.
              <memsz>    maximum amount of memory devoted to buffers
              <rint>     minimum buffer reshape interval in seconds
 
+             Any of the options makes <memsz> optional.
+
    Output: 0 upon success or !0 upon failure.
 */
 int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 {
     static const long long minBSZ = 1024*1024*2+1;  // 2mb
     static const long long maxBSZ = 1024*1024*1024; // 1gb
-    int bint = -1;
+    int bint = -1, mags = -1, hpmode = -1;
     long long blim;
     char *val;
 
     if (!(val = Config.GetWord()))
        {eDest->Emsg("Config", "buffer memory limit not specified"); return 1;}
 
-    if (!strcmp("maxbsz", val))
-       {if (!(val = Config.GetWord()))
-           {eDest->Emsg("Config", "max buffer size not specified"); return 1;}
-        if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
-           return 1;
-        XrdGlobal::xlBuff.Init(blim);
-        if (!(val = Config.GetWord())) return 0;
-       }
+    while(1)
+         {if (!strcmp("maxbsz", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "max buffer size not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
+                 return 1;
+              XrdGlobal::xlBuff.Init(blim);
+             }
+          else if (!strcmp("magazine", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "magazine size not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2i(*eDest, "magazine size", val, &mags, 0, 1024))
+                 return 1;
+             }
+          else if (!strcmp("hugepages", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "hugepages mode not specified");
+                  return 1;
+                 }
+                   if (!strcmp("off", val)) hpmode = 0;
+              else if (!strcmp("thp", val)) hpmode = 1;
+              else if (!strcmp("on",  val)) hpmode = 2;
+              else {eDest->Emsg("Config", "invalid hugepages mode -", val);
+                    return 1;
+                   }
+             }
+          else break;
+          if (!(val = Config.GetWord()))
+             {BuffPool.Set(-1, -1, mags, hpmode);
+              return 0;
+             }
+         }
 
     if (XrdOuca2x::a2sz(*eDest,"buffer limit value",val,&blim,
                        (long long)1024*1024)) return 1;
@@ -1691,7 +1733,7 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
        if (XrdOuca2x::a2tm(*eDest,"reshape interval", val, &bint, 300))
           return 1;
 
-    BuffPool.Set((int)blim, bint);
+    BuffPool.Set((int)blim, bint, mags, hpmode);
     return 0;
 }
 
@@ -2119,6 +2161,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
         {"all",      XRD_STATS_ALLX, true},
         {"buff",     XRD_STATS_BUFF, false},
         {"info",     XRD_STATS_INFO, false},
+        {"latency",  XRD_STATS_LTCY, false},
         {"link",     XRD_STATS_LINK, false},
         {"plugins",  XRD_STATS_PLUG, true},
         {"poll",     XRD_STATS_POLL, false},
@@ -32,6 +32,7 @@
 
 #include "Xrd/XrdMonitor.hh"
 #include "Xrd/XrdMonRoll.hh"
+#include "XrdSys/XrdSysHistogram.hh"
 
 /******************************************************************************/
 /*                        S t a t i c   M e m b e r s                         */
@@ -56,6 +57,30 @@ bool XrdMonRoll::Register(rollType setType, const char* setName,
    return XrdMon.Register(setType, setName, iVec.data(), iVec.size());
 }
 
+/******************************************************************************/
+bool XrdMonRoll::Register(rollType setType, const char* setName,
+                          XrdSysHistogram& hist)
+{
+   std::vector<Item>* iVec = new std::vector<Item>();
+
+// Describe the histogram as an object with the bucket counts as an array.
+// The values are refreshed by XrdSysHistogram::MergeAll() prior to reporting.
+//
+   iVec->push_back(Item("n",  hist.Count));
+   iVec->push_back(Item("us", hist.TotUS));
+   iVec->push_back(Item("b",  Item::Schema::begArray));
+   for (int i = 0; i < XrdSysHistogram::Buckets; i++)
+       iVec->push_back(Item(0, hist.Hits[i]));
+   iVec->push_back(Item("b",  Item::Schema::endArray));
+
+// Now register the list
+//
+   if (XrdMon.Register(setType, setName, iVec->data(), iVec->size()))
+      return true;
+   delete iVec;
+   return false;
+}
+
 /******************************************************************************/
 bool XrdMonRoll::Register(rollType  setType, const char* setName,
                           setMember setVec[])
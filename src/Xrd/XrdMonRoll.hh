@@ -46,6 +46,7 @@
 //-----------------------------------------------------------------------------
 
 class XrdMonitor;
+class XrdSysHistogram;
 class XrdSysMutex;
 
 class XrdMonRoll
@@ -224,6 +225,21 @@ enum rollType {Misc, Protocol, AddOn, Plugin};
 
 bool Register(rollType setType, const char* setName, std::vector<Item>& iVec);
 
+//-----------------------------------------------------------------------------c
+//! Register a latency histogram to be reported. The histogram is reported as
+//! {"n":count, "us":total_microseconds, "b":[bucket_counts]}. See the
+//! XrdSysHistogram class for the bucket definitions.
+//!
+//! @param setType - Is the type of set being defined (see above).
+//! @param setName - Is the name of the set, as above.
+//! @param hist    - Is the histogram. It must reside in allocated storage
+//!                  until execution ends.
+//!
+//! @return true when the histogram has been registered and false otherwise.
+//-----------------------------------------------------------------------------c
+
+bool Register(rollType setType, const char* setName, XrdSysHistogram& hist);
+
 //-----------------------------------------------------------------------------c
 // The following are deprecated and should not be used in new code. The above
 // definition should be used as they are a superset of what is below.
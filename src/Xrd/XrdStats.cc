@@ -44,6 +44,7 @@
 #include "Xrd/XrdStats.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysHistogram.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysTimer.hh"
 
@@ -317,6 +318,11 @@ const char *XrdStats::GenStats(int &rsz, int opts) // statsMutex must be locked!
        bp += sz; bl -= sz;
       }
 
+   if (opts & XRD_STATS_LTCY)
+      {sz = XrdSysHistogram::Stats(bp, bl, do_sync);
+       bp += sz; bl -= sz;
+      }
+
    if (opts & XRD_STATS_SGEN)
       {unsigned long totTime = 0;
        myTimer.Report(totTime);
@@ -331,6 +337,7 @@ const char *XrdStats::GenStats(int &rsz, int opts) // statsMutex must be locked!
    if (opts & XRD_STATS_PLUG) fOpts |= XrdMonitor::X_PLUG;
    if (fOpts)
       {int uL, sItem = 0;
+       XrdSysHistogram::MergeAll();
        while(bl > 0 && (uL = theMon->Format(bp, bl, sItem, fOpts)))
             {bp += uL; bl -= uL;}
       }
@@ -375,8 +382,10 @@ void XrdStats::GenStats(std::vector<struct iovec>& ioVec, int opts)
    if (opts & XRD_STATS_ADON) fOpts |= XrdMonitor::X_ADON;
    if (opts & XRD_STATS_PLUG) fOpts |= XrdMonitor::X_PLUG;
 
-// Generate all plugin statistics, one at a time
+// Generate all plugin statistics, one at a time. Make sure that registered
+// histograms reflect all observations made so far.
 //
+   XrdSysHistogram::MergeAll();
    while((sdSZ = theMon->Format(sbP, sbFree, sItem, fOpts)))
         {if (sdSZ > 0 && sdSZ <= sbFree)
             {char* bP = sbP + sdSZ;
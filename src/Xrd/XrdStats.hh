@@ -36,10 +36,11 @@
 
 #define XRD_STATS_ADON   0x00000200
 #define XRD_STATS_ALLJ   0x00000300
-#define XRD_STATS_ALLX   0x000003FF
+#define XRD_STATS_ALLX   0x000007FF
 #define XRD_STATS_INFO   0x00000001
 #define XRD_STATS_BUFF   0x00000002
 #define XRD_STATS_LINK   0x00000004
+#define XRD_STATS_LTCY   0x00000400
 #define XRD_STATS_PLUG   0x00000100
 #define XRD_STATS_POLL   0x00000008
 #define XRD_STATS_PROC   0x00000010
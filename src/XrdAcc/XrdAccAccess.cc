@@ -91,7 +91,8 @@ XrdAccAuthorize *XrdAccDefaultAuthorizeObject(XrdSysLogger *lp,
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
 
-XrdAccAccess::XrdAccAccess(XrdSysError *erp)
+XrdAccAccess::XrdAccAccess(XrdSysError *erp) : hostRefX(false), hostRefY(false),
+                                                cacheGen(0), tabGen(0)
 {
 // Get the audit option that we should use
 //
@@ -137,9 +138,16 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
        isuser = false;
       }
 
+// Check if we recently computed the privileges for this path
+//
+   unsigned int tGen = cacheGen;
+   if (tGen && aeP->GetCaps(eInfo.name, path, plen, phash, tGen, caps))
+      return Access2(caps, Entity, path, oper);
+
 // Get a shared context for these potentially long running routines
 //
    Access_Context.Lock(xs_Shared);
+   tGen = cacheGen;
 
 // Setup the host entry in the eInfo structure (it may need to be resolved)
 //
@@ -154,6 +162,8 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
                 {if (xlP->Applies(eInfo))
                     {xlP->caps->Privs(caps, path, plen, phash);
                      Access_Context.UnLock(xs_Shared);
+                     if (tGen) aeP->PutCaps(eInfo.name, path, plen, phash,
+                                            tGen, caps);
                      return Access2(caps, Entity, path, oper);
                     }
                 }
@@ -244,6 +254,10 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 //
    Access_Context.UnLock(xs_Shared);
 
+// Remember the result for the next time
+//
+   if (tGen) aeP->PutCaps(eInfo.name, path, plen, phash, tGen, caps);
+
 // Return the privileges as needed
 //
    return Access2(caps, Entity, path, oper);
@@ -401,6 +415,12 @@ void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
    hostRefX = hRefX;
    hostRefY = hRefY;
 
+// Invalidate all cached decisions. Netgroup membership may change at any time
+// so decisions are not cached at all when netgroup rules exist.
+//
+   if (++tabGen == 0) ++tabGen;
+   cacheGen = (Atab.N_Hash ? 0 : tabGen);
+
 // When we set new access tables, we should purge the group cache
 //
    XrdAccConfiguration.GroupMaster.PurgeCache();
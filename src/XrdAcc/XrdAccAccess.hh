@@ -34,7 +34,8 @@
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdAcc/XrdAccCapability.hh"
 #include "XrdSec/XrdSecEntity.hh"
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdSys/XrdSysXSLock.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
@@ -83,20 +84,20 @@ struct XrdAccAccess_ID
        };
 
 struct XrdAccAccess_Tables
-       {XrdOucHash<XrdAccCapability> *G_Hash;  // Groups
-        XrdOucHash<XrdAccCapability> *H_Hash;  // Hosts
-        XrdOucHash<XrdAccCapability> *N_Hash;  // Netgroups
-        XrdOucHash<XrdAccCapability> *O_Hash;  // Organizations
-        XrdOucHash<XrdAccCapability> *R_Hash;  // Roles
-        XrdOucHash<XrdAccAccess_ID>  *S_Hash;  // Sets
-        XrdOucHash<XrdAccCapability> *T_Hash;  // Templates
-        XrdOucHash<XrdAccCapability> *U_Hash;  // Users
-                  XrdAccCapName     *D_List;  // Domains
-                  XrdAccCapName     *E_List;  // Domains (end of list)
-                  XrdAccCapability  *X_List;  // Fungable capbailities
-                  XrdAccCapability  *Z_List;  // Default  capbailities
-                  XrdAccAccess_ID   *SXList;  // 's' exclusive list
-                  XrdAccAccess_ID   *SYList;  // 's' inclusive list
+       {XrdOucFlatHash<XrdAccCapability> *G_Hash;  // Groups
+        XrdOucFlatHash<XrdAccCapability> *H_Hash;  // Hosts
+        XrdOucFlatHash<XrdAccCapability> *N_Hash;  // Netgroups
+        XrdOucFlatHash<XrdAccCapability> *O_Hash;  // Organizations
+        XrdOucFlatHash<XrdAccCapability> *R_Hash;  // Roles
+        XrdOucFlatHash<XrdAccAccess_ID>  *S_Hash;  // Sets
+        XrdOucFlatHash<XrdAccCapability> *T_Hash;  // Templates
+        XrdOucFlatHash<XrdAccCapability> *U_Hash;  // Users
+                  XrdAccCapName         *D_List;  // Domains
+                  XrdAccCapName         *E_List;  // Domains (end of list)
+                  XrdAccCapability      *X_List;  // Fungable capbailities
+                  XrdAccCapability      *Z_List;  // Default  capbailities
+                  XrdAccAccess_ID       *SXList;  // 's' exclusive list
+                  XrdAccAccess_ID       *SYList;  // 's' inclusive list
 
         XrdAccAccess_Tables() {G_Hash = 0; H_Hash = 0; N_Hash = 0;
                                O_Hash = 0; R_Hash = 0;
@@ -166,6 +167,9 @@ struct XrdAccAccess_Tables Atab;
 bool   hostRefX; // True if we need to resolve hostname for exclusive rules
 bool   hostRefY; // True if we need to resolve hostname for any other rules
 
+RAtomic_uint cacheGen; // Generation of cached decisions (0 -> no caching)
+unsigned int tabGen;   // Generation of the current access tables
+
 XrdSysXSLock Access_Context;
 
 XrdAccAudit *Auditor;
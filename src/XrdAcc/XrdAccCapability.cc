@@ -28,6 +28,8 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
+
 #include "XrdAcc/XrdAccCapability.hh"
 
 /******************************************************************************/
@@ -46,7 +48,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; ptrie = 0;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
@@ -71,10 +73,21 @@ XrdAccCapability::~XrdAccCapability()
      XrdAccCapability *cp, *np = next;
 
      if (path) {free(path); path = 0;}
+     if (ptrie) {delete ptrie; ptrie = 0;}
 
      while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
      next = 0;
 }
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+void XrdAccCapability::Compile()
+{
+   if (ptrie) delete ptrie;
+   ptrie = new XrdAccCapTrie(this);
+}
+
 /******************************************************************************/
 /*                                 P r i v s                                  */
 /******************************************************************************/
@@ -87,6 +100,11 @@ int XrdAccCapability::Privs(      XrdAccPrivCaps &pathpriv,
 {XrdAccCapability *cp=this;
  const int psl = (pathsub ? strlen(pathsub) : 0);
 
+// Use the compiled form of the list when we have one. Substitutions can only
+// be handled by walking the list.
+//
+ if (ptrie && !pathsub) return ptrie->Privs(pathpriv, pathname, pathlen);
+
  do {if (cp->ctmp)
        {if (cp->ctmp->Privs(pathpriv,pathname,pathlen,pathhash,pathsub))
            return 1;
@@ -131,6 +149,153 @@ int XrdAccCapability::Subcomp(const char *pathname, const int pathlen,
    return 1;
 }
 
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccCapTrie::XrdAccCapTrie(XrdAccCapability *capList)
+{
+   std::vector<CapEnt> cVec;
+
+// Collect all of the paths in list order, expanding templates in place
+//
+   Flatten(cVec, capList);
+   for (int i = 0; i < (int)cVec.size(); i++) cVec[i].rank = i;
+
+// Sort the paths so that those sharing a prefix are adjacent. Identical paths
+// are ordered by their list position.
+//
+   std::sort(cVec.begin(), cVec.end(),
+             [](const CapEnt &a, const CapEnt &b)
+               {int rc = strcmp(a.path, b.path);
+                return (rc ? rc < 0 : a.rank < b.rank);
+               });
+
+// Build the tree starting with the root node
+//
+   Nodes.resize(1);
+   if (cVec.empty())
+      {Nodes[0].lOff = Nodes[0].lLen = Nodes[0].kBeg = Nodes[0].kNum = 0;
+       Nodes[0].rank = -1;
+      } else Build(cVec, 0, (int)cVec.size(), 0, 0);
+}
+
+/******************************************************************************/
+/*                                 B u i l d                                  */
+/******************************************************************************/
+
+// Build the node for the paths in cVec[lo:hi), all of which share the first
+// depth characters. The node's label is the longest common prefix beyond that.
+//
+void XrdAccCapTrie::Build(std::vector<CapEnt> &cVec, int lo, int hi,
+                          int depth, int nIdx)
+{
+   const CapEnt &first = cVec[lo], &last = cVec[hi-1];
+   int i, n, lLen = 0, kBeg, kNum = 0;
+
+// Since the paths are sorted, the common prefix of the first and the last
+// path is the common prefix of all of them.
+//
+   n = (first.plen < last.plen ? first.plen : last.plen) - depth;
+   while(lLen < n && first.path[depth+lLen] == last.path[depth+lLen]) lLen++;
+
+   Nodes[nIdx].lOff = (int)Labels.size();
+   Nodes[nIdx].lLen = lLen;
+   Labels.insert(Labels.end(), first.path+depth, first.path+depth+lLen);
+   depth += lLen;
+
+// Paths ending here sort first; the first one has the lowest list position
+//
+   Nodes[nIdx].rank = -1;
+   for (i = lo; i < hi && cVec[i].plen == depth; i++)
+       if (Nodes[nIdx].rank < 0)
+          {Nodes[nIdx].rank = cVec[i].rank;
+           Nodes[nIdx].priv = cVec[i].priv;
+          }
+
+// Count the children, one for each distinct next character
+//
+   for (n = i; n < hi; n++)
+       if (n == i || cVec[n].path[depth] != cVec[n-1].path[depth]) kNum++;
+
+// Allocate the children together so they can be binary searched and build
+// each one in turn.
+//
+   kBeg = (int)Nodes.size();
+   Nodes[nIdx].kBeg = kBeg;
+   Nodes[nIdx].kNum = kNum;
+   Nodes.resize(kBeg + kNum);
+   while(i < hi)
+        {for (n = i+1; n < hi && cVec[n].path[depth] == cVec[i].path[depth];
+              n++) {}
+         Build(cVec, i, n, depth, kBeg++);
+         i = n;
+        }
+}
+
+/******************************************************************************/
+/*                               F l a t t e n                                */
+/******************************************************************************/
+
+void XrdAccCapTrie::Flatten(std::vector<CapEnt> &cVec, XrdAccCapability *cP)
+{
+   CapEnt capEnt;
+
+   do {if (cP->ctmp) Flatten(cVec, cP->ctmp);
+          else {capEnt.path = cP->path;
+                capEnt.plen = cP->plen;
+                capEnt.priv = cP->priv;
+                cVec.push_back(capEnt);
+               }
+      } while((cP = cP->next));
+}
+
+/******************************************************************************/
+/*                                 P r i v s                                  */
+/******************************************************************************/
+
+int XrdAccCapTrie::Privs(      XrdAccPrivCaps &pathpriv,
+                         const char           *pathname,
+                         const int             pathlen)
+{
+   const Node *nP = &Nodes[0], *best = 0;
+   int pos = 0;
+
+// Descend the tree as far as the path allows. Every node passed on the way
+// corresponds to a prefix of the path; keep the one earliest in the list.
+//
+   while(true)
+        {if (pathlen - pos < nP->lLen
+         ||  memcmp(pathname+pos, &Labels[nP->lOff], nP->lLen)) break;
+         pos += nP->lLen;
+         if (nP->rank >= 0 && (!best || nP->rank < best->rank)) best = nP;
+         if (pos >= pathlen || !nP->kNum) break;
+
+         const Node *kP = &Nodes[nP->kBeg];
+         int lo = 0, hi = nP->kNum - 1, mid;
+         unsigned char c = pathname[pos];
+         nP = 0;
+         while(lo <= hi)
+              {mid = (lo + hi) / 2;
+               unsigned char k = Labels[kP[mid].lOff];
+                    if (k < c) lo = mid + 1;
+               else if (k > c) hi = mid - 1;
+               else {nP = &kP[mid]; break;}
+              }
+         if (!nP) break;
+        }
+
+// Apply the privileges of the best match, if any
+//
+   if (!best) return 0;
+   pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | best->priv.pprivs);
+   pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | best->priv.nprivs);
+   return 1;
+}
+
 /******************************************************************************/
 /*                         X r d A c c C a p N a m e                          */
 /******************************************************************************/
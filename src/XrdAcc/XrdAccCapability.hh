@@ -34,8 +34,12 @@
 #include <cstring>
 #include <strings.h>
 
+#include <vector>
+
 #include "XrdAcc/XrdAccPrivs.hh"
 
+class XrdAccCapTrie;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
@@ -45,6 +49,12 @@ class XrdAccCapability
 public:
 void                Add(XrdAccCapability *newcap) {next = newcap;}
 
+// Compile() builds a prefix tree from the capabilities starting with this one.
+// It must be called on the head of the list once the list is complete. Privs()
+// then searches the tree instead of the list unless pathsub is specified.
+//
+void                Compile();
+
 XrdAccCapability   *Next() {return next;}
 
 // Privs() searches the associated capability for a prefix matching path. If one
@@ -79,14 +89,17 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; ptrie = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
                  ~XrdAccCapability();
 private:
+friend class XrdAccCapTrie;
+
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapTrie    *ptrie;     // -> Compiled list (head of list only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
@@ -98,6 +111,51 @@ int              pins;    // index of @=
 int              prem;    // remaining length after @=
 };
 
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+
+// A radix tree of the paths in a capability list with templates expanded in
+// place. Each path keeps its position in the list so that the first matching
+// capability still wins, exactly as when the list is searched.
+//
+class XrdAccCapTrie
+{
+public:
+
+int               Privs(      XrdAccPrivCaps &pathpriv,
+                        const char           *pathname,
+                        const int             pathlen);
+
+                  XrdAccCapTrie(XrdAccCapability *capList);
+                 ~XrdAccCapTrie() {}
+
+private:
+
+struct CapEnt
+      {const char     *path;
+       int             plen;
+       int             rank;
+       XrdAccPrivCaps  priv;
+      };
+
+struct Node
+      {int             lOff;   // Offset of our label in Labels
+       int             lLen;   // Length of the label
+       int             kBeg;   // Index of our first child in Nodes
+       int             kNum;   // Number of children
+       int             rank;   // List position of the match ending here or -1
+       XrdAccPrivCaps  priv;
+      };
+
+void              Build(std::vector<CapEnt> &cVec, int lo, int hi,
+                        int depth, int nIdx);
+void              Flatten(std::vector<CapEnt> &cVec, XrdAccCapability *cP);
+
+std::vector<Node> Nodes;
+std::vector<char> Labels;
+};
+
 /******************************************************************************/
 /*                         X r d A c c C a p N a m e                          */
 /******************************************************************************/
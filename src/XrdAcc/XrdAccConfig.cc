@@ -197,13 +197,13 @@ int XrdAccConfig::ConfigDB(int Warm, XrdSysError &Eroute)
 
 // Allocate new hash tables
 //
-   if (!(tabs.G_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.H_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.N_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.O_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.R_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.T_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.U_Hash = new XrdOucHash<XrdAccCapability>()) )
+   if (!(tabs.G_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.H_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.N_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.O_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.R_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.T_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.U_Hash = new XrdOucFlatHash<XrdAccCapability>()) )
       {Eroute.Emsg("ConfigDB","Insufficient storage for id tables.");
        Database->Close(); return 1;
       }
@@ -649,7 +649,7 @@ int XrdAccConfig::ConfigDBrec(XrdSysError &Eroute,
     int alluser = 0, anyuser = 0, domname = 0, NoGo = 0;
     DB_RecType rectype;
     XrdAccAccess_ID *sp = 0;
-    XrdOucHash<XrdAccCapability> *hp;
+    XrdOucFlatHash<XrdAccCapability> *hp;
     XrdAccGroupType gtype = XrdAccNoGroup;
     XrdAccPrivCaps xprivs;
     XrdAccCapability mycap((char *)"", xprivs), *currcap, *lastcap = &mycap;
@@ -768,6 +768,12 @@ int XrdAccConfig::ConfigDBrec(XrdSysError &Eroute,
        return -1;
       }
 
+   // Compile the list so it can be searched quickly. This is not done for
+   // templates (they are folded into the lists using them) nor for the
+   // fungible list as it is always searched with a substitution.
+   //
+   if (!anyuser && rectype != Template_ID) mycap.Next()->Compile();
+
    // Insert the capability into the appropriate table/list
    //
         if (sp) sp->caps = mycap.Next();
@@ -895,7 +901,7 @@ int XrdAccConfig::idDef(XrdSysError &Eroute,
 
 // Make sure this name has not been specified before
 //
-   if (!tabs.S_Hash) tabs.S_Hash = new XrdOucHash<XrdAccAccess_ID>;
+   if (!tabs.S_Hash) tabs.S_Hash = new XrdOucFlatHash<XrdAccAccess_ID>;
       else if (tabs.S_Hash->Find(theID.name))
               {Eroute.Emsg("ConfigXeq","duplicate id definition -",theID.name);
                return -1;
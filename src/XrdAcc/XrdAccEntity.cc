@@ -117,6 +117,24 @@ XrdAccEntity::XrdAccEntity(const XrdSecEntity *secP, bool &aOK)
    if (have) aOK = false;
 }
 
+/******************************************************************************/
+/*                               G e t C a p s                                */
+/******************************************************************************/
+
+bool XrdAccEntity::GetCaps(const char *name, const char *path, int plen,
+                           unsigned long phash, unsigned int tGen,
+                           XrdAccPrivCaps &caps)
+{
+   CapsEnt &cEnt = capsTab[phash % capsNum];
+   XrdSysMutexHelper mHelp(capsMutex);
+
+   if (cEnt.tGen != tGen || cEnt.phash != phash
+   ||  cEnt.path.size() != (size_t)plen || cEnt.path.compare(path)
+   ||  cEnt.name.compare(name)) return false;
+   caps = cEnt.caps;
+   return true;
+}
+
 /******************************************************************************/
 /*                             G e t E n t i t y                              */
 /******************************************************************************/
@@ -183,6 +201,24 @@ bool XrdAccEntity::OneOrZero(char *src, const char *&dest)
    return true;
 }
 
+/******************************************************************************/
+/*                               P u t C a p s                                */
+/******************************************************************************/
+
+void XrdAccEntity::PutCaps(const char *name, const char *path, int plen,
+                           unsigned long phash, unsigned int tGen,
+                           const XrdAccPrivCaps &caps)
+{
+   CapsEnt &cEnt = capsTab[phash % capsNum];
+   XrdSysMutexHelper mHelp(capsMutex);
+
+   cEnt.phash = phash;
+   cEnt.tGen  = tGen;
+   cEnt.caps  = caps;
+   cEnt.name.assign(name);
+   cEnt.path.assign(path, plen);
+}
+
 /******************************************************************************/
 /*                             P u t E n t i t y                              */
 /******************************************************************************/
@@ -30,9 +30,12 @@
 /******************************************************************************/
 
 #include <cstdlib>
+#include <string>
 #include <vector>
 
+#include "XrdAcc/XrdAccPrivs.hh"
 #include "XrdSec/XrdSecAttr.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                      X r d A c c E n t i t y I n f o                       */
@@ -65,6 +68,18 @@ class XrdAccEntity : public XrdSecAttr
 {
 public:
 
+// GetCaps() and PutCaps() maintain a small cache of the privileges last
+// computed for this entity. Entries are keyed by user name and path and are
+// only valid for the access tables whose generation number is tGen.
+//
+bool          GetCaps(const char *name, const char *path, int plen,
+                      unsigned long phash, unsigned int tGen,
+                      XrdAccPrivCaps &caps);
+
+void          PutCaps(const char *name, const char *path, int plen,
+                      unsigned long phash, unsigned int tGen,
+                      const XrdAccPrivCaps &caps);
+
 static
 XrdAccEntity *GetEntity(const XrdSecEntity *secP, bool &isNew);
 
@@ -105,6 +120,20 @@ struct EntityAttr
 
 std::vector<EntityAttr> attrVec;
 
+static const int capsNum = 8;
+
+struct CapsEnt
+      {unsigned long  phash;
+       unsigned int   tGen;   // Zero when the entry is unused
+       XrdAccPrivCaps caps;
+       std::string    name;
+       std::string    path;
+                      CapsEnt() : phash(0), tGen(0) {}
+      };
+
+CapsEnt        capsTab[capsNum];
+XrdSysMutex    capsMutex;
+
 char          *vorgInfo;
 char          *roleInfo;
 char          *grpsInfo;
@@ -34,10 +34,15 @@
 #include <cstdlib>
 #include <strings.h>
 #include <cstdio>
+#include <fcntl.h>
 #include <grp.h>
 #include <arpa/inet.h>
 #include <sys/param.h>
 #include <sys/socket.h>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "XrdVersion.hh"
 
@@ -45,6 +50,7 @@
 #include "XrdAcc/XrdAccConfig.hh"
 #include "XrdAcc/XrdAccGroups.hh"
 #include "XrdAcc/XrdAccPrivs.hh"
+#include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysLogger.hh"
@@ -105,13 +111,15 @@ int opcnt = sizeof(optab)/sizeof(optab[0]);
 void Usage(const char *msg)
 {
    if (msg) std::cerr <<"xrdacctest: " <<msg <<std::endl;
-   std::cerr <<"Usage: xrdacctest [-c <cfn>] [<ids> | <user> <host>] <act>\n\n";
+   std::cerr <<"Usage: xrdacctest [-c <cfn>] [<ids> | <user> <host>] <act>\n";
+   std::cerr <<"       xrdacctest [-c <cfn>] -b <replay> [-n <loops>]\n\n";
    std::cerr <<"<ids>: -a <auth> -g <grp> -h <host> -o <org> -r <role> -u <user>\n";
    std::cerr <<"<act>: <opc> <path> [<path> [...]]\n";
    std::cerr <<"<opc>: cr - create    mv - rename    st - status    lk - lock\n";
    std::cerr <<"       rd - read      wr - write     ls - readdir   rm - remove\n";
    std::cerr <<"       ec - excl create              ei - excl rename\n";
    std::cerr <<"       *  - zap args  ?  - display privs\n";
+   std::cerr <<"<replay>: file with one '[<ids>] <opc> <path>' request per line\n";
    std::cerr << std::flush;
    exit(msg ? 1 : 0);
 }
@@ -159,6 +167,7 @@ extern XrdAccAuthorize *XrdAccDefaultAuthorizeObject(XrdSysLogger   *lp,
                                                      const char     *parm,
                                                      XrdVersionInfo &myVer);
 int DoIt(int argpnt, int argc, char **argv, bool singleshot);
+int Bench(const char *rfn, int loops);
 
 const char *cfHost = "localhost", *cfProg = "xrootd";
 char *p2l(XrdAccPrivs priv, char *buff, int blen);
@@ -166,8 +175,8 @@ char *argval[32], buff[255], tident[80], c;
 int DoIt(int argnum, int argc, char **argv, int singleshot);
 XrdOucStream Command;
 const int maxargs = sizeof(argval)/sizeof(argval[0]);
-char *at, *lp, *ConfigFN = (char *)"./acc.cf";
-int argnum, rc = 0;
+char *at, *lp, *ConfigFN = (char *)"./acc.cf", *ReplayFN = 0;
+int argnum, loops = 1, rc = 0;
 bool singleshot=false;
 
 // Print help if no args
@@ -179,7 +188,7 @@ bool singleshot=false;
 
 // Get all of the options.
 //
-   while ((c=getopt(argc,argv,"a:c:de:g:h:o:r:u:s")) != (char)EOF)
+   while ((c=getopt(argc,argv,"a:b:c:de:g:h:n:o:r:u:s")) != (char)EOF)
      { switch(c)
        {
        case 'a': 
@@ -195,7 +204,10 @@ bool singleshot=false;
        case 'o': SetID(Entity.vorg, optarg); v2 = true;    break;
        case 'r': SetID(Entity.role, optarg); v2 = true;    break;
        case 'u': SetID(Entity.name, optarg); v2 = true;    break;
+       case 'b': ReplayFN = optarg;                        break;
        case 'c': ConfigFN = optarg;                        break;
+       case 'n': if ((loops = atoi(optarg)) <= 0) Usage("invalid loop count");
+                                                           break;
        case 's': singleshot = true;                        break;
        default:  sprintf(buff, "-%c option is invalid.", c);
                  Usage(buff);
@@ -216,6 +228,10 @@ if (!(Authorize = XrdAccDefaultAuthorizeObject(&myLogger, ConfigFN, 0, myVer)))
     exit(2);
    }
 
+// If we are replaying a request mix, do so now
+//
+   if (ReplayFN) exit(Bench(ReplayFN, loops));
+
 // If command line options specified, process this
 //
    if (optind < argc) {rc = DoIt(optind, argc, argv, singleshot); exit(rc);}
@@ -346,6 +362,117 @@ XrdAccPrivs auth;
 return 0;
 }
 
+/******************************************************************************/
+/*                                 B e n c h                                  */
+/******************************************************************************/
+
+// Replay a mix of requests and report how long authorization takes. Requests
+// with the same identity share one entity object, as they would when they
+// arrive over the same connection.
+//
+int Bench(const char *rfn, int loops)
+{
+   struct Request {XrdSecEntity *secP; Access_Operation oper; char *path;};
+   std::map<std::string, XrdSecEntity *> idMap;
+   std::vector<Request> reqVec;
+   XrdOucStream rFile;
+   Access_Operation cmd2op(char *opname);
+   char *lp, *tok;
+   int fd, lnum = 0;
+
+// Open the replay file
+//
+   if ((fd = open(rfn, O_RDONLY)) < 0)
+      {std::cerr <<"xrdacctest: Unable to open " <<rfn <<"; "
+                 <<XrdSysE2T(errno) <<std::endl;
+       return 1;
+      }
+   rFile.Attach(fd);
+
+// Read in all of the requests
+//
+   while((lp = rFile.GetLine()))
+        {Request req;
+         XrdSecEntity idEnt("host");
+         std::string idKey;
+         lnum++;
+         if (!(tok = rFile.GetToken()) || *tok == '#') continue;
+         while(*tok == '-' && strlen(tok) == 2)
+              {char opt = tok[1], *val = rFile.GetToken();
+               if (!val) break;
+               switch(opt)
+                     {case 'a': strncpy(idEnt.prot, val, sizeof(idEnt.prot)-1);
+                                break;
+                      case 'g': SetID(idEnt.grps, val); break;
+                      case 'h': SetID(idEnt.host, val); break;
+                      case 'o': SetID(idEnt.vorg, val); break;
+                      case 'r': SetID(idEnt.role, val); break;
+                      case 'u': SetID(idEnt.name, val); break;
+                      default:  std::cerr <<"xrdacctest: Invalid option " <<tok
+                                          <<" in line " <<lnum <<std::endl;
+                                return 1;
+                     }
+               idKey += tok; idKey += ' '; idKey += val; idKey += ' ';
+               if (!(tok = rFile.GetToken())) break;
+              }
+         char *path = rFile.GetToken();
+         if (!tok || !path)
+            {std::cerr <<"xrdacctest: Incomplete request in line " <<lnum
+                       <<std::endl;
+             return 1;
+            }
+
+         // Find or create the entity for this identity
+         //
+         auto it = idMap.find(idKey);
+         if (it != idMap.end())
+            {req.secP = it->second;
+             free(idEnt.grps); free(idEnt.host); free(idEnt.vorg);
+             free(idEnt.role); free(idEnt.name);
+            } else {
+             XrdNetAddr *aP = new XrdNetAddr;
+             if (idEnt.host) aP->Set(idEnt.host, 0);
+             req.secP = new XrdSecEntity(idEnt.prot);
+             req.secP->grps = idEnt.grps; req.secP->host = idEnt.host;
+             req.secP->vorg = idEnt.vorg; req.secP->role = idEnt.role;
+             req.secP->name = idEnt.name; req.secP->addrInfo = aP;
+             req.secP->tident = Entity.tident;
+             idMap[idKey] = req.secP;
+            }
+         idEnt.grps = idEnt.host = idEnt.vorg = idEnt.role = idEnt.name = 0;
+         req.oper = cmd2op(tok);
+         req.path = strdup(path);
+         reqVec.push_back(req);
+        }
+   rFile.Close();
+
+   if (reqVec.empty())
+      {std::cerr <<"xrdacctest: No requests in " <<rfn <<std::endl;
+       return 1;
+      }
+
+// Now replay the requests timing the whole thing
+//
+   struct timespec tBeg, tEnd;
+   long long nReq = 0, nOK = 0;
+   clock_gettime(CLOCK_MONOTONIC, &tBeg);
+   for (int i = 0; i < loops; i++)
+       for (auto &req : reqVec)
+           {if (Authorize->Access(req.secP, req.path, req.oper)) nOK++;
+            nReq++;
+           }
+   clock_gettime(CLOCK_MONOTONIC, &tEnd);
+
+// Report the results
+//
+   double nsec = (tEnd.tv_sec - tBeg.tv_sec) * 1e9
+               + (tEnd.tv_nsec - tBeg.tv_nsec);
+   std::cout <<nReq <<" requests (" <<reqVec.size() <<" distinct, "
+             <<idMap.size() <<" identities) " <<nOK <<" allowed; "
+             <<static_cast<long long>(nsec/nReq) <<" ns per request" <<std::endl;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                c m d 2 o p                                 */
 /******************************************************************************/
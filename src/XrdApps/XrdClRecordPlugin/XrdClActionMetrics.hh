@@ -37,9 +37,111 @@
 #include <vector>
 #include <numeric>
 #include <regex>
+#include <cmath>
+#include <mutex>
 
 namespace XrdCl
 {
+//------------------------------------------------------------------------------
+//! Latency histogram with log-linear buckets: values below 64us are counted
+//! exactly, larger ones in 32 buckets per power of two (~3% resolution)
+//------------------------------------------------------------------------------
+struct LatencyHistogram
+{
+  LatencyHistogram() : counts(nbuckets, 0), n(0), sum(0), max(0)
+  {
+  }
+
+  //--------------------------------------------------------------------------
+  //! Add a latency given in seconds
+  //--------------------------------------------------------------------------
+  void add(double seconds)
+  {
+    if (seconds < 0)
+      seconds = 0;
+    uint64_t us = seconds * 1000000.0;
+    counts[index(us)]++;
+    n++;
+    sum += seconds;
+    if (seconds > max)
+      max = seconds;
+  }
+
+  //--------------------------------------------------------------------------
+  //! Merge another histogram into this one
+  //--------------------------------------------------------------------------
+  void add(const LatencyHistogram& other)
+  {
+    for (size_t i = 0; i < nbuckets; ++i)
+      counts[i] += other.counts[i];
+    n += other.n;
+    sum += other.sum;
+    if (other.max > max)
+      max = other.max;
+  }
+
+  //--------------------------------------------------------------------------
+  //! @return : the latency in seconds below which p percent of the values lie
+  //--------------------------------------------------------------------------
+  double percentile(double p) const
+  {
+    if (!n)
+      return 0;
+    uint64_t rank = std::ceil(p / 100.0 * n);
+    if (rank < 1)
+      rank = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < nbuckets; ++i)
+    {
+      seen += counts[i];
+      if (seen >= rank)
+        return std::min(midpoint(i) / 1000000.0, max);
+    }
+    return max;
+  }
+
+  double mean() const { return n ? sum / n : 0; }
+
+  std::vector<uint64_t> counts;
+  uint64_t              n;
+  double                sum;
+  double                max;
+
+  private:
+  static const size_t nbuckets = 64 * 32;
+
+  static size_t index(uint64_t us)
+  {
+    if (us < 64)
+      return us;
+    int shift = 63 - __builtin_clzll(us) - 5;
+    return shift * 32 + (us >> shift);
+  }
+
+  static double midpoint(size_t idx)
+  {
+    if (idx < 64)
+      return idx;
+    int      shift = idx / 32 - 1;
+    uint64_t mant  = idx % 32 + 32;
+    return ((mant << shift) + ((mant + 1) << shift)) / 2.0;
+  }
+};
+
+//------------------------------------------------------------------------------
+//! Work completed within one interval of the replay
+//------------------------------------------------------------------------------
+struct IntervalSample
+{
+  IntervalSample() : ops(0), rbytes(0), wbytes(0)
+  {
+  }
+
+  uint64_t ops;     //< operations completed
+  uint64_t rbytes;  //< bytes read
+  uint64_t wbytes;  //< bytes written
+};
+
 //------------------------------------------------------------------------------
 //! Metrics struct storing all timing and IO information of an action
 //------------------------------------------------------------------------------
@@ -77,6 +179,8 @@ struct ActionMetrics
     ios["All::e"] = 0;  // Error counter for summing over files
     synchronicity = 0.0;
     errors        = 0;
+    tstart        = 0;
+    interval      = 0;
   }
 
   std::string Dump(bool json) const
@@ -194,6 +298,34 @@ struct ActionMetrics
     delays[action + "::" + field] += value;
   }
 
+  //--------------------------------------------------------------------------
+  //! Account for a completed IO
+  //! @param tmeas   : time from submission to completion
+  //! @param latency : time from scheduled submission to completion, which
+  //!                  includes any delay in submitting the IO
+  //! @param rbytes  : bytes read
+  //! @param wbytes  : bytes written
+  //--------------------------------------------------------------------------
+  void addCompletion(const std::string& action,
+                     double             tmeas,
+                     double             latency,
+                     uint64_t           rbytes = 0,
+                     uint64_t           wbytes = 0)
+  {
+    // function called from callbacks requires a guard
+    std::unique_lock<std::mutex> guard(mtx);
+    delays[action + "::tmeas"] += tmeas;
+    latencies[action].add(latency);
+    if (interval > 0)
+    {
+      double t = Action::timeNow() - tstart;
+      auto&  sample = timeseries[t > 0 ? (uint64_t)(t / interval) : 0];
+      sample.ops++;
+      sample.rbytes += rbytes;
+      sample.wbytes += wbytes;
+    }
+  }
+
   void addIos(const std::string& action, const std::string& field, double value)
   {
     // function called from callbacks requires a guard
@@ -216,6 +348,17 @@ struct ActionMetrics
       delays[k.first] += k.second;
     }
     errors += other.errors;
+    for (auto& k : other.latencies)
+    {
+      latencies[k.first].add(k.second);
+    }
+    for (auto& k : other.timeseries)
+    {
+      auto& sample = timeseries[k.first];
+      sample.ops += k.second.ops;
+      sample.rbytes += k.second.rbytes;
+      sample.wbytes += k.second.wbytes;
+    }
 
     auto w1 = other.ios.find("Write::b");
     auto w2 = other.ios.find("PgWrite::b");
@@ -333,8 +476,12 @@ struct ActionMetrics
 
   synchronicity_t aggregated_synchronicity;
 
-  std::map<std::string, uint64_t> ios;
-  std::map<std::string, double>   delays;
-  std::mutex                      mtx;  // only required for async callbacks
+  std::map<std::string, uint64_t>         ios;
+  std::map<std::string, double>           delays;
+  std::map<std::string, LatencyHistogram> latencies;   //< per operation latencies
+  std::map<uint64_t, IntervalSample>      timeseries;  //< completions per interval
+  double                                  tstart;      //< start of the replay
+  double                                  interval;    //< time series interval
+  std::mutex                              mtx;  // only required for async callbacks
 };
 }
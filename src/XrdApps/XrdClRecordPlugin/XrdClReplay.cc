@@ -157,9 +157,12 @@ class mytimer_t
   public:
   //--------------------------------------------------------------------------
   //! Constructor (record start time)
+  //! @param late : how late the timed operation was started with respect to
+  //!               its schedule (in seconds)
   //--------------------------------------------------------------------------
-  mytimer_t()
+  mytimer_t(double late = 0)
   : start(clock_t::now())
+  , late(late > 0 ? late : 0)
   {
   }
 
@@ -178,9 +181,16 @@ class mytimer_t
             / 1000000000.0);
   }
 
+  //--------------------------------------------------------------------------
+  //! @return : get time elapsed from the scheduled start, which unlike the
+  //!           elapsed time does not hide the delays of an overloaded server
+  //--------------------------------------------------------------------------
+  double latency() const { return late + elapsed(); }
+
   private:
   using clock_t = std::chrono::high_resolution_clock;
   std::chrono::time_point<clock_t> start;  //< registered start time
+  double                           late;   //< delay of the start
 };
 
 //------------------------------------------------------------------------------
@@ -342,11 +352,13 @@ class ActionExecutor
   //--------------------------------------------------------------------------
   //! Execute the action
   //! @param ending  : synchronization object for ending the execution
+  //! @param late    : how late the action is with respect to its schedule
   //--------------------------------------------------------------------------
   void Execute(std::shared_ptr<barrier_t>& ending,
                std::shared_ptr<barrier_t>& closing,
                ActionMetrics&              metric,
-               bool                        simulate)
+               bool                        simulate,
+               double                      late = 0)
   {
     if (action == "Open")  // open action
     {
@@ -368,14 +380,14 @@ class ActionExecutor
 
       metric.ios["Open::n"]++;
 
-      mytimer_t timer;
+      mytimer_t timer(late);
 
       if (!simulate)
         WaitFor(Open(file, url, flags, mode, timeout) >>
                 [orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s) mutable
                 {
                   metric.addIos("Open", "e", HandleStatus(s, orgststr, "Open"));
-                  metric.addDelays("Open", "tmeas", timer.elapsed());
+                  metric.addCompletion("Open", timer.elapsed(), timer.latency());
                   ending.reset();
                   closing.reset();
                 });
@@ -388,7 +400,7 @@ class ActionExecutor
     else if (action == "Close")  // close action
     {
       time_t      timeout = GetCloseArgs();
-      mytimer_t   timer;
+      mytimer_t   timer(late);
 
       if (closing)
       {
@@ -404,7 +416,7 @@ class ActionExecutor
               [orgststr{ orgststr }, ending, timer, &metric](XRootDStatus& s) mutable
               {
                 metric.addIos("Close", "e", HandleStatus(s, orgststr, "Close"));
-                metric.addDelays("Close", "tmeas", timer.elapsed());
+                metric.addCompletion("Close", timer.elapsed(), timer.latency());
                 ending.reset();
               });
       else
@@ -418,14 +430,14 @@ class ActionExecutor
       time_t   timeout;
       std::tie(force, timeout) = GetStatArgs();
       metric.ios["Stat::n"]++;
-      mytimer_t timer;
+      mytimer_t timer(late);
 
       if (!simulate)
         Async(Stat(file, force, timeout) >>
               [orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s, StatInfo& r) mutable
               {
                 metric.addIos("Stat", "e", HandleStatus(s, orgststr, "Stat"));
-                metric.addDelays("Stat", "tmeas", timer.elapsed());
+                metric.addCompletion("Stat", timer.elapsed(), timer.latency());
                 ending.reset();
                 closing.reset();
               });
@@ -446,14 +458,14 @@ class ActionExecutor
       if ((offset + buffer->size()) > metric.ios["Read::o"])
         metric.ios["Read::o"] = offset + buffer->size();
 
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(Read(file, offset, buffer->size(), buffer->data(), timeout) >>
               [buffer, orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s,
                                                                               ChunkInfo& r) mutable
               {
                 metric.addIos("Read", "e", HandleStatus(s, orgststr, "Read"));
-                metric.addDelays("Read", "tmeas", timer.elapsed());
+                metric.addCompletion("Read", timer.elapsed(), timer.latency(), r.length);
                 buffer.reset();
                 ending.reset();
                 closing.reset();
@@ -475,14 +487,14 @@ class ActionExecutor
       metric.ios["PgRead::b"] += buffer->size();
       if ((offset + buffer->size()) > metric.ios["Read::o"])
         metric.ios["Read::o"] = offset + buffer->size();
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(PgRead(file, offset, buffer->size(), buffer->data(), timeout) >>
               [buffer, orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s,
                                                                               PageInfo& r) mutable
               {
                 metric.addIos("PgRead", "e", HandleStatus(s, orgststr, "PgRead"));
-                metric.addDelays("PgRead", "tmeas", timer.elapsed());
+                metric.addCompletion("PgRead", timer.elapsed(), timer.latency(), r.GetLength());
                 buffer.reset();
                 ending.reset();
                 closing.reset();
@@ -504,7 +516,7 @@ class ActionExecutor
       metric.ios["Write::b"] += buffer->size();
       if ((offset + buffer->size()) > metric.ios["Write::o"])
         metric.ios["Write::o"] = offset + buffer->size();
-      mytimer_t timer;
+      mytimer_t timer(late);
 
       if (!simulate)
         Async(
@@ -512,7 +524,7 @@ class ActionExecutor
           [buffer, orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s) mutable
           {
             metric.addIos("Write", "e", HandleStatus(s, orgststr, "Write"));
-            metric.addDelays("Write", "tmeas", timer.elapsed());
+            metric.addCompletion("Write", timer.elapsed(), timer.latency(), 0, buffer->size());
             buffer.reset();
             ending.reset();
             closing.reset();
@@ -534,14 +546,14 @@ class ActionExecutor
       metric.ios["PgWrite::b"] += buffer->size();
       if ((offset + buffer->size()) > metric.ios["Write::o"])
         metric.ios["Write::o"] = offset + buffer->size();
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(
           PgWrite(file, offset, buffer->size(), buffer->data(), timeout) >>
           [buffer, orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s) mutable
           {
             metric.addIos("PgWrite", "e", HandleStatus(s, orgststr, "PgWrite"));
-            metric.addDelays("PgWrite", "tmeas", timer.elapsed());
+            metric.addCompletion("PgWrite", timer.elapsed(), timer.latency(), 0, buffer->size());
             buffer.reset();
             ending.reset();
             closing.reset();
@@ -557,13 +569,13 @@ class ActionExecutor
     {
       time_t timeout = GetSyncArgs();
       metric.ios["Sync::n"]++;
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(Sync(file, timeout) >>
               [orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s) mutable
               {
                 metric.addIos("Sync", "e", HandleStatus(s, orgststr, "Sync"));
-                metric.addDelays("Sync", "tmeas", timer.elapsed());
+                metric.addCompletion("Sync", timer.elapsed(), timer.latency());
                 ending.reset();
                 closing.reset();
               });
@@ -582,13 +594,13 @@ class ActionExecutor
       if (size > metric.ios["Truncate::o"])
         metric.ios["Truncate::o"] = size;
 
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(Truncate(file, size, timeout) >>
               [orgststr{ orgststr }, ending, closing, timer, &metric](XRootDStatus& s) mutable
               {
                 metric.addIos("Truncate", "e", HandleStatus(s, orgststr, "Truncate"));
-                metric.addDelays("Truncate", "tmeas", timer.elapsed());
+                metric.addCompletion("Truncate", timer.elapsed(), timer.latency());
                 ending.reset();
                 closing.reset();
               });
@@ -612,14 +624,14 @@ class ActionExecutor
           metric.ios["Read::o"] = ch.GetOffset() + ch.GetLength();
       }
 
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(
           VectorRead(file, chunks, timeout) >>
           [orgststr{ orgststr }, buffers, ending, closing, timer, &metric](XRootDStatus& s, VectorReadInfo& r) mutable
           {
             metric.addIos("VectorRead", "e", HandleStatus(s, orgststr, "VectorRead"));
-            metric.addDelays("VectorRead", "tmeas", timer.elapsed());
+            metric.addCompletion("VectorRead", timer.elapsed(), timer.latency(), r.GetSize());
             buffers.clear();
             ending.reset();
             closing.reset();
@@ -638,19 +650,21 @@ class ActionExecutor
       std::vector<buffer_t> buffers;
       std::tie(chunks, timeout, buffers) = GetVectorWriteArgs();
       metric.ios["VectorWrite::n"]++;
+      uint64_t wbytes = 0;
       for (auto& ch : chunks)
       {
+        wbytes += ch.GetLength();
         metric.ios["VectorWrite::b"] += ch.GetLength();
         if ((ch.GetOffset() + ch.GetLength()) > metric.ios["Write::o"])
           metric.ios["Write::o"] = ch.GetOffset() + ch.GetLength();
       }
-      mytimer_t timer;
+      mytimer_t timer(late);
       if (!simulate)
         Async(VectorWrite(file, chunks, timeout) >>
-              [orgststr{ orgststr }, buffers, ending, closing, timer, &metric](XRootDStatus& s) mutable
+              [orgststr{ orgststr }, buffers, wbytes, ending, closing, timer, &metric](XRootDStatus& s) mutable
               {
                 metric.addIos("VectorWrite", "e", HandleStatus(s, orgststr, "VectorWrite"));
-                metric.addDelays("VectorWrite", "tmeas", timer.elapsed());
+                metric.addCompletion("VectorWrite", timer.elapsed(), timer.latency(), 0, wbytes);
                 buffers.clear();
                 ending.reset();
                 closing.reset();
@@ -1012,14 +1026,24 @@ std::unordered_map<File*, action_list> ParseInput(const std::string&
 
 //------------------------------------------------------------------------------
 //! Execute list of actions against given file
+//!
+//! The actions are run open-loop: each one is submitted when it is due
+//! according to the recorded schedule, whether or not the previous ones have
+//! completed. Hence, a slow server does not slow down the arrival of requests
+//! and the time an action was submitted late counts towards its latency.
+//!
 //! @param file    : the file object
 //! @param actions : list of actions to be executed
-//! @param t0      : offset to add to each start time to determine when to ru an action
+//! @param tstart  : the time the replay of the first recorded action is due,
+//!                  if 0 actions are executed without following the timing
+//! @param trec0   : the recorded time of the first action
+//! @param speed   : playback speed factor
 //! @return        : thread that will executed the list of actions
 //------------------------------------------------------------------------------
 std::thread ExecuteActions(std::unique_ptr<File> file,
                            action_list&&         actions,
-                           double                t0,
+                           double                tstart,
+                           double                trec0,
                            double                speed,
                            ActionMetrics&        metric,
                            bool                  simulate)
@@ -1027,10 +1051,11 @@ std::thread ExecuteActions(std::unique_ptr<File> file,
   std::thread t(
     [file{ std::move(file) },
      actions{ std::move(actions) },
-     t0,
+     tstart,
+     trec0,
      &metric,
      simulate,
-     &speed]() mutable
+     speed]() mutable
     {
       XrdSysSemaphore endsem(0);
       XrdSysSemaphore closesem(0);
@@ -1041,10 +1066,9 @@ std::thread ExecuteActions(std::unique_ptr<File> file,
       {
         auto& action = p.second;
 
-        auto tdelay = t0 ? ((p.first + t0) - XrdCl::Action::timeNow()) : 0;
+        auto tdelay = tstart ? ((tstart + (p.first - trec0) / speed) - XrdCl::Action::timeNow()) : 0;
         if (tdelay > 0)
         {
-          tdelay /= speed;
           metric.delays[action.Name() + "::tloss"] += tdelay;
 	  std::this_thread::sleep_for(std::chrono::milliseconds((int) (tdelay * 1000)));
         }
@@ -1054,7 +1078,7 @@ std::thread ExecuteActions(std::unique_ptr<File> file,
         }
 
         mytimer_t timer;
-        action.Execute(ending, closing, metric, simulate);
+        action.Execute(ending, closing, metric, simulate, -tdelay);
         metric.addDelays(action.Name(), "tnomi", action.NominalDuration());
         metric.addDelays(action.Name(), "texec", timer.elapsed());
       }
@@ -1067,6 +1091,101 @@ std::thread ExecuteActions(std::unique_ptr<File> file,
   return t;
 }
 
+//------------------------------------------------------------------------------
+//! Print the latency percentiles of each operation
+//------------------------------------------------------------------------------
+void DumpLatencies(const ActionMetrics& metric, bool json)
+{
+  static const double      pct[]  = { 50, 90, 99, 99.9 };
+  static const char* const pname[] = { "p50", "p90", "p99", "p99.9" };
+
+  if (json)
+  {
+    std::cout << "  \"latency\": {" << std::endl;
+    bool first = true;
+    for (auto& l : metric.latencies)
+    {
+      if (!l.second.n)
+        continue;
+      std::string key = l.first;
+      std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+      std::cout << (first ? "" : ",\n") << "    \"" << key << "\": { \"n\": " << l.second.n
+                << ", \"mean\": " << l.second.mean();
+      for (int i = 0; i < 4; ++i)
+        std::cout << ", \"" << pname[i] << "\": " << l.second.percentile(pct[i]);
+      std::cout << ", \"max\": " << l.second.max << " }";
+      first = false;
+    }
+    std::cout << std::endl << "  }," << std::endl;
+    return;
+  }
+
+  std::cout << "# ---------------------------------------------" << std::endl;
+  std::cout << "# Latency [ms] (from the scheduled submission)" << std::endl;
+  std::cout << "# ---------------------------------------------" << std::endl;
+  std::cout << "# " << std::setw(12) << "op" << std::setw(10) << "n" << std::setw(10) << "mean";
+  for (int i = 0; i < 4; ++i)
+    std::cout << std::setw(10) << pname[i];
+  std::cout << std::setw(10) << "max" << std::endl;
+  for (auto& l : metric.latencies)
+  {
+    if (!l.second.n)
+      continue;
+    std::cout << "# " << std::setw(12) << l.first << std::setw(10) << l.second.n << std::fixed
+              << std::setprecision(3) << std::setw(10) << l.second.mean() * 1000;
+    for (int i = 0; i < 4; ++i)
+      std::cout << std::setw(10) << l.second.percentile(pct[i]) * 1000;
+    std::cout << std::setw(10) << l.second.max * 1000 << std::endl;
+  }
+}
+
+//------------------------------------------------------------------------------
+//! Print the throughput over time
+//------------------------------------------------------------------------------
+void DumpTimeSeries(const ActionMetrics& metric, bool json)
+{
+  if (metric.timeseries.empty())
+  {
+    if (json)
+      std::cout << "  \"timeseries\": []," << std::endl;
+    return;
+  }
+
+  uint64_t last = metric.timeseries.rbegin()->first;
+  if (json)
+    std::cout << "  \"timeseries\": [" << std::endl;
+  else
+  {
+    std::cout << "# ---------------------------------------------" << std::endl;
+    std::cout << "# Throughput (interval " << metric.interval << " s)" << std::endl;
+    std::cout << "# ---------------------------------------------" << std::endl;
+    std::cout << "# " << std::setw(10) << "time [s]" << std::setw(12) << "ops/s" << std::setw(14)
+              << "R [MB/s]" << std::setw(14) << "W [MB/s]" << std::endl;
+  }
+
+  // intervals without any completion are reported as well
+  for (uint64_t i = 0; i <= last; ++i)
+  {
+    IntervalSample sample;
+    auto           it = metric.timeseries.find(i);
+    if (it != metric.timeseries.end())
+      sample = it->second;
+    double t = i * metric.interval;
+    double ops = sample.ops / metric.interval;
+    double rmb = sample.rbytes / metric.interval / 1000000.0;
+    double wmb = sample.wbytes / metric.interval / 1000000.0;
+    if (json)
+      std::cout << "    { \"t\": " << t << ", \"ops\": " << ops << ", \"read::mb\": " << rmb
+                << ", \"write::mb\": " << wmb << " }" << (i < last ? "," : "") << std::endl;
+    else
+      std::cout << "# " << std::fixed << std::setprecision(2) << std::setw(10) << t
+                << std::setw(12) << ops << std::setw(14) << rmb << std::setw(14) << wmb
+                << std::endl;
+  }
+  if (json)
+    std::cout << "  ]," << std::endl;
+}
+
 }
 
 void usage()
@@ -1117,23 +1236,47 @@ int main(int argc, char** argv)
     std::unordered_map<XrdCl::File*, std::string>          filenames;
     std::unordered_map<XrdCl::File*, double>               synchronicity;
     std::unordered_map<XrdCl::File*, size_t>               responseerrors;
-    auto                                                   actions = XrdCl::ParseInput(opt.path(),
-                                     t0,
-                                     t1,
-                                     filenames,
-                                     synchronicity,
-                                     responseerrors,
-                                     opt.regex());  // parse the input file
+    std::unordered_map<XrdCl::File*, XrdCl::action_list>   actions;
+    std::unordered_map<XrdCl::File*, int>                  clients;
+
+    // each simulated client replays the whole record with its own files
+    for (int c = 0; c < opt.clients(); ++c)
+    {
+      std::vector<std::string> regex = opt.regex();
+      for (auto& r : regex)
+      {
+        size_t pos;
+        while ((pos = r.find("%c")) != std::string::npos)
+          r.replace(pos, 2, std::to_string(c));
+      }
+      auto clientactions = XrdCl::ParseInput(opt.path(),
+                                             t0,
+                                             t1,
+                                             filenames,
+                                             synchronicity,
+                                             responseerrors,
+                                             regex);  // parse the input file
+      for (auto& action : clientactions)
+      {
+        clients[action.first] = c;
+        actions.emplace(action.first, std::move(action.second));
+      }
+    }
+
     std::vector<std::thread>                               threads;
     std::unordered_map<XrdCl::File*, XrdCl::ActionMetrics> metrics;
     threads.reserve(actions.size());
-    double               toffset = XrdCl::Action::timeNow() - t0;
+    double               tstart = XrdCl::Action::timeNow();
     XrdCl::mytimer_t     timer;
     XrdCl::ActionMetrics summetric;
     bool                 sampling_error = false;
 
+    summetric.tstart   = tstart;
+    summetric.interval = opt.interval();
     for (auto& action : actions)
     {
+      metrics[action.first].tstart        = tstart;
+      metrics[action.first].interval      = opt.interval();
       metrics[action.first].fname         = filenames[action.first];
       metrics[action.first].synchronicity = synchronicity[action.first];
       metrics[action.first].errors        = responseerrors[action.first];
@@ -1155,15 +1298,17 @@ int main(int argc, char** argv)
     }
 
 
-    if (opt.print())
-      toffset = 0;  // indicate not to follow timing
-
     for (auto& action : actions)
     {
+      // the clients are started evenly spread over the ramp up time
+      double tclient = opt.print() ? 0  // indicate not to follow timing
+                                   : tstart + opt.ramp() * clients[action.first] / opt.clients();
+
       // execute list of actions against file object
       threads.emplace_back(ExecuteActions(std::unique_ptr<XrdCl::File>(action.first),
                                           std::move(action.second),
-                                          toffset,
+                                          tclient,
+                                          t0,
                                           opt.speed(),
                                           metrics[action.first],
                                           opt.print()));
@@ -1202,12 +1347,18 @@ int main(int argc, char** argv)
     if (opt.json())
     {
       {
+        if (!opt.print())
+        {
+          XrdCl::DumpLatencies(summetric, true);
+          XrdCl::DumpTimeSeries(summetric, true);
+        }
         std::cout << "  \"iosummary\": { " << std::endl;
         if (!opt.print())
         {
           std::cout << "    \"player::runtime\": " << tbench << "," << std::endl;
         }
         std::cout << "    \"player::speed\": " << opt.speed() << "," << std::endl;
+        std::cout << "    \"player::clients\": " << opt.clients() << "," << std::endl;
         std::cout << "    \"sampled::runtime\": " << t1 - t0 << "," << std::endl;
         std::cout << "    \"volume::totalread\": " << summetric.getBytesRead() << "," << std::endl;
         std::cout << "    \"volume::totalwrite\": " << summetric.getBytesWritten() << ","
@@ -1245,7 +1396,7 @@ int main(int argc, char** argv)
                     << "," << std::endl;
           std::cout << "    \"gain::write\":"
                     << (100.0 * summetric.delays["Write::tnomi"] / summetric.delays["Write::tmeas"])
-                    << std::endl;
+                    << "," << std::endl;
         }
         std::cout << "    \"synchronicity::read\":"
                   << summetric.aggregated_synchronicity.ReadSynchronicity() << "," << std::endl;
@@ -1271,6 +1422,7 @@ int main(int argc, char** argv)
       std::cout << "# Sampled Runtime  : " << std::fixed << t1 - t0 << " s" << std::endl;
       std::cout << "# Playback Speed   : " << std::fixed << std::setprecision(2) << opt.speed()
                 << std::endl;
+      std::cout << "# Clients          : " << opt.clients() << std::endl;
       std::cout << "# IO Volume (R)    : " << std::fixed
                 << XrdCl::ActionMetrics::humanreadable(summetric.getBytesRead())
                 << " [ std:" << XrdCl::ActionMetrics::humanreadable(summetric.ios["Read::b"])
@@ -1324,6 +1476,8 @@ int main(int argc, char** argv)
                 << summetric.aggregated_synchronicity.WriteSynchronicity() << "%" << std::endl;
       if (!opt.print())
       {
+        XrdCl::DumpLatencies(summetric, false);
+        XrdCl::DumpTimeSeries(summetric, false);
         std::cout << "# ---------------------------------------------" << std::endl;
         std::cout << "# Response Errors  : " << std::fixed << summetric.ios["All::e"] << std::endl;
         std::cout << "# =============================================" << std::endl;
@@ -45,6 +45,9 @@ class ReplayArgs
   , option_suppress_error(false)
   , option_verify(false)
   , option_speed(1.0)
+  , option_clients(1)
+  , option_ramp(0)
+  , option_interval(1.0)
   {
     while (1)
     {
@@ -55,9 +58,11 @@ class ReplayArgs
             { "long", no_argument, 0, 'l' },        { "json", no_argument, 0, 'j' },
             { "summary", no_argument, 0, 's' },     { "replace", required_argument, 0, 'r' },
             { "suppress", no_argument, 0, 'f' },    { "verify", no_argument, 0, 'v' },
-            { "speed", required_argument, 0, 'x' }, { 0, 0, 0, 0 } };
+            { "speed", required_argument, 0, 'x' }, { "clients", required_argument, 0, 'n' },
+            { "ramp", required_argument, 0, 'R' },  { "interval", required_argument, 0, 'i' },
+            { 0, 0, 0, 0 } };
 
-      int c = getopt_long(argc, argv, "vjpctshlfr:x:", long_options, &option_index);
+      int c = getopt_long(argc, argv, "vjpctshlfr:x:n:R:i:", long_options, &option_index);
       if (c == -1)
         break;
 
@@ -106,6 +111,30 @@ class ReplayArgs
           }
           break;
 
+        case 'n':
+          option_clients = std::atoi(optarg);
+          if (option_clients < 1)
+          {
+            usage();
+          }
+          break;
+
+        case 'R':
+          option_ramp = std::strtod(optarg, 0);
+          if (option_ramp < 0)
+          {
+            usage();
+          }
+          break;
+
+        case 'i':
+          option_interval = std::strtod(optarg, 0);
+          if (option_interval < 0)
+          {
+            usage();
+          }
+          break;
+
         case 'r':
           option_regex.push_back(optarg);
           break;
@@ -139,12 +168,18 @@ class ReplayArgs
       // we also accept to have no path and read from STDIN
       _path = argv[optind];
     }
+
+    if (option_clients > 1 && _path.empty())
+    {
+      // each client parses the record again, which is not possible for STDIN
+      usage();
+    }
   }
 
   void usage()
   {
     std::cerr
-      << "usage: xrdreplay [-p|--print] [-c|--create-data] [t|--truncate-data] [-l|--long] [-s|--summary] [-h|--help] [-r|--replace <arg>:=<newarg>] [-f|--suppress] [-v|--verify] [-x|--speed <value] p<recordfilename>]\n"
+      << "usage: xrdreplay [-p|--print] [-c|--create-data] [t|--truncate-data] [-l|--long] [-s|--summary] [-h|--help] [-r|--replace <arg>:=<newarg>] [-f|--suppress] [-v|--verify] [-x|--speed <value] [-n|--clients <n>] [-R|--ramp <s>] [-i|--interval <s>] p<recordfilename>]\n"
       << std::endl;
     std::cerr << "                -h | --help             : show this help" << std::endl;
     std::cerr
@@ -168,12 +203,24 @@ class ReplayArgs
     std::cerr
       << "                -x | --speed <x>        : change playback speed by factor <x> [ <x> > 0.0 ]"
       << std::endl;
+    std::cerr
+      << "                -n | --clients <n>      : replay the record as <n> simulated clients, each with its own files [ requires a record file ]"
+      << std::endl;
+    std::cerr
+      << "                -R | --ramp <s>         : start the clients evenly spread over <s> seconds [ default 0 ]"
+      << std::endl;
+    std::cerr
+      << "                -i | --interval <s>     : report throughput over time in intervals of <s> seconds, 0 disables it [ default 1 ]"
+      << std::endl;
     std::cerr
       << "                -r | --replace <a>:=<b> : replace in the argument list the string <a> with <b> "
       << std::endl;
     std::cerr
       << "                                          - option is usable several times e.g. to change storage prefixes or filenames"
       << std::endl;
+    std::cerr
+      << "                                          - %c in <b> is replaced with the client number e.g. to give each client its own files"
+      << std::endl;
     std::cerr << std::endl;
     std::cerr
       << "             [recordfilename]          : if a file is given, it will be used as record input otherwise STDIN is used to read records!"
@@ -194,6 +241,9 @@ class ReplayArgs
   bool                      suppress_error() { return option_suppress_error; }
   bool                      verify() { return option_verify; }
   double                    speed() { return option_speed; }
+  int                       clients() { return option_clients; }
+  double                    ramp() { return option_ramp; }
+  double                    interval() { return option_interval; }
   std::vector<std::string>& regex() { return option_regex; }
   std::string&              path() { return _path; }
 
@@ -207,6 +257,9 @@ class ReplayArgs
   bool                     option_suppress_error;
   bool                     option_verify;
   double                   option_speed;
+  int                      option_clients;
+  double                   option_ramp;
+  double                   option_interval;
   std::vector<std::string> option_regex;
   std::string              _path;
 };
@@ -69,6 +69,8 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"buff.mem",        "Buffer bytes:"},
 {"buff.buffs",      "Buffer count:"},
 {"buff.adj",        "Buffer adjustments:"},
+{"buff.maghit",     "Buffer magazine hits:"},
+{"buff.magmiss",    "Buffer magazine misses:"},
 {"buff.xlreqs",     "Buffer XL requests:"},
 {"buff.xlmem",      "Buffer XL bytes:"},
 {"buff.xlbuffs",    "Buffer XL count:"},
@@ -590,6 +590,7 @@ namespace
       {
         int val = XrdCl::DefaultSubStreamsPerChannel;
         XrdCl::DefaultEnv::GetEnv()->GetInt( "SubStreamsPerChannel", val );
+        if( url->GetSubStreams() ) val = url->GetSubStreams();
         pMaxNbConn = val - 1; // account for the control stream
       }
 
@@ -96,6 +96,9 @@ namespace XrdCl
   const int DefaultRetryWrtAtLBLimit       = 3;
   const int DefaultCpRetry                 = 0;
   const int DefaultCpUsePgWrtRd            = 1;
+  const int DefaultReadAheadSize           = 0;
+  const int DefaultReadAheadWindow         = 16*1024*1024;
+  const int DefaultZipIndexSpan            = 0;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -161,7 +164,10 @@ namespace XrdCl
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
-      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit }
+      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit },
+      { to_lower( "ReadAheadSize" ),           DefaultReadAheadSize },
+      { to_lower( "ReadAheadWindow" ),         DefaultReadAheadWindow },
+      { to_lower( "ZipIndexSpan" ),            DefaultZipIndexSpan }
     };
 
   static std::unordered_map<std::string, std::string> theDefaultStrs
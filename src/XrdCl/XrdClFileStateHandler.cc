@@ -39,6 +39,7 @@
 #include "XrdCl/XrdClRedirectorRegistry.hh"
 #include "XrdCl/XrdClAnyObject.hh"
 #include "XrdCl/XrdClUtils.hh"
+#include "XrdCl/XrdClReadAhead.hh"
 
 #ifdef WITH_XRDEC
 #include "XrdCl/XrdClEcHandler.hh"
@@ -531,11 +532,13 @@ namespace
       StatefulHandler( std::shared_ptr<XrdCl::FileStateHandler> &stateHandler,
                        XrdCl::ResponseHandler                   *userHandler,
                        XrdCl::Message                           *message,
-                       const XrdCl::MessageSendParams           &sendParams ):
+                       const XrdCl::MessageSendParams           &sendParams,
+                       bool                                      monitor = true ):
         pStateHandler( stateHandler ),
         pUserHandler( userHandler ),
         pMessage( message ),
-        pSendParams( sendParams )
+        pSendParams( sendParams ),
+        pMonitor( monitor )
       {
       }
 
@@ -573,7 +576,7 @@ namespace
         // We're clear
         //----------------------------------------------------------------------
         responsePtr.release();
-        XrdCl::FileStateHandler::OnStateResponse( pStateHandler, status, pMessage, response, hostList );
+        XrdCl::FileStateHandler::OnStateResponse( pStateHandler, status, pMessage, response, hostList, pMonitor );
         if( pUserHandler )
           pUserHandler->HandleResponseWithHosts( status, response, hostList );
         else
@@ -598,6 +601,7 @@ namespace
       XrdCl::ResponseHandler                   *pUserHandler;
       XrdCl::Message                           *pMessage;
       XrdCl::MessageSendParams                  pSendParams;
+      bool                                      pMonitor;
   };
 
   //----------------------------------------------------------------------------
@@ -664,8 +668,10 @@ namespace XrdCl
     pUseVirtRedirector( true ),
     pIsChannelEncrypted( false ),
     pAllowBundledClose( false ),
+    pReadAheadSize( DefaultReadAheadSize ),
     pPlugin( plugin )
   {
+    DefaultEnv::GetEnv()->GetInt( "ReadAheadSize", pReadAheadSize );
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -696,8 +702,10 @@ namespace XrdCl
     pFollowRedirects( true ),
     pUseVirtRedirector( useVirtRedirector ),
     pAllowBundledClose( false ),
+    pReadAheadSize( DefaultReadAheadSize ),
     pPlugin( plugin )
   {
+    DefaultEnv::GetEnv()->GetInt( "ReadAheadSize", pReadAheadSize );
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -947,7 +955,17 @@ namespace XrdCl
     if( self->pFileState == OpenInProgress || self->pFileState == Recovering )
       return XRootDStatus( stError, errInvalidOp );
 
-    if( !self->pAllowBundledClose && !self->pInTheFly.empty() )
+    //--------------------------------------------------------------------------
+    // Readahead requests still in the fly are bundled with the close, but
+    // the user reads waiting for them are not
+    //--------------------------------------------------------------------------
+    size_t inTheFly = self->pInTheFly.size();
+    if( self->pReadAhead )
+    {
+      inTheFly -= std::min<size_t>( inTheFly, self->pReadAhead->InFlight() );
+      inTheFly += self->pReadAhead->Waiting();
+    }
+    if( !self->pAllowBundledClose && inTheFly )
       return XRootDStatus( stError, errInvalidOp );
 
     self->pFileState = CloseInProgress;
@@ -1075,6 +1093,59 @@ namespace XrdCl
     if( self->pFileState != Opened && self->pFileState != Recovering )
       return XRootDStatus( stError, errInvalidOp );
 
+    if( !self->pReadAhead )
+      return SendRead( self, offset, size, buffer, handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // Let the readahead serve the read if it can and send whatever it wants
+    // to have fetched
+    //--------------------------------------------------------------------------
+    std::vector<ReadAhead::Fetch> fetches;
+    uint32_t length = 0;
+    ReadAhead::Result res = self->pReadAhead->Read( offset, size, buffer, handler,
+                                                    length, fetches );
+    for( auto &f : fetches )
+    {
+      XRootDStatus st = SendRead( self, f.offset, f.size, f.buffer, f.handler,
+                                  timeout, false );
+      if( !st.IsOK() ) self->pReadAhead->Failed( f, st );
+    }
+
+    //--------------------------------------------------------------------------
+    // The reads served by the readahead are accounted for as user reads, its
+    // own fetches are reported separately; the bytes it actually returned
+    // (fewer than requested at the end of file) are added up on close
+    //--------------------------------------------------------------------------
+    if( res != ReadAhead::Miss )
+      ++self->pRCount;
+
+    if( res == ReadAhead::Pending )
+      return XRootDStatus();
+
+    if( res == ReadAhead::Hit )
+    {
+      AnyObject *obj = new AnyObject();
+      obj->Set( new ChunkInfo( offset, length, buffer ) );
+      ResponseJob *job = new ResponseJob( handler, new XRootDStatus(), obj,
+                                          new HostList() );
+      DefaultEnv::GetPostMaster()->GetJobManager()->QueueJob( job );
+      return XRootDStatus();
+    }
+
+    return SendRead( self, offset, size, buffer, handler, timeout );
+  }
+
+  //----------------------------------------------------------------------------
+  // Send a read request
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::SendRead( std::shared_ptr<FileStateHandler> &self,
+                                           uint64_t         offset,
+                                           uint32_t         size,
+                                           void            *buffer,
+                                           ResponseHandler *handler,
+                                           time_t           timeout,
+                                           bool             monitor )
+  {
     Log *log = DefaultEnv::GetLog();
     log->Debug( FileMsg, "[%p@%s] Sending a read command for handle %#x to %s",
                 (void*)self.get(), self->pFileUrl->GetObfuscatedURL().c_str(),
@@ -1099,7 +1170,8 @@ namespace XrdCl
     params.stateful        = true;
     params.chunkList       = list;
     MessageUtils::ProcessSendParams( params );
-    StatefulHandler  *stHandler = new StatefulHandler( self, handler, msg, params );
+    StatefulHandler  *stHandler = new StatefulHandler( self, handler, msg, params,
+                                                       monitor );
 
     return SendOrQueue( self, *self->pDataServer, msg, stHandler, params );
   }
@@ -2325,6 +2397,11 @@ namespace XrdCl
       else pAllowBundledClose = false;
       return true;
     }
+    else if( name == "ReadAheadSize" )
+    {
+      pReadAheadSize = atoi( value.c_str() );
+      return true;
+    }
     return false;
   }
 
@@ -2507,6 +2584,22 @@ namespace XrdCl
       //------------------------------------------------------------------------
       ReSendQueuedMessages();
       pFileState  = Opened;
+
+      //------------------------------------------------------------------------
+      // Set up the readahead, it only makes sense for remote files that are
+      // not going to change under our feet
+      //------------------------------------------------------------------------
+      if( !pReadAhead && pReadAheadSize > 0 && IsReadOnly() &&
+          !pDataServer->IsLocalFile() )
+      {
+        int window = DefaultReadAheadWindow;
+        DefaultEnv::GetEnv()->GetInt( "ReadAheadWindow", window );
+        pReadAhead = std::make_shared<ReadAhead>( pReadAheadSize,
+                                                  std::max( window, 0 ) );
+        log->Debug( FileMsg, "[%p@%s] Readahead enabled, block size: %d, "
+                    "window: %d", (void*)this, pFileUrl->GetObfuscatedURL().c_str(),
+                    pReadAheadSize, window );
+      }
     }
   }
 
@@ -2527,6 +2620,7 @@ namespace XrdCl
 
     MonitorClose( status );
     ResetMonitoringVars();
+    pReadAhead.reset();
 
     pStatus    = *status;
     pFileState = Closed;
@@ -2657,7 +2751,8 @@ namespace XrdCl
                                           XRootDStatus                      *status,
                                           Message                           *message,
                                           AnyObject                         *response,
-                                          HostList                          */*urlList*/ )
+                                          HostList                          */*urlList*/,
+                                          bool                               monitor )
   {
     Log    *log = DefaultEnv::GetLog();
     XrdSysMutexHelper scopedLock( self->pMutex );
@@ -2697,8 +2792,11 @@ namespace XrdCl
       //------------------------------------------------------------------------
       case kXR_read:
       {
-        ++self->pRCount;
-        self->pRBytes += req->read.rlen;
+        if( monitor )
+        {
+          ++self->pRCount;
+          self->pRBytes += req->read.rlen;
+        }
         break;
       }
 
@@ -3275,11 +3373,30 @@ namespace XrdCl
     Monitor *mon = DefaultEnv::GetMonitor();
     if( mon )
     {
+      uint64_t rBytes = pRBytes;
+      if( pReadAhead )
+      {
+        ReadAhead::Stats st = pReadAhead->GetStats();
+        rBytes += st.hitBytes;
+        Monitor::ReadAheadInfo i;
+        i.file       = pFileUrl;
+        i.hits       = st.hits;
+        i.hitBytes   = st.hitBytes;
+        i.waits      = st.waits;
+        i.misses     = st.misses;
+        i.missBytes  = st.missBytes;
+        i.fetches    = st.fetches;
+        i.fetchBytes = st.fetchBytes;
+        i.wasteBytes = st.wasteBytes;
+        i.maxWindow  = st.maxWindow;
+        mon->Event( Monitor::EvReadAhead, &i );
+      }
+
       Monitor::CloseInfo i;
       i.file = pFileUrl;
       i.oTOD = pOpenTime;
       gettimeofday( &i.cTOD, 0 );
-      i.rBytes  = pRBytes;
+      i.rBytes  = rBytes;
       i.vrBytes = pVRBytes;
       i.wBytes  = pWBytes;
       i.vwBytes = pVWBytes;
@@ -56,6 +56,7 @@ namespace XrdCl
   class Message;
   class EcHandler;
   class FileStateHandler;
+  class ReadAhead;
 
   //----------------------------------------------------------------------------
   //! PgRead flags
@@ -694,13 +695,15 @@ namespace XrdCl
                                       MessageSendParams                 &sendParams );
 
       //------------------------------------------------------------------------
-      //! Handle stateful response
+      //! Handle stateful response, reads are accounted for in the monitoring
+      //! counters only if monitor is true
       //------------------------------------------------------------------------
       static void OnStateResponse( std::shared_ptr<FileStateHandler> &self,
                                    XRootDStatus                      *status,
                                    Message                           *message,
                                    AnyObject                         *response,
-                                   HostList                          *hostList );
+                                   HostList                          *hostList,
+                                   bool                               monitor = true );
 
       //------------------------------------------------------------------------
       //! Check if the file is open
@@ -859,6 +862,20 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool IsReadOnly() const;
 
+      //------------------------------------------------------------------------
+      //! Send a read request, the file has to be locked
+      //!
+      //! @param monitor false if the read is not to be accounted for in the
+      //!                monitoring counters (readahead fetches)
+      //------------------------------------------------------------------------
+      static XRootDStatus SendRead( std::shared_ptr<FileStateHandler> &self,
+                                    uint64_t                           offset,
+                                    uint32_t                           size,
+                                    void                              *buffer,
+                                    ResponseHandler                   *handler,
+                                    time_t                             timeout,
+                                    bool                               monitor = true );
+
       //------------------------------------------------------------------------
       //! Re-open the current file at a given server
       //------------------------------------------------------------------------
@@ -969,6 +986,12 @@ namespace XrdCl
       bool                    pIsChannelEncrypted;
       bool                    pAllowBundledClose;
 
+      //------------------------------------------------------------------------
+      // Client side readahead, only set up for files opened for reading
+      //------------------------------------------------------------------------
+      int                         pReadAheadSize;
+      std::shared_ptr<ReadAhead>  pReadAhead;
+
       //------------------------------------------------------------------------
       // Monitoring variables
       //------------------------------------------------------------------------
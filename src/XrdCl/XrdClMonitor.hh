@@ -135,6 +135,27 @@ namespace XrdCl
         const XRootDStatus *status;   //!< Close status
       };
 
+      //------------------------------------------------------------------------
+      //! Describe the client side readahead done for a file, reported before
+      //! its close event
+      //------------------------------------------------------------------------
+      struct ReadAheadInfo
+      {
+        ReadAheadInfo():
+          file(0), hits(0), hitBytes(0), waits(0), misses(0), missBytes(0),
+          fetches(0), fetchBytes(0), wasteBytes(0), maxWindow(0) {}
+        const URL *file;        //!< The file in question
+        uint64_t   hits;        //!< Reads served from readahead buffers
+        uint64_t   hitBytes;    //!< Bytes served from readahead buffers
+        uint64_t   waits;       //!< Hits that waited for data being fetched
+        uint64_t   misses;      //!< Reads sent to the server
+        uint64_t   missBytes;   //!< Bytes requested by those reads
+        uint64_t   fetches;     //!< Readahead requests completed
+        uint64_t   fetchBytes;  //!< Bytes received by readahead requests
+        uint64_t   wasteBytes;  //!< Fetched bytes dropped without being read
+        uint32_t   maxWindow;   //!< Largest readahead window reached
+      };
+
       //------------------------------------------------------------------------
       //! Describe an encountered file-based error
       //------------------------------------------------------------------------
@@ -219,7 +240,8 @@ namespace XrdCl
         EvClose,          //!< CloseInfo: File closed
         EvErrIO,          //!< ErrorInfo: An I/O error occurred
         EvConnect,        //!< ConnectInfo: Login  into a server
-        EvDisconnect      //!< DisconnectInfo: Logout from a server
+        EvDisconnect,     //!< DisconnectInfo: Logout from a server
+        EvReadAhead       //!< ReadAheadInfo: Readahead done for a file
 
       };
 
@@ -370,6 +370,23 @@ namespace XrdCl
       itr = config.find( "plgr" );
       if( itr != config.end() )
         Utils::splitString( plgr, itr->second, "," );
+      itr = config.find( "hedge" );
+      if( itr != config.end() )
+        XrdEc::Config::Instance().hedge_budget =
+            std::chrono::milliseconds( std::stoul( itr->second ) );
+      itr = config.find( "hedgepct" );
+      if( itr != config.end() )
+      {
+        unsigned long hedgepct = std::stoul( itr->second );
+        if( hedgepct > 100 )
+        {
+          log->Error( PlugInMgrMsg, "Invalid hedgepct '%s' for XrdEcDefault, "
+                      "must be a percentile between 0 and 100",
+                      itr->second.c_str() );
+          return std::make_pair<XrdOucPinLoader*, PlugInFactory*>( nullptr, nullptr );
+        }
+        XrdEc::Config::Instance().hedge_percentile = hedgepct;
+      }
 
       std::string xrdclECenv = std::to_string(nbdta) + "," +
                                  std::to_string(nbprt) + "," +
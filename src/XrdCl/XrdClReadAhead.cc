@@ -0,0 +1,479 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClReadAhead.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Data fetched (or being fetched) ahead of the application
+  //----------------------------------------------------------------------------
+  struct ReadAhead::Block
+  {
+    enum State { Fetching, Done, Failed };
+
+    Block( uint64_t off, uint32_t sz ):
+      offset( off ), size( sz ), length( 0 ), data( new char[sz] ),
+      state( Fetching ), used( false ), issued( Clock::now() ) {}
+
+    uint64_t                             offset;
+    uint32_t                             size;    // requested
+    uint32_t                             length;  // received
+    std::unique_ptr<char[]>              data;
+    State                                state;
+    bool                                 used;
+    Clock::time_point                    issued;
+    XRootDStatus                         status;
+    std::vector<std::shared_ptr<Waiter>> waiters;
+  };
+
+  //----------------------------------------------------------------------------
+  //! A read of the application waiting for blocks being fetched
+  //----------------------------------------------------------------------------
+  struct ReadAhead::Waiter
+  {
+    uint64_t                             offset;
+    uint32_t                             size;
+    char                                *buffer;
+    ResponseHandler                     *handler;
+    int                                  pending;
+    std::vector<std::shared_ptr<Block>>  blocks;
+  };
+
+  //----------------------------------------------------------------------------
+  //! Handler of the fetch of a block
+  //----------------------------------------------------------------------------
+  class ReadAhead::BlockHandler: public ResponseHandler
+  {
+    public:
+      BlockHandler( std::shared_ptr<ReadAhead> ra, std::shared_ptr<Block> blk ):
+        pReadAhead( std::move( ra ) ), pBlock( std::move( blk ) ) {}
+
+      void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        pReadAhead->Done( pBlock, status, response );
+        delete this;
+      }
+
+    private:
+      std::shared_ptr<ReadAhead> pReadAhead;
+      std::shared_ptr<Block>     pBlock;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  ReadAhead::ReadAhead( uint32_t blockSize, uint32_t maxWindow ):
+    pBlockSize( blockSize ),
+    pMaxWindow( std::max( maxWindow, 2 * blockSize ) ),
+    pWindow( 2 * blockSize ),
+    pBuffered( 0 ),
+    pInFlight( 0 ),
+    pWaiting( 0 ),
+    pEOF( std::numeric_limits<uint64_t>::max() ),
+    pLastOffset( 0 ),
+    pLastSize( 0 ),
+    pStride( 0 ),
+    pSeqRun( 0 ),
+    pStrideRun( 0 ),
+    pNext( 0 ),
+    pMinLatency( 0 ),
+    pRate( 0 ),
+    pSamples( 0 )
+  {
+    pStats.maxWindow = pWindow;
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  ReadAhead::~ReadAhead()
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Handle a read of the application
+  //----------------------------------------------------------------------------
+  ReadAhead::Result ReadAhead::Read( uint64_t             offset,
+                                     uint32_t             size,
+                                     void                *buffer,
+                                     ResponseHandler     *handler,
+                                     uint32_t            &length,
+                                     std::vector<Fetch>  &fetches )
+  {
+    //--------------------------------------------------------------------------
+    // Empty reads tell nothing about the access pattern
+    //--------------------------------------------------------------------------
+    if( !size ) return Miss;
+
+    std::unique_lock<std::mutex> lck( pMutex );
+    Result result = Miss;
+
+    //--------------------------------------------------------------------------
+    // Update the access pattern: a read is sequential if it starts where the
+    // previous one ended, strided if it has the same size and distance from
+    // the previous one as that one had from its predecessor.
+    //--------------------------------------------------------------------------
+    if( offset == pLastOffset + pLastSize )
+    {
+      ++pSeqRun;
+      pStrideRun = 0;
+    }
+    else
+    {
+      pSeqRun = 0;
+      uint64_t stride = offset > pLastOffset ? offset - pLastOffset : 0;
+      if( stride && stride == pStride && size == pLastSize ) ++pStrideRun;
+      else pStrideRun = 0;
+      pStride = stride;
+    }
+    pLastOffset = offset;
+    pLastSize   = size;
+
+    //--------------------------------------------------------------------------
+    // Look for the data
+    //--------------------------------------------------------------------------
+    std::vector<std::shared_ptr<Block>> blocks;
+    if( Collect( offset, size, blocks ) )
+    {
+      int pending = 0;
+      for( auto &blk : blocks )
+        if( blk->state == Block::Fetching ) ++pending;
+
+      ++pStats.hits;
+      if( !pending )
+      {
+        length = Copy( offset, size, static_cast<char*>( buffer ), blocks );
+        pStats.hitBytes += length;
+        result = Hit;
+      }
+      else
+      {
+        std::shared_ptr<Waiter> w = std::make_shared<Waiter>();
+        w->offset  = offset;
+        w->size    = size;
+        w->buffer  = static_cast<char*>( buffer );
+        w->handler = handler;
+        w->pending = pending;
+        w->blocks  = blocks;
+        for( auto &blk : blocks )
+          if( blk->state == Block::Fetching ) blk->waiters.push_back( w );
+        ++pStats.waits;
+        ++pWaiting;
+        Grow();
+        result = Pending;
+      }
+    }
+    else
+    {
+      ++pStats.misses;
+      pStats.missBytes += size;
+    }
+
+    //--------------------------------------------------------------------------
+    // Drop what is behind a sequential or strided reader and fetch what comes
+    // next; a random read means that whatever was fetched is of no use.
+    //--------------------------------------------------------------------------
+    if( pSeqRun || pStrideRun ) Evict( offset );
+    else if( result == Miss ) Evict( std::numeric_limits<uint64_t>::max() );
+    if( pSeqRun >= 2 || pStrideRun >= 2 ) Prefetch( offset, size, fetches );
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+  // Tell the readahead that a fetch could not be sent
+  //----------------------------------------------------------------------------
+  void ReadAhead::Failed( const Fetch &fetch, const XRootDStatus &status )
+  {
+    fetch.handler->HandleResponse( new XRootDStatus( status ), 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Number of fetches in flight
+  //----------------------------------------------------------------------------
+  uint32_t ReadAhead::InFlight() const
+  {
+    std::unique_lock<std::mutex> lck( pMutex );
+    return pInFlight;
+  }
+
+  //----------------------------------------------------------------------------
+  // Number of application reads waiting for fetches in flight
+  //----------------------------------------------------------------------------
+  uint32_t ReadAhead::Waiting() const
+  {
+    std::unique_lock<std::mutex> lck( pMutex );
+    return pWaiting;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the statistics
+  //----------------------------------------------------------------------------
+  ReadAhead::Stats ReadAhead::GetStats() const
+  {
+    std::unique_lock<std::mutex> lck( pMutex );
+    return pStats;
+  }
+
+  //----------------------------------------------------------------------------
+  // A fetch has completed
+  //----------------------------------------------------------------------------
+  void ReadAhead::Done( std::shared_ptr<Block> &block, XRootDStatus *status,
+                        AnyObject *response )
+  {
+    std::vector<std::shared_ptr<Waiter>> ready;
+    {
+      std::unique_lock<std::mutex> lck( pMutex );
+      Clock::time_point now = Clock::now();
+      --pInFlight;
+
+      ChunkInfo *chunk = 0;
+      if( status->IsOK() && response ) response->Get( chunk );
+      if( chunk )
+      {
+        block->state  = Block::Done;
+        block->length = std::min( chunk->length, block->size );
+        if( block->length < block->size )
+          pEOF = std::min( pEOF, block->offset + block->length );
+        ++pStats.fetches;
+        pStats.fetchBytes += block->length;
+
+        //----------------------------------------------------------------------
+        // Estimate the bandwidth-delay product: the latency of a fetch and
+        // the rate at which fetches complete while several are in flight.
+        //----------------------------------------------------------------------
+        double latency = std::chrono::duration<double>( now - block->issued ).count();
+        if( !pSamples || latency < pMinLatency ) pMinLatency = latency;
+        if( pSamples )
+        {
+          double gap = std::chrono::duration<double>( now - pLastDone ).count();
+          if( gap > 0 )
+          {
+            double rate = block->length / gap;
+            pRate = pSamples > 1 ? 0.8 * pRate + 0.2 * rate : rate;
+          }
+        }
+        pLastDone = now;
+        ++pSamples;
+      }
+      else
+      {
+        block->state  = Block::Failed;
+        block->status = *status;
+        if( block->status.IsOK() )
+          block->status = XRootDStatus( stError, errInternal );
+        auto it = pBlocks.find( block->offset );
+        if( it != pBlocks.end() && it->second == block ) Drop( it );
+      }
+
+      for( auto &w : block->waiters )
+        if( --w->pending == 0 ) ready.push_back( w );
+      block->waiters.clear();
+      pWaiting -= ready.size();
+    }
+
+    delete status;
+    delete response;
+
+    //--------------------------------------------------------------------------
+    // Reply to the application reads that were waiting for this block, out of
+    // the lock as the handlers may issue new reads.
+    //--------------------------------------------------------------------------
+    for( auto &w : ready )
+    {
+      XRootDStatus st;
+      for( auto &blk : w->blocks )
+        if( blk->state == Block::Failed ) { st = blk->status; break; }
+      if( !st.IsOK() )
+      {
+        w->handler->HandleResponseWithHosts( new XRootDStatus( st ), 0,
+                                             new HostList() );
+        continue;
+      }
+      uint32_t length;
+      {
+        std::unique_lock<std::mutex> lck( pMutex );
+        length = Copy( w->offset, w->size, w->buffer, w->blocks );
+        pStats.hitBytes += length;
+      }
+      AnyObject *obj = new AnyObject();
+      obj->Set( new ChunkInfo( w->offset, length, w->buffer ) );
+      w->handler->HandleResponseWithHosts( new XRootDStatus(), obj,
+                                           new HostList() );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Issue the fetches for what the application is expected to read next
+  //----------------------------------------------------------------------------
+  void ReadAhead::Prefetch( uint64_t offset, uint32_t size,
+                            std::vector<Fetch> &fetches )
+  {
+    if( !size ) return;
+
+    auto issue = [&]( uint64_t off, uint32_t sz )
+    {
+      if( off >= pEOF || pBuffered + sz > 2 * uint64_t( pMaxWindow ) ) return false;
+      std::shared_ptr<Block> blk = std::make_shared<Block>( off, sz );
+      pBlocks[off] = blk;
+      pBuffered += sz;
+      ++pInFlight;
+      Fetch f;
+      f.offset  = off;
+      f.size    = sz;
+      f.buffer  = blk->data.get();
+      f.handler = new BlockHandler( shared_from_this(), blk );
+      fetches.push_back( f );
+      return true;
+    };
+
+    uint64_t end = offset + size;
+    if( pSeqRun >= 2 )
+    {
+      //------------------------------------------------------------------------
+      // Sequential: keep a window of blocks beyond the end of this read
+      //------------------------------------------------------------------------
+      std::vector<std::shared_ptr<Block>> blocks;
+      if( pNext < end || !Collect( end, 1, blocks ) )
+        pNext = end;
+      while( pNext < end + pWindow )
+      {
+        if( !pBlocks.count( pNext ) && !issue( pNext, pBlockSize ) ) break;
+        pNext += pBlockSize;
+      }
+    }
+    else
+    {
+      //------------------------------------------------------------------------
+      // Strided: fetch the records expected at the next strides, but do not
+      // have more than a handful of them in flight
+      //------------------------------------------------------------------------
+      uint64_t off = offset;
+      for( uint64_t ahead = 0; ahead < pWindow; ahead += size )
+      {
+        if( pInFlight >= MaxStridedFetches ) break;
+        off += pStride;
+        if( !pBlocks.count( off ) && !issue( off, size ) ) break;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Find the blocks holding a range; false if it is not entirely covered
+  //----------------------------------------------------------------------------
+  bool ReadAhead::Collect( uint64_t offset, uint32_t size,
+                           std::vector<std::shared_ptr<Block>> &blocks )
+  {
+    auto it = pBlocks.upper_bound( offset );
+    if( it == pBlocks.begin() ) return false;
+    --it;
+
+    uint64_t pos = offset, end = offset + size;
+    while( pos < end )
+    {
+      if( it == pBlocks.end() || it->first > pos ) return false;
+      Block &blk = *it->second;
+      if( blk.offset + blk.size <= pos ) return false;
+      blocks.push_back( it->second );
+      if( blk.state == Block::Done && blk.length < blk.size ) break; // EOF
+      pos = blk.offset + blk.size;
+      ++it;
+      if( it != pBlocks.end() && it->first != pos ) it = pBlocks.end();
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Copy a range out of the blocks holding it, up to the end of file
+  //----------------------------------------------------------------------------
+  uint32_t ReadAhead::Copy( uint64_t offset, uint32_t size, char *buffer,
+                            const std::vector<std::shared_ptr<Block>> &blocks )
+  {
+    uint64_t pos = offset, end = offset + size;
+    for( auto &blk : blocks )
+    {
+      blk->used = true;
+      uint64_t bend = std::min( blk->offset + blk->length, end );
+      if( pos < bend )
+      {
+        memcpy( buffer + ( pos - offset ), blk->data.get() + ( pos - blk->offset ),
+                bend - pos );
+        pos = bend;
+      }
+      if( blk->length < blk->size ) break;
+    }
+    return pos - offset;
+  }
+
+  //----------------------------------------------------------------------------
+  // Forget about a block
+  //----------------------------------------------------------------------------
+  void ReadAhead::Drop( std::map<uint64_t, std::shared_ptr<Block>>::iterator it )
+  {
+    Block &blk = *it->second;
+    pBuffered -= blk.size;
+    if( blk.state == Block::Done && !blk.used )
+    {
+      pStats.wasteBytes += blk.length;
+      Shrink();
+    }
+    pBlocks.erase( it );
+  }
+
+  //----------------------------------------------------------------------------
+  // Drop the fetched blocks entirely behind the given offset
+  //----------------------------------------------------------------------------
+  void ReadAhead::Evict( uint64_t offset )
+  {
+    auto it = pBlocks.begin();
+    while( it != pBlocks.end() && it->first < offset )
+    {
+      Block &blk = *it->second;
+      if( blk.state != Block::Fetching && blk.offset + blk.size <= offset )
+        Drop( it++ );
+      else ++it;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // The application had to wait: fetch further ahead, unless the window
+  // already covers twice the bandwidth-delay product.
+  //----------------------------------------------------------------------------
+  void ReadAhead::Grow()
+  {
+    uint64_t limit = pMaxWindow;
+    if( pSamples >= 4 && pRate > 0 )
+      limit = std::min<uint64_t>( limit, std::max<uint64_t>( 2 * pBlockSize,
+                                         2 * pRate * pMinLatency ) );
+    if( pWindow < limit )
+      pWindow = std::min<uint64_t>( 2 * uint64_t( pWindow ), limit );
+    pStats.maxWindow = std::max( pStats.maxWindow, pWindow );
+  }
+
+  //----------------------------------------------------------------------------
+  // Fetched data was not used: fetch less ahead
+  //----------------------------------------------------------------------------
+  void ReadAhead::Shrink()
+  {
+    pWindow = std::max( pWindow / 2, 2 * pBlockSize );
+  }
+}
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_READ_AHEAD_HH__
+#define __XRD_CL_READ_AHEAD_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace XrdCl
+{
+  class AnyObject;
+  class ResponseHandler;
+  class XRootDStatus;
+
+  //----------------------------------------------------------------------------
+  //! Client side readahead for a file opened for reading.
+  //!
+  //! Every read of the application is shown to the readahead, which tracks
+  //! the access pattern. Once the reads are found to be sequential, or to be
+  //! records of the same size at a constant stride, the readahead asks for
+  //! the data that should come next to be fetched into its own buffers.
+  //! Reads falling entirely within fetched (or still being fetched) data are
+  //! then served from memory.
+  //!
+  //! The amount of data being fetched ahead of the application (the window)
+  //! starts at two blocks. It doubles whenever the application has to wait
+  //! for data that was already requested and halves whenever fetched data is
+  //! dropped unused. It is capped by twice the bandwidth-delay product
+  //! estimated from the fetches themselves and by the configured maximum.
+  //!
+  //! The readahead does not send anything itself: the fetches it wants are
+  //! handed back to the caller who sends them as ordinary reads with the
+  //! given handlers.
+  //----------------------------------------------------------------------------
+  class ReadAhead: public std::enable_shared_from_this<ReadAhead>
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! How a read was handled
+      //------------------------------------------------------------------------
+      enum Result
+      {
+        Miss,     //!< Not in memory, the caller must read the data itself
+        Hit,      //!< Data copied to the user buffer, the caller must reply
+        Pending   //!< Data is being fetched, the handler will be called
+      };
+
+      //------------------------------------------------------------------------
+      //! A read the caller must send on behalf of the readahead
+      //------------------------------------------------------------------------
+      struct Fetch
+      {
+        uint64_t         offset;
+        uint32_t         size;
+        void            *buffer;
+        ResponseHandler *handler;
+      };
+
+      //------------------------------------------------------------------------
+      //! Statistics
+      //------------------------------------------------------------------------
+      struct Stats
+      {
+        Stats(): hits( 0 ), hitBytes( 0 ), waits( 0 ), misses( 0 ),
+                 missBytes( 0 ), fetches( 0 ), fetchBytes( 0 ),
+                 wasteBytes( 0 ), maxWindow( 0 ) {}
+        uint64_t hits;        //!< Reads served from memory
+        uint64_t hitBytes;    //!< Bytes served from memory
+        uint64_t waits;       //!< Reads that waited for a fetch (also hits)
+        uint64_t misses;      //!< Reads sent to the server
+        uint64_t missBytes;   //!< Bytes requested by those reads
+        uint64_t fetches;     //!< Readahead requests completed
+        uint64_t fetchBytes;  //!< Bytes received by those requests
+        uint64_t wasteBytes;  //!< Fetched bytes dropped before being read
+        uint32_t maxWindow;   //!< Largest window reached
+      };
+
+      //------------------------------------------------------------------------
+      //! Maximum number of strided fetches in flight, each of them is just one
+      //! record so without it small records would fill the window with
+      //! thousands of tiny reads
+      //------------------------------------------------------------------------
+      static const uint32_t MaxStridedFetches = 16;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param blockSize size of the sequential readahead requests
+      //! @param maxWindow maximum number of bytes fetched ahead
+      //------------------------------------------------------------------------
+      ReadAhead( uint32_t blockSize, uint32_t maxWindow );
+
+      ~ReadAhead();
+
+      //------------------------------------------------------------------------
+      //! Handle a read of the application
+      //!
+      //! @param offset   offset of the read
+      //! @param size     size of the read
+      //! @param buffer   user buffer
+      //! @param handler  user handler, only used if Pending is returned
+      //! @param length   set to the number of bytes copied if Hit is returned
+      //!                 (smaller than size at the end of file)
+      //! @param fetches  filled with the reads the caller must send
+      //------------------------------------------------------------------------
+      Result Read( uint64_t             offset,
+                   uint32_t             size,
+                   void                *buffer,
+                   ResponseHandler     *handler,
+                   uint32_t            &length,
+                   std::vector<Fetch>  &fetches );
+
+      //------------------------------------------------------------------------
+      //! Tell the readahead that a fetch could not be sent; this takes care of
+      //! its handler.
+      //------------------------------------------------------------------------
+      void Failed( const Fetch &fetch, const XRootDStatus &status );
+
+      //------------------------------------------------------------------------
+      //! Number of fetches in flight
+      //------------------------------------------------------------------------
+      uint32_t InFlight() const;
+
+      //------------------------------------------------------------------------
+      //! Number of application reads waiting for fetches in flight
+      //------------------------------------------------------------------------
+      uint32_t Waiting() const;
+
+      //------------------------------------------------------------------------
+      //! Get the statistics
+      //------------------------------------------------------------------------
+      Stats GetStats() const;
+
+    private:
+      typedef std::chrono::steady_clock Clock;
+
+      struct Block;
+      struct Waiter;
+      class  BlockHandler;
+
+      void     Done( std::shared_ptr<Block> &block, XRootDStatus *status,
+                     AnyObject *response );
+      void     Prefetch( uint64_t offset, uint32_t size,
+                         std::vector<Fetch> &fetches );
+      bool     Collect( uint64_t offset, uint32_t size,
+                        std::vector<std::shared_ptr<Block>> &blocks );
+      uint32_t Copy( uint64_t offset, uint32_t size, char *buffer,
+                     const std::vector<std::shared_ptr<Block>> &blocks );
+      void     Drop( std::map<uint64_t, std::shared_ptr<Block>>::iterator it );
+      void     Evict( uint64_t offset );
+      void     Grow();
+      void     Shrink();
+
+      mutable std::mutex                           pMutex;
+      std::map<uint64_t, std::shared_ptr<Block>>   pBlocks;
+      uint32_t                                     pBlockSize;
+      uint32_t                                     pMaxWindow;
+      uint32_t                                     pWindow;
+      uint64_t                                     pBuffered; // fetched or in flight
+      uint32_t                                     pInFlight;
+      uint32_t                                     pWaiting;
+      uint64_t                                     pEOF;
+
+      // Access pattern
+      uint64_t                                     pLastOffset;
+      uint32_t                                     pLastSize;
+      uint64_t                                     pStride;
+      int                                          pSeqRun;
+      int                                          pStrideRun;
+      uint64_t                                     pNext;     // end of sequential fetches
+
+      // Bandwidth-delay product estimate
+      double                                       pMinLatency;  // seconds
+      double                                       pRate;        // bytes per second
+      Clock::time_point                            pLastDone;
+      int                                          pSamples;
+
+      Stats                                        pStats;
+  };
+}
+
+#endif // __XRD_CL_READ_AHEAD_HH__
@@ -495,6 +495,21 @@ namespace XrdCl
     return false;
   }
 
+  //------------------------------------------------------------------------
+  // Get the number of streams per channel asked for in the URL
+  //------------------------------------------------------------------------
+  int URL::GetSubStreams() const
+  {
+    ParamsMap::const_iterator itr = pParams.find( "xrdcl.streams" );
+    if( itr == pParams.end() )
+      return 0;
+    char *end;
+    long streams = strtol( itr->second.c_str(), &end, 10 );
+    if( *end || streams < 1 || streams > 255 )
+      return 0;
+    return streams + 1; // stands for the control stream
+  }
+
   std::string URL::GetObfuscatedURL() const {
     return obfuscateAuth(pURL);
   }
@@ -515,6 +530,7 @@ namespace XrdCl
     bool hascgi = false;
 
     std::string keys[] = { "xrdcl.intent",
+                           "xrdcl.streams",
                            "xrd.gsiusrpxy",
                            "xrd.gsiusrcrt",
                            "xrd.gsiusrkey",
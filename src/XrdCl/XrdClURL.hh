@@ -80,6 +80,12 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool IsTPC() const;
 
+      //------------------------------------------------------------------------
+      //! Get the number of streams per channel asked for with xrdcl.streams
+      //! (the data streams plus the control stream), or 0 if not given
+      //------------------------------------------------------------------------
+      int GetSubStreams() const;
+
       //------------------------------------------------------------------------
       //! Get the URL
       //------------------------------------------------------------------------
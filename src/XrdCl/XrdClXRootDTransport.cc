@@ -448,6 +448,7 @@ namespace XrdCl
     Env *env = DefaultEnv::GetEnv();
     int streams = DefaultSubStreamsPerChannel;
     env->GetInt( "SubStreamsPerChannel", streams );
+    if( url.GetSubStreams() ) streams = url.GetSubStreams();
     if( streams < 1 ) streams = 1;
     info->stream.resize( streams );
     info->strmSelector.reset( new StreamSelector( streams ) );
@@ -37,6 +37,22 @@ namespace XrdCl
 {
   using namespace XrdZip;
 
+  //---------------------------------------------------------------------------
+  // Identity of a member, to tell whether an inflate index belongs to it
+  //---------------------------------------------------------------------------
+  static ZipCache::member_t GetMember( const CDFH &cdfh )
+  {
+    ZipCache::member_t member;
+    member.csize = cdfh.compressedSize;
+    if( member.csize == std::numeric_limits<uint32_t>::max() && cdfh.extra )
+      member.csize = cdfh.extra->compressedSize;
+    member.usize = cdfh.uncompressedSize;
+    if( member.usize == std::numeric_limits<uint32_t>::max() && cdfh.extra )
+      member.usize = cdfh.extra->uncompressedSize;
+    member.crc32 = cdfh.ZCRC32;
+    return member;
+  }
+
   //---------------------------------------------------------------------------
   // Read data from a given file
   //---------------------------------------------------------------------------
@@ -94,8 +110,6 @@ namespace XrdCl
     if( cdfh->compressionMethod == Z_DEFLATED )
     {
       log->Dump( ZipMsg, "[%p] Reading compressed data.", (void*)&me );
-      // check if respective ZIP cache exists
-      bool empty = me.zipcache.find( fn ) == me.zipcache.end();
       // if the entry does not exist, it will be created using
       // default constructor
       ZipCache &cache = me.zipcache[fn];
@@ -111,58 +125,49 @@ namespace XrdCl
         return XRootDStatus();
       }
 
-      uint32_t sizereq = size;
-      if( relativeOffset + size > uncompressedSize )
-        sizereq = uncompressedSize - relativeOffset;
-      cache.QueueReq( relativeOffset, sizereq, usrbuff, usrHandler );
-
-      // if we have the whole ZIP archive we can populate the cache
-      // straight away
-      if( empty && me.buffer)
+      if( !cache.IsInitialized() )
       {
-        auto begin = me.buffer.get() + fileoff;
-        auto end   = begin + filesize ;
-        buffer_t buff( begin, end );
-        cache.QueueRsp( XRootDStatus(), 0, std::move( buff ) );
-        return XRootDStatus();
-      }
+        int span = DefaultZipIndexSpan;
+        DefaultEnv::GetEnv()->GetInt( "ZipIndexSpan", span );
 
-      // if we don't have the data we need to issue a remote read
-      if( !me.buffer )
-      {
-        if( relativeOffset > filesize ) return XRootDStatus(); // there's nothing to do,
-                                                                           // we already have all the data locally
-        uint32_t rdsize = size;
-        // check if this is the last read (we reached the end of
-        // file from user perspective)
-        if( relativeOffset + size >= uncompressedSize )
+        // if we have the whole ZIP archive the cache can take
+        // the compressed data straight away
+        if( me.buffer )
+        {
+          const char *data = me.buffer.get() + fileoff;
+          cache.Init( filesize, std::min<uint64_t>( filesize, std::numeric_limits<uint32_t>::max() ),
+                      std::max( span, 0 ),
+                      [data, &cache]( uint64_t off, uint32_t size )
+                      {
+                        ZipCache::buffer_t buff( data + off, data + off + size );
+                        cache.QueueRsp( XRootDStatus(), off, std::move( buff ) );
+                      } );
+        }
+        // otherwise the compressed data are read as they are needed
+        else
         {
-          // if yes, make sure we readout all the compressed data
-          // Note: In a patological case the compressed size may
-          //       be greater than the uncompressed size
-          rdsize = filesize > relativeOffset ?
-                   filesize - relativeOffset :
-                   0;
+          cache.Init( filesize, ZipCache::ChunkSize, std::max( span, 0 ),
+                      [fileoff, timeout, &cache, &me]( uint64_t off, uint32_t size )
+                      {
+                        auto rdbuff = std::make_shared<ZipCache::buffer_t>( size );
+                        Pipeline p = XrdCl::RdWithRsp<ChunkInfo>( me.archive, fileoff + off, size, rdbuff->data() ) >>
+                                       [off, rdbuff, &cache, &me]( XRootDStatus &st, ChunkInfo &rsp )
+                                       {
+                                         Log *log = DefaultEnv::GetLog();
+                                         log->Dump( ZipMsg, "[%p] Read %u bytes of remote data at offset %llu.",
+                                                            (void*)&me, rsp.GetLength(), (unsigned long long) rsp.GetOffset() );
+                                         rdbuff->resize( st.IsOK() ? rsp.GetLength() : 0 );
+                                         cache.QueueRsp( st, off, std::move( *rdbuff ) );
+                                       };
+                        Async( std::move( p ), timeout );
+                      } );
         }
-        // make sure we are not reading past the end of
-        // compressed data
-        if( relativeOffset + size > filesize )
-          rdsize = filesize - relativeOffset;
-
-
-        // now read the data ...
-        auto rdbuff = std::make_shared<ZipCache::buffer_t>( rdsize );
-        Pipeline p = XrdCl::RdWithRsp<RSP>( me.archive, offset, rdbuff->size(), rdbuff->data() ) >>
-                       [relativeOffset, rdbuff, &cache, &me]( XRootDStatus &st, RSP &rsp )
-                       {
-                         Log *log = DefaultEnv::GetLog();
-                         log->Dump( ZipMsg, "[%p] Read %u bytes of remote data at offset %llu.",
-                                            (void*)&me, rsp.GetLength(), (unsigned long long) rsp.GetOffset() );
-                         cache.QueueRsp( st, relativeOffset, std::move( *rdbuff ) );
-                       };
-        Async( std::move( p ), timeout );
       }
 
+      uint32_t sizereq = size;
+      if( relativeOffset + size > uncompressedSize )
+        sizereq = uncompressedSize - relativeOffset;
+      cache.QueueReq( relativeOffset, sizereq, usrbuff, usrHandler );
       return XRootDStatus();
     }
 
@@ -714,6 +719,51 @@ namespace XrdCl
     return ReadFromImpl<PageInfo>( *this, fn, offset, size, buffer, handler, timeout );
   }
 
+  //---------------------------------------------------------------------------
+  // Get the index of access points of a compressed file
+  //---------------------------------------------------------------------------
+  XRootDStatus ZipArchive::GetInflateIndex( const std::string &fn,
+                                            std::vector<char> &index )
+  {
+    if( openstage != Done )
+      return XRootDStatus( stError, errInvalidOp );
+    auto cditr = cdmap.find( fn );
+    if( cditr == cdmap.end() )
+      return XRootDStatus( stError, errNotFound,
+                           errNotFound, "File not found." );
+    if( cdvec[cditr->second]->compressionMethod != Z_DEFLATED )
+      return XRootDStatus( stError, errNotSupported,
+                           0, "The file is not compressed!" );
+    zipcache[fn].ExportIndex( GetMember( *cdvec[cditr->second] ), index );
+    return XRootDStatus();
+  }
+
+  //---------------------------------------------------------------------------
+  // Set the index of access points of a compressed file
+  //---------------------------------------------------------------------------
+  XRootDStatus ZipArchive::SetInflateIndex( const std::string       &fn,
+                                            const std::vector<char> &index )
+  {
+    if( openstage != Done )
+      return XRootDStatus( stError, errInvalidOp );
+    auto cditr = cdmap.find( fn );
+    if( cditr == cdmap.end() )
+      return XRootDStatus( stError, errNotFound,
+                           errNotFound, "File not found." );
+    if( cdvec[cditr->second]->compressionMethod != Z_DEFLATED )
+      return XRootDStatus( stError, errNotSupported,
+                           0, "The file is not compressed!" );
+    if( !zipcache[fn].ImportIndex( GetMember( *cdvec[cditr->second] ), index ) )
+    {
+      Log *log = DefaultEnv::GetLog();
+      log->Warning( ZipMsg, "[%p] Ignoring the inflate index of %s, it is "
+                    "invalid or does not match the file.", (void*)this, fn.c_str() );
+      return XRootDStatus( stError, errDataError,
+                           0, "Invalid inflate index." );
+    }
+    return XRootDStatus();
+  }
+
   //---------------------------------------------------------------------------
   // List files in the ZIP archive
   //---------------------------------------------------------------------------
@@ -186,6 +186,31 @@ namespace XrdCl
                                ResponseHandler   *handler,
                                time_t             timeout = 0 );
 
+      //-----------------------------------------------------------------------
+      //! Get the index of access points built so far for a compressed file
+      //! (see XRD_ZIPINDEXSPAN), so that it can be kept for later use
+      //!
+      //! @param fn    : the name of the file
+      //! @param index : output parameter, the serialized index
+      //! @return      : the status of the operation
+      //-----------------------------------------------------------------------
+      XRootDStatus GetInflateIndex( const std::string &fn,
+                                    std::vector<char> &index );
+
+      //-----------------------------------------------------------------------
+      //! Set the index of access points of a compressed file, as obtained
+      //! with GetInflateIndex, so that random reads do not have to inflate
+      //! the file from its beginning. An index built for another version of
+      //! the file (different sizes or CRC32) is rejected and the file is
+      //! then inflated without it.
+      //!
+      //! @param fn    : the name of the file
+      //! @param index : the serialized index
+      //! @return      : the status of the operation
+      //-----------------------------------------------------------------------
+      XRootDStatus SetInflateIndex( const std::string       &fn,
+                                    const std::vector<char> &index );
+
       //-----------------------------------------------------------------------
       //! Append data to a new file
       //!
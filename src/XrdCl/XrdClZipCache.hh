@@ -27,7 +27,11 @@
 
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include <zlib.h>
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <functional>
+#include <limits>
 #include <string>
 #include <vector>
 #include <mutex>
@@ -49,7 +53,20 @@ namespace XrdCl
   };
 
   //---------------------------------------------------------------------------
-  //! Utility class for inflating a compressed buffer
+  //! Utility class for inflating a compressed buffer.
+  //!
+  //! Read requests may come in any order, the compressed data is pulled in
+  //! through the fetch function given at initialization. A read ahead of the
+  //! current position of the inflate stream discards the data in between,
+  //! a read behind it restarts the stream.
+  //!
+  //! Optionally (span > 0) an index of access points is built while the
+  //! stream advances (see zran.c from the zlib examples): at the first block
+  //! boundary after every span bytes of output the position in the compressed
+  //! and uncompressed data and the 32kB window preceding it are saved, so
+  //! that the stream can later be restarted at the nearest access point
+  //! rather than at the beginning of the member. The index can be exported
+  //! and imported, e.g. to be kept next to the archive.
   //---------------------------------------------------------------------------
   class ZipCache
   {
@@ -57,10 +74,33 @@ namespace XrdCl
 
       typedef std::vector<char> buffer_t;
 
+      //-----------------------------------------------------------------------
+      //! Fetch a range of compressed data, the data have to be passed back
+      //! with QueueRsp (possibly from within the call)
+      //-----------------------------------------------------------------------
+      typedef std::function<void( uint64_t, uint32_t )> fetch_t;
+
+      //-----------------------------------------------------------------------
+      //! Default size of the compressed data fetched at a time
+      //-----------------------------------------------------------------------
+      static constexpr uint32_t ChunkSize = 1024 * 1024;
+
+      //-----------------------------------------------------------------------
+      //! Identity of the member an index was built for
+      //-----------------------------------------------------------------------
+      struct member_t
+      {
+        uint64_t csize; //< size of the compressed data
+        uint64_t usize; //< size of the uncompressed data
+        uint32_t crc32; //< CRC32 of the uncompressed data
+      };
+
     private:
 
       typedef std::tuple<uint64_t, uint32_t, void*, ResponseHandler*> read_args_t;
       typedef std::tuple<XRootDStatus, uint64_t, buffer_t> read_resp_t;
+      typedef std::tuple<ResponseHandler*, XRootDStatus, ChunkInfo*> read_done_t;
+      typedef std::vector<std::pair<uint64_t, uint32_t>> fetch_list_t;
 
       struct greater_read_resp_t
       {
@@ -72,9 +112,34 @@ namespace XrdCl
 
       typedef std::priority_queue<read_resp_t, std::vector<read_resp_t>, greater_read_resp_t> resp_queue_t;
 
+      //-----------------------------------------------------------------------
+      //! Access point of the index
+      //-----------------------------------------------------------------------
+      struct access_point_t
+      {
+        uint64_t out;      //< offset in the uncompressed data
+        uint64_t in;       //< offset of the next full byte of compressed data
+        uint8_t  bits;     //< number of bits of the previous byte still to be used
+        uint8_t  lastbyte; //< the previous byte of compressed data
+        buffer_t window;   //< uncompressed data preceding the access point
+      };
+
+      static constexpr uint32_t WinSize = 32768;
+
+      static const char* IdxMagic() { return "XRDZIDX2"; }
+      static constexpr size_t IdxMagicLen = 8;
+      static constexpr size_t IdxHdrLen   = IdxMagicLen + 32;
+
+      //-----------------------------------------------------------------------
+      //! Where the output of the inflate stream goes
+      //-----------------------------------------------------------------------
+      enum target_t { None, Skip, User };
+
     public:
 
-      ZipCache() : inabsoff( 0 )
+      ZipCache() : inabsoff( 0 ), outabsoff( 0 ), insize( 0 ), infetch( 0 ),
+                   chunksize( 0 ), target( None ), streamend( false ),
+                   lastbyte( 0 ), span( 0 ), initialized( false )
       {
         strm.zalloc    = Z_NULL;
         strm.zfree     = Z_NULL;
@@ -96,18 +161,138 @@ namespace XrdCl
         inflateEnd( &strm );
       }
 
-      inline void QueueReq( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler )
+      //-----------------------------------------------------------------------
+      //! Set up the cache
+      //!
+      //! @param insize    : size of the compressed data
+      //! @param chunksize : size of the compressed data fetched at a time
+      //! @param span      : distance between access points, 0 for no index
+      //! @param fetch     : function fetching compressed data
+      //-----------------------------------------------------------------------
+      inline void Init( uint64_t insize, uint32_t chunksize, uint64_t span, fetch_t fetch )
       {
         std::unique_lock<std::mutex> lck( mtx );
-        rdreqs.emplace( offset, length, buffer, handler );
-        Decompress();
+        this->insize    = insize;
+        this->chunksize = chunksize ? chunksize : 1;
+        this->fetch     = std::move( fetch );
+        // an imported index may have set the span already
+        if( !this->span ) this->span = span;
+        if( this->span ) window.resize( WinSize );
+        initialized = true;
+      }
+
+      inline bool IsInitialized()
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        return initialized;
+      }
+
+      inline void QueueReq( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler )
+      {
+        fetch_list_t todo;
+        std::vector<read_done_t> done;
+        {
+          std::unique_lock<std::mutex> lck( mtx );
+          rdreqs.emplace( offset, length, buffer, handler );
+          Decompress( todo, done );
+        }
+        Fetch( todo );
+        CallHandlers( done );
       }
 
       inline void QueueRsp( const XRootDStatus &st, uint64_t offset, buffer_t &&buffer )
       {
+        fetch_list_t todo;
+        std::vector<read_done_t> done;
+        {
+          std::unique_lock<std::mutex> lck( mtx );
+          // drop data that is not wanted anymore (the stream has been
+          // restarted in the meanwhile)
+          if( offset >= infetch ) return;
+          rdrsps.emplace( st, offset, std::move( buffer ) );
+          Decompress( todo, done );
+        }
+        Fetch( todo );
+        CallHandlers( done );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Serialize the index
+      //!
+      //! @param member : identity of the member the index is built for
+      //! @param buffer : output parameter, the serialized index
+      //-----------------------------------------------------------------------
+      inline void ExportIndex( const member_t &member, buffer_t &buffer )
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        size_t size = IdxHdrLen;
+        for( auto &ap : index ) size += 22 + ap.window.size();
+        buffer.resize( size );
+        char *ptr = buffer.data();
+        memcpy( ptr, IdxMagic(), IdxMagicLen );
+        ptr += IdxMagicLen;
+        Put( ptr, span, 8 );
+        Put( ptr, member.csize, 8 );
+        Put( ptr, member.usize, 8 );
+        Put( ptr, member.crc32, 4 );
+        Put( ptr, index.size(), 4 );
+        for( auto &ap : index )
+        {
+          Put( ptr, ap.out, 8 );
+          Put( ptr, ap.in, 8 );
+          Put( ptr, ap.bits, 1 );
+          Put( ptr, ap.lastbyte, 1 );
+          Put( ptr, ap.window.size(), 4 );
+          if( !ap.window.empty() ) memcpy( ptr, ap.window.data(), ap.window.size() );
+          ptr += ap.window.size();
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      //! Load a serialized index, replaces the one built so far
+      //!
+      //! @param member : identity of the member the index is for
+      //! @param buffer : the serialized index
+      //! @return       : false if the buffer does not hold a valid index for
+      //!                 the member (e.g. it was built for an older version
+      //!                 of it), in which case the index is left as it was
+      //-----------------------------------------------------------------------
+      inline bool ImportIndex( const member_t &member, const buffer_t &buffer )
+      {
+        const char *ptr = buffer.data(), *end = ptr + buffer.size();
+        if( buffer.size() < IdxHdrLen ||
+            memcmp( ptr, IdxMagic(), IdxMagicLen ) ) return false;
+        ptr += IdxMagicLen;
+        uint64_t idxspan = Get( ptr, 8 );
+        uint64_t csize   = Get( ptr, 8 );
+        uint64_t usize   = Get( ptr, 8 );
+        uint32_t crc32   = Get( ptr, 4 );
+        uint64_t count   = Get( ptr, 4 );
+        if( csize != member.csize || usize != member.usize ||
+            crc32 != member.crc32 ) return false;
+        std::vector<access_point_t> idx;
+        for( uint64_t i = 0; i < count; ++i )
+        {
+          if( end - ptr < 22 ) return false;
+          access_point_t ap;
+          ap.out      = Get( ptr, 8 );
+          ap.in       = Get( ptr, 8 );
+          ap.bits     = Get( ptr, 1 );
+          ap.lastbyte = Get( ptr, 1 );
+          uint64_t wsize = Get( ptr, 4 );
+          if( ap.bits > 7 || wsize > WinSize || uint64_t( end - ptr ) < wsize ||
+              ap.in > csize || ap.out > usize || wsize > ap.out ||
+              ( !idx.empty() && ap.out <= idx.back().out ) ) return false;
+          ap.window.assign( ptr, ptr + wsize );
+          ptr += wsize;
+          idx.push_back( std::move( ap ) );
+        }
         std::unique_lock<std::mutex> lck( mtx );
-        rdrsps.emplace( st, offset, std::move( buffer ) );
-        Decompress();
+        index.swap( idx );
+        // keep extending the index beyond the last access point we got
+        if( !span ) span = idxspan;
+        if( span && window.empty() ) window.resize( WinSize );
+        return true;
       }
 
     private:
@@ -122,58 +307,284 @@ namespace XrdCl
         return strm.avail_out != 0;
       }
 
-      inline void Input( const read_resp_t &rdrsp )
+      //-----------------------------------------------------------------------
+      //! Take the next chunk of compressed data if it has arrived
+      //!
+      //! @return : false if there is no data, or the data could not be read
+      //!           (in which case the status is set)
+      //-----------------------------------------------------------------------
+      inline bool Input( XRootDStatus &st )
       {
-        const buffer_t &buffer = std::get<2>( rdrsp );
-        strm.avail_in = buffer.size();
-        strm.next_in  = (Bytef*)buffer.data();
+        while( !rdrsps.empty() )
+        {
+          const read_resp_t &rdrsp = rdrsps.top();
+          uint64_t offset = std::get<1>( rdrsp );
+          if( offset > inabsoff ) return false; // still in the fly
+          if( !std::get<0>( rdrsp ).IsOK() )
+          {
+            st = std::get<0>( rdrsp );
+            rdrsps.pop();
+            return false;
+          }
+          const buffer_t &buffer = std::get<2>( rdrsp );
+          if( offset + buffer.size() <= inabsoff ) // data we have already used
+          {
+            rdrsps.pop();
+            continue;
+          }
+          inbuff = std::move( const_cast<buffer_t&>( buffer ) );
+          rdrsps.pop();
+          strm.avail_in = inbuff.size() - ( inabsoff - offset );
+          strm.next_in  = (Bytef*)inbuff.data() + ( inabsoff - offset );
+          return true;
+        }
+        return false;
       }
 
-      inline void Output( const read_args_t &rdreq )
+      //-----------------------------------------------------------------------
+      //! Point the output of the stream to the first request, or to the
+      //! scratch buffer if there is data to be skipped before it
+      //-----------------------------------------------------------------------
+      inline void Output()
       {
+        const read_args_t &rdreq = rdreqs.front();
+        uint64_t offset = std::get<0>( rdreq );
+        if( offset < outabsoff || Nearest( offset ) > outabsoff )
+          Restart( offset );
+
+        if( offset > outabsoff )
+        {
+          if( scratch.empty() ) scratch.resize( WinSize );
+          target         = Skip;
+          strm.avail_out = std::min<uint64_t>( offset - outabsoff, scratch.size() );
+          strm.next_out  = (Bytef*)scratch.data();
+          return;
+        }
+
+        target         = User;
         strm.avail_out = std::get<1>( rdreq );
         strm.next_out  = (Bytef*)std::get<2>( rdreq );
       }
 
-      inline bool Consecutive( const read_resp_t &resp ) const
+      //-----------------------------------------------------------------------
+      //! Uncompressed offset of the last access point at or before offset
+      //-----------------------------------------------------------------------
+      inline uint64_t Nearest( uint64_t offset ) const
       {
-        return ( std::get<1>( resp ) == inabsoff );
+        auto itr = std::upper_bound( index.begin(), index.end(), offset,
+                                     []( uint64_t off, const access_point_t &ap )
+                                     {
+                                       return off < ap.out;
+                                     } );
+        return itr == index.begin() ? 0 : ( itr - 1 )->out;
       }
 
-      void Decompress()
+      //-----------------------------------------------------------------------
+      //! Restart the stream at the last access point at or before offset
+      //-----------------------------------------------------------------------
+      inline void Restart( uint64_t offset )
       {
-        while( HasInput() || HasOutput() || !rdreqs.empty() || !rdrsps.empty() )
+        auto itr = std::upper_bound( index.begin(), index.end(), offset,
+                                     []( uint64_t off, const access_point_t &ap )
+                                     {
+                                       return off < ap.out;
+                                     } );
+        inflateReset( &strm );
+        strm.avail_in = 0;
+        inbuff.clear();
+        rdrsps = resp_queue_t();
+        streamend = false;
+        if( itr == index.begin() )
         {
-          if( !HasOutput() && !rdreqs.empty() )
-            Output( rdreqs.front() );
+          inabsoff  = 0;
+          outabsoff = 0;
+        }
+        else
+        {
+          const access_point_t &ap = *( itr - 1 );
+          if( ap.bits )
+            inflatePrime( &strm, ap.bits, ap.lastbyte >> ( 8 - ap.bits ) );
+          if( !ap.window.empty() )
+            inflateSetDictionary( &strm, (const Bytef*)ap.window.data(), ap.window.size() );
+          inabsoff  = ap.in;
+          outabsoff = ap.out;
+          Remember( ap.window.data(), ap.window.size(), ap.out - ap.window.size() );
+        }
+        infetch = inabsoff;
+      }
 
-          if( !HasInput() && !rdrsps.empty() && Consecutive( rdrsps.top() ) ) // the response might come out of order so we need to check the offset
-            Input( rdrsps.top() );
+      //-----------------------------------------------------------------------
+      //! Keep the last 32kB of output in the window
+      //-----------------------------------------------------------------------
+      inline void Remember( const char *data, uint64_t size, uint64_t offset )
+      {
+        if( window.empty() ) return;
+        if( size > WinSize )
+        {
+          data   += size - WinSize;
+          offset += size - WinSize;
+          size    = WinSize;
+        }
+        uint64_t pos   = offset % WinSize;
+        uint64_t first = std::min<uint64_t>( size, WinSize - pos );
+        memcpy( window.data() + pos, data, first );
+        memcpy( window.data(), data + first, size - first );
+      }
 
-          if( !HasInput() || !HasOutput() ) return;
+      //-----------------------------------------------------------------------
+      //! Add an access point at the current position if it is due
+      //-----------------------------------------------------------------------
+      inline void AddAccessPoint()
+      {
+        // we can only restart the stream at block boundaries (but not after
+        // the last block)
+        if( !( strm.data_type & 128 ) || ( strm.data_type & 64 ) ) return;
+        uint64_t last = index.empty() ? 0 : index.back().out;
+        if( outabsoff < last + span ) return;
+        access_point_t ap;
+        ap.out      = outabsoff;
+        ap.in       = inabsoff;
+        ap.bits     = strm.data_type & 7;
+        ap.lastbyte = lastbyte;
+        uint64_t wsize = std::min<uint64_t>( outabsoff, WinSize );
+        uint64_t pos   = outabsoff % WinSize;
+        ap.window.reserve( wsize );
+        if( wsize == WinSize )
+          ap.window.insert( ap.window.end(), window.begin() + pos, window.end() );
+        ap.window.insert( ap.window.end(), window.begin(), window.begin() + pos );
+        index.push_back( std::move( ap ) );
+      }
 
-          // check the response status
-          XRootDStatus st = std::get<0>( rdrsps.top() );
-          if( !st.IsOK() ) return CallHandler( st );
+      //-----------------------------------------------------------------------
+      //! Fetch the compressed data needed next that has not been asked for
+      //! yet, keeping two chunks on the way
+      //-----------------------------------------------------------------------
+      inline void Prefetch( fetch_list_t &todo )
+      {
+        if( infetch < inabsoff ) infetch = inabsoff;
+        while( infetch < insize && infetch < inabsoff + 2 * uint64_t( chunksize ) )
+        {
+          uint32_t size = std::min<uint64_t>( chunksize - infetch % chunksize,
+                                              insize - infetch );
+          todo.emplace_back( infetch, size );
+          infetch += size;
+        }
+      }
 
-          // the available space in output buffer before inflating
-          uInt avail_before = strm.avail_in;
+      void Decompress( fetch_list_t &todo, std::vector<read_done_t> &done )
+      {
+        while( !rdreqs.empty() )
+        {
+          if( target == None )
+            Output();
+
+          if( target == User && !HasOutput() ) // nothing to read
+          {
+            Complete( XRootDStatus(), done );
+            continue;
+          }
+
+          if( streamend ) // we have reached the end of the compressed data
+          {
+            Complete( XRootDStatus(), done );
+            continue;
+          }
+
+          if( !HasInput() )
+          {
+            XRootDStatus st;
+            if( !Input( st ) )
+            {
+              if( !st.IsOK() )
+              {
+                // report error to user handler, the data will be
+                // fetched again for the next request
+                infetch = inabsoff;
+                Complete( st, done );
+                continue;
+              }
+              if( inabsoff >= insize ) // there is no more data
+              {
+                Complete( XRootDStatus( stError, errDataError, 0,
+                                        "[zlib] inflate : truncated data." ), done );
+                continue;
+              }
+              return Prefetch( todo );
+            }
+          }
+
+          // the available space in input/output buffer before inflating
+          uInt avail_in  = strm.avail_in;
+          uInt avail_out = strm.avail_out;
+          char *outptr   = (char*)strm.next_out;
           // decompress the data
-          int rc = inflate( &strm, Z_SYNC_FLUSH );
-          st = ToXRootDStatus( rc, "inflate" );
-          if( !st.IsOK() ) return CallHandler( st ); // report error to user handler
-          // update the absolute input offset by the number of bytes we consumed
-          inabsoff += avail_before - strm.avail_in;
-
-          if( !strm.avail_out ) // the output buffer is empty meaning a request has been fulfilled
-            CallHandler( XRootDStatus() );
-
-          // the input buffer is empty meaning a response has been consumed
-          // (we need to check if there are any elements in the responses
-          // queue as the input buffer might have been set directly by the user)
-          if( !strm.avail_in && !rdrsps.empty() )
-            rdrsps.pop();
+          int rc = inflate( &strm, span ? Z_BLOCK : Z_SYNC_FLUSH );
+          XRootDStatus st = ToXRootDStatus( rc, "inflate" );
+          if( !st.IsOK() )
+          {
+            // report error to user handler, and make sure the next request
+            // restarts the stream
+            Complete( st, done );
+            outabsoff = std::numeric_limits<uint64_t>::max();
+            continue;
+          }
+          // update the absolute offsets by the number of bytes we consumed
+          // and produced
+          if( avail_in != strm.avail_in )
+          {
+            inabsoff += avail_in - strm.avail_in;
+            lastbyte  = strm.next_in[-1];
+          }
+          Remember( outptr, avail_out - strm.avail_out, outabsoff );
+          outabsoff += avail_out - strm.avail_out;
+          if( span ) AddAccessPoint();
+          if( rc == Z_STREAM_END ) streamend = true;
+
+          if( !strm.avail_out ) // the output buffer is full
+          {
+            if( target == User ) Complete( XRootDStatus(), done ); // a request has been fulfilled
+            else target = None; // we are done skipping
+          }
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      //! Reply to the first request
+      //-----------------------------------------------------------------------
+      inline void Complete( const XRootDStatus &st, std::vector<read_done_t> &done )
+      {
+        read_args_t args = std::move( rdreqs.front() );
+        rdreqs.pop();
+
+        ChunkInfo *chunk = nullptr;
+        if( st.IsOK() )
+        {
+          uint32_t length = target == User ? std::get<1>( args ) - strm.avail_out : 0;
+          chunk = new ChunkInfo( std::get<0>( args ), length, std::get<2>( args ) );
         }
+        target = None;
+        strm.avail_out = 0;
+
+        done.emplace_back( std::get<3>( args ), st, chunk );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Issue the fetches, outside of the lock
+      //-----------------------------------------------------------------------
+      inline void Fetch( const fetch_list_t &todo )
+      {
+        for( auto &f : todo )
+          fetch( f.first, f.second );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Call the user handlers, outside of the lock
+      //-----------------------------------------------------------------------
+      static inline void CallHandlers( std::vector<read_done_t> &done )
+      {
+        for( auto &d : done )
+          std::get<0>( d )->HandleResponse( new XRootDStatus( std::get<1>( d ) ),
+                                            PkgRsp( std::get<2>( d ) ) );
       }
 
       static inline AnyObject* PkgRsp( ChunkInfo *chunk )
@@ -184,19 +595,18 @@ namespace XrdCl
         return rsp;
       }
 
-      inline void CallHandler( const XRootDStatus &st )
+      static inline void Put( char *&ptr, uint64_t value, int size )
       {
-        if( rdreqs.empty() ) return;
-        read_args_t args = std::move( rdreqs.front() );
-        rdreqs.pop();
-
-        ChunkInfo *chunk = nullptr;
-        if( st.IsOK() ) chunk = new ChunkInfo( std::get<0>( args ),
-                                                   std::get<1>( args ),
-                                                   std::get<2>( args ) );
+        for( int i = 0; i < size; ++i )
+          *ptr++ = char( value >> ( 8 * i ) );
+      }
 
-        ResponseHandler *handler = std::get<3>( args );
-        handler->HandleResponse( new XRootDStatus( st ), PkgRsp( chunk ) );
+      static inline uint64_t Get( const char *&ptr, int size )
+      {
+        uint64_t value = 0;
+        for( int i = 0; i < size; ++i )
+          value |= uint64_t( uint8_t( *ptr++ ) ) << ( 8 * i );
+        return value;
       }
 
       XrdCl::XRootDStatus ToXRootDStatus( int rc, const std::string &func )
@@ -219,10 +629,24 @@ namespace XrdCl
 
       z_stream  strm;      // the zlib stream we will use for reading
 
-      std::mutex              mtx;
-      uint64_t                inabsoff; //< the absolute offset in the input file (compressed), ensures the user is actually streaming the data
-      std::queue<read_args_t> rdreqs;   //< pending read requests  (we only allow read requests to be submitted in order)
-      resp_queue_t            rdrsps;   //< pending read responses (due to multiple-streams the read response may come out of order)
+      std::mutex                  mtx;
+      uint64_t                    inabsoff;    //< the absolute offset in the input file (compressed)
+      uint64_t                    outabsoff;   //< the absolute offset in the output file (uncompressed)
+      uint64_t                    insize;      //< size of the compressed data
+      uint64_t                    infetch;     //< compressed data up to this offset has been asked for
+      uint32_t                    chunksize;   //< size of compressed data fetched at a time
+      fetch_t                     fetch;       //< function fetching compressed data
+      std::queue<read_args_t>     rdreqs;      //< pending read requests
+      resp_queue_t                rdrsps;      //< pending read responses (due to multiple-streams the read response may come out of order)
+      buffer_t                    inbuff;      //< compressed data being inflated
+      buffer_t                    scratch;     //< output for the data being skipped
+      target_t                    target;      //< where the output goes
+      bool                        streamend;   //< the end of the compressed data has been reached
+      uint8_t                     lastbyte;    //< the last byte of compressed data consumed
+      uint64_t                    span;        //< distance between access points (0 if there is no index)
+      std::vector<access_point_t> index;       //< the access points
+      buffer_t                    window;      //< last 32kB of output (if there is an index)
+      bool                        initialized; //< Init has been called
   };
 
 }
@@ -0,0 +1,184 @@
+/******************************************************************************/
+/*                                                                            */
+/*                X r d C r y p t o C h a i n C a c h e . c c                 */
+/*                                                                            */
+/* (c) 2026 by European Organization for Nuclear Research (CERN)              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/*                                                                            */
+/******************************************************************************/
+
+/* ************************************************************************** */
+/*                                                                            */
+/* Cache of successful X509 chain verifications.                              */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <cstdio>
+#include <cstring>
+
+#include "XrdCrypto/XrdCryptoChainCache.hh"
+#include "XrdCrypto/XrdCryptoFactory.hh"
+#include "XrdCrypto/XrdCryptoMsgDigest.hh"
+#include "XrdCrypto/XrdCryptoX509Chain.hh"
+#include "XrdCrypto/XrdCryptoX509Crl.hh"
+#include "XrdSut/XrdSutBucket.hh"
+
+//_____________________________________________________________________________
+XrdCryptoChainCache::XrdCryptoChainCache(int maxent)
+{
+   // Constructor: 'maxent' is the maximum number of entries kept
+
+   maxPerShard = (maxent > nShards) ? maxent / nShards : 1;
+}
+
+//_____________________________________________________________________________
+bool XrdCryptoChainCache::Key(XrdCryptoFactory *cf, XrdSutBucket *chain,
+                              XrdCryptoX509Chain *ca, XrdCryptoX509Crl *crl,
+                              int opt, std::string &key)
+{
+   // Compute the key of a verification: the SHA-256 of the chain presented,
+   // of the identity of the trusted certificates and CRL, and of the options.
+   // Return true on success.
+
+   if (!cf || !chain || !chain->buffer || chain->size <= 0) return false;
+
+   XrdCryptoMsgDigest *md = cf->MsgDigest("sha256");
+   if (!md) return false;
+
+   char buf[64];
+   int  lbuf;
+
+   md->Update(chain->buffer, chain->size);
+   //
+   // Trusted certificates
+   if (ca) {
+      XrdCryptoX509 *xc = ca->Begin();
+      while (xc) {
+         XrdOucString sn = xc->SerialNumberString();
+         const char *sh = xc->SubjectHash();
+         if (sh) md->Update(sh, strlen(sh));
+         md->Update(sn.c_str(), sn.length());
+         lbuf = snprintf(buf, sizeof(buf), "|%lld|", (long long)xc->NotAfter());
+         md->Update(buf, lbuf);
+         xc = ca->Next();
+      }
+   }
+   //
+   // The CRL: a new one makes a different verification
+   if (crl) {
+      const char *ih = crl->IssuerHash(0);
+      if (ih) md->Update(ih, strlen(ih));
+      lbuf = snprintf(buf, sizeof(buf), "|%lld|", (long long)crl->LastUpdate());
+      md->Update(buf, lbuf);
+   }
+   lbuf = snprintf(buf, sizeof(buf), "opt:%d", opt);
+   md->Update(buf, lbuf);
+
+   bool ok = (md->Final() == 0);
+   if (ok) key.assign(md->Buffer(), md->Length());
+   delete md;
+   return ok;
+}
+
+//_____________________________________________________________________________
+time_t XrdCryptoChainCache::Expiry(XrdCryptoX509Chain *chain,
+                                   XrdCryptoX509Crl *crl)
+{
+   // Earliest expiration of the certificates in the chain and of the CRL
+
+   time_t exp = -1;
+
+   if (chain) {
+      XrdCryptoX509 *xc = chain->Begin();
+      while (xc) {
+         if (exp < 0 || xc->NotAfter() < exp) exp = xc->NotAfter();
+         xc = chain->Next();
+      }
+   }
+   if (crl && crl->NextUpdate() > 0 && (exp < 0 || crl->NextUpdate() < exp))
+      exp = crl->NextUpdate();
+
+   return (exp < 0) ? 0 : exp;
+}
+
+//_____________________________________________________________________________
+bool XrdCryptoChainCache::Find(const std::string &key, time_t now)
+{
+   // True if the verification 'key' is known and still valid
+
+   Shard &s = GetShard(key);
+   XrdSysMutexHelper mh(s.mtx);
+
+   auto it = s.ent.find(key);
+   if (it == s.ent.end()) return false;
+   if (it->second > now) return true;
+   s.ent.erase(it);
+   return false;
+}
+
+//_____________________________________________________________________________
+void XrdCryptoChainCache::Add(const std::string &key, time_t expires)
+{
+   // Record a successful verification
+
+   Shard &s = GetShard(key);
+   XrdSysMutexHelper mh(s.mtx);
+
+   //
+   // Make room, if needed: expired entries first, then any entry
+   if (s.ent.size() >= maxPerShard && !s.ent.count(key)) {
+      time_t now = time(0);
+      for (auto it = s.ent.begin(); it != s.ent.end(); ) {
+         if (it->second <= now) it = s.ent.erase(it);
+            else ++it;
+      }
+      if (s.ent.size() >= maxPerShard) s.ent.erase(s.ent.begin());
+   }
+   s.ent[key] = expires;
+}
+
+//_____________________________________________________________________________
+void XrdCryptoChainCache::Purge(time_t now)
+{
+   // Remove the expired entries
+
+   for (int i = 0; i < nShards; i++) {
+      XrdSysMutexHelper mh(shards[i].mtx);
+      for (auto it = shards[i].ent.begin(); it != shards[i].ent.end(); ) {
+         if (it->second <= now) it = shards[i].ent.erase(it);
+            else ++it;
+      }
+   }
+}
+
+//_____________________________________________________________________________
+int XrdCryptoChainCache::Num()
+{
+   // Number of entries
+
+   int n = 0;
+   for (int i = 0; i < nShards; i++) {
+      XrdSysMutexHelper mh(shards[i].mtx);
+      n += shards[i].ent.size();
+   }
+   return n;
+}
@@ -0,0 +1,104 @@
+#ifndef __CRYPTO_CHAINCACHE_H__
+#define __CRYPTO_CHAINCACHE_H__
+/******************************************************************************/
+/*                                                                            */
+/*                X r d C r y p t o C h a i n C a c h e . h h                 */
+/*                                                                            */
+/* (c) 2026 by European Organization for Nuclear Research (CERN)              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/*                                                                            */
+/******************************************************************************/
+
+/* ************************************************************************** */
+/*                                                                            */
+/* Cache of successful X509 chain verifications.                              */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <ctime>
+#include <string>
+#include <unordered_map>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCryptoFactory;
+class XrdCryptoX509Chain;
+class XrdCryptoX509Crl;
+class XrdSutBucket;
+
+// ---------------------------------------------------------------------------//
+//                                                                            //
+// XrdCryptoChainCache                                                        //
+//                                                                            //
+// Remembers the chains verified successfully, so that a chain presented     //
+// again (e.g. the same proxy on another connection) needs no signature      //
+// verification. A verification is identified by the SHA-256 of the chain   //
+// as received, of the trusted certificates and of the CRL; it stays valid   //
+// until the earliest certificate expiration or the next update of the CRL.  //
+// The cache is split into independently locked shards.                      //
+//                                                                            //
+// ---------------------------------------------------------------------------//
+
+class XrdCryptoChainCache
+{
+public:
+   XrdCryptoChainCache(int maxent = 16384);
+   virtual ~XrdCryptoChainCache() { }
+
+   // Compute the key of the verification of the certificates in 'chain'
+   // (as received) against the trusted certificates in 'ca' and the CRL
+   // 'crl' (may be null), with options 'opt'. Returns false on failure.
+   static bool Key(XrdCryptoFactory *cf, XrdSutBucket *chain,
+                   XrdCryptoX509Chain *ca, XrdCryptoX509Crl *crl, int opt,
+                   std::string &key);
+
+   // Time at which a verification of 'chain' with 'crl' stops being valid
+   static time_t Expiry(XrdCryptoX509Chain *chain, XrdCryptoX509Crl *crl);
+
+   // True if the verification 'key' succeeded and is still valid at 'now'
+   bool   Find(const std::string &key, time_t now);
+
+   // Record a successful verification, valid until 'expires'
+   void   Add(const std::string &key, time_t expires);
+
+   // Remove the expired entries (done by GSI when a CA/CRL entry is reloaded)
+   void   Purge(time_t now);
+
+   // Number of entries
+   int    Num();
+
+private:
+   static const int nShards = 16;
+
+   struct Shard {
+      XrdSysMutex                             mtx;
+      std::unordered_map<std::string, time_t> ent;
+   };
+
+   Shard &GetShard(const std::string &key)
+          {return shards[(key.empty() ? 0 : (unsigned char)key[0]) % nShards];}
+
+   Shard  shards[nShards];
+   size_t maxPerShard;
+};
+
+#endif
@@ -63,6 +63,7 @@ XrdCryptosslRSA::XrdCryptosslRSA(int bits, int exp)
    // exponent `pubex` (default 65537).
    EPNAME("RSA::XrdCryptosslRSA");
 
+   fEVP = 0;
    publen = -1;
    prilen = -1;
 
@@ -28,6 +28,7 @@
 #include "XrdEc/XrdEcRedundancyProvider.hh"
 #include "XrdEc/XrdEcObjCfg.hh"
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
@@ -76,6 +77,22 @@ namespace XrdEc
 
       bool enable_plugins;
 
+      //-----------------------------------------------------------------------
+      //! Latency budget for a single stripe read, if a stripe has not been
+      //! delivered within the budget the reader fires parity reads and
+      //! reconstructs the stripe from whichever stripes arrive first
+      //! (0 disables hedging)
+      //-----------------------------------------------------------------------
+      std::chrono::milliseconds hedge_budget;
+
+      //-----------------------------------------------------------------------
+      //! If non-zero, the latency budget is derived from the given percentile
+      //! of recently observed stripe response times, hedge_budget (if set) is
+      //! then used as the lower bound and as the budget until enough samples
+      //! have been collected (without it there is no hedging until then)
+      //-----------------------------------------------------------------------
+      uint8_t hedge_percentile;
+
     private:
 
       std::unordered_map<std::string, RedundancyProvider> redundancies;
@@ -84,7 +101,7 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       //! Constructor
       //-----------------------------------------------------------------------
-      Config() : enable_plugins( true )
+      Config() : enable_plugins( true ), hedge_budget( 0 ), hedge_percentile( 0 )
       {
       }
 
@@ -132,11 +132,66 @@ namespace XrdEc
                                                               stripes( objcfg.nbchunks ),
                                                               state( objcfg.nbchunks, Empty ),
                                                               pending( objcfg.nbchunks ),
+                                                              started( objcfg.nbchunks ),
+                                                              hedged( objcfg.nbchunks, false ),
+                                                              hedgebuf( objcfg.nbchunks ),
                                                               blkid( blkid ),
                                                               recovering( 0 )
     {
     }
 
+    //-----------------------------------------------------------------------
+    // Load the data of given stripe, and if hedging is enabled make sure
+    // we don't wait for a slow stripe longer than the latency budget
+    //
+    // @param self     : the block_t object
+    // @param strpid   : stripe ID
+    // @param timeout  : operation timeout
+    //-----------------------------------------------------------------------
+    static void load( std::shared_ptr<block_t> &self,
+                      size_t                    strpid,
+                      time_t                    timeout = 0 )
+    {
+      self->started[strpid] = std::chrono::steady_clock::now();
+      self->reader.Read( self->blkid, strpid, self->stripes[strpid],
+                         read_callback( self, strpid ), timeout );
+      self->state[strpid] = Loading;
+
+      std::chrono::milliseconds budget = self->reader.HedgeBudget();
+      if( budget.count() > 0 )
+        ThreadPool::Instance().ExecuteAfter( budget, hedge, self, strpid );
+    }
+
+    //-----------------------------------------------------------------------
+    // Called when the latency budget for given stripe has elapsed, if the
+    // stripe is still loading give up on it and reconstruct it from the
+    // remaining stripes (the straggler is not cancelled, but its response
+    // lands in a spare buffer and is used only if it still can help)
+    //
+    // @param self     : the block_t object
+    // @param strpid   : stripe ID
+    //-----------------------------------------------------------------------
+    static void hedge( std::shared_ptr<block_t> self, size_t strpid )
+    {
+      std::unique_lock<std::mutex> lck( self->mtx );
+      if( self->state[strpid] != Loading || self->hedged[strpid] ) return;
+      //---------------------------------------------------------------------
+      // Make sure we can afford to lose one more stripe
+      //---------------------------------------------------------------------
+      size_t missingcnt = std::count_if( self->state.begin(), self->state.end(),
+                                         []( state_t s ){ return s == Missing || s == Recovering; } );
+      if( missingcnt + 1 > self->objcfg.nbparity ) return;
+      //---------------------------------------------------------------------
+      // The straggler keeps writing into the buffer it has been given,
+      // hence the recovery has to use a different one
+      //---------------------------------------------------------------------
+      self->hedged[strpid] = true;
+      std::swap( self->stripes[strpid], self->hedgebuf[strpid] );
+      self->state[strpid] = Missing;
+      if( !error_correction( self ) )
+        self->fail_missing();
+    }
+
     //-----------------------------------------------------------------------
     // Read data from stripe
     //
@@ -163,11 +218,7 @@ namespace XrdEc
       // The cache is empty, we need to load the data
       //---------------------------------------------------------------------
       if( self->state[strpid] == Empty )
-      {
-        self->reader.Read( self->blkid, strpid, self->stripes[strpid],
-                           read_callback( self, strpid ), timeout );
-        self->state[strpid] = Loading;
-      }
+        load( self, strpid, timeout );
       //---------------------------------------------------------------------
       // The stripe is either corrupted or unreachable
       //---------------------------------------------------------------------
@@ -287,9 +338,7 @@ namespace XrdEc
       {
         size_t strpid = i++;
         if( self->state[strpid] != Empty ) continue;
-        self->reader.Read( self->blkid, strpid, self->stripes[strpid],
-                           read_callback( self, strpid ) );
-        self->state[strpid] = Loading;
+        load( self, strpid );
         ++loadingcnt;
       }
 
@@ -311,6 +360,26 @@ namespace XrdEc
       return [self, strpid]( const XrdCl::XRootDStatus &st, uint32_t ) mutable
              {
                std::unique_lock<std::mutex> lck( self->mtx );
+               if( self->hedged[strpid] )
+               {
+                 //----------------------------------------------------------
+                 // This is the response of a stripe we gave up on, record
+                 // how long it really took (otherwise the percentile would
+                 // only ever see reads that beat the budget and the budget
+                 // would keep shrinking), and use the data only if the
+                 // stripe has not been reconstructed meanwhile
+                 //----------------------------------------------------------
+                 self->hedged[strpid] = false;
+                 self->reader.RecordLatency( std::chrono::steady_clock::now() -
+                                             self->started[strpid] );
+                 if( !st.IsOK() || ( self->state[strpid] != Recovering &&
+                                     self->state[strpid] != Missing ) )
+                   return;
+                 std::swap( self->stripes[strpid], self->hedgebuf[strpid] );
+               }
+               else if( st.IsOK() )
+                 self->reader.RecordLatency( std::chrono::steady_clock::now() -
+                                             self->started[strpid] );
                self->state[strpid] = st.IsOK() ? Valid : Missing;
                //------------------------------------------------------------
                // Check if we need to do any error correction (either for
@@ -415,6 +484,9 @@ namespace XrdEc
     std::vector<buffer_t>   stripes;    //< data buffer for every stripe
     std::vector<state_t>    state;      //< state of every data buffer (empty/loading/valid)
     std::vector<pending_t>  pending;    //< pending reads per stripe
+    std::vector<std::chrono::steady_clock::time_point> started; //< time the stripe read was issued
+    std::vector<bool>       hedged;     //< true if we gave up waiting for the stripe
+    std::vector<buffer_t>   hedgebuf;   //< buffers still owned by the stripes we gave up on
     size_t                  blkid;      //< block ID
     bool                    recovering; //< true if we are in the process of recovering data, false otherwise
     std::mutex              mtx;
@@ -629,7 +701,7 @@ namespace XrdEc
     // get the URL of the ZIP archive with the respective data
     const std::string &url = itr->second;
     // get the ZipArchive object
-    auto &zipptr = dataarchs[url];
+    auto zipptr = dataarchs[url];
     // check the size of the data to be read
     XrdCl::StatInfo *info = nullptr;
     auto st = zipptr->Stat( fn, info );
@@ -642,47 +714,52 @@ namespace XrdEc
     delete info;
     // create a buffer for the data
     buffer.resize( objcfg.chunksize );
+    char *rdbuff = buffer.data();
     // issue the read request
-    XrdCl::Async( XrdCl::ReadFrom( *zipptr, fn, 0, rdsize, buffer.data() ) >>
-                    [zipptr, fn, cb, this]( XrdCl::XRootDStatus &st, XrdCl::ChunkInfo &ch )
-                    {
-                      //---------------------------------------------------
-                      // If read failed there's nothing to do, just pass the
-                      // status to user callback
-                      //---------------------------------------------------
-                      if( !st.IsOK() )
-                      {
-                        cb( st, 0 );
-                        return;
-                      }
-                      //---------------------------------------------------
-                      // Get the checksum for the read data
-                      //---------------------------------------------------
-                      uint32_t orgcksum = 0;
-                      auto s = zipptr->GetCRC32( fn, orgcksum );
-                      //---------------------------------------------------
-                      // If we cannot extract the checksum assume the data
-                      // are corrupted
-                      //---------------------------------------------------
-                      if( !st.IsOK() )
-                      {
-                        cb( st, 0 );
-                        return;
-                      }
-                      //---------------------------------------------------
-                      // Verify data integrity
-                      //---------------------------------------------------
-                      uint32_t cksum = objcfg.digest( 0, ch.buffer, ch.length );
-                      if( orgcksum != cksum )
+    auto rdfunc = [zipptr, fn, rdsize, rdbuff, cb, timeout, this]()
+    {
+      XrdCl::Async( XrdCl::ReadFrom( *zipptr, fn, 0, rdsize, rdbuff ) >>
+                      [zipptr, fn, cb, this]( XrdCl::XRootDStatus &st, XrdCl::ChunkInfo &ch )
                       {
-                        cb( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError ), 0 );
-                        return;
-                      }
-                      //---------------------------------------------------
-                      // All is good, we can call now the user callback
-                      //---------------------------------------------------
-                      cb( XrdCl::XRootDStatus(), ch.length );
-                    }, timeout );
+                        //---------------------------------------------------
+                        // If read failed there's nothing to do, just pass the
+                        // status to user callback
+                        //---------------------------------------------------
+                        if( !st.IsOK() )
+                        {
+                          cb( st, 0 );
+                          return;
+                        }
+                        //---------------------------------------------------
+                        // Get the checksum for the read data
+                        //---------------------------------------------------
+                        uint32_t orgcksum = 0;
+                        auto s = zipptr->GetCRC32( fn, orgcksum );
+                        //---------------------------------------------------
+                        // If we cannot extract the checksum assume the data
+                        // are corrupted
+                        //---------------------------------------------------
+                        if( !st.IsOK() )
+                        {
+                          cb( st, 0 );
+                          return;
+                        }
+                        //---------------------------------------------------
+                        // Verify data integrity
+                        //---------------------------------------------------
+                        uint32_t cksum = objcfg.digest( 0, ch.buffer, ch.length );
+                        if( orgcksum != cksum )
+                        {
+                          cb( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError ), 0 );
+                          return;
+                        }
+                        //---------------------------------------------------
+                        // All is good, we can call now the user callback
+                        //---------------------------------------------------
+                        cb( XrdCl::XRootDStatus(), ch.length );
+                      }, timeout );
+    };
+    IssueRead( url, rdfunc );
   }
 
   //-----------------------------------------------------------------------
@@ -842,6 +919,43 @@ namespace XrdEc
   }
 
 
+  //-----------------------------------------------------------------------
+  // Get the latency budget after which a stripe read is hedged
+  //-----------------------------------------------------------------------
+  std::chrono::milliseconds Reader::HedgeBudget()
+  {
+    Config &cfg = Config::Instance();
+    if( cfg.hedge_percentile == 0 )
+      return cfg.hedge_budget;
+
+    std::unique_lock<std::mutex> lck( latmtx );
+    if( latencies.size() < latwnd ) return cfg.hedge_budget;
+    std::vector<uint32_t> sorted( latencies );
+    lck.unlock();
+
+    size_t pct = std::min<size_t>( cfg.hedge_percentile, 100 );
+    auto   nth = sorted.begin() + ( pct * ( sorted.size() - 1 ) ) / 100;
+    std::nth_element( sorted.begin(), nth, sorted.end() );
+    auto budget = std::chrono::ceil<std::chrono::milliseconds>(
+                    std::chrono::microseconds( *nth ) );
+    return std::max( budget, cfg.hedge_budget );
+  }
+
+  //-----------------------------------------------------------------------
+  // Record the response time of a successful stripe read
+  //-----------------------------------------------------------------------
+  void Reader::RecordLatency( std::chrono::steady_clock::duration latency )
+  {
+    if( Config::Instance().hedge_percentile == 0 ) return;
+    uint32_t us = std::chrono::duration_cast<std::chrono::microseconds>( latency ).count();
+    std::unique_lock<std::mutex> lck( latmtx );
+    if( latencies.size() < latwnd )
+      latencies.push_back( us );
+    else
+      latencies[latidx] = us;
+    latidx = ( latidx + 1 ) % latwnd;
+  }
+
   inline callback_t Reader::ErrorCorrected(Reader *reader, std::shared_ptr<block_t> &self, size_t blkid, size_t strpid){
 	  return [reader, self, strpid, blkid]( const XrdCl::XRootDStatus &st, uint32_t ) mutable
 	                 {
@@ -30,6 +30,8 @@
 #include "XrdCl/XrdClZipArchive.hh"
 #include "XrdCl/XrdClOperations.hh"
 
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -68,7 +70,8 @@ namespace XrdEc
       //! @param objcfg : configuration for the data object (e.g. number of
       //!                 data and parity stripes)
       //-----------------------------------------------------------------------
-      Reader( ObjCfg &objcfg ) : objcfg( objcfg ), lstblk( 0 ), filesize( 0 )
+      Reader( ObjCfg &objcfg ) : objcfg( objcfg ), lstblk( 0 ), filesize( 0 ),
+                                 latidx( 0 )
       {
       }
 
@@ -123,6 +126,21 @@ namespace XrdEc
         return filesize;
       }
 
+    protected:
+
+      //-----------------------------------------------------------------------
+      //! Issue a stripe read, the default issues it right away (tests override
+      //! it to simulate slow placements)
+      //!
+      //! @param url    : URL of the ZIP archive the stripe is read from
+      //! @param rdfunc : function that issues the read
+      //-----------------------------------------------------------------------
+      virtual void IssueRead( const std::string &url, std::function<void()> rdfunc )
+      {
+        (void)url;
+        rdfunc();
+      }
+
     private:
 
       //-----------------------------------------------------------------------
@@ -173,6 +191,17 @@ namespace XrdEc
 
       void MissingVectorRead(std::shared_ptr<block_t> &block, size_t blkid, size_t strpid, time_t timeout = 0);
 
+      //-----------------------------------------------------------------------
+      //! @return : the latency budget after which a stripe read is hedged
+      //!           with parity reads (0 if hedging is disabled)
+      //-----------------------------------------------------------------------
+      std::chrono::milliseconds HedgeBudget();
+
+      //-----------------------------------------------------------------------
+      //! Record the response time of a successful stripe read
+      //-----------------------------------------------------------------------
+      void RecordLatency( std::chrono::steady_clock::duration latency );
+
       typedef std::unordered_map<std::string, std::shared_ptr<XrdCl::ZipArchive>> dataarchs_t;
       typedef std::unordered_map<std::string, buffer_t> metadata_t;
       typedef std::unordered_map<std::string, std::string> urlmap_t;
@@ -192,6 +221,11 @@ namespace XrdEc
       std::mutex	missingChunksMutex;
       std::vector<std::tuple<size_t, size_t>> missingChunksVectorRead;
       std::condition_variable waitMissing;
+
+      static const size_t latwnd = 64;  //> number of response times kept
+      std::vector<uint32_t> latencies;  //> recent stripe response times (us)
+      size_t                latidx;     //> next slot to overwrite in latencies
+      std::mutex            latmtx;     //> mutex guarding the response times
   };
 
 } /* namespace XrdEc */
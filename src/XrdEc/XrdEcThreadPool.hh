@@ -24,7 +24,13 @@
 
 #include "XrdCl/XrdClJobManager.hh"
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <future>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 
 #ifndef SRC_XRDEC_XRDECTHREADPOOL_HH_
@@ -142,6 +148,12 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       ~ThreadPool()
       {
+        {
+          std::unique_lock<std::mutex> lck( tmrmtx );
+          tmrstop = true;
+        }
+        tmrcv.notify_all();
+        if( timer.joinable() ) timer.join();
         threadpool.Stop();
         threadpool.Finalize();
       }
@@ -169,18 +181,74 @@ namespace XrdEc
         return ftr;
       }
 
+      //-----------------------------------------------------------------------
+      //! Schedule a functional (together with its arguments) for execution
+      //! once the given delay has elapsed
+      //-----------------------------------------------------------------------
+      template<typename FUNC, typename ... ARGs>
+      inline void ExecuteAfter( std::chrono::milliseconds delay,
+                                FUNC func, ARGs... args )
+      {
+        auto job = [this, func, args...]() mutable
+                   {
+                     this->Execute( std::move( func ), std::move( args )... );
+                   };
+        auto when = std::chrono::steady_clock::now() + delay;
+        std::unique_lock<std::mutex> lck( tmrmtx );
+        if( !timer.joinable() )
+          timer = std::thread( &ThreadPool::TimerLoop, this );
+        bool first = timers.empty() || when < timers.begin()->first;
+        timers.emplace( when, std::move( job ) );
+        if( first ) tmrcv.notify_all();
+      }
+
     private:
 
       //-----------------------------------------------------------------------
       //! Constructor
       //-----------------------------------------------------------------------
-      ThreadPool() : threadpool( 64 )
+      ThreadPool() : threadpool( 64 ), tmrstop( false )
       {
         threadpool.Initialize();
         threadpool.Start();
       }
 
-      XrdCl::JobManager threadpool; //< the thread-pool itself
+      //-----------------------------------------------------------------------
+      //! Hand over the expired delayed jobs to the thread-pool
+      //-----------------------------------------------------------------------
+      void TimerLoop()
+      {
+        std::unique_lock<std::mutex> lck( tmrmtx );
+        while( !tmrstop )
+        {
+          if( timers.empty() )
+          {
+            tmrcv.wait( lck );
+            continue;
+          }
+          auto itr = timers.begin();
+          if( std::chrono::steady_clock::now() < itr->first )
+          {
+            tmrcv.wait_until( lck, itr->first );
+            continue;
+          }
+          std::function<void()> job = std::move( itr->second );
+          timers.erase( itr );
+          lck.unlock();
+          job();
+          lck.lock();
+        }
+      }
+
+      typedef std::multimap<std::chrono::steady_clock::time_point,
+                            std::function<void()>> timers_t;
+
+      XrdCl::JobManager        threadpool; //< the thread-pool itself
+      std::thread              timer;      //< thread firing delayed jobs
+      timers_t                 timers;     //< delayed jobs sorted by deadline
+      std::mutex               tmrmtx;     //< guards the delayed jobs
+      std::condition_variable  tmrcv;      //< wakes up the timer thread
+      bool                     tmrstop;    //< stop flag for the timer thread
   };
 
 }
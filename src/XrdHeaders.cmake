@@ -116,6 +116,7 @@ if( NOT XRDCL_ONLY )
     XrdPfc/XrdPfcDecision.hh
     XrdOfs/XrdOfsFSctl_PI.hh
     XrdOfs/XrdOfsPrepare.hh
+    XrdOfs/XrdOfsTPCEngine.hh
     XrdOss/XrdOss.hh
     XrdOss/XrdOssVS.hh
     XrdOss/XrdOssDefaultSS.hh
@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstring>
 
 
 void XrdHttpHeaderUtils::parseReprDigest(const std::string &value, std::map<std::string, std::string> &output) {
@@ -101,4 +102,38 @@ void XrdHttpHeaderUtils::parseWantReprDigest(const std::string & value, std::map
       // discard invalid values
     }
   }
-}
\ No newline at end of file
+}
+bool XrdHttpHeaderUtils::parseContentRange(const std::string & value, long long & first, long long & last) {
+  // Expected format: bytes <first>-<last>/<complete-length or *>
+  std::string_view value_sv {value};
+  XrdOucUtils::trim(value_sv);
+  if(value_sv.size() < 6 || strncasecmp(value_sv.data(), "bytes ", 6)) return false;
+  value_sv.remove_prefix(6);
+  XrdOucUtils::trim(value_sv);
+
+  size_t dash = value_sv.find('-');
+  size_t slash = value_sv.find('/');
+  if(dash == std::string_view::npos || slash == std::string_view::npos || dash > slash) return false;
+
+  // Only digits are accepted so that signs, blanks or trailing garbage make the range invalid
+  auto toNumber = [](std::string_view sv, long long & number) {
+    if(sv.empty() || sv.size() > 18) return false;
+    number = 0;
+    for(char c: sv) {
+      if(c < '0' || c > '9') return false;
+      number = number * 10 + (c - '0');
+    }
+    return true;
+  };
+
+  long long rfirst, rlast, total;
+  if(!toNumber(value_sv.substr(0, dash), rfirst) ||
+     !toNumber(value_sv.substr(dash + 1, slash - dash - 1), rlast) ||
+     rlast < rfirst) return false;
+  std::string_view total_sv {value_sv.substr(slash + 1)};
+  if(total_sv != "*" && (!toNumber(total_sv, total) || total <= rlast)) return false;
+
+  first = rfirst;
+  last = rlast;
+  return true;
+}
@@ -47,6 +47,18 @@ public:
    * @param output the map containing the lower-cased digest name and the associated preference
    */
   static void parseWantReprDigest(const std::string & value, std::map<std::string, uint8_t> & output);
+
+  /**
+   * Parses the 'Content-Range' header value of a partial upload (PUT)
+   * Syntax: "Content-Range: bytes first-last/complete-length" where the complete length may be '*'.
+   * The unsatisfied-range form, with '*' in place of "first-last", is not valid for an upload.
+   *
+   * @param value contains the value of the header Content-Range
+   * @param first set to the first byte of the range
+   * @param last set to the last byte of the range (inclusive)
+   * @return true if the value is a valid range for an upload, false otherwise (first and last are then left unchanged)
+   */
+  static bool parseContentRange(const std::string & value, long long & first, long long & last);
 };
 
 
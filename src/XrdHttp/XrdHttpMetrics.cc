@@ -0,0 +1,288 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+// File Date: Oct 2026
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdHttpMetrics.hh"
+#include "Xrd/XrdStats.hh"
+#include "XrdSys/XrdSysHistogram.hh"
+
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+const char *XrdHttpMetrics::ContentType =
+  "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+namespace {
+
+const char eofLine[] = "# EOF\n";
+const int  eofLen    = sizeof(eofLine) - 1;
+
+// Sequential writer into a fixed size buffer. Once a line does not fit,
+// nothing else is written so that we never emit partial metric families.
+//
+class Writer {
+public:
+  Writer(char *buff, int bsz) : bP(buff), left(bsz - eofLen), full(left < 0) {}
+
+  void Put(const char *fmt, ...) {
+    if (full) return;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(bP, left, fmt, args);
+    va_end(args);
+    if (n < 0 || n >= left) {full = true; return;}
+    bP += n; left -= n;
+  }
+
+  char *End() {memcpy(bP, eofLine, eofLen); return bP + eofLen;}
+
+private:
+  char *bP;
+  int   left;
+  bool  full;
+};
+
+// Copy a name, mapping characters not allowed in a metric name (or a label
+// value) to an underscore. Returns the new length or -1 if it does not fit.
+//
+int CpyName(char *nP, int nMax, const char *src, int sLen) {
+  if (sLen >= nMax) return -1;
+  for (int i = 0; i < sLen; i++) {
+    char c = src[i];
+    nP[i] = (isalnum(static_cast<unsigned char>(c)) ? c : '_');
+  }
+  nP[sLen] = 0;
+  return sLen;
+}
+
+// Append a name component separated by an underscore.
+//
+int AddName(char *nP, int nLen, int nMax, const char *src, int sLen) {
+  if (nLen + 1 >= nMax) return nLen;
+  nP[nLen] = '_';
+  int n = CpyName(nP + nLen + 1, nMax - nLen - 1, src, sLen);
+  if (n < 0) {nP[nLen] = 0; return nLen;}
+  return nLen + 1 + n;
+}
+
+// Return true if the text is a number, trimming surrounding blanks.
+//
+bool IsNumber(const char *&tP, int &tLen) {
+  while (tLen && isspace(static_cast<unsigned char>(*tP))) {tP++; tLen--;}
+  while (tLen && isspace(static_cast<unsigned char>(tP[tLen-1]))) tLen--;
+  if (!tLen) return false;
+
+  int i = 0, digits = 0;
+  if (tP[i] == '-' || tP[i] == '+') i++;
+  while (i < tLen && isdigit(tP[i])) {i++; digits++;}
+  if (i < tLen && tP[i] == '.') {
+    i++;
+    while (i < tLen && isdigit(tP[i])) {i++; digits++;}
+  }
+  if (!digits) return false;
+  if (i < tLen && (tP[i] == 'e' || tP[i] == 'E')) {
+    i++;
+    if (i < tLen && (tP[i] == '-' || tP[i] == '+')) i++;
+    if (i >= tLen || !isdigit(tP[i])) return false;
+    while (i < tLen && isdigit(tP[i])) i++;
+  }
+  return i == tLen;
+}
+
+// Emit a latency histogram (see XrdSysHistogram for the bucket definitions).
+//
+void PutHist(Writer &out, const char *op, unsigned long long count,
+             unsigned long long totUS, const char *bP, int bLen) {
+  unsigned long long cum = 0;
+  const char *bEnd = bP + bLen;
+  char *eP;
+
+  for (int i = 0; i < XrdSysHistogram::Buckets - 1 && bP < bEnd; i++) {
+    cum += strtoull(bP, &eP, 10);
+    if (eP == bP || eP > bEnd) break;
+    bP = eP;
+    out.Put("xrd_ltcy_seconds_bucket{op=\"%s\",le=\"%g\"} %llu\n",
+            op, static_cast<double>(2ULL << i) / 1000000.0, cum);
+  }
+  out.Put("xrd_ltcy_seconds_bucket{op=\"%s\",le=\"+Inf\"} %llu\n", op, count);
+  out.Put("xrd_ltcy_seconds_count{op=\"%s\"} %llu\n", op, count);
+  out.Put("xrd_ltcy_seconds_sum{op=\"%s\"} %.6f\n", op,
+          static_cast<double>(totUS) / 1000000.0);
+}
+}
+
+/******************************************************************************/
+/*                               C o n v e r t                                */
+/******************************************************************************/
+
+int XrdHttpMetrics::Convert(const char *xml, int xlen, char *out, int osz) {
+  static const int maxDepth = 16;
+  Writer wr(out, osz);
+  const char *xP = xml, *xEnd = xml + xlen, *tBeg = 0;
+  char name[512] = "xrd";
+  int  nLen[maxDepth+1], kids[maxDepth+1], depth = 0, skip = 0;
+  bool leaf = false;
+
+  // Histogram state, filled in while inside a <hist> element
+  //
+  char hOp[128];
+  const char *hBuck = 0;
+  int  hBLen = 0, hDepth = -1;
+  unsigned long long hCount = 0, hTotUS = 0;
+  bool hTyped = false;
+
+  if (osz < eofLen) return 0;
+  nLen[0] = 3; kids[0] = 0;
+
+  while (xP < xEnd) {
+    const char *lt = static_cast<const char *>(memchr(xP, '<', xEnd - xP));
+    if (!lt) break;
+    const char *gt = static_cast<const char *>(memchr(lt, '>', xEnd - lt));
+    if (!gt) break;
+
+    // Skip processing instructions and comments
+    //
+    if (lt + 1 < gt && (lt[1] == '?' || lt[1] == '!')) {xP = gt + 1; continue;}
+
+    // Handle a closing tag. Leaf elements with a numeric value become metrics.
+    //
+    if (lt[1] == '/') {
+      if (skip) skip--;
+      else if (depth > 0) {
+        if (leaf && tBeg) {
+          const char *vP = tBeg;
+          int vLen = lt - tBeg;
+          if (hDepth >= 0 && depth == hDepth + 1) {
+            const char *tag = lt + 2;
+            int tLen = gt - tag;
+                 if (tLen == 1 && *tag == 'n')   hCount = strtoull(vP, 0, 10);
+            else if (tLen == 2 && !strncmp(tag, "us", 2))
+                                                 hTotUS = strtoull(vP, 0, 10);
+            else if (tLen == 1 && *tag == 'b')  {hBuck = vP; hBLen = vLen;}
+          } else if (hDepth < 0 && IsNumber(vP, vLen)) {
+            wr.Put("%s %.*s\n", name, vLen, vP);
+          }
+        }
+        if (depth == hDepth) {
+          if (!hTyped) {wr.Put("# TYPE xrd_ltcy_seconds histogram\n"); hTyped = true;}
+          PutHist(wr, hOp, hCount, hTotUS, hBuck, hBLen);
+          hDepth = -1;
+        }
+        depth--;
+        name[nLen[depth]] = 0;
+      }
+      leaf = false; tBeg = 0;
+      xP = gt + 1;
+      continue;
+    }
+
+    // This is an opening tag, extract the tag name and the id attribute
+    //
+    const char *tag = lt + 1, *tEnd = tag, *id = 0;
+    int idLen = 0;
+    while (tEnd < gt && !isspace(static_cast<unsigned char>(*tEnd))
+                     && *tEnd != '/') tEnd++;
+    const char *iP = tEnd;
+    while (iP < gt) {
+      if (gt - iP > 5 && !strncmp(iP, " id=\"", 5)) {
+        id = iP + 5;
+        const char *q = static_cast<const char *>(memchr(id, '"', gt - id));
+        idLen = (q ? q - id : 0);
+        break;
+      }
+      iP++;
+    }
+    bool selfClose = (gt[-1] == '/');
+    int  tLen = tEnd - tag;
+
+    if (depth >= maxDepth) {
+      if (!selfClose) skip++;
+      xP = gt + 1;
+      continue;
+    }
+    kids[depth]++;
+    depth++;
+    kids[depth] = 0;
+
+    // Construct the metric name for this element. The root element does not
+    // contribute to the name, elements with an id use the id instead of the
+    // tag, and unnamed array elements use their position.
+    //
+    int n = nLen[depth-1];
+    bool isRoot = (depth == 1 && tLen == 10 && !strncmp(tag, "statistics", 10));
+    if (isRoot) n = 3;
+    else if (hDepth < 0 && tLen == 4 && !strncmp(tag, "hist", 4) && id) {
+      hDepth = depth; hCount = hTotUS = 0; hBuck = 0; hBLen = 0;
+      if (CpyName(hOp, sizeof(hOp), id, idLen) < 0) strcpy(hOp, "unknown");
+    } else if (id && idLen) {
+      n = AddName(name, n, sizeof(name), id, idLen);
+    } else if (tLen == 4 && !strncmp(tag, "item", 4)) {
+      char iBuff[16];
+      int iLen = snprintf(iBuff, sizeof(iBuff), "%d", kids[depth-1] - 1);
+      n = AddName(name, n, sizeof(name), iBuff, iLen);
+    } else {
+      n = AddName(name, n, sizeof(name), tag, tLen);
+    }
+    nLen[depth] = n;
+
+    if (selfClose) {depth--; name[nLen[depth]] = 0; leaf = false; tBeg = 0;}
+    else {leaf = true; tBeg = gt + 1;}
+    xP = gt + 1;
+  }
+
+  return wr.End() - out;
+}
+
+/******************************************************************************/
+/*                                R e n d e r                                 */
+/******************************************************************************/
+
+int XrdHttpMetrics::Render(XrdStats *statsP, const char *&data) {
+  static thread_local std::unique_ptr<char[]> tBuff;
+
+  class statsInfo : public XrdStats::CallBack {
+  public:
+    void Info(const char *buff, int bsz) {dLen = Convert(buff, bsz, oBuff, maxSize);}
+    void Info(struct iovec *ioVec, int iovn) {}
+    statsInfo(char *oP) : oBuff(oP), dLen(-1) {}
+    ~statsInfo() {}
+    char *oBuff;
+    int   dLen;
+  };
+
+  // Allocate our buffer the first time this thread generates metrics
+  //
+  if (!tBuff) tBuff.reset(new (std::nothrow) char[maxSize]);
+  if (!tBuff) return -1;
+  statsInfo statsResp(tBuff.get());
+
+  // Generate the XML summary and convert it into OpenMetrics
+  //
+  if (statsP) statsP->Stats(&statsResp, XRD_STATS_ALLX);
+  if (statsResp.dLen < 0) statsResp.dLen = Convert("", 0, tBuff.get(), maxSize);
+
+  data = tBuff.get();
+  return statsResp.dLen;
+}
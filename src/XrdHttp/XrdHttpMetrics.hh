@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+// File Date: Oct 2026
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef XROOTD_XRDHTTPMETRICS_HH
+#define XROOTD_XRDHTTPMETRICS_HH
+
+class XrdStats;
+
+/**
+ * Renders the server summary statistics (the same ones reported via the
+ * xrd.report directive, including all XrdMonRoll registered sets) in the
+ * OpenMetrics text format so that they can be scraped over http.
+ *
+ * Every numeric leaf of the XML summary becomes a metric whose name is the
+ * path to the leaf, e.g. <stats id="sched"><jobs>5</jobs> becomes
+ * "xrd_sched_jobs 5". Latency histograms are rendered as OpenMetrics
+ * histograms named "xrd_ltcy_seconds" with an "op" label.
+ *
+ * Nothing is allocated per scrape: the XML is produced in the XrdStats
+ * buffer and converted into a buffer that is allocated once per thread.
+ */
+class XrdHttpMetrics {
+public:
+
+  /// Content type of the generated text
+  static const char *ContentType;
+
+  /// Size of the per-thread output buffer
+  static const int maxSize = 256 * 1024;
+
+  /**
+   * Generate the metrics.
+   *
+   * @param statsP  the server statistics object.
+   * @param data    set to the generated text; it remains valid until the
+   *                calling thread calls Render() again.
+   *
+   * @return the length of the generated text or -1 if no buffer is available.
+   */
+  static int Render(XrdStats *statsP, const char *&data);
+
+  /**
+   * Convert an XML summary report into OpenMetrics text.
+   *
+   * @param xml   the XML summary (need not be null terminated).
+   * @param xlen  the length of the XML summary.
+   * @param out   the buffer to receive the text.
+   * @param osz   the size of the buffer. Metrics that do not fit are dropped
+   *              but the text is always terminated by "# EOF".
+   *
+   * @return the length of the generated text.
+   */
+  static int Convert(const char *xml, int xlen, char *out, int osz);
+
+private:
+
+  XrdHttpMetrics() = delete;
+};
+
+#endif
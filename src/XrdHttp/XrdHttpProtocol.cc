@@ -33,6 +33,7 @@
 #include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
+#include "XrdHttpMetrics.hh"
 #include "XrdHttpMon.hh"
 #include "XrdHttpTrace.hh"
 #include "XrdHttpProtocol.hh"
@@ -88,6 +89,7 @@ char *XrdHttpProtocol::listredir = 0;
 bool XrdHttpProtocol::listdeny = false;
 bool XrdHttpProtocol::embeddedstatic = true;
 char *XrdHttpProtocol::staticredir = 0;
+char *XrdHttpProtocol::metricspath = 0;
 int XrdHttpProtocol::m_maxdelay = -1;
 XrdOucHash<XrdHttpProtocol::StaticPreloadInfo> *XrdHttpProtocol::staticpreload = 0;
 
@@ -116,6 +118,7 @@ bool XrdHttpProtocol::hasCache= false;
 
 XrdScheduler *XrdHttpProtocol::Sched = 0; // System scheduler
 XrdBuffManager *XrdHttpProtocol::BPool = 0; // Buffer manager
+XrdStats *XrdHttpProtocol::SysStats = 0; // System statistics
 XrdSysError XrdHttpProtocol::eDest = 0; // Error message handler
 XrdSecService *XrdHttpProtocol::CIA = 0; // Authentication Server
 int XrdHttpProtocol::m_bio_type = 0; // BIO type identifier for our custom BIO.
@@ -995,6 +998,7 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
       else if TS_Xeq("listingredir", xlistredir);
       else if TS_Xeq("staticredir", xstaticredir);
       else if TS_Xeq("staticpreload", xstaticpreload);
+      else if TS_Xeq("metrics", xmetrics);
       else if TS_Xeq("staticheader", xstaticheader);
       else if TS_Xeq("listingdeny", xlistdeny);
       else if TS_Xeq("listing", xlisting);
@@ -1686,6 +1690,22 @@ int XrdHttpProtocol::SendSimpleResp(int code, const char *desc, const char *head
   return r;
 }
 
+/******************************************************************************/
+/*                           S e n d M e t r i c s                            */
+/******************************************************************************/
+
+int XrdHttpProtocol::SendMetrics(bool keepalive) {
+  const char *data;
+  int dlen;
+
+  // The metrics are generated in a per-thread buffer so nothing is allocated
+  //
+  if ((dlen = XrdHttpMetrics::Render(SysStats, data)) < 0)
+    return SendSimpleResp(500, NULL, NULL, "Unable to generate metrics.", 0, keepalive);
+
+  return SendSimpleResp(200, NULL, XrdHttpMetrics::ContentType, data, dlen, keepalive);
+}
+
 /******************************************************************************/
 /*                             C o n f i g u r e                              */
 /******************************************************************************/
@@ -1708,6 +1728,7 @@ int XrdHttpProtocol::Configure(char *parms, XrdProtocol_Config * pi) {
   //  SI = new XrdXrootdStats(pi->Stats);
   Sched = pi->Sched;
   BPool = pi->BPool;
+  SysStats = pi->Stats;
   xrd_cslist = getenv("XRD_CSLIST");
 
   Port = pi->Port;
@@ -2589,6 +2610,40 @@ int XrdHttpProtocol::xstaticpreload(XrdOucStream & Config) {
   return 0;
 }
 
+/******************************************************************************/
+/*                                x m e t r i c s                             */
+/******************************************************************************/
+
+/* Function: xmetrics
+
+   Purpose:  To parse the directive: metrics <http url path>
+
+             <http url path>    the path at which the summary statistics are
+                                served in OpenMetrics text format
+                                e.g. /metrics
+
+  Output: 0 upon success or !0 upon failure.
+ */
+
+int XrdHttpProtocol::xmetrics(XrdOucStream & Config) {
+  char *val;
+
+  // Get the path
+  //
+  val = Config.GetWord();
+  if (!val || val[0] != '/') {
+    eDest.Emsg("Config", "metrics path not specified or not absolute");
+    return 1;
+  }
+
+  // Record the value
+  //
+  if (metricspath) free(metricspath);
+  metricspath = strdup(val);
+
+  return 0;
+}
+
 /******************************************************************************/
 /*                             x s t a t i c h e a d e r                      */
 /******************************************************************************/
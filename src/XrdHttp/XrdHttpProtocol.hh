@@ -220,6 +220,7 @@ private:
   static int xstaticheader(XrdOucStream &Config);
   static int xstaticredir(XrdOucStream &Config);
   static int xstaticpreload(XrdOucStream &Config);
+  static int xmetrics(XrdOucStream &Config);
   static int xgmap(XrdOucStream &Config);
   static int xsslcafile(XrdOucStream &Config);
   static int xsslverifydepth(XrdOucStream &Config);
@@ -294,6 +295,9 @@ private:
   /// Sends a basic response. If the length is < 0 then it is calculated internally
   int SendSimpleResp(int code, const char *desc, const char *header_to_add, const char *body, long long bodylen, bool keepalive);
 
+  /// Sends the summary statistics in OpenMetrics format
+  int SendMetrics(bool keepalive);
+
   /// Starts a chunked response; body of request is sent over multiple parts using the SendChunkResp
   //  API.
   int StartChunkedResp(int code, const char *desc, const char *header_to_add, long long bodylen, bool keepalive);
@@ -360,6 +364,7 @@ protected:
 
   static XrdScheduler *Sched; // System scheduler
   static XrdBuffManager *BPool; // Buffer manager
+  static XrdStats *SysStats; // System statistics
   static XrdSysError eDest; // Error message handler
   static XrdSecService *CIA; // Authentication Server
 
@@ -438,6 +443,9 @@ protected:
   // Url to redirect to in the case a /static is requested
   static char *staticredir;
 
+  /// Path at which the summary statistics are served in OpenMetrics format
+  static char *metricspath;
+
   // Maximum amount of time an operation on the bridge can be
   // delayed
   static int m_maxdelay;
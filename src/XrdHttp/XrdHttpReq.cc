@@ -179,6 +179,9 @@ int XrdHttpReq::parseLine(char *line, int len) {
     } else if (!strcasecmp(key, "content-length")) {
       length = atoll(val);
 
+    } else if (!strcasecmp(key, "content-range") && request == rtPUT) {
+      parsePutRange(val);
+
     } else if (!strcasecmp(key, "destination")) {
       destination.assign(val, line+len-val);
       trim(destination);
@@ -246,6 +249,12 @@ int XrdHttpReq::parseHost(char *line) {
   return 0;
 }
 
+void XrdHttpReq::parsePutRange(const char *val) {
+  // Only "bytes first-last/complete-length" (or "/*") makes sense for a PUT
+  if (!XrdHttpHeaderUtils::parseContentRange(val, m_put_range_start, m_put_range_end))
+    m_put_range_invalid = true;
+}
+
 void XrdHttpReq::parseScitag(const std::string & val) {
   // The scitag header has been populated and the packet marking was configured, the scitag will either be equal to 0
   // or to the value passed by the client
@@ -983,6 +992,13 @@ int XrdHttpReq::ProcessHTTPReq() {
     {
         int retval = keepalive ? 1 : -1; // reset() clears keepalive
 
+        // Scrapes of the summary statistics are answered directly
+        if (prot->metricspath && resource == prot->metricspath) {
+            if (prot->SendMetrics(keepalive)) return -1;
+            reset();
+            return retval;
+        }
+
         if (resource.beginswith("/static/")) {
 
             // This is a request for a /static resource
@@ -1275,13 +1291,30 @@ int XrdHttpReq::ProcessHTTPReq() {
 
       if (!fopened) {
 
+        // A partial upload writes the given range of the file; the range
+        // starting at 0 creates (or truncates) the file, the others update it
+        // and may do so concurrently.
+        if (m_put_range_start >= 0 || m_put_range_invalid) {
+          if (m_put_range_invalid || m_transfer_encoding_chunked ||
+              length != m_put_range_end - m_put_range_start + 1) {
+            prot->SendSimpleResp(400, NULL, NULL, (char *) "Invalid Content-Range for a partial upload.", 0, false);
+            return -1;
+          }
+          if (XrdHttpProtocol::usingEC) {
+            prot->SendSimpleResp(501, NULL, NULL, (char *) "Partial uploads are not supported with erasure coding.", 0, false);
+            return -1;
+          }
+        }
+
         // --------- OPEN for write!
         memset(&xrdreq, 0, sizeof (ClientRequest));
         xrdreq.open.requestid = htons(kXR_open);
         l = resourceplusopaque.length() + 1;
         xrdreq.open.dlen = htonl(l);
         xrdreq.open.mode = htons(kXR_ur | kXR_uw | kXR_gw | kXR_gr | kXR_or);
-        if (! XrdHttpProtocol::usingEC) 
+        if (m_put_range_start > 0)
+          xrdreq.open.options = htons(kXR_open_wrto | kXR_force);
+        else if (! XrdHttpProtocol::usingEC) 
           xrdreq.open.options = htons(kXR_mkpath | kXR_open_wrto | kXR_delete);
         else
           xrdreq.open.options = htons(kXR_mkpath | kXR_open_wrto | kXR_new);
@@ -1406,7 +1439,7 @@ int XrdHttpReq::ProcessHTTPReq() {
           long long bytes_to_read = std::min(static_cast<long long>(prot->BuffUsed()),
                                         length - writtenbytes);
 
-          xrdreq.write.offset = htonll(writtenbytes);
+          xrdreq.write.offset = htonll(std::max(m_put_range_start, 0LL) + writtenbytes);
           xrdreq.write.dlen = htonl(bytes_to_read);
 
           TRACEI(REQ, "Writing " << bytes_to_read);
@@ -2334,7 +2367,14 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
 
         if (ntohs(xrdreq.header.requestid) == kXR_close) {
           if (xrdresp == kXR_ok) {
-            prot->SendSimpleResp(201, NULL, NULL, (char *)":-)", 0, keepalive);
+            // Acknowledge a partial upload so that the client knows the range
+            // was not taken for the whole file
+            std::string hdr;
+            if (m_put_range_start >= 0)
+              hdr = "X-Partial-Put: bytes " + std::to_string(m_put_range_start) +
+                    "-" + std::to_string(m_put_range_end);
+            prot->SendSimpleResp(201, NULL, hdr.empty() ? NULL : hdr.c_str(),
+                                 (char *)":-)", 0, keepalive);
             return keepalive ? 1 : -1;
           } else {
             prot->SendSimpleResp(httpStatusCode, NULL, NULL, httpErrorBody.c_str(), httpErrorBody.length(), keepalive);
@@ -2781,6 +2821,10 @@ void XrdHttpReq::reset() {
   m_trailer_headers = false;
   m_status_trailer = false;
 
+  m_put_range_start = -1;
+  m_put_range_end = -1;
+  m_put_range_invalid = false;
+
   /// State machine to talk to the bridge
   reqstate = 0;
 
@@ -130,8 +130,16 @@ private:
   // after a response body has started
   bool m_status_trailer{false};
 
+  // Byte range of a partial upload, given by the Content-Range header of a
+  // PUT request (-1 if the whole file is uploaded).
+  long long m_put_range_start{-1};
+  long long m_put_range_end{-1};
+  bool m_put_range_invalid{false};
+
   int parseHost(char *);
 
+  void parsePutRange(const char *val);
+
   void parseScitag(const std::string & val);
 
   //xmlDocPtr xmlbody; /* the resulting document tree */
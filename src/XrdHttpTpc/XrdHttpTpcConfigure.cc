@@ -72,6 +72,21 @@ bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
                 m_log.Emsg("Config", "tpc.fixed_route value is invalid", val);
                 return false;
             }
+        } else if (!strcmp("tpc.push_streams", val)) {
+            if (!(val = Config.GetWord())) {
+                Config.Close();
+                m_log.Emsg("Config", "tpc.push_streams value not specified");
+                return false;
+            }
+            if (!strcmp("1", val) || !strcasecmp("yes", val) || !strcasecmp("true", val)) {
+                m_push_streams = true;
+            } else if (!strcmp("0", val) || !strcasecmp("no", val) || !strcasecmp("false", val)) {
+                m_push_streams = false;
+            } else {
+                Config.Close();
+                m_log.Emsg("Config", "tpc.push_streams value is invalid", val);
+                return false;
+            }
         } else if (!strcmp("tpc.header2cgi",val)) {
             // header2cgi parsing
             if(XrdHttpProtocol::parseHeader2CGI(Config,m_log,hdr2cgimap)){
@@ -96,6 +111,19 @@ bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
             } else {
                 m_first_timeout = 2*m_timeout;
             }
+        } else if (!strcmp("tpc.writebehind", val)) {
+            long long wbsize;
+            if (!(val = Config.GetWord())) {
+                Config.Close();
+                m_log.Emsg("Config","tpc.writebehind value not specified.");  return false;
+            }
+            if (!strcmp("off", val)) {
+                wbsize = 0;
+            } else if (XrdOuca2x::a2sz(m_log, "write-behind size", val, &wbsize, 0)) {
+                Config.Close();
+                return false;
+            }
+            m_write_behind = wbsize;
         }
     }
     Config.Close();
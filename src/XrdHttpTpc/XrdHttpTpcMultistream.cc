@@ -86,6 +86,15 @@ public:
                     m_status_code = status_code;
                     m_error_message = (*state_iter)->GetErrorMessage();
                 }
+                // A remote side that ignored the Content-Range of a partial
+                // upload has overwritten the file with that range.
+                if (status_code >= 200 && status_code < 400 && !m_error_code &&
+                    (*state_iter)->IsPartialTransfer() &&
+                    !(*state_iter)->PartialTransferAccepted()) {
+                    m_error_code = 11;
+                    m_error_message = "Transfer failed because the destination did not "
+                                      "acknowledge a partial upload.";
+                }
                 (*state_iter)->ResetAfterRequest();
                 break;
             }
@@ -223,6 +232,8 @@ private:
             }
             return false;
         }
+        // A push reads the local file directly, there is nothing to reorder.
+        if (m_states[0]->IsPush()) {return true;}
         ssize_t available_buffers = m_states[0]->AvailableBuffers();
         // To be conservative, set aside buffers for any transfers that have been activated
         // but don't have their first responses back yet.
@@ -255,14 +266,18 @@ private:
 
 int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
     size_t streams, std::vector<State*> &handles,
-    std::vector<ManagedCurlHandle> &curl_handles, TPCLogRecord &rec)
+    std::vector<ManagedCurlHandle> &curl_handles, TPCLogRecord &rec,
+    off_t start_offset)
 {
     bool success;
     // The content-length was set thanks to the call to GetRemoteFileInfoTPCPull() before calling this function
+    // (for a push, it is the size of the local file).
     off_t content_size = state.GetContentLength();
-    off_t current_offset = 0;
+    off_t current_offset = start_offset;
 
-    size_t concurrency = streams * m_pipelining_multiplier;
+    // Pulled blocks are pipelined to keep the reordering buffers busy; pushed
+    // ones are read from the file when the connection is ready for them.
+    size_t concurrency = state.IsPush() ? streams : streams * m_pipelining_multiplier;
 
     handles.reserve(concurrency);
     handles.push_back(new State());
@@ -431,7 +446,7 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
 
     mch.Flush();
 
-    rec.bytes_transferred = mch.BytesTransferred();
+    rec.bytes_transferred = start_offset + mch.BytesTransferred();
     rec.tpc_status = mch.GetStatusCode();
 
     // Generate the final response back to the client.
@@ -498,13 +513,14 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
 
 
 int TPCHandler::RunCurlWithStreams(XrdHttpExtReq &req, State &state,
-    size_t streams, TPCLogRecord &rec)
+    size_t streams, TPCLogRecord &rec, off_t start_offset)
 {
     std::vector<ManagedCurlHandle> curl_handles;
     std::vector<State*> handles;
     std::stringstream err_ss;
     try {
-        int retval = RunCurlWithStreamsImpl(req, state, streams, handles, curl_handles, rec);
+        int retval = RunCurlWithStreamsImpl(req, state, streams, handles, curl_handles, rec,
+                                            start_offset);
         for (std::vector<State*>::iterator state_iter = handles.begin();
              state_iter != handles.end();
              state_iter++) {
@@ -37,6 +37,8 @@ void State::Move(State &other)
     m_status_code = other.m_status_code;
     m_content_length = other.m_content_length;
     m_push_length = other.m_push_length;
+    m_range_size = other.m_range_size;
+    m_range_accepted = other.m_range_accepted;
     m_stream = other.m_stream;
     m_curl = other.m_curl;
     m_headers = other.m_headers;
@@ -47,6 +49,7 @@ void State::Move(State &other)
     if (m_is_transfer_state) {
         if (m_push) {
             curl_easy_setopt(m_curl, CURLOPT_READDATA, this);
+            curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, this);
         } else {
             curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, this);
         }
@@ -199,7 +202,9 @@ void State::ResetAfterRequest() {
     m_offset = 0;
     m_status_code = -1;
     m_content_length = -1;
-    m_push_length = -1;
+    // The size of the file being pushed is kept for the next partial upload
+    if (!m_is_transfer_state) {m_push_length = -1;}
+    m_range_accepted = false;
     m_recv_all_headers = false;
     m_recv_status_line = false;
     m_repr_digests.clear();
@@ -223,6 +228,7 @@ int State::Header(const std::string &header) {
         std::string item;
         if (!std::getline(ss, item, ' ')) return 0;
         m_resp_protocol = item;
+        m_range_accepted = false;
         //printf("\n\nResponse protocol: %s\n", m_resp_protocol.c_str());
         if (!std::getline(ss, item, ' ')) return 0;
         try {
@@ -251,6 +257,9 @@ int State::Header(const std::string &header) {
                     return 0;
                 }
             }
+            if (header_name == "x-partial-put") {
+                m_range_accepted = true;
+            }
             if(header_name == "repr-digest") {
               XrdHttpHeaderUtils::parseReprDigest(header_value,m_repr_digests);
             }
@@ -338,6 +347,10 @@ size_t State::ReadCB(void *buffer, size_t size, size_t nitems, void *userdata) {
 }
 
 int State::Read(char *buffer, size_t size) {
+    if (m_range_size >= 0) {
+        size = std::min(size, static_cast<size_t>(m_range_size - m_offset));
+        if (!size) {return 0;}
+    }
     int retval = m_stream->Read(m_start_offset + m_offset, buffer, size);
     if (retval == SFS_ERROR) {
         return -1;
@@ -374,11 +387,41 @@ void State::SetTransferParameters(off_t offset, size_t size) {
     m_start_offset = offset;
     m_offset = 0;
     m_content_length = size;
+    if (m_push) {
+        SetPushRange(offset, size);
+        return;
+    }
     std::stringstream ss;
     ss << offset << "-" << (offset+size-1);
     curl_easy_setopt(m_curl, CURLOPT_RANGE, ss.str().c_str());
 }
 
+/**
+ * Send only [offset, offset+size) of the local file; the remote side is told
+ * which part of the file it receives through the Content-Range header.  The
+ * whole-file headers (such as Repr-Digest) are not sent with a range; a push
+ * carrying a digest is therefore never split into ranges.
+ */
+void State::SetPushRange(off_t offset, size_t size) {
+    m_range_size = size;
+    m_range_accepted = false;
+    curl_easy_setopt(m_curl, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(size));
+
+    struct curl_slist *list = NULL;
+    for (const auto &header : m_headers_copy) {
+        list = curl_slist_append(list, header.c_str());
+    }
+    list = curl_slist_append(list, "Expect: 100-continue");
+    std::stringstream ss;
+    ss << "Content-Range: bytes " << offset << "-" << (offset+size-1) << "/";
+    if (m_push_length >= 0) {ss << m_push_length;}
+    else {ss << "*";}
+    list = curl_slist_append(list, ss.str().c_str());
+    curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, list);
+    if (m_headers) {curl_slist_free_all(m_headers);}
+    m_headers = list;
+}
+
 int State::AvailableBuffers() const
 {
     return m_stream->AvailableBuffers();
@@ -30,6 +30,9 @@ public:
         m_status_code(-1),
         m_error_code(0),
         m_content_length(-1),
+        m_push_length(-1),
+        m_range_size(-1),
+        m_range_accepted(false),
         m_stream(NULL),
         m_curl(NULL),
         m_headers(NULL),
@@ -52,6 +55,8 @@ public:
       m_error_code(0),
       m_content_length(-1),
       m_push_length(-1),
+      m_range_size(-1),
+      m_range_accepted(false),
       m_stream(NULL),
       m_curl(curl),
       m_headers(NULL),
@@ -74,6 +79,8 @@ public:
       m_error_code(0),
       m_content_length(-1),
       m_push_length(-1),
+      m_range_size(-1),
+      m_range_accepted(false),
       m_stream(&stream),
       m_curl(curl),
       m_headers(NULL),
@@ -85,6 +92,8 @@ public:
 
     ~State();
 
+    // Set the byte range of the next request: a Range for a pull, a partial
+    // upload (Content-Range) for a push.
     void SetTransferParameters(off_t offset, size_t size);
 
     void SetupHeaders(XrdHttpExtReq &req);
@@ -97,6 +106,16 @@ public:
 
     off_t GetContentLength() const {return m_content_length;}
 
+    // Size of the local file sent by a push (-1 if unknown).
+    off_t GetPushLength() const {return m_push_length;}
+
+    bool IsPush() const {return m_push;}
+
+    // For a partial upload, whether the remote side acknowledged that it
+    // only wrote the given range.
+    bool IsPartialTransfer() const {return m_push && m_range_size >= 0;}
+    bool PartialTransferAccepted() const {return m_range_accepted;}
+
     const std::map<std::string, std::string> & GetReprDigest() const { return m_repr_digests; }
 
     int GetErrorCode() const {return m_error_code;}
@@ -152,6 +171,8 @@ public:
 private:
     bool InstallHandlers(CURL *curl);
 
+    void SetPushRange(off_t offset, size_t size);
+
     State(const State&);
     // Add back once C++11 is available
     //State(State &&) noexcept;
@@ -179,6 +200,8 @@ private:
     int m_error_code; // error code from underlying stream operations.
     off_t m_content_length;  // value of Content-Length header, if we received one.
     off_t m_push_length; // For push transfers, the size of the file on our server.
+    off_t m_range_size; // For partial push transfers, the size of the range sent (-1 for the whole file).
+    bool m_range_accepted; // Whether the remote side acknowledged the partial push.
     Stream *m_stream;  // stream corresponding to this transfer.
     CURL *m_curl;  // libcurl handle
     struct curl_slist *m_headers; // any headers we set as part of the libcurl request.
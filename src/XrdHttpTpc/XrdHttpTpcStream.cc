@@ -1,8 +1,10 @@
 
+#include <algorithm>
 #include <sstream>
 
 #include "XrdHttpTpcStream.hh"
 
+#include "XrdOuc/XrdOucIOVec.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysError.hh"
 
@@ -10,6 +12,7 @@ using namespace TPC;
 
 Stream::~Stream()
 {
+    StopWriteBehind();
     for (std::vector<Entry*>::iterator buffer_iter = m_buffers.begin();
         buffer_iter != m_buffers.end();
         buffer_iter++) {
@@ -29,6 +32,9 @@ Stream::Finalize()
     }
     m_open_for_write = false;
 
+    // Wait for the queued data to reach the file handle
+    bool wb_ok = StopWriteBehind();
+
     for (std::vector<Entry*>::iterator buffer_iter = m_buffers.begin();
         buffer_iter != m_buffers.end();
         buffer_iter++) {
@@ -44,6 +50,9 @@ Stream::Finalize()
         m_error_buf = ss.str();
         return false;
     }
+    if (!wb_ok) {
+        return false;
+    }
 
     // If there are outstanding buffers to reorder, finalization failed
     return m_avail_count == m_buffers.size();
@@ -167,6 +176,9 @@ ssize_t Stream::WriteImpl(off_t offset, const char *buf, size_t size)
 {
     ssize_t retval;
     if (size == 0) {return 0;}
+    if (m_wb_max) {
+        return QueueCopy(offset, buf, size);
+    }
     retval = m_fh->write(offset, buf, size);
     if (retval != SFS_ERROR) {
         m_offset += retval;
@@ -181,6 +193,191 @@ ssize_t Stream::WriteImpl(off_t offset, const char *buf, size_t size)
 }
 
 
+ssize_t Stream::WriteImpl(off_t offset, std::vector<char> &buffer, size_t size)
+{
+    if (size == 0) {return 0;}
+    if (m_wb_max) {
+        return QueueWrite(offset, buffer, size);
+    }
+    return WriteImpl(offset, &buffer[0], size);
+}
+
+
+bool Stream::WaitForRoom(std::unique_lock<std::mutex> &lock, size_t size)
+{
+    // Backpressure: wait until the writer thread has caught up enough to make
+    // room for this data (more than the limit is accepted once the queue is
+    // empty).
+    m_wb_room.wait(lock, [&]{
+        return m_wb_failed || !m_wb_queued || m_wb_queued + size <= m_wb_max;
+    });
+    if (m_wb_failed) {
+        m_error_buf = m_wb_error;
+        return false;
+    }
+    return true;
+}
+
+
+std::vector<char> Stream::TakeBuffer(size_t size)
+{
+    std::vector<char> buffer;
+    for (size_t idx = m_wb_free.size(); idx > 0; idx--) {
+        if (m_wb_free[idx - 1].size() >= size) {
+            buffer.swap(m_wb_free[idx - 1]);
+            m_wb_free.erase(m_wb_free.begin() + (idx - 1));
+            m_wb_free_bytes -= buffer.size();
+            return buffer;
+        }
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+
+ssize_t Stream::QueueWrite(off_t offset, std::vector<char> &buffer, size_t size)
+{
+    std::unique_lock<std::mutex> lock(m_wb_mutex);
+    if (!WaitForRoom(lock, size)) {
+        return SFS_ERROR;
+    }
+    PendingWrite pending;
+    pending.offset = offset;
+    pending.size = size;
+    pending.buffer.swap(buffer);
+    if (!m_wb_free.empty()) {
+        buffer.swap(m_wb_free.back());
+        m_wb_free.pop_back();
+        m_wb_free_bytes -= buffer.size();
+    }
+    m_wb_queue.push_back(std::move(pending));
+    m_wb_queued += size;
+    m_offset += size;
+    m_wb_work.notify_one();
+    return size;
+}
+
+
+ssize_t Stream::QueueCopy(off_t offset, const char *buf, size_t size)
+{
+    // Small writes (as they come from curl) are gathered into buffers of this
+    // size so the writer thread sees large contiguous writes.
+    static const size_t copy_chunk = 1024*1024;
+
+    std::unique_lock<std::mutex> lock(m_wb_mutex);
+    if (!WaitForRoom(lock, size)) {
+        return SFS_ERROR;
+    }
+    if (!m_wb_queue.empty()) {
+        PendingWrite &last = m_wb_queue.back();
+        if (last.offset + static_cast<off_t>(last.size) == offset &&
+            last.buffer.size() - last.size >= size) {
+            memcpy(&last.buffer[last.size], buf, size);
+            last.size += size;
+            m_wb_queued += size;
+            m_offset += size;
+            return size;
+        }
+    }
+    PendingWrite pending;
+    pending.offset = offset;
+    pending.size = size;
+    pending.buffer = TakeBuffer(std::max(size, std::min(copy_chunk, m_wb_max)));
+    memcpy(&pending.buffer[0], buf, size);
+    m_wb_queue.push_back(std::move(pending));
+    m_wb_queued += size;
+    m_offset += size;
+    m_wb_work.notify_one();
+    return size;
+}
+
+
+void Stream::WriteBehind()
+{
+    // Contiguous buffers are written together, up to this many bytes.
+    static const size_t max_batch = 64*1024*1024;
+    static const size_t max_iov = 64;
+
+    std::vector<PendingWrite> batch;
+    std::vector<XrdOucIOVec> iov;
+    std::unique_lock<std::mutex> lock(m_wb_mutex);
+    while (true) {
+        m_wb_work.wait(lock, [&]{return m_wb_stop || !m_wb_queue.empty();});
+        if (m_wb_queue.empty()) {break;}
+
+        // The queue is in file order, take the buffers that follow each other
+        size_t batch_size = 0;
+        while (!m_wb_queue.empty() && batch.size() < max_iov &&
+               (batch.empty() || (m_wb_queue.front().offset == batch.back().offset + static_cast<off_t>(batch.back().size)
+                                  && batch_size + m_wb_queue.front().size <= max_batch))) {
+            batch_size += m_wb_queue.front().size;
+            batch.push_back(std::move(m_wb_queue.front()));
+            m_wb_queue.pop_front();
+        }
+        bool failed = m_wb_failed;
+        lock.unlock();
+
+        ssize_t retval = 0;
+        if (!failed) {
+            if (batch.size() == 1) {
+                retval = m_fh->write(batch[0].offset, &batch[0].buffer[0], batch[0].size);
+            } else {
+                iov.resize(batch.size());
+                for (size_t idx = 0; idx < batch.size(); idx++) {
+                    iov[idx].offset = batch[idx].offset;
+                    iov[idx].size = batch[idx].size;
+                    iov[idx].info = 0;
+                    iov[idx].data = &batch[idx].buffer[0];
+                }
+                retval = m_fh->writev(&iov[0], iov.size());
+            }
+        }
+
+        lock.lock();
+        if (!failed && (retval < 0 || static_cast<size_t>(retval) != batch_size)) {
+            std::stringstream ss;
+            const char *msg = m_fh->error.getErrText();
+            if (retval >= 0) {msg = "short write";}
+            else if (!msg || (*msg == '\0')) {msg = "(no error message provided)";}
+            ss << msg << " (code=" << m_fh->error.getErrInfo() << ")";
+            m_wb_error = ss.str();
+            m_wb_failed = true;
+        }
+        m_wb_queued -= batch_size;
+        // Keep the buffers for reuse, up to as much as may be queued
+        for (auto &pending : batch) {
+            if (m_wb_free_bytes + pending.buffer.size() <= m_wb_max) {
+                m_wb_free_bytes += pending.buffer.size();
+                m_wb_free.push_back(std::move(pending.buffer));
+            }
+        }
+        batch.clear();
+        m_wb_room.notify_all();
+    }
+}
+
+
+bool Stream::StopWriteBehind()
+{
+    if (!m_wb_thread.joinable()) {
+        std::lock_guard<std::mutex> lock(m_wb_mutex);
+        return !m_wb_failed;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wb_mutex);
+        m_wb_stop = true;
+        m_wb_work.notify_one();
+    }
+    m_wb_thread.join();
+    std::lock_guard<std::mutex> lock(m_wb_mutex);
+    if (m_wb_failed) {
+        if (!m_error_buf.size()) {m_error_buf = m_wb_error;}
+        return false;
+    }
+    return true;
+}
+
+
 void
 Stream::DumpBuffers() const
 {
@@ -9,7 +9,11 @@
 
 #include "XrdSfs/XrdSfsInterface.hh"
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -22,18 +26,31 @@ class XrdSysError;
 namespace TPC {
 class Stream {
 public:
-    Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log)
+    // When write_behind is non-zero, the data is written to the file handle
+    // by a separate thread so the caller (the curl callbacks) does not wait
+    // for the disk; up to write_behind bytes may be queued before the caller
+    // is made to wait.
+    Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log,
+           size_t write_behind = 0)
         : m_open_for_write(false),
           m_avail_count(max_blocks),
           m_fh(std::move(fh)),
           m_offset(0),
-          m_log(log)
+          m_log(log),
+          m_wb_max(write_behind),
+          m_wb_queued(0),
+          m_wb_stop(false),
+          m_wb_failed(false),
+          m_wb_free_bytes(0)
     {
         m_buffers.reserve(max_blocks);
         for (size_t idx=0; idx < max_blocks; idx++) {
             m_buffers.push_back(new Entry(buffer_size));
         }
         m_open_for_write = true;
+        if (m_wb_max) {
+            m_wb_thread = std::thread(&Stream::WriteBehind, this);
+        }
     }
 
     ~Stream();
@@ -91,7 +108,7 @@ private:
             if (!force && (m_size != m_capacity)) {
                 return 0;
             }
-            ssize_t retval = stream.WriteImpl(m_offset, &m_buffer[0], m_size);
+            ssize_t retval = stream.WriteImpl(m_offset, m_buffer, m_size);
             // Currently the only valid negative value is SFS_ERROR (-1); checking for
             // all negative values to future-proof the code.
             if ((retval < 0) || (static_cast<size_t>(retval) != m_size)) {
@@ -162,6 +179,34 @@ private:
 
     ssize_t WriteImpl(off_t offset, const char *buffer, size_t size);
 
+    // Write the first size bytes of a buffer; with write-behind the buffer is
+    // handed over to the writer thread (and replaced by a recycled one).
+    ssize_t WriteImpl(off_t offset, std::vector<char> &buffer, size_t size);
+
+    // Queue data for the writer thread, waiting for room if needed.
+    ssize_t QueueWrite(off_t offset, std::vector<char> &buffer, size_t size);
+
+    // Queue a copy of data for the writer thread; the data is appended to the
+    // last queued buffer when it follows it, otherwise copied into a recycled
+    // buffer.
+    ssize_t QueueCopy(off_t offset, const char *buf, size_t size);
+
+    // Wait until size bytes may be queued; false if the writer thread failed.
+    bool WaitForRoom(std::unique_lock<std::mutex> &lock, size_t size);
+
+    // Take a recycled buffer of at least size bytes, or allocate one.
+    std::vector<char> TakeBuffer(size_t size);
+
+    // Body of the writer thread and the way to stop it.
+    void WriteBehind();
+    bool StopWriteBehind();
+
+    struct PendingWrite {
+        off_t offset;
+        size_t size;
+        std::vector<char> buffer;
+    };
+
     bool m_open_for_write;
     size_t m_avail_count;
     std::unique_ptr<XrdSfsFile> m_fh;
@@ -169,5 +214,19 @@ private:
     std::vector<Entry*> m_buffers;
     XrdSysError &m_log;
     std::string m_error_buf;
+
+    // Write-behind state, protected by m_wb_mutex.
+    size_t m_wb_max;  // Maximum number of bytes queued; 0 if write-behind is disabled.
+    size_t m_wb_queued;  // Number of bytes queued or being written.
+    bool m_wb_stop;  // Set when no more data will be queued.
+    bool m_wb_failed;  // Set when a write of the writer thread failed.
+    std::string m_wb_error;  // Error message of the failed write.
+    std::deque<PendingWrite> m_wb_queue;
+    std::vector<std::vector<char>> m_wb_free;  // Buffers to be reused.
+    size_t m_wb_free_bytes;  // Total size of the buffers to be reused.
+    std::mutex m_wb_mutex;
+    std::condition_variable m_wb_work;  // Signalled when data is queued.
+    std::condition_variable m_wb_room;  // Signalled when queued data was written.
+    std::thread m_wb_thread;
 };
 }
@@ -315,6 +315,8 @@ TPCHandler::TPCHandler(XrdSysError *log, const char *config, XrdOucEnv *myEnv) :
         m_fixed_route(false),
         m_timeout(60),
         m_first_timeout(120),
+        m_push_streams(true),
+        m_write_behind(64*1024*1024),
         m_log(log->logger(), "TPC_"),
         m_sfs(NULL)
 {
@@ -843,6 +845,15 @@ int TPCHandler::ProcessPushReq(const std::string & resource, XrdHttpExtReq &req)
         redirect_resource = query_header->second;
     }
 
+    int streams = GetRequestedStreams(req);
+    if (streams < 0) {
+        std::stringstream ss;
+        ss << "Invalid request for number of streams";
+        rec.status = 400;
+        logTransferEvent(LogMask::Info, rec, "INVALID_REQUEST", ss.str());
+        return req.SendSimpleResp(rec.status, NULL, NULL, generateClientErr(ss, rec).c_str(), 0);
+    }
+
     AtomicBeg(m_monid_mutex);
     uint64_t file_monid = AtomicInc(m_monid);
     AtomicEnd(m_monid_mutex);
@@ -883,9 +894,78 @@ int TPCHandler::ProcessPushReq(const std::string & resource, XrdHttpExtReq &req)
     State state(0, stream, curl, true, req.tpcForwardCreds);
     state.SetupHeaders(req);
 
+    // Several streams are used by sending the file as partial uploads of one
+    // block each, provided the destination acknowledges the first one.  A
+    // Repr-Digest describes the whole file and cannot be checked against a
+    // partial upload, so such a push is always sent as a single stream.
+    off_t push_length = state.GetPushLength();
+    bool has_digest = XrdOucTUtils::caseInsensitiveFind(req.headers, "repr-digest") != req.headers.end();
+    if (streams > 1 && m_push_streams && has_digest) {
+        logTransferEvent(LogMask::Info, rec, "PUSH_SINGLE_STREAM",
+            "Repr-Digest requested; sending the file as a single stream");
+    } else if (streams > 1 && m_push_streams && push_length > static_cast<off_t>(m_block_size)) {
+        if (StartPartialPush(state, rec)) {
+            rec.streams = streams;
+            state.SetContentLength(push_length);
+            return RunCurlWithStreams(req, state, streams, rec, m_block_size);
+        }
+        logTransferEvent(LogMask::Info, rec, "PUSH_SINGLE_STREAM",
+            "Destination does not accept partial uploads; sending the file as a single stream");
+    }
+
     return RunCurlWithUpdates(curl, req, state, rec);
 }
 
+/******************************************************************************/
+/*          T P C H a n d l e r : : S t a r t P a r t i a l P u s h           */
+/******************************************************************************/
+
+bool TPCHandler::StartPartialPush(State &state, TPCLogRecord &rec) {
+    // The first block is sent on its own: its upload creates (or truncates)
+    // the destination file, which the other blocks can then update in any
+    // order.  A destination that does not know about partial uploads either
+    // rejects it or takes it for the whole file, which is then sent again.
+    ManagedCurlHandle curl;
+    std::unique_ptr<State> probe;
+    try {
+        probe.reset(state.Duplicate());
+    } catch (std::runtime_error &) {
+        return false;
+    }
+    curl.reset(probe->GetHandle());
+    probe->SetTransferParameters(0, m_block_size);
+
+    CURLcode res = curl_easy_perform(curl.get());
+    int status = probe->GetStatusCode();
+    bool accepted = (res == CURLE_OK) && (status >= 200) && (status < 300) &&
+                    probe->PartialTransferAccepted() &&
+                    (probe->BytesTransferred() == static_cast<off_t>(m_block_size));
+
+    std::stringstream ss;
+    ss << "Partial upload of the first " << m_block_size << " bytes "
+       << (accepted ? "accepted" : "not accepted") << " by the destination (status=" << status;
+    if (res != CURLE_OK) {ss << ", " << curl_easy_strerror(res);}
+    ss << ")";
+    logTransferEvent(LogMask::Debug, rec, "PUSH_PARTIAL_START", ss.str());
+    return accepted;
+}
+
+/******************************************************************************/
+/*       T P C H a n d l e r : : G e t R e q u e s t e d S t r e a m s        */
+/******************************************************************************/
+
+int TPCHandler::GetRequestedStreams(XrdHttpExtReq &req) {
+    auto streams_header = XrdOucTUtils::caseInsensitiveFind(req.headers,"x-number-of-streams");
+    if (streams_header == req.headers.end()) {return 1;}
+    int stream_req = -1;
+    try {
+        stream_req = std::stol(streams_header->second);
+    } catch (...) { // Handled below
+    }
+    if (stream_req < 0 || stream_req > 100) {return -1;}
+    return stream_req == 0 ? 1 : stream_req;
+}
+
 /******************************************************************************/
 /*            T P C H a n d l e r : : P r o c e s s P u l l R e q             */
 /******************************************************************************/
@@ -970,24 +1050,13 @@ int TPCHandler::ProcessPullReq(const std::string &resource, XrdHttpExtReq &req)
     if ((overwrite_header == req.headers.end()) || (overwrite_header->second == "T")) {
         if (! usingEC) mode = SFS_O_TRUNC;
     }
-    int streams = 1;
-    {
-        auto streams_header = XrdOucTUtils::caseInsensitiveFind(req.headers,"x-number-of-streams");
-        if (streams_header != req.headers.end()) {
-            int stream_req = -1;
-            try {
-                stream_req = std::stol(streams_header->second);
-            } catch (...) { // Handled below
-            }
-            if (stream_req < 0 || stream_req > 100) {
-                std::stringstream ss;
-                ss << "Invalid request for number of streams";
-                rec.status = 400;
-                logTransferEvent(LogMask::Info, rec, "INVALID_REQUEST", ss.str());
-                return req.SendSimpleResp(rec.status, NULL, NULL, generateClientErr(ss, rec).c_str(), 0);
-            }
-            streams = stream_req == 0 ? 1 : stream_req;
-        }
+    int streams = GetRequestedStreams(req);
+    if (streams < 0) {
+        std::stringstream ss;
+        ss << "Invalid request for number of streams";
+        rec.status = 400;
+        logTransferEvent(LogMask::Info, rec, "INVALID_REQUEST", ss.str());
+        return req.SendSimpleResp(rec.status, NULL, NULL, generateClientErr(ss, rec).c_str(), 0);
     }
     rec.streams = streams;
     std::string full_url = prepareURL(req);
@@ -1034,7 +1103,7 @@ int TPCHandler::ProcessPullReq(const std::string &resource, XrdHttpExtReq &req)
         fh->close();
         return resp_result;
     }
-    Stream stream(std::move(fh), streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log);
+    Stream stream(std::move(fh), streams * m_pipelining_multiplier, streams > 1 ? m_block_size : m_small_block_size, m_log, m_write_behind);
     State state(0, stream, curl, false, req.tpcForwardCreds);
     state.SetupHeaders(req);
     state.SetContentLength(sourceFileContentLength);
@@ -122,13 +122,21 @@ private:
     int RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, TPC::State &state,
                            TPCLogRecord &rec);
 
-    // Experimental multi-stream version of RunCurlWithUpdates
+    // Experimental multi-stream version of RunCurlWithUpdates; the bytes
+    // before start_offset are assumed to have been transferred already.
     int RunCurlWithStreams(XrdHttpExtReq &req, TPC::State &state,
-                           size_t streams, TPCLogRecord &rec);
+                           size_t streams, TPCLogRecord &rec, off_t start_offset = 0);
     int RunCurlWithStreamsImpl(XrdHttpExtReq &req, TPC::State &state,
                            size_t streams, std::vector<TPC::State*> &streams_handles,
                            std::vector<ManagedCurlHandle> &curl_handles,
-                           TPCLogRecord &rec);
+                           TPCLogRecord &rec, off_t start_offset);
+
+    // Send the first block of a push as a partial upload to find out whether
+    // the destination accepts them; true if the block was written.
+    bool StartPartialPush(TPC::State &state, TPCLogRecord &rec);
+
+    // Number of streams requested by the client, -1 if the request is invalid.
+    int GetRequestedStreams(XrdHttpExtReq &req);
 
     int ProcessPushReq(const std::string & resource, XrdHttpExtReq &req);
     int ProcessPullReq(const std::string &resource, XrdHttpExtReq &req);
@@ -168,6 +176,9 @@ private:
     int m_timeout; // the 'timeout interval'; if no bytes have been received during this time period, abort the transfer.
     int m_first_timeout; // the 'first timeout interval'; the amount of time we're willing to wait to get the first byte.
                          // Unless explicitly specified, this is 2x the timeout interval.
+    bool m_push_streams; // If 'true', a push may be split into partial uploads over several streams.
+    size_t m_write_behind; // Bytes of pulled data that may be queued for writing to disk by a separate thread (0 to write
+                           // synchronously from the curl callbacks).
     std::string m_cadir;  // The directory to use for CAs.
     std::string m_cafile; // The file to use for CAs in libcurl
     static XrdSysMutex m_monid_mutex;
@@ -231,6 +231,49 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return (retc < 0 ? retErr(errno, specDest) : 0);
 }
   
+/******************************************************************************/
+
+int XrdNetMsg::Send(struct msghdr mVec[], int mNum)
+{
+   int retc, mDone = 0, mSent = 0;
+
+// Batches can only be sent to the connected address
+//
+   if (!destOK)
+      {eDest->Emsg("NetMsg", "Destination not specified."); return -1;}
+
+// Send as many messages as we can at a time. Should a message fail, report it
+// and continue with the next one as UDP errors are specific to a message.
+//
+#ifdef __linux__
+   static const int mMax = 64;
+   struct mmsghdr mmVec[mMax];
+
+   while(mDone < mNum)
+        {int n = (mNum - mDone > mMax ? mMax : mNum - mDone);
+         for (int i = 0; i < n; i++)
+             {mmVec[i].msg_hdr = mVec[mDone+i];
+              mmVec[i].msg_len = 0;
+             }
+         do {retc = sendmmsg(FD, mmVec, n, 0);}
+            while (retc < 0 && errno == EINTR);
+         if (retc > 0) {mDone += retc; mSent += retc;}
+            else {retErr((retc ? errno : EAGAIN), dfltDest); mDone++;}
+        }
+#else
+   for (; mDone < mNum; mDone++)
+       {do {retc = sendmsg(FD, &mVec[mDone], 0);}
+           while (retc < 0 && errno == EINTR);
+        if (retc >= 0) mSent++;
+           else retErr(errno, dfltDest);
+       }
+#endif
+
+// All done
+//
+   return (mNum && !mSent ? -1 : mSent);
+}
+  
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
@@ -111,6 +111,20 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+//------------------------------------------------------------------------------
+//! Send a batch of UDP messages to the endpoint specified in the constructor.
+//! Where supported, the messages are sent with a single system call.
+//!
+//! @param  mVec     The vector of message headers. The msg_name field of each
+//!                  element must be null.
+//! @param  mNum     The number of elements in mVec.
+//! @return <0       No message was sent due to error.
+//! @return >=0      The number of messages sent. Messages that encountered an
+//!                  error are skipped after the error is reported.
+//------------------------------------------------------------------------------
+
+int           Send(struct msghdr mVec[], int mNum);
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
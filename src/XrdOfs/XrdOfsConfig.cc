@@ -1609,7 +1609,8 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
                                          [restrict <path>]
                                          [streams <num>[,<max>]]
                                          [echo] [scan {stderr | stdout}]
-                                         [autorm] [pgm <path> [parms]]
+                                         [autorm] [engine {pgm | xrdcl | <lib>}]
+                                         [pgm <path> [parms]]
                                          [fcreds  [?]<auth> =<evar>]
                                          [fcpath <path>] [oids]
 
@@ -1638,6 +1639,10 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
              autorm  Remove file when copy fails.
              scan    scan fr error messages either in stderr or stdout. The
                      default is to scan both.
+             engine  how copies are run: pgm runs the transfer command for
+                     each copy (the default), xrdcl runs copies within the
+                     server using the native client, and <lib> is the path of
+                     a plugin implementing XrdOfsTPCEngine.
              pgm     specifies the transfer command with optional paramaters.
                      It must be the last parameter on the line.
              fcreds  Forward destination credentials for protocol <auth>. The
@@ -1695,6 +1700,16 @@ int XrdOfs::xtpc(XrdOucStream &Config, XrdSysError &Eroute)
          if (!strcmp(val, "logok")) {Parms.LogOK  = true; continue;}
          if (!strcmp(val, "autorm")){Parms.autoRM = true; continue;}
          if (!strcmp(val, "oids"))  {Parms.noids  = false;continue;}
+         if (!strcmp(val, "engine"))
+            {if (!(val = Config.GetWord()))
+                {Eroute.Emsg("Config","tpc engine not specified"); return 1;}
+             if (Parms.XfrEngine) free(Parms.XfrEngine);
+                  if (!strcmp(val, "pgm"))   Parms.XfrEngine = 0;
+             else if (!strcmp(val, "xrdcl")) Parms.XfrEngine =
+                                                strdup("libXrdOfsTPCCl.so");
+             else Parms.XfrEngine = strdup(val);
+             continue;
+            }
          if (!strcmp(val, "pgm"))
             {if (!Config.GetRest(pgm, sizeof(pgm)))
                 {Eroute.Emsg("Config", "tpc command line too long"); return 1;}
@@ -244,11 +244,8 @@ extern XrdOfsStats OfsStats;
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
   
-XrdSysMutex   XrdOfsHandle::myMutex;
-XrdOfsHanTab  XrdOfsHandle::roTable;
-XrdOfsHanTab  XrdOfsHandle::rwTable;
+XrdOfsHandle::HanShard XrdOfsHandle::hanShard[XrdOfsHandle::hShards];
 XrdOssDF     *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
-XrdOfsHandle *XrdOfsHandle::Free = 0;
 
 /******************************************************************************/
 /*                    c l a s s   X r d O f s H a n d l e                     */
@@ -260,33 +257,39 @@ XrdOfsHandle *XrdOfsHandle::Free = 0;
 int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 {
    XrdOfsHandle *hP;
-   XrdOfsHanTab *theTable = (Opts & opRW ? &rwTable : &roTable);
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   HanShard    &hs = Shard(theKey.Hash);
+   XrdOfsHanTab *theTable = (Opts & opRW ? &hs.rwTable : &hs.roTable);
    int          retc;
 
-// Lock the search table and try to find the key. If found, increment the
-// the link count (can only be done with the global lock) then release the
-// lock and try to lock the handle. It can't escape between lock calls because
+// Lock the shard and try to find the key. If found, increment the link count
+// (adding a link can only be done with the shard lock) then release the lock
+// and try to lock the handle. It can't escape between lock calls because
 // the link count is positive. If we can't lock the handle then it must be the
 // that a long running operation is occuring. Return the handle to its former
-// state and return a delay. Otherwise, return the handle.
+// state and return a delay. Otherwise, return the handle. Note that should the
+// holder have retired the handle in the meantime we may have the last link,
+// in which case it must be properly retired (the lock is now free).
 //
-   myMutex.Lock();
+   hs.Mutex.Lock();
    if ((hP = theTable->Find(theKey)))
-      {hP->Path.Links++; myMutex.UnLock();
+      {hP->Path.Links++; hs.Mutex.UnLock();
        if (hP->WaitLock()) {*Handle = hP; return 0;}
-       myMutex.Lock(); hP->Path.Links--; myMutex.UnLock();
+       unsigned int numLinks = hP->Path.Links.load();
+       while(numLinks > 1
+         && !hP->Path.Links.compare_exchange_weak(numLinks, numLinks-1)) {}
+       if (numLinks <= 1) {hP->Lock(); hP->Retire(retc);}
        return nolokDelay;
       }
 
 // Get a new handle
 //
-   if (!(retc = Alloc(theKey, Opts, Handle))) theTable->Add(*Handle);
-   OfsStats.Add(OfsStats.Data.numHandles);
+   if (!(retc = Alloc(hs, theKey, Opts, Handle))) theTable->Add(*Handle);
 
 // All done
 //
-   myMutex.UnLock();
+   hs.Mutex.UnLock();
+   OfsStats.Add(OfsStats.Data.numHandles);
    return retc;
 }
 
@@ -297,12 +300,13 @@ int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 {
     XrdOfsHanKey myKey("dummy", 5);
+    HanShard    &hs = Shard(myKey.Hash);
     int retc;
 
-    myMutex.Lock();
-    if (!(retc = Alloc(myKey, 0, Handle))) 
+    hs.Mutex.Lock();
+    if (!(retc = Alloc(hs, myKey, 0, Handle)))
        {(*Handle)->Path.Links = 0; (*Handle)->UnLock();}
-    myMutex.UnLock();
+    hs.Mutex.UnLock();
     return retc;
 }
 
@@ -310,16 +314,20 @@ int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 /* private                      A l l o c   # 3                               */
 /******************************************************************************/
   
-int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
+// The shard must be locked upon entry.
+
+int XrdOfsHandle::Alloc(HanShard &hs, XrdOfsHanKey &theKey, int Opts,
+                        XrdOfsHandle **Handle)
 {
    static const int minAlloc = 4096/sizeof(XrdOfsHandle);
    XrdOfsHandle *hP;
 
-// No handle currently in the table. Get a new one off the free list
+// No handle currently in the table. Get a new one off the shard's free list.
+// Handles always return to the shard they came from as they hold the same key.
 //
-   if (!Free && (hP = new XrdOfsHandle[minAlloc]))
-      {int i = minAlloc; while(i--) {hP->Next = Free; Free = hP; hP++;}}
-   if ((hP = Free)) Free = hP->Next;
+   if (!hs.Free && (hP = new XrdOfsHandle[minAlloc]))
+      {int i = minAlloc; while(i--) {hP->Next = hs.Free; hs.Free = hP; hP++;}}
+   if ((hP = hs.Free)) hs.Free = hP->Next;
 
 // Initialize the new handle, if we have one, and add it to the table
 //
@@ -347,14 +355,15 @@ void XrdOfsHandle::Hide(const char *thePath)
 {
    XrdOfsHandle *hP;
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   HanShard    &hs = Shard(theKey.Hash);
 
-// Lock the search table and try to find the key in each table. If found,
-// clear the length field to effectively hide the item.
+// Lock the shard and try to find the key in each table. If found, clear the
+// length field to effectively hide the item.
 //
-   myMutex.Lock();
-   if ((hP = roTable.Find(theKey))) hP->Path.Len = 0;
-   if ((hP = rwTable.Find(theKey))) hP->Path.Len = 0;
-   myMutex.UnLock();
+   hs.Mutex.Lock();
+   if ((hP = hs.roTable.Find(theKey))) hP->Path.Len = 0;
+   if ((hP = hs.rwTable.Find(theKey))) hP->Path.Len = 0;
+   hs.Mutex.UnLock();
 }
 
 /******************************************************************************/
@@ -373,7 +382,7 @@ int XrdOfsHandle::PoscGet(short &Mode, int Done)
        Mode = Posc->Mode;
        if (Done)
           {pP = Posc; Posc = 0;
-           if (pP->xprP) {myMutex.Lock(); Path.Links--; myMutex.UnLock();}
+           if (pP->xprP) Path.Links--;
            pP->Recycle();
           }
        return pnum;
@@ -457,31 +466,43 @@ const char *XrdOfsHandle::PoscUsr()
 
 int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 {
+   HanShard &hs = Shard(Path.Hash);
    XrdOssDF *mySSI;
-   int numLeft;
+   unsigned int numLinks;
 
-// Get the global lock as the links field can only be manipulated with it.
-// Decrement the links count and if zero, remove it from the table and
-// place it on the free list. Otherwise, it is still in use.
+// If this is not the last link, simply drop it. Links are only added with the
+// shard lock held and we hold the handle lock, so no one else can drop the
+// last link while we are doing this.
 //
    retc = 0;
-   myMutex.Lock();
-   if (Path.Links == 1)
+   numLinks = Path.Links.load();
+   while(numLinks > 1)
+        {if (Path.Links.compare_exchange_weak(numLinks, numLinks-1))
+            {UnLock(); return numLinks-1;}
+        }
+
+// Get the shard lock as the last link can only be dropped with it. Someone
+// may have added a link before we got the lock, so check again. If this is
+// the last link, remove it from the table and place it on the free list.
+// Otherwise, it is still in use.
+//
+   hs.Mutex.Lock();
+   if ((numLinks = Path.Links--) == 1)
       {if (buff) strlcpy(buff, Path.Val, blen);
-       numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
-       if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
+       OfsStats.Dec(OfsStats.Data.numHandles);
+       if ( (isRW ? hs.rwTable.Remove(this) : hs.roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
-          Next = Free; Free = this; UnLock(); myMutex.UnLock();
+          Next = hs.Free; hs.Free = this; UnLock(); hs.Mutex.UnLock();
           if (mySSI && mySSI != ossDF)
              {retc = mySSI->Close(retsz); delete mySSI;}
          } else {
-          UnLock(); myMutex.UnLock();
+          UnLock(); hs.Mutex.UnLock();
           OfsEroute.Emsg("Retire", "Lost handle to", buff);
         }
-      } else {numLeft = --Path.Links; UnLock(); myMutex.UnLock();}
-   return numLeft;
+      } else {UnLock(); hs.Mutex.UnLock();}
+   return numLinks-1;
 }
 
 /******************************************************************************/
@@ -489,20 +510,21 @@ int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 int XrdOfsHandle::Retire(XrdOfsHanCB *cbP, int hTime)
 {
    static int allOK = StartXpr(1);
+   HanShard &hs = Shard(Path.Hash);
    XrdOfsHanXpr *xP;
    int retc;
 
 // The handle can only be held by one reference and only if it's a POSC and
 // deferred handling was properly set up.
 //
-   myMutex.Lock();
+   hs.Mutex.Lock();
    if (!Posc || !allOK)
       {OfsEroute.Emsg("Retire", "ignoring deferred retire of", Path.Val);
-       if (Path.Links != 1 || !Posc || !cbP) myMutex.UnLock();
-          else {myMutex.UnLock(); cbP->Retired(this);}
+       if (Path.Links != 1 || !Posc || !cbP) hs.Mutex.UnLock();
+          else {hs.Mutex.UnLock(); cbP->Retired(this);}
        return Retire(retc);
       }
-   myMutex.UnLock();
+   hs.Mutex.UnLock();
 
 // If this object already has an xpr object (happens for bouncing connections)
 // then reuse that object. Otherwise create a new one and put it on the queue.
@@ -554,14 +576,15 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
             hP->UnLock(); delete xP; continue;
            }
 
-// As the handle is locked we can get the global handle lock to prevent
-// additions and removals of handles as we need a stable reference count to
-// effect the callout, if any. Do so only if the reference count is one (for us)
-// and the handle is active. In all cases, drop the global lock.
+// As the handle is locked we can get the shard lock to prevent additions
+// and removals of handles as we need a stable reference count to effect the
+// callout, if any. Do so only if the reference count is one (for us) and the
+// handle is active. In all cases, drop the shard lock.
 //
-   myMutex.Lock();
-   if (hP->Path.Links != 1 || !xP->Call) myMutex.UnLock();
-      else {myMutex.UnLock();
+   HanShard &hs = Shard(hP->Path.Hash);
+   hs.Mutex.Lock();
+   if (hP->Path.Links != 1 || !xP->Call) hs.Mutex.UnLock();
+      else {hs.Mutex.UnLock();
             xP->Call->Retired(hP);
            }
 
@@ -34,6 +34,7 @@
    appropriate size (yes, that means dbx has a tough time).
 */
 
+#include <atomic>
 #include <cstdlib>
 
 #include "XrdOuc/XrdOucCRC.hh"
@@ -48,7 +49,7 @@ class XrdOfsHanKey
 public:
 
 const char          *Val;
-unsigned int         Links;
+std::atomic<unsigned int> Links;
 unsigned int         Hash;
 short                Len;
 
@@ -74,7 +75,9 @@ inline int           operator!=(const XrdOfsHanKey &oth)
                           XrdOucCRC::CRC32((const unsigned char *)key,kln) : 0);
                     }
 
-		    XrdOfsHanKey(const XrdOfsHanKey&) = default;
+                    XrdOfsHanKey(const XrdOfsHanKey &oth)
+                                : Val(oth.Val), Links(oth.Links.load()),
+                                  Hash(oth.Hash), Len(oth.Len) {}
 
                    ~XrdOfsHanKey() {};
 };
@@ -98,7 +101,7 @@ int            Remove(XrdOfsHandle *rip);
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
 //
-    XrdOfsHanTab(int psize = 987, int size = 1597);
+    XrdOfsHanTab(int psize = 55, int size = 89);
    ~XrdOfsHanTab() {} // Never gets deleted
 
 private:
@@ -174,7 +177,28 @@ inline       void   UnLock() {hMutex.UnLock();}
          ~XrdOfsHandle() {int retc; Retire(retc);}
 
 private:
-static int           Alloc(XrdOfsHanKey, int Opts, XrdOfsHandle **Handle);
+// Handles are spread over shards by the hash of their path so that opens and
+// closes of different files do not contend for a single lock. Each shard has
+// its own lock, tables, and free list. The lock protects the tables and the
+// free list and must be held to add a link to a handle found in the table or
+// to drop the last link. Other links may be dropped without the lock.
+//
+struct alignas(64) HanShard
+      {XrdSysMutex   Mutex;
+       XrdOfsHanTab  roTable;    // File handles open r/o
+       XrdOfsHanTab  rwTable;    // File Handles open r/w
+       XrdOfsHandle *Free;       // List of free handles
+
+       HanShard() : Free(0) {}
+      };
+
+static const int     hShards  = 64; // Must be a power of two
+
+static HanShard     &Shard(unsigned int hash)
+                          {return hanShard[(hash >> 24) & (hShards-1)];}
+
+static int           Alloc(HanShard &hs, XrdOfsHanKey &theKey, int Opts,
+                           XrdOfsHandle **Handle);
        int           WaitLock(void);
 
 static const int     LockTries =   3; // Times to try for a lock
@@ -182,11 +206,8 @@ static const int     LockWait  = 333; // Mills to wait between tries
 static const int     nolokDelay=   3; // Secs to delay client when lock failed
 static const int     nomemDelay=  15; // Secs to delay client when ENOMEM
 
-static XrdSysMutex   myMutex;
-static XrdOfsHanTab  roTable;    // File handles open r/o
-static XrdOfsHanTab  rwTable;    // File Handles open r/w
+static HanShard      hanShard[hShards];
 static XrdOssDF     *ossDF;      // Dummy storage sysem
-static XrdOfsHandle *Free;       // List of free handles
 
        XrdSysMutex   hMutex;
        XrdOssDF     *ssi;        // Storage System Interface
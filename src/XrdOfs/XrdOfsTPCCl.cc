@@ -0,0 +1,215 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O f s T P C C l . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClCopyProcess.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClPostMasterInterfaces.hh"
+#include "XrdCl/XrdClUtils.hh"
+#include "XrdOfs/XrdOfsTPCEngine.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdVersion.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Relays the copy progress into the transfer and lets the copy process know
+// when the transfer has been cancelled.
+//
+class TPCProgress : public XrdCl::CopyProgressHandler
+{
+public:
+
+void JobProgress(uint32_t jobNum, uint64_t bytesProcessed,
+                                  uint64_t bytesTotal) override
+                {(void)jobNum; (void)bytesTotal;
+                 if (xfr.Bytes) xfr.Bytes->store(bytesProcessed);
+                }
+
+bool ShouldCancel(uint32_t jobNum) override
+                 {(void)jobNum; return xfr.Stop && xfr.Stop->load();}
+
+     TPCProgress(XrdOfsTPCEngine::Xfr &xP) : xfr(xP) {}
+    ~TPCProgress() {}
+
+private:
+XrdOfsTPCEngine::Xfr &xfr;
+};
+
+// The engine runs copies with XrdCl in this process. Every copy shares the
+// client's post-master and thus its connections to the source servers.
+//
+class XrdOfsTPCCl : public XrdOfsTPCEngine
+{
+public:
+
+int  Copy(Xfr &xfr) override;
+
+     XrdOfsTPCCl(XrdSysError *eP, int nStrm) : eDest(eP), dfltStrm(nStrm) {}
+    ~XrdOfsTPCCl() {}
+
+private:
+
+int  Fail(Xfr &xfr, const XrdCl::XRootDStatus &st);
+
+XrdSysError *eDest;
+int          dfltStrm;
+};
+}
+
+/******************************************************************************/
+/*                                  C o p y                                   */
+/******************************************************************************/
+
+int XrdOfsTPCCl::Copy(XrdOfsTPCEngine::Xfr &xfr)
+{
+   XrdCl::CopyProcess  process;
+   XrdCl::PropertyList props, results;
+   XrdCl::XRootDStatus st;
+   TPCProgress         progress(xfr);
+   std::string         src(xfr.Src), dst("file://");
+   int                 nStrm = (xfr.Strm > 0 ? xfr.Strm : dfltStrm);
+
+// If we are to use forwarded credentials, tell the security layer about them
+// for this copy only (the copy program would have used an envar instead).
+//
+   if (xfr.Crd)
+      {src += (strchr(xfr.Src, '?') ? '&' : '?');
+       src += "xrd.gsiusrpxy=";
+       src += xfr.Crd;
+      }
+
+// The number of streams is a property of the connection to the source. So,
+// ask for it in the url. Copies wanting the same number of streams share a
+// connection and no other client in this process is affected.
+//
+   if (nStrm > 0)
+      {src += (src.find('?') != std::string::npos ? '&' : '?');
+       src += "xrdcl.streams=";
+       src += std::to_string(nStrm);
+      }
+   dst += xfr.Dst;
+
+// Describe the copy just like "xrdcp --server" would
+//
+   props.Set("source", src);
+   props.Set("target", dst);
+   props.Set("force",  true);
+
+// Handle the checksum, which is <type>[:{print | <value>}]
+//
+   if (xfr.Cks && *xfr.Cks)
+      {std::vector<std::string> cksParms;
+       XrdCl::Utils::splitString(cksParms, xfr.Cks, ":");
+       props.Set("checkSumType", cksParms[0]);
+       if (cksParms.size() < 2) props.Set("checkSumMode", "end2end");
+          else if (cksParms[1] == "print") props.Set("checkSumMode", "target");
+                  else {props.Set("checkSumMode",   "end2end");
+                        props.Set("checkSumPreset", cksParms[1]);
+                       }
+      }
+
+// Run the copy
+//
+   xfr.isIPv4 = false;
+   if (!(st = process.AddJob(props, &results)).IsOK()
+   ||  !(st = process.Prepare()).IsOK()) return Fail(xfr, st);
+   st = process.Run(&progress);
+   if (results.HasProperty("status"))
+      {XrdCl::XRootDStatus jst = results.Get<XrdCl::XRootDStatus>("status");
+       if (!jst.IsOK()) st = jst;
+      }
+
+// Find out which IP stack was used to reach the source
+//
+   XrdCl::AnyObject obj;
+   XrdCl::URL       srcURL(src);
+   std::string     *ipStack = 0;
+   if (!srcURL.IsLocalFile()
+   &&  XrdCl::DefaultEnv::GetPostMaster()->QueryTransport(srcURL,
+                          XrdCl::StreamQuery::IpStack, obj).IsOK())
+      {obj.Get(ipStack);
+       if (ipStack) {xfr.isIPv4 = (*ipStack == "IPv4"); delete ipStack;}
+      }
+
+// All done
+//
+   return (st.IsOK() ? 0 : Fail(xfr, st));
+}
+
+/******************************************************************************/
+/*                                  F a i l                                   */
+/******************************************************************************/
+
+int XrdOfsTPCCl::Fail(XrdOfsTPCEngine::Xfr &xfr, const XrdCl::XRootDStatus &st)
+{
+   int rc;
+
+// Convert the status to an errno. Errors returned by a server as well as
+// those for local files carry an xrootd error code rather than an errno.
+//
+        if (st.code == XrdCl::errOperationInterrupted
+        || (xfr.Stop && xfr.Stop->load())) rc = ECANCELED;
+   else if (st.errNo >= kXR_ArgInvalid) rc = XProtocol::toErrno(st.errNo);
+   else if (st.errNo) rc = st.errNo;
+   else rc = EIO;
+
+// Return the message
+//
+   if (xfr.eBuff && xfr.eBlen > 0)
+      snprintf(xfr.eBuff, xfr.eBlen, "%s", st.ToStr().c_str());
+   return rc;
+}
+
+/******************************************************************************/
+/*                    X r d O f s T P C E n g i n e G e t                     */
+/******************************************************************************/
+
+extern "C"
+{
+XrdOfsTPCEngine *XrdOfsTPCEngineGet(XrdSysError *eDest, int nStrm)
+{
+   eDest->Say("Config using in-process XrdCl tpc engine.");
+   return new XrdOfsTPCCl(eDest, nStrm);
+}
+}
+
+XrdVERSIONINFO(XrdOfsTPCEngineGet,XrdOfsTPCCl);
@@ -0,0 +1,114 @@
+#ifndef __XRDOFSTPCENGINE_HH__
+#define __XRDOFSTPCENGINE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O f s T P C E n g i n e . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+
+class XrdSysError;
+
+/******************************************************************************/
+/*                       X r d O f s T P C E n g i n e                        */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! The XrdOfsTPCEngine class describes an in-process third party copy engine.
+//! Normally, each native TPC is run by spawning the copy program specified by
+//! the "ofs.tpc pgm" directive. When "ofs.tpc engine" is specified, the engine
+//! plugin is loaded and copies are run within the server by the same threads
+//! that would otherwise wait for the copy program to finish.
+//-----------------------------------------------------------------------------
+
+class XrdOfsTPCEngine
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Describes a single copy.
+//-----------------------------------------------------------------------------
+
+struct Xfr
+      {const char              *Src;    //!< In:  Source URL with cgi
+       const char              *Dst;    //!< In:  Destination PFN with cgi
+       const char              *Cks;    //!< In:  Checksum <type>[:<val>] or 0
+       const char              *Crd;    //!< In:  Path of forwarded proxy or 0
+       const char              *Tid;    //!< In:  Trace id of the originator
+       int                      Strm;   //!< In:  Streams wanted, 0 -> default
+       const std::atomic<bool> *Stop;   //!< In:  Set when the copy is cancelled
+       std::atomic<long long>  *Bytes;  //!< Out: Bytes copied so far
+       char                    *eBuff;  //!< Out: Error message upon failure
+       int                      eBlen;  //!< In:  Size of eBuff
+       bool                     isIPv4; //!< Out: Source was reached via IPv4
+      };
+
+//-----------------------------------------------------------------------------
+//! Copy a file. This method is called by many threads at the same time and
+//! is expected to return once the copy has ended.
+//!
+//! @param  xfr   - The copy to be done.
+//!
+//! @return 0 upon success or the errno reflecting the reason for failure, in
+//!         which case xfr.eBuff holds a message describing the failure.
+//-----------------------------------------------------------------------------
+
+virtual int  Copy(Xfr &xfr) = 0;
+
+             XrdOfsTPCEngine() {}
+virtual     ~XrdOfsTPCEngine() {}
+};
+
+/******************************************************************************/
+/*                    X r d O f s T P C E n g i n e G e t                     */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! Obtain an instance of the engine. The plugin must define a function of the
+//! following type named XrdOfsTPCEngineGet with C linkage.
+//!
+//! @param  eDest    - The error object to be used for messages.
+//! @param  nStrm    - The default number of streams a copy should use or zero
+//!                    when the engine's default is to be used.
+//!
+//! @return Pointer to the engine or nil if it could not be initialized.
+//-----------------------------------------------------------------------------
+
+typedef XrdOfsTPCEngine *(*XrdOfsTPCEngineGet_t)(XrdSysError *eDest,
+                                                 int          nStrm);
+
+//------------------------------------------------------------------------------
+/*! The plugin must also be versioned using:
+
+    #include "XrdVersion.hh"
+    XrdVERSIONINFO(XrdOfsTPCEngineGet,<name>);
+
+    where <name> is a 1- to 15-character unquoted name identifying the plugin.
+*/
+//------------------------------------------------------------------------------
+#endif
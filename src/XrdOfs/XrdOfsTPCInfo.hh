@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 
@@ -87,6 +88,7 @@ void        Success() {isAOK = true;}
                       Spr(vSpr ? strdup(vSpr) :0),
                       Tpr(vTpr ? strdup(vTpr) :0),
                       Rpx(0), Env(0), Crd(0), Csz(0), Str(0),
+                      xfrBytes(0),
                       inWtR(false), isDST(false), isAOK(false)
                       {}
 
@@ -105,6 +107,7 @@ const char     *Env;   // -> creds envar name
 char           *Crd;   // Credentials to be forwarded dst->src
 int             Csz;   // Size of credentials
 char            Str;   // Number of streams to use
+std::atomic<long long> xfrBytes; // Bytes copied so far (engine only)
 bool           inWtR;  // Traget in waitresp status, async reply is valid.
 bool           isDST;  // This info is about the destination file (PFN)
 bool           isAOK;  // The copy succeeded
@@ -36,15 +36,18 @@
 #include "XrdNet/XrdNetIdentity.hh"
 #include "XrdOfs/XrdOfsTPC.hh"
 #include "XrdOfs/XrdOfsTPCConfig.hh"
+#include "XrdOfs/XrdOfsTPCEngine.hh"
 #include "XrdOfs/XrdOfsTPCJob.hh"
 #include "XrdOfs/XrdOfsTPCProg.hh"
 #include "XrdOfs/XrdOfsTrace.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdOuc/XrdOucCallBack.hh"
+#include "XrdOuc/XrdOucPinLoader.hh"
 #include "XrdOuc/XrdOucProg.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysHeaders.hh"
+#include "XrdVersion.hh"
 
 #include "XrdXrootd/XrdXrootdTpcMon.hh"
 
@@ -63,12 +66,15 @@ extern XrdOfsTPCConfig Cfg;
 
 using namespace XrdOfsTPCParms;
 
+XrdVERSIONINFOREF(XrdOfs);
+
 /******************************************************************************/
 /*                      S t a t i c   V a r i a b l e s                       */
 /******************************************************************************/
   
 XrdSysMutex        XrdOfsTPCProg::pgmMutex;
 XrdOfsTPCProg     *XrdOfsTPCProg::pgmIdle  = 0;
+XrdOfsTPCEngine   *XrdOfsTPCProg::Engine   = 0;
 
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
@@ -122,11 +128,31 @@ int         credFile::cSeq = 0;
 XrdOfsTPCProg::XrdOfsTPCProg(XrdOfsTPCProg *Prev, int num, int errMon)
              : Prog(&OfsEroute, errMon),
                JobStream(&OfsEroute),
-               Next(Prev), Job(0)
+               Next(Prev), Job(0), Stop(false)
              {snprintf(Pname, sizeof(Pname), "TPC job %d: ", num);
               Pname[sizeof(Pname)-1] = 0;
              }
   
+/******************************************************************************/
+/*                                 E n d e d                                  */
+/******************************************************************************/
+
+int XrdOfsTPCProg::Ended(int rc)
+{
+
+// Log failures and optionally remove the file (Info would do that as well
+// but much later on, so we do it now).
+//
+   if (rc)
+      {OfsEroute.Emsg("TPC", Job->Info.Org, Job->Info.Lfn, eRec);
+       if (Cfg.autoRM) XrdOfsOss->Unlink(Job->Info.Lfn);
+      } else Job->Info.Success();
+
+// All done
+//
+   return rc;
+}
+
 /******************************************************************************/
 /*                           E x p o r t C r e d s                            */
 /******************************************************************************/
@@ -168,6 +194,17 @@ int XrdOfsTPCProg::Init()
 {
    int n;
 
+// Load the in-process copy engine if one was specified. Copies that it can't
+// handle are still run by the copy program, so we always set that up as well.
+//
+   if (Cfg.XfrEngine)
+      {XrdOucPinLoader myLib(&OfsEroute, &XrdVERSIONINFOVAR(XrdOfs),
+                             "tpc engine", Cfg.XfrEngine);
+       XrdOfsTPCEngineGet_t ep;
+       if (!(ep = (XrdOfsTPCEngineGet_t)(myLib.Resolve("XrdOfsTPCEngineGet")))
+       ||  !(Engine = ep(&OfsEroute, Cfg.tcpSTRM))) return 0;
+      }
+
 // Allocate copy program objects
 //
    for (n = 0; n < Cfg.xfrMax; n++)
@@ -198,7 +235,8 @@ void XrdOfsTPCProg::Run()
 // Run the current job and indicate it's ending status and possibly getting a
 // another job to run. Note "Job" will always be valid.
 //
-do{if (doMon)
+do{Stop = false;
+   if (doMon)
       {monInfo.Init();
        gettimeofday(&monInfo.begT, 0);
       }
@@ -225,9 +263,12 @@ do{if (doMon)
           }
        monInfo.clID = clID;
 
-       if ((questDst = index(Job->Info.Dst, '?'))) *questDst = 0;
-       if (!XrdOfsOss->Stat(Job->Info.Dst, &Stat)) monInfo.fSize = Stat.st_size;
-       if (questDst) *questDst = '?';
+       if (Job->Info.xfrBytes > 0) monInfo.fSize = Job->Info.xfrBytes;
+          else {if ((questDst = index(Job->Info.Dst, '?'))) *questDst = 0;
+                if (!XrdOfsOss->Stat(Job->Info.Dst, &Stat))
+                   monInfo.fSize = Stat.st_size;
+                if (questDst) *questDst = '?';
+               }
        Cfg.tpcMon->Report(monInfo);
        if (questLfn) *questLfn = '?';
        if (questSrc) *questSrc = '?';
@@ -304,6 +345,16 @@ int XrdOfsTPCProg::Xeq(bool &isIPv4)
 // Determine checksum option
 //
    cksVal = (Job->Info.Cks ? Job->Info.Cks : Cfg.cksType);
+
+// Use the in-process engine if we have one. However, reproxied copies and
+// credentials handed over via anything but a proxy file need the program.
+//
+   if (Engine && !Job->Info.Rpx
+   &&  (!cFile.Path || !strcmp(Job->Info.Env, "X509_USER_PROXY")))
+      return Ended(XeqEngine(cksVal, cFile.Path, isIPv4));
+
+// Pass the checksum option to the program
+//
    if (cksVal)
       {Args[aNum++] = "-C";
        Args[aNum++] = cksVal;
@@ -390,15 +441,49 @@ int XrdOfsTPCProg::Xeq(bool &isIPv4)
 //
    if (rc && !(*eRec)) sprintf(eRec, "Copy failed with return code %d", rc);
 
-// Log failures and optionally remove the file (Info would do that as well
-// but much later on, so we do it now).
+// All done
 //
-   if (rc)
-      {OfsEroute.Emsg("TPC", Job->Info.Org, Job->Info.Lfn, eRec);
-       if (Cfg.autoRM) XrdOfsOss->Unlink(Job->Info.Lfn);
-      } else Job->Info.Success();
+   return Ended(rc);
+}
 
-// All done
+/******************************************************************************/
+/*                             X e q E n g i n e                              */
+/******************************************************************************/
+
+int XrdOfsTPCProg::XeqEngine(const char *cksVal, const char *crdPath,
+                             bool &isIPv4)
+{
+   EPNAME("XeqEngine");
+   XrdOfsTPCEngine::Xfr xfr;
+   const char *tident = Job->Info.Org;
+   int rc;
+
+// Describe the copy. Progress is reported straight into the job's info and
+// a cancel is seen by the engine via our stop flag.
 //
+   xfr.Src    = Job->Info.Key;
+   xfr.Dst    = Job->Info.Dst;
+   xfr.Cks    = cksVal;
+   xfr.Crd    = crdPath;
+   xfr.Tid    = tident;
+   xfr.Strm   = Job->Info.Str;
+   xfr.Stop   = &Stop;
+   xfr.Bytes  = &Job->Info.xfrBytes;
+   xfr.eBuff  = eRec;
+   xfr.eBlen  = sizeof(eRec);
+   xfr.isIPv4 = false;
+
+// Run the copy in this thread
+//
+   *eRec = 0;
+   rc = Engine->Copy(xfr);
+   isIPv4 = xfr.isIPv4;
+   DEBUG(Pname <<"ended with rc=" <<rc <<" after " <<Job->Info.xfrBytes.load()
+               <<" bytes");
+
+// Check if we should generate a message
+//
+   if (rc && !(*eRec)) sprintf(eRec, "Copy failed with return code %d", rc);
+   if (rc && Cfg.doEcho) OfsEroute.Say(Pname, eRec);
    return rc;
 }
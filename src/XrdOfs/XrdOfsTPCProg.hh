@@ -30,10 +30,13 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
+
 #include "XrdOuc/XrdOucProg.hh"
 #include "XrdOuc/XrdOucStream.hh"
 #include "XrdSys/XrdSysPthread.hh"
   
+class XrdOfsTPCEngine;
 class XrdOfsTPCJob;
 class XrdOucProg;
   
@@ -41,7 +44,7 @@ class XrdOfsTPCProg
 {
 public:
 
-       void      Cancel() {JobStream.Drain();}
+       void      Cancel() {Stop = true; JobStream.Drain();}
 
 static int       Init();
 
@@ -56,14 +59,19 @@ XrdOfsTPCProg   *Start(XrdOfsTPCJob *jP, int &rc);
 
                 ~XrdOfsTPCProg() {}
 private:
+       int            Ended(int rc);
        int            ExportCreds(const char *path);
-static XrdSysMutex    pgmMutex;
-static XrdOfsTPCProg *pgmIdle;
+       int            XeqEngine(const char *cksVal, const char *crdPath,
+                                bool &isIPv4);
+static XrdSysMutex      pgmMutex;
+static XrdOfsTPCProg   *pgmIdle;
+static XrdOfsTPCEngine *Engine;
 
        XrdOucProg     Prog;
        XrdOucStream   JobStream;
        XrdOfsTPCProg *Next;
        XrdOfsTPCJob  *Job;
+std::atomic<bool>     Stop;
        char           Pname[32];
        char           eRec[1024];
 };
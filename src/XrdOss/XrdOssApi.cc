@@ -67,6 +67,7 @@
 #include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
+#include "XrdSys/XrdSysHistogram.hh"
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPlugin.hh"
@@ -85,6 +86,18 @@ XrdSysError OssEroute(0, "oss_");
 
 XrdSysTrace OssTrace("oss");
 
+/******************************************************************************/
+/*                    L a t e n c y   H i s t o g r a m s                     */
+/******************************************************************************/
+
+namespace
+{
+XrdSysHistogram OssHistOpen("oss.open");
+XrdSysHistogram OssHistRead("oss.read");
+XrdSysHistogram OssHistReadV("oss.readv");
+XrdSysHistogram OssHistWrite("oss.write");
+}
+
 /******************************************************************************/
 /*           S t o r a g e   S y s t e m   I n s t a n t i a t o r            */
 /******************************************************************************/
@@ -819,6 +832,7 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
    int retc, mopts;
    char actual_path[MAXPATHLEN+1], *local_path;
    struct stat buf;
+   XrdSysHistogram::Timer ossTimer(&OssHistOpen);
 
 // Return an error if this object is already open
 //
@@ -974,6 +988,7 @@ ssize_t XrdOssFile::Read(off_t offset, size_t blen)
 ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 {
      ssize_t retval;
+     XrdSysHistogram::Timer ossTimer(&OssHistRead);
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
@@ -1010,6 +1025,7 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 {
    ssize_t rdsz, totBytes = 0;
    int i;
+   XrdSysHistogram::Timer ossTimer(&OssHistReadV);
 
 // For platforms that support fadvise, pre-advise what we will be reading
 //
@@ -1121,6 +1137,7 @@ ssize_t XrdOssFile::ReadRaw(void *buff, off_t offset, size_t blen)
 ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
 {
      ssize_t retval;
+     XrdSysHistogram::Timer ossTimer(&OssHistWrite);
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
@@ -112,6 +112,8 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
           * static_cast<long long>(fsbuff.FS_BLKSZ);
      frsz = static_cast<long long>(fsbuff.f_bavail)
           * static_cast<long long>(fsbuff.FS_BLKSZ);
+     sfree = frsz;
+     rsvd  = 0;
      XrdOssCache::fsTotal += size;
      XrdOssCache::fsTotFr += frsz;
      XrdOssCache::fsCount++;
@@ -136,6 +138,58 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
          devN = "dev";
         }
 }
+
+/******************************************************************************/
+
+// Refresh is called by the space scanner with the cache mutex held. Rather
+// than simply forgetting the outstanding reservations (the space statfs sees
+// lags well behind a burst of creates) we retire only as much of them as
+// statfs now reports as having been used. Whatever remains is halved so that
+// reservations for files that never grew to their estimate do not pin space.
+//
+void XrdOssCache_FSData::Refresh(long long newfree)
+{
+   long long used = sfree - newfree, held = rsvd.load(), left;
+
+// Compute how much of the reservation is kept. Reserve() and Release() may
+// run concurrently, so recompute it from whatever is held when we swap.
+//
+   if (used < 0) used = 0;
+   do {left = (held > used ? (held - used) - (held - used)/2 : 0);}
+      while(!rsvd.compare_exchange_weak(held, left));
+
+// Now record the new free space
+//
+   frsz  = newfree;
+   sfree = newfree;
+}
+
+/******************************************************************************/
+
+void XrdOssCache_FSData::Release(long long size)
+{
+   long long held = rsvd.load(), left;
+
+// Return a reservation that will not be used. Since Refresh() may have already
+// retired part of it, make sure we never go negative.
+//
+   do {left = (held > size ? held - size : 0);}
+      while(!rsvd.compare_exchange_weak(held, left));
+}
+
+/******************************************************************************/
+
+bool XrdOssCache_FSData::Reserve(long long size)
+{
+   long long held = rsvd.load();
+
+// Reserve the space but only if it is still available. Concurrent allocations
+// racing for the same partition will see each other's reservation here.
+//
+   do {if (frsz.load() - held < size) return false;}
+      while(!rsvd.compare_exchange_weak(held, held + size));
+   return true;
+}
   
 /******************************************************************************/
 /*            X r d O s s C a c h e _ F S   C o n s t r u c t o r             */
@@ -214,11 +268,17 @@ XrdOssCache_FS::XrdOssCache_FS(int &retc,
 //
    fsgroup = XrdOssCache_Group::fsgroups;
    while(fsgroup && strcmp(group, fsgroup->group)) fsgroup = fsgroup->next;
-   if (!fsgroup && (fsgroup = new XrdOssCache_Group(group, this)))
+   if (!fsgroup && (fsgroup = new XrdOssCache_Group(group)))
       {fsgroup->next = XrdOssCache_Group::fsgroups; 
        XrdOssCache_Group::fsgroups=fsgroup;
       }
 
+// Add this allocation path to the group's allocation vector
+//
+   n = (fsgroup->faNum + 1) * sizeof(XrdOssCache_FS *);
+   fsgroup->fsAlloc = (XrdOssCache_FS **)realloc((void *)fsgroup->fsAlloc, n);
+   fsgroup->fsAlloc[fsgroup->faNum++] = this;
+
 // Add a filesystem to this group but only if it is a new one
 //
    XrdOssCache_FSAP *fsAP;
@@ -408,7 +468,7 @@ void  XrdOssCache::Adjust(dev_t devid, off_t size)
 //
    Mutex.Lock();
    if (fsdp) 
-      {DEBUG("free=" <<fsdp->frsz <<'-' <<size <<" path=" <<fsdp->path);
+      {DEBUG("free=" <<fsdp->frsz.load() <<'-' <<size <<" path=" <<fsdp->path);
        if ((fsdp->frsz  -= size) < 0) fsdp->frsz = 0;
        fsdp->stat |= XrdOssFSData_ADJUSTED;
       } else {
@@ -475,7 +535,7 @@ void XrdOssCache::Adjust(XrdOssCache_FS *fsp, off_t size)
    if (fsp) 
       {fsdp = fsp->fsdata;
        DEBUG("used=" <<fsp->fsgroup->Usage <<'+' <<size <<" path=" <<fsp->path);
-       DEBUG("free=" <<fsdp->frsz <<'-' <<size <<" path=" <<fsdp->path);
+       DEBUG("free=" <<fsdp->frsz.load() <<'-' <<size <<" path=" <<fsdp->path);
        Mutex.Lock();
        if ((fsp->fsgroup->Usage += size) < 0) fsp->fsgroup->Usage = 0;
        if (        (fsdp->frsz  -= size) < 0) fsdp->frsz = 0;
@@ -493,13 +553,11 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
 {
    EPNAME("Alloc");
    static const mode_t theMode = S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH;
-   XrdSysMutexHelper myMutex(&Mutex);
-   double diffree;
    XrdOssPath::fnInfo Info;
-   XrdOssCache_FS *fsp, *fspend, *fsp_sel;
+   XrdOssCache_FS *fsp_sel;
    XrdOssCache_Group *cgp = 0;
-   long long size, maxfree, curfree;
-   int rc, madeDir, datfd = 0;
+   long long size;
+   int n, rc, madeDir, datfd = 0;
 
 // Compute appropriate allocation size
 //
@@ -507,39 +565,22 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
    ||  (size=aInfo.cgSize*ovhAlloc/100+aInfo.cgSize) < minAlloc)
       aInfo.cgSize = size = minAlloc;
 
-// Find the corresponding cache group
+// Find the corresponding cache group. Groups are only defined during
+// configuration so no lock is needed here.
 //
    cgp = XrdOssCache_Group::fsgroups;
    while(cgp && strcmp(aInfo.cgName, cgp->group)) cgp = cgp->next;
    if (!cgp) return -ENOENT;
 
-// Find a cache that will fit this allocation request. We start with the next
-// entry past the last one we selected and go full round looking for a
-// compatable entry (enough space and in the right space group).
-//
-   fsp_sel = 0; maxfree = 0;
-   fsp = cgp->curr->next; fspend = fsp; // End when we hit the start again
-   do {
-       if (strcmp(aInfo.cgName, fsp->group)
-       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
-                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
-       curfree = fsp->fsdata->frsz;
-       if (size > curfree) continue;
-
-             if (fuzAlloc > 0.999) {fsp_sel = fsp; break;}
-       else  if (!fuzAlloc || !fsp_sel)
-                {if (curfree > maxfree) {fsp_sel = fsp; maxfree = curfree;}}
-       else {diffree = (!(curfree + maxfree) ? 0.0
-                     : static_cast<double>(XRDABS(maxfree - curfree)) /
-                       static_cast<double>(       maxfree + curfree));
-             if (diffree > fuzAlloc) {fsp_sel = fsp; maxfree = curfree;}
-            }
-      } while((fsp = fsp->next) != fspend);
-
-// Check if we can realy fit this file. If so, update current scan pointer
+// Select a partition and reserve the space in it. The cache mutex is not
+// held; instead, the reservation fails should a concurrent allocation have
+// taken the space in the meantime and we simply select again.
 //
-   if (!fsp_sel) return -ENOSPC;
-   cgp->curr = fsp_sel;
+   for (n = 0; ; n++)
+       {if (n > cgp->faNum || !(fsp_sel = Select(cgp, aInfo, size)))
+           return -ENOSPC;
+        if (fsp_sel->fsdata->Reserve(size)) break;
+       }
 
 // Construct the target filename
 //
@@ -551,7 +592,7 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
 
 // Verify that target name was constructed
 //
-   if (!(*aInfo.cgPFbf)) return -ENAMETOOLONG;
+   if (!(*aInfo.cgPFbf)) {fsp_sel->fsdata->Release(size); return -ENAMETOOLONG;}
 
 // Simply open the file in the local filesystem, creating it if need be.
 //
@@ -563,15 +604,18 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
            *Info.Slash='\0'; rc=mkdir(aInfo.cgPFbf,theMode); *Info.Slash='/';
            madeDir = 1;
           } while(!rc);
-       if (datfd < 0) return (errno ? -errno : -EFAULT);
+       if (datfd < 0)
+          {rc = (errno ? -errno : -EFAULT);
+           fsp_sel->fsdata->Release(size);
+           return rc;
+          }
       }
 
-// All done (temporarily adjust down the free space)x
+// All done (the space stays reserved until statfs sees it used)
 //
-   DEBUG("free=" <<fsp_sel->fsdata->frsz <<'-' <<size <<" path=" 
+   DEBUG("free=" <<fsp_sel->fsdata->frsz.load() <<" rsvd="
+                 <<fsp_sel->fsdata->rsvd.load() <<" path="
                  <<fsp_sel->fsdata->path);
-   fsp_sel->fsdata->frsz -= size;
-   fsp_sel->fsdata->stat |= XrdOssFSData_REFRESH;
    aInfo.cgFSp  = fsp_sel;
    return datfd;
 }
@@ -880,11 +924,11 @@ void *XrdOssCache::Scan(int cscanint)
                      {frsz = XrdOssCache_FS::freeSpace(llT,fsdp->path);
                       if (frsz < 0) OssEroute.Emsg("CacheScan", errno ,
                                     "state file system ",(char *)fsdp->path);
-                         else {fsdp->frsz = frsz;
+                         else {fsdp->Refresh(frsz);
                                fsdp->stat &= ~(XrdOssFSData_REFRESH |
                                                XrdOssFSData_ADJUSTED);
                                if (dbgDoMsg)
-                                  {DEBUG("New free=" <<fsdp->frsz <<" path=" <<fsdp->path);}
+                                  {DEBUG("New free=" <<fsdp->frsz.load() <<" path=" <<fsdp->path);}
                                }
                      } else fsdp->stat |= XrdOssFSData_REFRESH;
                  if (!retc)
@@ -917,3 +961,84 @@ void *XrdOssCache::Scan(int cscanint)
 //
    return (void *)0;
 }
+
+/******************************************************************************/
+/*                                S e l e c t                                 */
+/******************************************************************************/
+
+namespace
+{
+// A cheap per-thread generator is all we need to pick candidates.
+//
+unsigned int Random()
+{
+   static std::atomic<unsigned long long> seed(0x9e3779b97f4a7c15ULL);
+   thread_local unsigned long long state = 0;
+
+   if (!state) state = (seed += 0x9e3779b97f4a7c15ULL) | 1;
+   state ^= state >> 12; state ^= state << 25; state ^= state >> 27;
+   return static_cast<unsigned int>((state * 0x2545f4914f6cdd1dULL) >> 32);
+}
+}
+
+// Select picks a partition in the space that can hold an allocation of the
+// given size. A fuzz of 100% is simple round-robin. Otherwise, we use the
+// power of two choices: two of the eligible partitions are picked at random
+// and the one with more space available wins unless the difference is within
+// the fuzz. Contrary to always taking the emptiest partition, a burst of
+// concurrent creates does not pile up on whatever partition last looked best.
+//
+XrdOssCache_FS *XrdOssCache::Select(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                                    long long size)
+{
+   XrdOssCache_FS *fsp, *fsp_one = 0, *fsp_two = 0;
+   long long free_one, free_two;
+   double diffree;
+   unsigned int i, k, start, nFS = static_cast<unsigned int>(cgp->faNum);
+   int eligible = 0;
+
+// Check if there is anything to pick from
+//
+   if (!nFS) return 0;
+
+// Round-robin starts at the next entry past the last one selected while the
+// random start just avoids favouring the first entries.
+//
+   if (fuzAlloc > 0.999) start = cgp->fsNext++;
+      else start = Random();
+
+// Look for eligible partitions, keeping a random sample of two of them
+//
+   for (i = 0; i < nFS; i++)
+       {fsp = cgp->fsAlloc[(start + i) % nFS];
+        if (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                         ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))
+           continue;
+        if (fsp->fsdata->Avail() < size) continue;
+        if (fuzAlloc > 0.999)
+           {cgp->fsNext = (start + i + 1) % nFS;
+            return fsp;
+           }
+        eligible++;
+             if (!fsp_one) fsp_one = fsp;
+        else if (!fsp_two) fsp_two = fsp;
+        else if ((k = Random() % eligible) < 2) (k ? fsp_two : fsp_one) = fsp;
+       }
+
+// If we have fewer than two choices there is nothing to compare
+//
+   if (!fsp_two) return fsp_one;
+
+// Pick the one with the most space unless the difference is in the fuzz
+//
+   free_one = fsp_one->fsdata->Avail();
+   free_two = fsp_two->fsdata->Avail();
+   if (free_one < 0) free_one = 0;
+   if (free_two < 0) free_two = 0;
+   if (fuzAlloc && free_one + free_two)
+      {diffree = static_cast<double>(XRDABS(free_one - free_two)) /
+                 static_cast<double>(       free_one + free_two);
+       if (diffree <= fuzAlloc) return fsp_one;
+      }
+   return (free_two > free_one ? fsp_two : fsp_one);
+}
@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <ctime>
 #include <sys/stat.h>
 #include "XrdOuc/XrdOucDLlist.hh"
@@ -109,7 +110,9 @@ public:
 
 XrdOssCache_FSData *next;
 long long           size;
-long long           frsz;
+std::atomic<long long> frsz; // Free space less adjustments since last statfs
+std::atomic<long long> rsvd; // Space reserved by Alloc() not yet seen in use
+long long           sfree;   // Free space reported by the last statfs
 dev_t               fsid;
 const char         *path;
 const char         *pact;
@@ -119,6 +122,17 @@ int                 stat;
 unsigned short      bdevID;
 unsigned short      partID;
 
+// Return the space that may still be allocated in this partition
+//
+long long           Avail() {return frsz.load(std::memory_order_relaxed)
+                                  - rsvd.load(std::memory_order_relaxed);}
+
+void                Refresh(long long newfree);
+
+void                Release(long long size);
+
+bool                Reserve(long long size);
+
        XrdOssCache_FSData(const char *, STATFS_t &, dev_t);
       ~XrdOssCache_FSData() {if (path) free((void *)path);}
 };
@@ -185,11 +199,13 @@ public:
 
 XrdOssCache_Group   *next;
 char                *group;
-XrdOssCache_FS      *curr;
+XrdOssCache_FS     **fsAlloc; // Allocation paths in this space
 XrdOssCache_FSAP    *fsVec; // Partitions where space may be allocated
+std::atomic<unsigned int> fsNext; // Round-robin cursor into fsAlloc
 long long            Usage;
 long long            Quota;
 int                  GRPid;
+int                  faNum;  // Number of entries in fsAlloc
 short                fsNum;
 short                rsvd;
 static
@@ -198,9 +214,10 @@ static long long     PubQuota;
 
 static XrdOssCache_Group *fsgroups;
 
-       XrdOssCache_Group(const char *grp, XrdOssCache_FS *fsp=0) 
-                        : next(0), group(strdup(grp)), curr(fsp), fsVec(0),
-                          Usage(0), Quota(-1), GRPid(-1), fsNum(0), rsvd(0)
+       XrdOssCache_Group(const char *grp)
+                        : next(0), group(strdup(grp)), fsAlloc(0), fsVec(0),
+                          fsNext(0), Usage(0), Quota(-1), GRPid(-1), faNum(0),
+                          fsNum(0), rsvd(0)
                         {if (!strcmp("public", grp)) PubGroup = this;}
       ~XrdOssCache_Group() {if (group) free((void *)group);}
 };
@@ -274,6 +291,9 @@ static int                 fsCount;  // Number of file systems
 private:
 static bool MapDM(const char *ldm, char *buff, int blen);
 
+static XrdOssCache_FS *Select(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                              long long size);
+
 static long long           minAlloc;
 static double              fuzAlloc;
 static int                 ovhAlloc;
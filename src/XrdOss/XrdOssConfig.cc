@@ -1188,7 +1188,8 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
                          free space amount (asterisk uses default).
              <fuzz>      the percentage difference between two free space
                          quantities that may be ignored when selecting a space
-                           0 - reduces to finding the largest free space
+                         from two partitions picked at random
+                           0 - reduces to taking the larger free space
                          100 - reduces to simple round-robin allocation
 
    Output: 0 upon success or !0 upon failure.
@@ -102,6 +102,17 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
        return fileSize;
       }
 
+// A sparse file (e.g. one only partially filled by a cache) is copied extent
+// by extent so that its holes are not allocated in the target.
+//
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+   if (buf.st_blocks*512 < fileSize
+   &&  (rc = Sparse(inFn, In.FD, outFn, Out.FD, fileSize)) <= 0)
+      {if (rc < 0) return rc;
+       copySize = 0;
+      }
+#endif
+
 // We now copy 1MB segments using direct I/O
 //
    ioSize = (fileSize < (off_t)segSize ? fileSize : segSize);
@@ -162,6 +173,55 @@ off_t XrdOssCopy::Copy(const char *inFn, const char *outFn, int outFD)
    return fileSize;
 }
 
+/******************************************************************************/
+/* private:                       S p a r s e                                 */
+/******************************************************************************/
+
+// Returns 0 upon success, 1 if the filesystem cannot tell where the data is,
+// and -errno upon failure.
+//
+int XrdOssCopy::Sparse(const char *inFn,  int inFD,
+                       const char *outFn, int outFD, off_t fileSize)
+{
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+   static const size_t segSize = 1024*1024;
+   char ioBuff[segSize];
+   off_t dBeg, dEnd = 0;
+   size_t ioSize;
+   ssize_t rLen;
+   int rc;
+
+// Copy each data extent, a seek for data past the last one fails with ENXIO
+//
+   while(dEnd < fileSize)
+        {if ((dBeg = lseek(inFD, dEnd, SEEK_DATA)) < 0)
+            {if (errno == ENXIO) break;
+             if (!dEnd && errno == EINVAL) return 1;
+             return -OssEroute.Emsg("Copy", errno, "seek data in", inFn);
+            }
+         if ((dEnd = lseek(inFD, dBeg, SEEK_HOLE)) < 0)
+            return -OssEroute.Emsg("Copy", errno, "seek hole in", inFn);
+         while(dBeg < dEnd)
+              {ioSize = (dEnd - dBeg < (off_t)segSize ? dEnd - dBeg : segSize);
+               do {rLen = pread(inFD, ioBuff, ioSize, dBeg);}
+                  while(rLen < 0 && errno == EINTR);
+               if (rLen <= 0) return -OssEroute.Emsg("Copy",
+                                    rLen ? errno : ECANCELED, "read", inFn);
+               if ((rc = Write(outFn, outFD, ioBuff, rLen, dBeg)) < 0) return rc;
+               dBeg += rLen;
+              }
+        }
+
+// A trailing hole only shows up in the size of the file
+//
+   if (ftruncate(outFD, fileSize))
+      return -OssEroute.Emsg("Copy", errno, "truncate", outFn);
+   return 0;
+#else
+   return 1;
+#endif
+}
+
 /******************************************************************************/
 /* private:                        W r i t e                                  */
 /******************************************************************************/
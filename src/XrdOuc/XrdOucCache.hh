@@ -98,7 +98,8 @@ virtual ~XrdOucCacheIOCD() {}
 
 struct XrdOucCacheOp
       {enum Code {QFinfo  = 0,  // Requires a file   target
-                  QFSinfo = 1   // Requires a global target
+                  QFSinfo = 1,  // Requires a global target
+                  QCgi    = 2   // Requires a file   target, cgi of the open
                  };
       };
   
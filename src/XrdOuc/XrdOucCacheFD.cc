@@ -0,0 +1,355 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c C a c h e F D . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#include "XrdOuc/XrdOucCacheFD.hh"
+#include "XrdSys/XrdSysFD.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+const char XrdOucCacheFD::magicID[8] = {'x','r','d','c','f','d','2','\0'};
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace
+{
+static const int ioTimeout = 5000; // Milliseconds a client waits for the cache
+
+int Wait(int sock, short events, int tmo)
+{
+   struct pollfd pfd = {sock, events, 0};
+   int rc;
+
+   do {rc = poll(&pfd, 1, tmo);} while(rc < 0 && errno == EINTR);
+   if (rc < 0) return -errno;
+   return (rc ? 0 : -ETIMEDOUT);
+}
+
+int ReadAll(int sock, void *buff, int blen, int tmo)
+{
+   char *bP = (char *)buff;
+   ssize_t n;
+   int rc;
+
+   while(blen > 0)
+        {if ((rc = Wait(sock, POLLIN, tmo))) return rc;
+         if ((n = read(sock, bP, blen)) <= 0)
+            {if (n < 0 && errno == EINTR) continue;
+             return (n ? -errno : -EPIPE);
+            }
+         bP += n; blen -= n;
+        }
+   return 0;
+}
+
+int WriteAll(int sock, const void *buff, int blen)
+{
+   const char *bP = (const char *)buff;
+   ssize_t n;
+   int rc;
+
+   while(blen > 0)
+        {if ((rc = Wait(sock, POLLOUT, ioTimeout))) return rc;
+         if ((n = send(sock, bP, blen, MSG_NOSIGNAL)) < 0)
+            {if (errno == EINTR) continue;
+             return -errno;
+            }
+         bP += n; blen -= n;
+        }
+   return 0;
+}
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOucCacheFD::~XrdOucCacheFD()
+{
+   if (theFD >= 0) close(theFD);
+}
+
+/******************************************************************************/
+/*                                C o v e r s                                 */
+/******************************************************************************/
+
+bool XrdOucCacheFD::Covers(long long offs, long long len) const
+{
+// Anything at or past the end of the file reads as zero bytes
+//
+   if (theFD < 0 || offs < 0 || len < 0) return false;
+   if (offs >= fSize || !len || blkMap.empty()) return true;
+
+// All of the blocks spanned by the range must be cached
+//
+   long long last = (len < fSize - offs ? offs + len : fSize) - 1;
+   for (long long blk = offs / bSize; blk <= last / bSize; blk++)
+       if (!(blkMap[blk >> 3] & (1 << (blk & 7)))) return false;
+   return true;
+}
+
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+
+int XrdOucCacheFD::Get(const char *sockPath, const char *path, const char *cap)
+{
+   struct sockaddr_un sAddr;
+   int sock, rc;
+
+// Validate the arguments
+//
+   if (theFD >= 0) return -EBUSY;
+   if (strlen(sockPath) >= sizeof(sAddr.sun_path)) return -ENAMETOOLONG;
+
+// Connect to the cache
+//
+   memset(&sAddr, 0, sizeof(sAddr));
+   sAddr.sun_family = AF_UNIX;
+   strcpy(sAddr.sun_path, sockPath);
+   if ((sock = XrdSysFD_Socket(AF_UNIX, SOCK_STREAM, 0)) < 0) return -errno;
+   if (connect(sock, (struct sockaddr *)&sAddr, sizeof(sAddr)))
+      {rc = -errno; close(sock); return rc;}
+
+// Do the exchange
+//
+   rc = Get(sock, path, cap);
+   close(sock);
+   return rc;
+}
+
+/******************************************************************************/
+
+int XrdOucCacheFD::Get(int sock, const char *path, const char *cap)
+{
+   Request  req;
+   Response rsp;
+   union {struct cmsghdr cmh;
+          char buff[CMSG_SPACE(sizeof(int))];
+         } cbuff;
+   struct iovec  iov = {(void *)&rsp, sizeof(rsp)};
+   struct msghdr msg;
+   struct cmsghdr *cmP;
+   int rc, pLen = strlen(path), fd = -1;
+   ssize_t n;
+
+// Validate the arguments
+//
+   if (theFD >= 0) return -EBUSY;
+   if (pLen >= maxPath) return -ENAMETOOLONG;
+   if (!pLen || !cap || (int)strlen(cap) != capSize) return -EINVAL;
+
+// Send the request
+//
+   memcpy(req.magic, magicID, sizeof(req.magic));
+   req.pathLen = pLen;
+   req.capLen  = capSize;
+   if ((rc = WriteAll(sock, &req, sizeof(req)))
+   ||  (rc = WriteAll(sock, path, pLen))
+   ||  (rc = WriteAll(sock, cap, capSize))) return rc;
+
+// Receive the response header which carries the descriptor, if any
+//
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov        = &iov;
+   msg.msg_iovlen     = 1;
+   msg.msg_control    = cbuff.buff;
+   msg.msg_controllen = sizeof(cbuff.buff);
+
+   if ((rc = Wait(sock, POLLIN, ioTimeout))) return rc;
+   do {n = recvmsg(sock, &msg, 0);} while(n < 0 && errno == EINTR);
+   if (n <= 0) return (n ? -errno : -EPIPE);
+
+   for (cmP = CMSG_FIRSTHDR(&msg); cmP; cmP = CMSG_NXTHDR(&msg, cmP))
+       if (cmP->cmsg_level == SOL_SOCKET && cmP->cmsg_type == SCM_RIGHTS)
+          {memcpy(&fd, CMSG_DATA(cmP), sizeof(int));
+           fcntl(fd, F_SETFD, FD_CLOEXEC);
+          }
+
+// Get the rest of the header and the block map
+//
+   if (n < (ssize_t)sizeof(rsp))
+      rc = ReadAll(sock, (char *)&rsp + n, sizeof(rsp) - n, ioTimeout);
+
+   if (!rc)
+      {     if (memcmp(rsp.magic, magicID, sizeof(rsp.magic))) rc = -EPROTO;
+       else if (rsp.rc) rc = (rsp.rc < 0 ? rsp.rc : -rsp.rc);
+       else if (fd < 0 || rsp.fileSize < 0 || rsp.mapLen < 0
+            ||  rsp.mapLen > maxMap || (rsp.mapLen && (rsp.blockSize <= 0
+            ||  (rsp.fileSize + rsp.blockSize - 1) / rsp.blockSize
+                > 8LL * rsp.mapLen))) rc = -EPROTO;
+       else if (rsp.mapLen)
+               {blkMap.resize(rsp.mapLen);
+                rc = ReadAll(sock, blkMap.data(), rsp.mapLen, ioTimeout);
+               }
+      }
+
+// Keep the descriptor only if all went well
+//
+   if (rc)
+      {if (fd >= 0) close(fd);
+       blkMap.clear();
+       return rc;
+      }
+
+   theFD = fd;
+   fSize = rsp.fileSize;
+   bSize = rsp.blockSize;
+   return 0;
+}
+
+/******************************************************************************/
+/*                                N e w C a p                                 */
+/******************************************************************************/
+
+int XrdOucCacheFD::NewCap(char *cap)
+{
+   static const char hv[] = "0123456789abcdef";
+   unsigned char rnd[capSize/2];
+   ssize_t n;
+   int fd, rc = 0;
+
+// The capability must not be guessable, so it comes from the kernel
+//
+   if ((fd = XrdSysFD_Open("/dev/urandom", O_RDONLY)) < 0) return -errno;
+   if ((n = read(fd, rnd, sizeof(rnd))) != (ssize_t)sizeof(rnd))
+      rc = (n < 0 ? -errno : -EIO);
+   close(fd);
+   if (rc) return rc;
+
+   for (int i = 0; i < (int)sizeof(rnd); i++)
+       {cap[2*i]   = hv[rnd[i] >> 4];
+        cap[2*i+1] = hv[rnd[i] & 0x0f];
+       }
+   cap[capSize] = 0;
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  R e c v                                   */
+/******************************************************************************/
+
+int XrdOucCacheFD::Recv(int sock, char *path, int plen, char *cap, int tmo)
+{
+   Request req;
+   int rc;
+
+// Get the request header and validate it
+//
+   if ((rc = ReadAll(sock, &req, sizeof(req), tmo))) return rc;
+   if (memcmp(req.magic, magicID, sizeof(req.magic))
+   ||  req.pathLen <= 0 || req.pathLen >= maxPath
+   ||  req.capLen != capSize) return -EPROTO;
+   if (req.pathLen >= plen) return -ENAMETOOLONG;
+
+// Get the path and the capability
+//
+   if ((rc = ReadAll(sock, path, req.pathLen, tmo))
+   ||  (rc = ReadAll(sock, cap,  capSize,     tmo))) return rc;
+   path[req.pathLen] = 0;
+   cap[capSize] = 0;
+   if ((int)strlen(path) != req.pathLen || (int)strlen(cap) != capSize)
+      return -EPROTO;
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+
+int XrdOucCacheFD::Send(int sock, int rc, int fd, long long fsize,
+                        long long bsize, const unsigned char *bmap, int mlen)
+{
+   Response rsp;
+   union {struct cmsghdr cmh;
+          char buff[CMSG_SPACE(sizeof(int))];
+         } cbuff;
+   struct iovec  iov[2];
+   struct msghdr msg;
+   ssize_t n;
+   int ioN = 1, tlen;
+
+// Construct the header
+//
+   memset(&rsp, 0, sizeof(rsp));
+   memcpy(rsp.magic, magicID, sizeof(rsp.magic));
+   if (rc || fd < 0)
+      {rsp.rc = (rc ? rc : -EBADF);
+       return WriteAll(sock, &rsp, sizeof(rsp));
+      }
+   if (!bmap) mlen = 0;
+   rsp.mapLen    = mlen;
+   rsp.fileSize  = fsize;
+   rsp.blockSize = bsize;
+
+// The descriptor rides along with the header, the map follows it
+//
+   iov[0].iov_base = (void *)&rsp; iov[0].iov_len = sizeof(rsp);
+   if (mlen) {iov[1].iov_base = (void *)bmap; iov[1].iov_len = mlen; ioN++;}
+   tlen = sizeof(rsp) + mlen;
+
+   memset(&msg, 0, sizeof(msg));
+   memset(&cbuff, 0, sizeof(cbuff));
+   msg.msg_iov        = iov;
+   msg.msg_iovlen     = ioN;
+   msg.msg_control    = cbuff.buff;
+   msg.msg_controllen = sizeof(cbuff.buff);
+
+   struct cmsghdr *cmP = CMSG_FIRSTHDR(&msg);
+   cmP->cmsg_level = SOL_SOCKET;
+   cmP->cmsg_type  = SCM_RIGHTS;
+   cmP->cmsg_len   = CMSG_LEN(sizeof(int));
+   memcpy(CMSG_DATA(cmP), &fd, sizeof(int));
+
+   if ((rc = Wait(sock, POLLOUT, ioTimeout))) return rc;
+   do {n = sendmsg(sock, &msg, MSG_NOSIGNAL);} while(n < 0 && errno == EINTR);
+   if (n < 0) return -errno;
+
+// Send whatever did not fit
+//
+   if (n < (ssize_t)sizeof(rsp))
+      {if ((rc = WriteAll(sock, (char *)&rsp + n, sizeof(rsp) - n))) return rc;
+       n = sizeof(rsp);
+      }
+   if (n < tlen) return WriteAll(sock, bmap + (n - sizeof(rsp)), tlen - n);
+   return 0;
+}
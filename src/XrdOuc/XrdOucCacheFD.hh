@@ -0,0 +1,162 @@
+#ifndef __XRDOUCCACHEFD_HH__
+#define __XRDOUCCACHEFD_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c C a c h e F D . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+/******************************************************************************/
+/*                         X r d O u c C a c h e F D                          */
+/******************************************************************************/
+
+// XrdOucCacheFD passes descriptors of cached files from a disk cache to
+// clients running on the same host. The cache listens on a Unix domain socket;
+// a client sends the path of a file it has open through the cache and gets
+// back a read-only descriptor of the cached data file together with a map of
+// the blocks that are in the cache. Reads of cached blocks can then be done
+// directly on the descriptor while the rest still goes through the network.
+// Being able to connect to the socket is not enough. The client makes up a
+// random capability (see NewCap()) and passes it as the pfc.fdcap cgi element
+// when opening the file through the cache, where the open is authorized as
+// usual. The request must carry the same capability, which the cache accepts
+// once and only while that open is active.
+
+class XrdOucCacheFD
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Client side: obtain a descriptor for a cached file.
+//!
+//! @param  sockPath  Path of the Unix domain socket of the cache.
+//! @param  path      Path of the file as known to the cache (no CGI).
+//! @param  cap       The capability used when opening the file.
+//!
+//! @return 0 upon success, -errno otherwise. ECONNREFUSED or ENOENT mean
+//!         that no cache is listening, EREMOTE that nothing of the file is
+//!         in the cache and EACCES that the capability was not accepted.
+//------------------------------------------------------------------------------
+
+int       Get(const char *sockPath, const char *path, const char *cap);
+
+//------------------------------------------------------------------------------
+//! Client side: same as above but over a connected socket, which is left open.
+//------------------------------------------------------------------------------
+
+int       Get(int sock, const char *path, const char *cap);
+
+//------------------------------------------------------------------------------
+//! Check whether a byte range can be read with the descriptor. Ranges that
+//! start at or past the end of the file are covered (the read returns 0).
+//------------------------------------------------------------------------------
+
+bool      Covers(long long offs, long long len) const;
+
+int       FD()       const {return theFD;}
+long long Size()     const {return fSize;}
+bool      Complete() const {return blkMap.empty();}
+
+//------------------------------------------------------------------------------
+//! Client side: make up a new capability.
+//!
+//! @param  cap   Buffer of capSize+1 bytes that receives the capability as a
+//!               null terminated string of hex digits.
+//!
+//! @return 0 upon success, -errno otherwise.
+//------------------------------------------------------------------------------
+
+static int NewCap(char *cap);
+
+//------------------------------------------------------------------------------
+//! Server side: read a request from an accepted connection.
+//!
+//! @param  sock  The connection.
+//! @param  path  Buffer for the path, it is null terminated on success.
+//! @param  plen  Size of the buffer.
+//! @param  cap   Buffer of capSize+1 bytes for the capability, it is null
+//!               terminated on success.
+//! @param  tmo   Milliseconds to wait for the request.
+//!
+//! @return 0 upon success, -errno otherwise.
+//------------------------------------------------------------------------------
+
+static int Recv(int sock, char *path, int plen, char *cap, int tmo=1000);
+
+//------------------------------------------------------------------------------
+//! Server side: send the response to a request.
+//!
+//! @param  sock   The connection.
+//! @param  rc     0 when a descriptor is passed, -errno otherwise in which
+//!                case the remaining arguments are ignored.
+//! @param  fd     The descriptor, it remains open on our side.
+//! @param  fsize  The size of the file.
+//! @param  bsize  The size of the blocks in the map.
+//! @param  bmap   Block map, bit (i % 8) of byte (i / 8) set for block i
+//!                being cached. A null pointer means all blocks are cached.
+//! @param  mlen   Number of bytes in the map.
+//!
+//! @return 0 upon success, -errno otherwise.
+//------------------------------------------------------------------------------
+
+static int Send(int sock, int rc, int fd=-1, long long fsize=0,
+                long long bsize=0, const unsigned char *bmap=0, int mlen=0);
+
+static const int maxPath = 4096;
+static const int maxMap  = 16*1024*1024;
+static const int capSize = 32;
+
+           XrdOucCacheFD() : theFD(-1), fSize(0), bSize(0) {}
+          ~XrdOucCacheFD();
+
+private:
+
+struct Request
+      {char    magic[8];
+       int32_t pathLen;
+       int32_t capLen;
+      };
+
+struct Response
+      {char    magic[8];
+       int32_t rc;
+       int32_t mapLen;
+       int64_t fileSize;
+       int64_t blockSize;
+      };
+
+static const char magicID[8];
+
+std::vector<unsigned char> blkMap; // Empty when the whole file is cached
+int                        theFD;
+long long                  fSize;
+long long                  bSize;
+};
+#endif
@@ -0,0 +1,309 @@
+#ifndef __XRDOUCFLATHASH_HH__
+#define __XRDOUCFLATHASH_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O u c F l a t H a s h . h h                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                        X r d O u c F l a t H a s h                         */
+/******************************************************************************/
+
+// XrdOucFlatHash is a drop-in replacement for XrdOucHash (same methods, same
+// options, same ownership and lifetime rules) that uses open addressing. The
+// entries live in one flat array next to an array of one byte tags, 16 tags
+// per group. A lookup hashes the key once and then compares a whole group of
+// tags at a time (with SSE2 when available), so that most misses and hits
+// touch a single cache line of tags and only compare keys whose tag matches.
+// Adding an entry allocates nothing but the copy of the key.
+//
+// Like XrdOucHash, the table is not thread safe. Find() only modifies the
+// table when it finds an expired entry, so a table filled once and then only
+// searched may be shared by many threads. Use XrdOucShardedHash (below) when
+// the table is updated concurrently.
+//
+template<class T>
+class XrdOucFlatHash
+{
+public:
+
+// Add() adds a new item to the hash. If it exists and repl = 0 then the old
+//       entry is returned and the new data is not added. Otherwise the current
+//       entry is replaced and 0 is returned. See XrdOucHash::Add() for the
+//       meaning of the LifeTime and the options.
+//
+T           *Add(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default)
+                {return Add(HashVal(KeyVal), KeyVal, KeyData, LifeTime, opt);}
+
+// Del() deletes the item from the hash. If it doesn't exist, it returns
+//       -ENOENT. Otherwise 0 is returned. If the item was added with the
+//       Hash_count option it is only deleted when the entry count drops below 0.
+//
+int          Del(const char *KeyVal, XrdOucHash_Options=Hash_default)
+                {return Del(HashVal(KeyVal), KeyVal);}
+
+// Find() looks up an entry in the table. It optionally returns the time
+//        at which the entry expires (0 if it never does). Expired entries
+//        are removed and not returned.
+//
+T           *Find(const char *KeyVal, time_t *KeyTime=0)
+                 {return Find(HashVal(KeyVal), KeyVal, KeyTime);}
+
+// Num() returns the number of items in the hash table
+//
+int          Num() {return hashnum;}
+
+// Purge() deletes all of the items in the table.
+//
+void         Purge();
+
+// Rep() is simply Add() that allows replacement.
+//
+T           *Rep(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default)
+                {return Add(KeyVal, KeyData, LifeTime,
+                            (XrdOucHash_Options)(opt | Hash_replace));}
+
+// Apply() applies the specified function to every item in the hash exactly
+//         as XrdOucHash::Apply() does:
+//         <0 - The hash table item is deleted.
+//         =0 - The next hash table item is processed.
+//         >0 - Processing stops and the hash table item is returned.
+//
+T           *Apply(int (*func)(const char *, T *, void *), void *Arg);
+
+// HashVal() returns the hash value used to place a key. The key is consumed
+//           a word at a time (the last word overlapping the previous one) and
+//           the result is mixed so that all of its bits depend on every byte
+//           of the key, as the table uses both ends.
+//
+static
+uint64_t     HashVal(const char *KeyVal)
+                    {const uint64_t k = 0x9e3779b97f4a7c15ULL;
+                     size_t   klen = strlen(KeyVal);
+                     uint64_t h = klen * k, w = 0;
+                     if (klen >= sizeof(w))
+                        {const char *kEnd = KeyVal + klen - sizeof(w);
+                         for (; KeyVal < kEnd; KeyVal += sizeof(w))
+                             {memcpy(&w, KeyVal, sizeof(w));
+                              h = ((h << 5 | h >> 59) ^ w) * k;
+                             }
+                         memcpy(&w, kEnd, sizeof(w));
+                        } else {
+                         for (size_t i = 0; i < klen; i++)
+                             w |= uint64_t(static_cast<unsigned char>(KeyVal[i])) << 8*i;
+                        }
+                     h = ((h << 5 | h >> 59) ^ w) * k;
+                     h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+                     h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+                     h ^= h >> 33;
+                     return h;
+                    }
+
+// The table starts with room for at least size items and is doubled whenever
+// it becomes more than load percent full (load is capped at 7/8).
+//
+     XrdOucFlatHash(int size=64, int load=80);
+    ~XrdOucFlatHash() {Purge(); free(ctrl);}
+
+private:
+template<class> friend class XrdOucShardedHash;
+
+static const int GrpSize = 16;
+
+// Tag values. A used slot holds the low 7 bits of the hash (top bit clear).
+//
+static const int8_t tagEmpty = -128;
+static const int8_t tagDead  = -2;
+
+struct Slot
+      {uint64_t           keyhash;
+       const char        *keyval;
+       T                 *keydata;
+       time_t             keytime;
+       int                keycount;
+       XrdOucHash_Options entopts;
+      };
+
+T        *Add(uint64_t khash, const char *KeyVal, T *KeyData,
+              const int LifeTime, XrdOucHash_Options opt);
+int       Del(uint64_t khash, const char *KeyVal);
+T        *Find(uint64_t khash, const char *KeyVal, time_t *KeyTime);
+
+int       Locate(uint64_t khash, const char *KeyVal);
+int       FreeSlot(uint64_t khash);
+void      Release(Slot &slot);
+void      Remove(int ent);
+void      Resize(int newsize);
+bool      Setup(int newsize);
+
+static
+uint32_t  Match(const int8_t *grp, int8_t tag);
+static
+uint32_t  MatchFree(const int8_t *grp);
+
+int8_t   *ctrl;          // Tags, one per slot
+Slot     *slots;         // The items, in the same memory block as the tags
+int       hashtablesize; // Number of slots (a power of 2)
+int       hashnum;       // Number of items
+int       hashdead;      // Number of deleted slots still tagged as such
+int       hashmax;       // Maximum number of used and deleted slots
+int       hashload;
+};
+
+/******************************************************************************/
+/*                     X r d O u c S h a r d e d H a s h                      */
+/******************************************************************************/
+
+// XrdOucShardedHash is a thread safe XrdOucFlatHash. Items are spread over a
+// number of independently locked tables selected by the hash of the key, so
+// that threads working on different keys rarely contend. It offers the same
+// methods as XrdOucFlatHash, each executed under the lock of its table.
+//
+// Note that a pointer returned by Find() or Add() is only protected by the
+// lock while the call runs. When the item may be deleted by another thread,
+// or when a lookup and an update must be atomic, use a Ref which keeps the
+// table holding a key locked for as long as it exists:
+//
+//     {XrdOucShardedHash<T>::Ref tab(hash, key);
+//      if (!(item = tab->Find(key))) tab->Add(key, item = new T);
+//      ... use item ...
+//     }
+//
+template<class T>
+class XrdOucShardedHash
+{
+struct Shard;
+public:
+
+class Ref
+{
+public:
+XrdOucFlatHash<T> *operator->() {return &sP->table;}
+
+      Ref(XrdOucShardedHash<T> &hash, const char *KeyVal)
+         : sP(&hash.GetShard(XrdOucFlatHash<T>::HashVal(KeyVal)))
+         {sP->mtx.Lock();}
+     ~Ref() {sP->mtx.UnLock();}
+
+private:
+      Ref(const Ref &) = delete;
+Ref &operator=(const Ref &) = delete;
+Shard *sP;
+};
+
+T    *Add(const char *KeyVal, T *KeyData, const int LifeTime=0,
+          XrdOucHash_Options opt=Hash_default)
+         {uint64_t khash = XrdOucFlatHash<T>::HashVal(KeyVal);
+          Shard &shard = GetShard(khash);
+          XrdSysMutexHelper mHelp(shard.mtx);
+          return shard.table.Add(khash, KeyVal, KeyData, LifeTime, opt);
+         }
+
+int   Del(const char *KeyVal, XrdOucHash_Options=Hash_default)
+         {uint64_t khash = XrdOucFlatHash<T>::HashVal(KeyVal);
+          Shard &shard = GetShard(khash);
+          XrdSysMutexHelper mHelp(shard.mtx);
+          return shard.table.Del(khash, KeyVal);
+         }
+
+T    *Find(const char *KeyVal, time_t *KeyTime=0)
+          {uint64_t khash = XrdOucFlatHash<T>::HashVal(KeyVal);
+           Shard &shard = GetShard(khash);
+           XrdSysMutexHelper mHelp(shard.mtx);
+           return shard.table.Find(khash, KeyVal, KeyTime);
+          }
+
+int   Num() {int n = 0;
+             for (int i = 0; i < numShards; i++)
+                 {XrdSysMutexHelper mHelp(shards[i].mtx);
+                  n += shards[i].table.Num();
+                 }
+             return n;
+            }
+
+void  Purge() {for (int i = 0; i < numShards; i++)
+                   {XrdSysMutexHelper mHelp(shards[i].mtx);
+                    shards[i].table.Purge();
+                   }
+              }
+
+T    *Rep(const char *KeyVal, T *KeyData, const int LifeTime=0,
+          XrdOucHash_Options opt=Hash_default)
+         {return Add(KeyVal, KeyData, LifeTime,
+                     (XrdOucHash_Options)(opt | Hash_replace));}
+
+// Apply() applies the function to each table in turn, holding its lock.
+//
+T    *Apply(int (*func)(const char *, T *, void *), void *Arg)
+           {T *item;
+            for (int i = 0; i < numShards; i++)
+                {XrdSysMutexHelper mHelp(shards[i].mtx);
+                 if ((item = shards[i].table.Apply(func, Arg))) return item;
+                }
+            return (T *)0;
+           }
+
+// The number of shards is rounded up to a power of 2 (at most 64), size is
+// the initial size of each of them.
+//
+      XrdOucShardedHash(int nshards=16, int size=64, int load=80);
+     ~XrdOucShardedHash();
+
+private:
+
+struct alignas(64) Shard
+      {XrdSysMutex       mtx;
+       XrdOucFlatHash<T> table;
+       Shard(int size, int load) : table(size, load) {}
+      };
+
+// The shard is selected by the top bits of the hash; the tables use the
+// bottom ones.
+//
+Shard &GetShard(uint64_t khash) {return shards[(khash >> 58) & (numShards-1)];}
+
+Shard *shards;
+int    numShards;
+};
+
+/******************************************************************************/
+/*                 A c t u a l   I m p l e m e n t a t i o n                  */
+/******************************************************************************/
+
+#include "XrdOuc/XrdOucFlatHash.icc"
+#endif
@@ -46,7 +46,7 @@ static inline bool is_subdirectory(const std::string& dir,
 }
 
 /**
- * Obfuscates strings containing "authz=value", "Authorization: value",
+ * Obfuscates strings containing "authz=value", "pfc.fdcap=value", "Authorization: value",
  * "TransferHeaderAuthorization: value", "WhateverAuthorization: value"
  * in a case insensitive way.
  *
@@ -322,6 +322,7 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
              preread   [minpages [minrdsz]] [perf nn [recalc]]
              r/w       enables caching for files opened read/write.
              sfiles    {on | off | .<sfx>}
+             shards    number of independent cache shards (default 1).
              size      size of cache in bytes  (can be suffixed with k, m, g).
 
    Output: true upon success or false upon failure.
@@ -329,7 +330,7 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
 
 bool XrdOucPsx::ParseCache(XrdSysError *Eroute, XrdOucStream &Config)
 {
-   long long llVal, cSize=-1, m2Cache=-1, pSize=-1, minPg = -1;
+   long long llVal, cSize=-1, m2Cache=-1, pSize=-1, minPg = -1, nShards = -1;
    const char *ivN = 0;
    char  *val, *sfSfx = 0, sfVal = '0', lgVal = '0', dbVal = '0', rwVal = '0';
    char eBuff[2048], pBuff[1024], *eP;
@@ -337,6 +338,7 @@ bool XrdOucPsx::ParseCache(XrdSysError *Eroute, XrdOucStream &Config)
                {{"max2cache", &m2Cache},
                 {"minpages",  &minPg},
                 {"pagesize",  &pSize},
+                {"shards",    &nShards},
                 {"size",      &cSize}
                };
    int i, numopts = sizeof(szopts)/sizeof(struct sztab);
@@ -402,6 +404,7 @@ do{for (i = 0; i < numopts; i++) if (!strcmp(szopts[i].Key, val)) break;
        eP += sprintf(eP, "&minpages=%lld", minPg);
       }
    if (pSize > 0)    eP += sprintf(eP, "&pagesz=%lld", pSize);
+   if (nShards > 1)  eP += sprintf(eP, "&shards=%lld", nShards);
    if (lgVal != '0') strcat(eP, "&optlg=1");
    if (sfVal != '0' || sfSfx)
       {if (!sfSfx)   strcat(eP, "&optsf=1");
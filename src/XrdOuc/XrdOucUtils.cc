@@ -1581,8 +1581,9 @@ static bool is_token_character(int c)
 }
 
 /**
- * This function obfuscates away authz= cgi elements and/or HTTP authorization
- * headers from URL or other log line strings which might contain them.
+ * This function obfuscates away authz= and pfc.fdcap= cgi elements and/or HTTP
+ * authorization headers from URL or other log line strings which might contain
+ * them.
  *
  * @param input the string to obfuscate
  * @return the string with token values obfuscated
@@ -1592,7 +1593,7 @@ std::string obfuscateAuth(const std::string& input)
 {
   static const regex_t auth_regex = []() {
     constexpr char re[] =
-      "(authz=|(transferheader)?(www-|proxy-)?auth(orization|enticate)[[:space:]]*:[[:space:]]*)"
+      "(authz=|pfc\\.fdcap=|(transferheader)?(www-|proxy-)?auth(orization|enticate)[[:space:]]*:[[:space:]]*)"
       "(Bearer([[:space:]]|%20)?(token([[:space:]]|%20)?)?)?";
 
     regex_t regex;
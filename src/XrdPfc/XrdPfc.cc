@@ -29,7 +29,11 @@
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdOuc/XrdOucPrivateUtils.hh"
 #include "XrdOuc/XrdOucJson.hh"
+#include "XrdOuc/XrdOucCacheFD.hh"
 
+#include "XrdNet/XrdNetSocket.hh"
+
+#include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdSys/XrdSysTrace.hh"
 #include "XrdSys/XrdSysXAttr.hh"
@@ -73,6 +77,12 @@ void *PrefetchThread(void*)
    return 0;
 }
 
+void *LocalAccessThread(void*)
+{
+   Cache::GetInstance().LocalAccess();
+   return 0;
+}
+
 //==============================================================================
 
 extern "C"
@@ -115,6 +125,11 @@ XrdOucCache *XrdOucGetCache(XrdSysLogger *logger,
       {
          XrdSysThread::Run(&tid, PrefetchThread, 0, 0, "XrdPfc Prefetch ");
       }
+
+      if ( ! instance.RefConfiguration().m_local_access_path.empty())
+      {
+         XrdSysThread::Run(&tid, LocalAccessThread, 0, 0, "XrdPfc LocalAccess");
+      }
    }
 
    XrdPfcFSctl* pfcFSctl = new XrdPfcFSctl(instance, logger);
@@ -167,6 +182,7 @@ Cache::Cache(XrdSysLogger *logger, XrdOucEnv *env) :
    m_traceID("Cache"),
    m_oss(0),
    m_gstream(0),
+   m_local_sock(0),
    m_purge_pin(0),
    m_prefetch_condVar(0),
    m_prefetch_enabled(false),
@@ -212,6 +228,8 @@ XrdOucCacheIO *Cache::Attach(XrdOucCacheIO *io, int Options)
          }
 
          cio = iof;
+
+         if (m_local_sock) RegisterLocalCap(cio);
       }
 
       TRACE_PC(Debug, const char* loc = io->Location(), tpfx << io->Path() << " location: " <<
@@ -281,6 +299,7 @@ void Cache::RemoveWriteQEntriesFor(File *file)
 void Cache::ProcessWriteTasks()
 {
    std::vector<Block*> blks_to_write(m_configuration.m_wqueue_blocks);
+   std::vector<Block*> blks_of_file;
 
    while (true)
    {
@@ -316,11 +335,20 @@ void Cache::ProcessWriteTasks()
          m_RAM_write_queue -= sum_size;
       }
 
-      for (int bi = 0; bi < n_pushed; ++bi)
+      // Blocks of the same file are written together and in file order.
+      std::sort(blks_to_write.begin(), blks_to_write.begin() + n_pushed,
+                [](const Block *a, const Block *b)
+                { return a->m_file != b->m_file ? a->m_file < b->m_file : a->m_offset < b->m_offset; });
+
+      for (int bi = 0; bi < n_pushed; )
       {
-         Block* block = blks_to_write[bi];
+         File *file = blks_to_write[bi]->m_file;
+
+         blks_of_file.clear();
+         while (bi < n_pushed && blks_to_write[bi]->m_file == file)
+            blks_of_file.push_back(blks_to_write[bi++]);
 
-         block->m_file->WriteBlockToDisk(block);
+         file->WriteBlocksToDisk(blks_of_file);
       }
    }
 }
@@ -488,6 +516,14 @@ void Cache::ReleaseFile(File* f, IO* io)
 
      f->RemoveIO(io);
    }
+   if ( ! io->m_local_cap.empty())
+   {
+      XrdSysMutexHelper lock(&m_local_caps_mutex);
+
+      auto it = m_local_caps.find(io->m_local_cap);
+      if (it != m_local_caps.end() && it->second.second == io)
+         m_local_caps.erase(it);
+   }
    dec_ref_cnt(f, true);
 }
 
@@ -914,6 +950,198 @@ int Cache::LocalFilePath(const char *curl, char *buff, int blen,
    return -ENOENT;
 }
 
+//______________________________________________________________________________
+// A local client proves that it opened a file through us, and that the open
+// was authorized, by passing a random capability as pfc.fdcap on the open and
+// again in its request for the descriptor.
+//------------------------------------------------------------------------------
+void Cache::RegisterLocalCap(IO *io)
+{
+   // The cgi is usually stripped from the path the cache sees, ask for it.
+   std::string cgi;
+   if (io->GetInput()->Fcntl(XrdOucCacheOp::QCgi, "", cgi) != 0 || cgi.empty()) return;
+
+   XrdOucEnv   env(cgi.c_str(), cgi.size());
+   const char *cap = env.Get("pfc.fdcap");
+   if ( ! cap) return;
+
+   std::string f_name = XrdCl::URL(io->Path()).GetPath();
+   if (f_name.empty() || f_name[0] != '/') f_name.insert(0, 1, '/');
+
+   if (strlen(cap) != (size_t) XrdOucCacheFD::capSize)
+   {
+      TRACE(Debug, "RegisterLocalCap malformed capability for " << f_name);
+      return;
+   }
+
+   XrdSysMutexHelper lock(&m_local_caps_mutex);
+
+   // A capability already in use was not made up by the client that sent it.
+   if (m_local_caps.find(cap) != m_local_caps.end()) return;
+
+   m_local_caps.insert(std::make_pair(std::string(cap), std::make_pair(f_name, io)));
+   io->m_local_cap = cap;
+}
+
+bool Cache::ClaimLocalCap(const std::string &cap, const std::string &f_name)
+{
+   XrdSysMutexHelper lock(&m_local_caps_mutex);
+
+   auto it = m_local_caps.find(cap);
+   if (it == m_local_caps.end() || it->second.first != f_name) return false;
+
+   m_local_caps.erase(it);
+   return true;
+}
+
+//______________________________________________________________________________
+// Local clients (see pfc.localaccess) get a descriptor of the data file
+// instead of its path so that neither the file nor the directories leading to
+// it need to be readable by them. The block map is taken from the cinfo file
+// on disk; blocks that were written since its last sync are reported missing
+// and are read by the client through the proxy.
+//------------------------------------------------------------------------------
+int Cache::LocalFileFD(const std::string &f_name, int &fd, long long &file_size,
+                       long long &block_size, std::vector<unsigned char> &block_map)
+{
+   static const char *trc_pfx = "LocalFileFD ";
+
+   fd = -1;
+   block_map.clear();
+
+   // Only plain absolute paths within the cache namespace.
+   if (f_name[0] != '/' || f_name.find("/../") != std::string::npos ||
+       (f_name.size() >= 3 && f_name.compare(f_name.size() - 3, 3, "/..") == 0))
+   {
+      return -EINVAL;
+   }
+
+   const std::string i_name = f_name + Info::s_infoExtension;
+   XrdOucEnv myEnv;
+
+   XrdOssDF *infoFile = m_oss->newFile(m_configuration.m_username.c_str());
+   int res = infoFile->Open(i_name.c_str(), O_RDONLY, 0600, myEnv);
+   if (res < 0)
+   {
+      delete infoFile;
+      TRACE(Debug, trc_pfx << f_name << " -> ENOENT");
+      return -ENOENT;
+   }
+
+   Info info(m_trace, 0);
+   bool read_ok = info.Read(infoFile, i_name.c_str());
+   infoFile->Close();
+   delete infoFile;
+
+   if ( ! read_ok)
+   {
+      return -EREMOTE;
+   }
+
+   file_size  = info.GetFileSize();
+   block_size = info.GetBufferSize();
+
+   if ( ! info.IsComplete())
+   {
+      const int n_blocks = info.GetNBlocks();
+      int       n_cached = 0;
+
+      block_map.assign((n_blocks + 7) / 8, 0);
+      for (int i = 0; i < n_blocks; ++i)
+      {
+         if (info.TestBitWritten(i))
+         {
+            block_map[i >> 3] |= 1 << (i & 7);
+            ++n_cached;
+         }
+      }
+      if (n_cached == 0)
+      {
+         block_map.clear();
+         TRACE(Debug, trc_pfx << f_name << " -> EREMOTE");
+         return -EREMOTE;
+      }
+   }
+
+   XrdOssDF *dataFile = m_oss->newFile(m_configuration.m_username.c_str());
+   if ((res = dataFile->Open(f_name.c_str(), O_RDONLY, 0600, myEnv)) < 0)
+   {
+      delete dataFile;
+      block_map.clear();
+      return res;
+   }
+   // The oss keeps its own descriptor, the client gets a copy of it.
+   if (dataFile->getFD() < 0 || (fd = XrdSysFD_Dup(dataFile->getFD())) < 0)
+   {
+      res = dataFile->getFD() < 0 ? -ENOTSUP : -errno;
+   }
+   dataFile->Close();
+   delete dataFile;
+
+   if (fd < 0)
+   {
+      block_map.clear();
+      return res;
+   }
+
+   TRACE(Debug, trc_pfx << f_name << (block_map.empty() ? " -> FILE_COMPLETE_IN_CACHE" : " -> PARTIAL"));
+   return 0;
+}
+
+//______________________________________________________________________________
+// Serve local clients one at a time, each request is a stat and two opens.
+//------------------------------------------------------------------------------
+void Cache::LocalAccess()
+{
+   static const char *trc_pfx = "LocalAccess ";
+
+   char path[XrdOucCacheFD::maxPath];
+   char cap[XrdOucCacheFD::capSize + 1];
+   std::vector<unsigned char> block_map;
+
+   TRACE(Info, trc_pfx << "serving local clients on " << m_configuration.m_local_access_path);
+
+   while (true)
+   {
+      int sock = m_local_sock->Accept();
+      if (sock < 0)
+      {
+         if (m_local_sock->LastError())
+         {
+            TRACE(Warning, trc_pfx << "accept failed " << ERRNO_AND_ERRSTR(m_local_sock->LastError()));
+            XrdSysTimer::Wait(100);
+         }
+         continue;
+      }
+
+      int rc = XrdOucCacheFD::Recv(sock, path, sizeof(path), cap);
+      if (rc == 0)
+      {
+         int       fd = -1;
+         long long file_size = 0, block_size = 0;
+
+         if (ClaimLocalCap(cap, path))
+         {
+            rc = LocalFileFD(path, fd, file_size, block_size, block_map);
+         }
+         else
+         {
+            TRACE(Info, trc_pfx << "no active open with the given capability for " << path);
+            rc = -EACCES;
+         }
+
+         rc = XrdOucCacheFD::Send(sock, rc, fd, file_size, block_size,
+                                  block_map.empty() ? 0 : block_map.data(), block_map.size());
+         if (fd >= 0) close(fd);
+      }
+      if (rc != 0 && rc != -ENOENT && rc != -EREMOTE)
+      {
+         TRACE(Debug, trc_pfx << "request failed " << ERRNO_AND_ERRSTR(-rc));
+      }
+      close(sock);
+   }
+}
+
 //______________________________________________________________________________
 // If supported, write Cache-Control as xattr to cinfo file.
 // One can use file descriptor or full path interchangeably
@@ -1326,6 +1554,37 @@ int Cache::UnlinkFile(const std::string& f_name, bool fail_if_open)
    return std::min(f_ret, i_ret);
 }
 
+int Cache::RelocateFile(const std::string& f_name, const std::string& space)
+{
+   static const char* trc_pfx = "RelocateFile ";
+   ActiveMap_i it;
+   {
+      XrdSysCondVarHelper lock(&m_active_cond);
+
+      if (m_active.find(f_name) != m_active.end() ||
+          m_purge_delay_set.find(f_name) != m_purge_delay_set.end())
+      {
+         TRACE(Debug, trc_pfx << f_name << ", file is active or purge-protected - skipping");
+         return -EBUSY;
+      }
+
+      // As in UnlinkFile(), a null File* makes GetFile() wait for us.
+      it = m_active.insert(std::make_pair(f_name, (File*) 0)).first;
+   }
+
+   int ret = m_oss->Reloc(m_configuration.m_username.c_str(), f_name.c_str(), space.c_str());
+
+   TRACE(Debug, trc_pfx << f_name << " to space " << space << ", ret=" << ret);
+
+   {
+      XrdSysCondVarHelper lock(&m_active_cond);
+      m_active.erase(it);
+      m_active_cond.Broadcast();
+   }
+
+   return ret;
+}
+
 //---------------------------------------------------------------------
 //! Test validity of http cache.
 //! Compare FS query results with cinfo xattr.
@@ -33,6 +33,7 @@
 #include "XrdPfcFile.hh"
 #include "XrdPfcDecision.hh"
 
+class XrdNetSocket;
 class XrdOss;
 class XrdOucStream;
 class XrdSysError;
@@ -71,6 +72,8 @@ struct Configuration
    bool is_uvkeep_purge_in_effect()    const { return m_cs_UVKeep >= 0; }
    bool is_dir_stat_reporting_on()     const { return m_dirStatsStoreDepth >= 0 || ! m_dirStatsDirs.empty() || ! m_dirStatsDirGlobs.empty(); }
    bool is_purge_plugin_set_up()       const { return false; }
+   bool is_fast_tier_set()             const { return ! m_fast_space.empty(); }
+   bool is_promotion_on()              const { return is_fast_tier_set() && m_promoteMinAccesses > 0; }
 
    CkSumCheck_e get_cs_Chk() const { return (CkSumCheck_e) m_cs_Chk; }
 
@@ -90,6 +93,7 @@ struct Configuration
    std::string m_username;              //!< username passed to oss plugin
    std::string m_data_space;            //!< oss space for data files
    std::string m_meta_space;            //!< oss space for metadata files (cinfo)
+   std::string m_fast_space;            //!< oss space of the fast tier in front of the data space, empty if none
 
    long long m_diskTotalSpace;          //!< total disk space on configured partition or oss space
    long long m_diskUsageLWM;            //!< cache purge - disk usage low water mark
@@ -102,6 +106,11 @@ struct Configuration
    int       m_purgeAgeBasedPeriod;     //!< peform cold file / uvkeep purge every this many purge cycles
    int       m_accHistorySize;          //!< max number of entries in access history part of cinfo file
 
+   long long m_fastUsageLWM;            //!< fast tier - demote down to this usage
+   long long m_fastUsageHWM;            //!< fast tier - demote when usage exceeds this
+   int       m_promoteMinAccesses;      //!< fast tier - accesses within promote window that promote a file, 0 for never
+   int       m_promoteWindow;           //!< fast tier - time window for counting accesses
+
    std::set<std::string> m_dirStatsDirs;     //!< directories for which stat reporting was requested
    std::set<std::string> m_dirStatsDirGlobs; //!< directory globs for which stat reporting was requested
    int       m_dirStatsInterval;        //!< time between resource monitor statistics dump in seconds
@@ -113,6 +122,7 @@ struct Configuration
    int       m_wqueue_blocks;           //!< maximum number of blocks written per write-queue loop
    int       m_wqueue_threads;          //!< number of threads writing blocks to disk
    int       m_prefetch_max_blocks;     //!< default maximum number of blocks to prefetch per file
+   long long m_maxFetchSize;            //!< maximum size of a remote request for a run of adjacent blocks
 
    long long m_cgi_min_bufferSize = 0;          //!< min buffer size allowed in pfc.blocksize
    long long m_cgi_max_bufferSize = 0;          //!< max buffer size allowed in pfc.blocksize
@@ -123,6 +133,8 @@ struct Configuration
 
    long long m_hdfsbsize;               //!< used with m_hdfsmode, default 128MB
    long long m_flushCnt;                //!< nuber of unsynced blcoks on disk before flush is called
+   bool      m_direct_io;               //!< open data files with O_DIRECT, bypassing the page cache
+   int       m_direct_io_sync_interval; //!< with direct I/O, seconds between syncs of data and cinfo files
 
    time_t    m_cs_UVKeep;               //!< unverified checksum cache keep
    int       m_cs_Chk;                  //!< Checksum check
@@ -138,6 +150,8 @@ struct Configuration
 
    bool      m_httpcc;                  //!< enable http cache control
    bool      m_qfsredir;                //!< redirect file system query to the origin
+
+   std::string m_local_access_path;     //!< unix socket passing descriptors of cached files to local clients
 };
 
 //------------------------------------------------------------------------------
@@ -150,10 +164,13 @@ struct TmpConfiguration
    std::string m_fileUsageNominal;
    std::string m_fileUsageMax;
    std::string m_flushRaw;
+   std::string m_fastUsageLWM;
+   std::string m_fastUsageHWM;
 
    TmpConfiguration() :
       m_diskUsageLWM("0.90"), m_diskUsageHWM("0.95"),
-      m_flushRaw("")
+      m_flushRaw(""),
+      m_fastUsageLWM("0.80"), m_fastUsageHWM("0.90")
    {}
 };
 
@@ -259,6 +276,12 @@ public:
    //---------------------------------------------------------------------
    int  UnlinkFile(const std::string& f_name, bool fail_if_open);
 
+   //---------------------------------------------------------------------
+   //! Move a data file that is not open to another oss space. Opens of
+   //! the file wait until the move is done.
+   //---------------------------------------------------------------------
+   int  RelocateFile(const std::string& f_name, const std::string& space);
+
    //---------------------------------------------------------------------
    //! Add downloaded block in write queue.
    //---------------------------------------------------------------------
@@ -287,6 +310,31 @@ public:
 
    void Prefetch();
 
+   //---------------------------------------------------------------------
+   //! Serve requests for descriptors of cached files from local clients.
+   //---------------------------------------------------------------------
+   void LocalAccess();
+
+   //---------------------------------------------------------------------
+   //! Remember the capability a local client passed when opening a file,
+   //! see pfc.localaccess. Forgotten when the io is released.
+   //---------------------------------------------------------------------
+   void RegisterLocalCap(IO *io);
+
+   //---------------------------------------------------------------------
+   //! Check that a capability was passed when opening the given file and
+   //! that the open is still active. A capability can only be claimed once.
+   //---------------------------------------------------------------------
+   bool ClaimLocalCap(const std::string &cap, const std::string &f_name);
+
+   //---------------------------------------------------------------------
+   //! Open a cached data file for a local client. On success fd is a
+   //! read-only descriptor owned by the caller and block_map holds one bit
+   //! per block, it is left empty when the file is complete.
+   //---------------------------------------------------------------------
+   int  LocalFileFD(const std::string &f_name, int &fd, long long &file_size,
+                    long long &block_size, std::vector<unsigned char> &block_map);
+
    XrdOss* GetOss() const { return m_oss; }
 
    bool IsFileActiveOrPurgeProtected(const std::string&) const;
@@ -340,6 +388,13 @@ private:
 
    ResourceMonitor  *m_res_mon;
 
+   XrdNetSocket     *m_local_sock;      //!< listener for local clients, see pfc.localaccess
+
+   typedef std::map<std::string, std::pair<std::string, IO*>> LocalCapMap_t;
+
+   LocalCapMap_t     m_local_caps;      //!< capability -> file name and io of its open
+   XrdSysMutex       m_local_caps_mutex;
+
    std::vector<Decision*> m_decisionpoints; //!< decision plugins
    PurgePin*              m_purge_pin;      //!< purge plugin
 
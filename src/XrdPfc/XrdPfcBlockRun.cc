@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdPfcFile.hh"
+#include "XProtocol/XProtocol.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace XrdPfc;
+
+//------------------------------------------------------------------------------
+
+void BlockRunResponseHandler::MakeRuns(BlockList_t& blks, long long max_fetch,
+                                       std::vector<std::vector<Block*>>& runs)
+{
+   // Runs of blocks that follow each other in the file and are read through
+   // the same IO are fetched with a single remote request of at most
+   // max_fetch bytes. The last block of the file is left alone when it
+   // is read with checksums as its request size is rounded up to a page.
+
+   BlockList_i bi = blks.begin();
+   while (bi != blks.end())
+   {
+      std::vector<Block*> run(1, *bi);
+      long long run_size = (*bi)->get_size();
+      int       run_segs = ((*bi)->get_size() - 1) / XrdProto::maxRVdsz + 1;
+
+      for (++bi; bi != blks.end(); ++bi)
+      {
+         Block *prev = run.back(), *b = *bi;
+         int    segs = (b->get_size() - 1) / XrdProto::maxRVdsz + 1;
+
+         if (b->get_offset() != prev->get_offset() + prev->get_size() ||
+             b->get_io() != prev->get_io() ||
+             b->req_cksum_net() != prev->req_cksum_net() ||
+             b->get_req_size() != b->get_size() ||
+             run_size + b->get_size() > max_fetch ||
+             run_segs + segs > XrdProto::maxRvecsz)
+         {
+            break;
+         }
+         run.push_back(b);
+         run_size += b->get_size();
+         run_segs += segs;
+      }
+
+      runs.emplace_back(std::move(run));
+   }
+}
+
+//------------------------------------------------------------------------------
+
+int BlockRunResponseHandler::Distribute(const std::vector<Block*>& blks, const char *buff,
+                                        const std::vector<uint32_t>& cksum_vec, int n_cksum_errors,
+                                        int res, std::vector<int>& bres)
+{
+   // Each block gets its part of the result as if it had been read on its
+   // own; a short read leaves the blocks past the end of the data with 0.
+
+   const long long off0  = blks.front()->get_offset();
+   long long       left  = res;
+   int             short_idx = -1;
+
+   // The checksum error count is for the whole run, book it with the first block.
+   if (buff)
+      *blks.front()->ptr_n_cksum_errors() = n_cksum_errors;
+
+   bres.clear();
+   for (Block *b : blks)
+   {
+      if (res < 0)
+      {
+         bres.push_back(res);
+         continue;
+      }
+      bres.push_back((int) std::min(left, (long long) b->get_size()));
+      left -= bres.back();
+      if (short_idx < 0 && bres.back() != b->get_size())
+         short_idx = (int) bres.size() - 1;
+
+      if (buff)
+      {
+         const long long boff = b->get_offset() - off0;
+         memcpy(b->get_buff(), buff + boff, bres.back());
+
+         // Blocks are page aligned, so each gets its own pages' checksums.
+         const size_t pg0 = boff / XrdSys::PageSize;
+         const size_t pgn = (boff + b->get_size() - 1) / XrdSys::PageSize + 1;
+         if (pgn <= cksum_vec.size())
+            b->ref_cksum_vec().assign(cksum_vec.begin() + pg0, cksum_vec.begin() + pgn);
+      }
+   }
+
+   return short_idx;
+}
@@ -6,6 +6,7 @@
 #include "XrdPfcPurgePin.hh"
 
 #include "XrdOss/XrdOss.hh"
+#include "XrdNet/XrdNetSocket.hh"
 
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucUtils.hh"
@@ -46,6 +47,10 @@ Configuration::Configuration() :
    m_purgeColdFilesAge(-1),
    m_purgeAgeBasedPeriod(10),
    m_accHistorySize(20),
+   m_fastUsageLWM(-1),
+   m_fastUsageHWM(-1),
+   m_promoteMinAccesses(3),
+   m_promoteWindow(24*3600),
    m_dirStatsInterval(900),
    m_dirStatsStoreDepth(1),
    m_bufferSize(128*1024),
@@ -54,8 +59,11 @@ Configuration::Configuration() :
    m_wqueue_blocks(16),
    m_wqueue_threads(4),
    m_prefetch_max_blocks(10),
+   m_maxFetchSize(8*1024*1024),
    m_hdfsbsize(128*1024*1024),
    m_flushCnt(2000),
+   m_direct_io(false),
+   m_direct_io_sync_interval(10),
    m_cs_UVKeep(-1),
    m_cs_Chk(CSChk_Net),
    m_cs_ChkTLS(false),
@@ -421,6 +429,12 @@ bool Cache::test_oss_basics_and_features()
    bool aOK = true;
    aOK &= check_space(conf.m_data_space.c_str(), m_dataXattr);
    aOK &= check_space(conf.m_meta_space.c_str(), m_metaXattr);
+   if (conf.is_fast_tier_set())
+   {
+      bool fast_xattr = false;
+      aOK &= check_space(conf.m_fast_space.c_str(), fast_xattr);
+      m_dataXattr = m_dataXattr && fast_xattr;
+   }
 
    return aOK;
 }
@@ -593,6 +607,30 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
       }
       else aOK = false;
 
+      if (m_configuration.is_fast_tier_set())
+      {
+         if (m_configuration.m_fast_space == m_configuration.m_data_space)
+         {
+            m_log.Emsg("ConfigParameters()", "pfc.fasttier space must differ from the data space ", m_configuration.m_data_space.c_str());
+            return false;
+         }
+         XrdOssVSInfo fP;
+         if (m_oss->StatVS(&fP, m_configuration.m_fast_space.c_str(), 1) < 0)
+         {
+            m_log.Emsg("ConfigParameters()", "error obtaining stat info for fast tier space ", m_configuration.m_fast_space.c_str());
+            return false;
+         }
+         if (cfg2bytes(tmpc.m_fastUsageLWM, m_configuration.m_fastUsageLWM, fP.Total, "fast tier lowWatermark") &&
+             cfg2bytes(tmpc.m_fastUsageHWM, m_configuration.m_fastUsageHWM, fP.Total, "fast tier highWatermark"))
+         {
+            if (m_configuration.m_fastUsageLWM >= m_configuration.m_fastUsageHWM) {
+               m_log.Emsg("ConfigParameters()", "pfc.fasttier usage should have lowWatermark < highWatermark.");
+               aOK = false;
+            }
+         }
+         else aOK = false;
+      }
+
       if ( ! tmpc.m_fileUsageMax.empty())
       {
         if (cfg2bytes(tmpc.m_fileUsageBaseline, m_configuration.m_fileUsageBaseline, sP.Total, "files baseline") &&
@@ -641,6 +679,14 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
       }
    }
 
+   // Checksums kept in the cache are maintained by the oss with partial page
+   // updates that can not be done on a file opened for direct I/O.
+   if (m_configuration.m_direct_io && m_configuration.is_cschk_cache())
+   {
+      m_log.Emsg("ConfigParameters()", "pfc.directio can not be used with pfc.cschk cache, turning it off.");
+      m_configuration.m_direct_io = false;
+   }
+
    // get number of available RAM blocks after process configuration
    if (m_configuration.m_RamAbsAvailable == 0)
    {
@@ -681,12 +727,17 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
          snprintf(urlcgi_npref, sizeof(urlcgi_npref), "%d %d",
                   CFG.m_cgi_min_prefetch_max_blocks, CFG.m_cgi_max_prefetch_max_blocks);
 
+      char dio[64] = "off";
+      if (m_configuration.m_direct_io)
+         snprintf(dio, sizeof(dio), "on syncinterval %d", m_configuration.m_direct_io_sync_interval);
+
       char buff[8192];
       int  loff = 0;
       loff = snprintf(buff, sizeof(buff), "Config effective %s pfc configuration:\n"
                       "       pfc.cschk %s uvkeep %s\n"
                       "       pfc.blocksize %lldk\n"
                       "       pfc.prefetch %d\n"
+                      "       pfc.maxfetch %lldk\n"
                       "       pfc.urlcgi blocksize %s prefetch %s\n"
                       "       pfc.ram %.fg\n"
                       "       pfc.writequeue %d %d\n"
@@ -695,6 +746,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       "       pfc.spaces %s %s\n"
                       "       pfc.trace %d\n"
                       "       pfc.flush %lld\n"
+                      "       pfc.directio %s\n"
                       "       pfc.acchistorysize %d\n"
                       "       pfc.onlyIfCachedMinBytes %lld\n"
                       "       pfc.onlyIfCachedMinFrac %.2f\n",
@@ -702,6 +754,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       csc[int(m_configuration.m_cs_Chk)], uvk,
                       m_configuration.m_bufferSize >> 10,
                       m_configuration.m_prefetch_max_blocks,
+                      m_configuration.m_maxFetchSize >> 10,
                       urlcgi_blks, urlcgi_npref,
                       ram_gb,
                       m_configuration.m_wqueue_blocks, m_configuration.m_wqueue_threads,
@@ -713,10 +766,20 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       m_configuration.m_meta_space.c_str(),
                       m_trace->What,
                       m_configuration.m_flushCnt,
+                      dio,
                       m_configuration.m_accHistorySize,
                       m_configuration.m_onlyIfCachedMinSize,
                       m_configuration.m_onlyIfCachedMinFrac);
 
+      if (m_configuration.is_fast_tier_set())
+      {
+         loff += snprintf(buff + loff, sizeof(buff) - loff,
+                          "       pfc.fasttier %s usage %lld %lld promote %d %d\n",
+                          m_configuration.m_fast_space.c_str(),
+                          m_configuration.m_fastUsageLWM, m_configuration.m_fastUsageHWM,
+                          m_configuration.m_promoteMinAccesses, m_configuration.m_promoteWindow);
+      }
+
       if (m_configuration.is_dir_stat_reporting_on())
       {
          loff += snprintf(buff + loff, sizeof(buff) - loff,
@@ -757,6 +820,11 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
       {
          loff += snprintf(buff + loff, sizeof(buff) - loff, "       pfc.qfsredir on\n");
       }
+      if ( ! m_configuration.m_local_access_path.empty())
+      {
+         loff += snprintf(buff + loff, sizeof(buff) - loff, "       pfc.localaccess %s\n",
+                          m_configuration.m_local_access_path.c_str());
+      }
 
       m_log.Say(buff);
 
@@ -771,6 +839,21 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
 
    m_log.Say("       pfc g-stream has", m_gstream ? "" : " NOT", " been configured via xrootd.monitor directive\n");
 
+   // Socket for local clients, created here so that a bad path fails the configuration.
+   if (aOK && ! m_configuration.m_local_access_path.empty())
+   {
+      m_local_sock = XrdNetSocket::Create(&m_log, m_configuration.m_local_access_path.c_str(), 0, 0660);
+      if (m_local_sock)
+      {
+         chmod(m_configuration.m_local_access_path.c_str(), 0660);
+      }
+      else
+      {
+         m_log.Emsg("Config", "Error: can not create pfc.localaccess socket", m_configuration.m_local_access_path.c_str());
+         aOK = false;
+      }
+   }
+
    // Create the ResourceMonitor and get it ready for starting the main thread function.
    if (aOK)
    {
@@ -1077,6 +1160,16 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          return false;
       }
    }
+   else if ( part == "maxfetch" )
+   {
+      // Runs of adjacent missing blocks are fetched with a single request
+      // up to this size; 0 fetches each block on its own.
+      if (XrdOuca2x::a2sz(m_log, "Error getting pfc.maxfetch size", cwg.GetWord(),
+                          &m_configuration.m_maxFetchSize, 0, 1024ll*1024*1024))
+      {
+         return false;
+      }
+   }
    else if ( part == "writequeue")
    {
       if (XrdOuca2x::a2i(m_log, "Error getting pfc.writequeue num-blocks", cwg.GetWord(), &m_configuration.m_wqueue_blocks, 1, 1024))
@@ -1088,6 +1181,46 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          return false;
       }
    }
+   else if ( part == "fasttier" )
+   {
+      //  pfc.fasttier <space> [usage <lwm> <hwm>] [promote <n-accesses> <window>]
+      m_configuration.m_fast_space = cwg.GetWord();
+      if ( ! cwg.HasLast() || m_configuration.m_fast_space.empty())
+      {
+         m_log.Emsg("Config", "Error: pfc.fasttier requires a space name.");
+         return false;
+      }
+
+      const char *p = 0;
+      while ((p = cwg.GetWord()) && cwg.HasLast())
+      {
+         if (strcmp(p, "usage") == 0)
+         {
+            tmpc.m_fastUsageLWM = cwg.GetWord();
+            tmpc.m_fastUsageHWM = cwg.GetWord();
+            if ( ! cwg.HasLast())
+            {
+               m_log.Emsg("Config", "Error: pfc.fasttier usage requires two arguments.");
+               return false;
+            }
+         }
+         else if (strcmp(p, "promote") == 0)
+         {
+            if (XrdOuca2x::a2i(m_log, "Error getting pfc.fasttier promote accesses", cwg.GetWord(),
+                               &m_configuration.m_promoteMinAccesses, 0, 1000) ||
+                XrdOuca2x::a2tm(m_log, "Error getting pfc.fasttier promote window", cwg.GetWord(),
+                                &m_configuration.m_promoteWindow, 60, 3600*24*360))
+            {
+               return false;
+            }
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: pfc.fasttier unknown option", p);
+            return false;
+         }
+      }
+   }
    else if ( part == "spaces" )
    {
       m_configuration.m_data_space = cwg.GetWord();
@@ -1152,6 +1285,44 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          return false;
       }
    }
+   else if ( part == "directio" )
+   {
+      //  pfc.directio {off | on [syncinterval <time>]}
+      const char *val = cwg.GetWord();
+      if ( ! val || ! cwg.HasLast())
+      {
+         m_log.Emsg("Config", "Error: pfc.directio requires a parameter.");
+         return false;
+      }
+
+      if (strcmp(val, "on") == 0) {
+         m_configuration.m_direct_io = true;
+      } else if (strcmp(val, "off") == 0) {
+         m_configuration.m_direct_io = false;
+      } else {
+         m_log.Emsg("ConfigParameters()",
+                    "Unknown value for pfc.directio:", val, "(valid values are 'on' or 'off')");
+         return false;
+      }
+
+      const char *p = 0;
+      while ((p = cwg.GetWord()) && cwg.HasLast())
+      {
+         if (strcmp(p, "syncinterval") == 0)
+         {
+            if (XrdOuca2x::a2tm(m_log, "Error getting pfc.directio syncinterval", cwg.GetWord(),
+                                &m_configuration.m_direct_io_sync_interval, 1, 3600))
+            {
+               return false;
+            }
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: pfc.directio unknown option", p);
+            return false;
+         }
+      }
+   }
    else if ( part == "onlyifcached" )
    {
       const char *p = 0;
@@ -1220,6 +1391,22 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
           return false;
       }
    }
+   else if ( part == "localaccess" )
+   {
+      //  pfc.localaccess <socket path>
+      m_configuration.m_local_access_path = cwg.GetWord();
+      if ( ! cwg.HasLast() || m_configuration.m_local_access_path[0] != '/')
+      {
+         m_log.Emsg("Config", "Error: pfc.localaccess requires an absolute socket path.");
+         return false;
+      }
+      const char *p = cwg.GetWord();
+      if (cwg.HasLast())
+      {
+         m_log.Emsg("Config", "Error: pfc.localaccess unknown option", p);
+         return false;
+      }
+   }
    else
    {
       m_log.Emsg("ConfigParameters() unmatched pfc parameter", part.c_str());
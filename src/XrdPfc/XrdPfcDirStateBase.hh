@@ -73,6 +73,8 @@ struct DataFsStateBase
    long long m_file_usage = 0; // Calculate usage by data files in the cache
    long long m_meta_total = 0; // In bytes, from Oss::StatVS() on space meta
    long long m_meta_used  = 0; // ""
+   long long m_fast_total = 0; // In bytes, from Oss::StatVS() on space of the fast tier, 0 if none
+   long long m_fast_used  = 0; // ""
 };
 
 }
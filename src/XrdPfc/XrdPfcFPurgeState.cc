@@ -2,6 +2,7 @@
 #include "XrdPfcFsTraversal.hh"
 #include "XrdPfcInfo.hh"
 #include "XrdPfc.hh"
+#include "XrdPfcTierState.hh"
 #include "XrdPfcTrace.hh"
 
 #include "XrdOuc/XrdOucEnv.hh"
@@ -48,14 +49,15 @@ void FPurgeState::MoveListEntriesToMap()
 //! @param fname name of cache-info file
 //! @param Info object
 //! @param stat of the given file
+//! @param space_purge false if the file does not count towards the space being purged
 //!
 //----------------------------------------------------------------------------
-void FPurgeState::CheckFile(const FsTraversal &fst, const char *fname, time_t atime, struct stat &fstat)
+void FPurgeState::CheckFile(const FsTraversal &fst, const char *fname, time_t atime, struct stat &fstat, bool space_purge)
 {
    long long nblocks = fstat.st_blocks;
    // TRACE(Dump, trc_pfx << "FPurgeState::CheckFile checking " << fname << " accessTime  " << atime);
 
-   m_nStBlocksTotal += nblocks;
+   if (space_purge) m_nStBlocksTotal += nblocks;
 
    // Could remove aged-out / uv-keep-failed files here ... or in the calling function that
    // can aggreagate info for all files in the directory.
@@ -65,10 +67,11 @@ void FPurgeState::CheckFile(const FsTraversal &fst, const char *fname, time_t at
 
    if (m_tMinTimeStamp > 0 && atime < m_tMinTimeStamp)
    {
-      m_flist.push_back(PurgeCandidate(fst.m_current_path, fname, nblocks, 0));
-      m_nStBlocksAccum += nblocks;
+      m_flist.push_back(PurgeCandidate(fst.m_current_path, fname, nblocks, 0, space_purge));
+      if (space_purge) m_nStBlocksAccum += nblocks;
    }
-   else if (m_nStBlocksAccum < m_nStBlocksReq || (!m_fmap.empty() && atime < m_fmap.rbegin()->first))
+   // Files in other spaces are only removed when aged-out.
+   else if (space_purge && (m_nStBlocksAccum < m_nStBlocksReq || (!m_fmap.empty() && atime < m_fmap.rbegin()->first)))
    {
       m_fmap.insert(std::make_pair(atime, PurgeCandidate(fst.m_current_path, fname, nblocks, atime)));
       m_nStBlocksAccum += nblocks;
@@ -99,7 +102,9 @@ void FPurgeState::ProcessDirAndRecurse(FsTraversal &fst)
       }
 
       time_t atime = it->second.stat_cinfo.st_mtime;
-      CheckFile(fst, i_name.c_str(), atime, it->second.stat_data);
+      // Files in the skip space, i.e., the fast tier, are kept in check by demotion.
+      bool space_purge = m_skip_space.empty() || ! is_in_oss_space(m_oss, fst.m_current_path + f_name, m_skip_space);
+      CheckFile(fst, i_name.c_str(), atime, it->second.stat_data, space_purge);
 
       // Protected top-directories are skipped.
    }
@@ -27,9 +27,10 @@ public:
       std::string path;
       long long   nStBlocks;
       time_t      time;
+      bool        spacePurge; // counts towards the space being purged
 
-      PurgeCandidate(const std::string &dname, const char *fname, long long n, time_t t) :
-         path(dname + fname), nStBlocks(n), time(t)
+      PurgeCandidate(const std::string &dname, const char *fname, long long n, time_t t, bool sp = true) :
+         path(dname + fname), nStBlocks(n), time(t), spacePurge(sp)
       {}
    };
 
@@ -46,6 +47,7 @@ private:
    long long m_nStBlocksTotal;
    time_t    m_tMinTimeStamp;
    time_t    m_tMinUVKeepTimeStamp;
+   std::string m_skip_space;  // files in this oss space are only purged when aged-out
 
    static const char *m_traceID;
 
@@ -61,12 +63,13 @@ public:
    void      setMinTime(time_t min_time) { m_tMinTimeStamp = min_time; }
    time_t    getMinTime()          const { return m_tMinTimeStamp; }
    void      setUVKeepMinTime(time_t min_time) { m_tMinUVKeepTimeStamp = min_time; }
+   void      setSkipSpace(const std::string &space) { m_skip_space = space; }
    long long getNStBlocksTotal() const { return m_nStBlocksTotal; }
    long long getNBytesTotal() const { return 512ll * m_nStBlocksTotal; }
 
    void MoveListEntriesToMap();
 
-   void CheckFile(const FsTraversal &fst, const char *fname, time_t atime, struct stat &fstat);
+   void CheckFile(const FsTraversal &fst, const char *fname, time_t atime, struct stat &fstat, bool space_purge = true);
 
    void ProcessDirAndRecurse(FsTraversal &fst);
    bool TraverseNamespace(const char *root_path);
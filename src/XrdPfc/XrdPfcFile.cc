@@ -24,6 +24,8 @@
 #include "XrdPfcTrace.hh"
 
 #include "XProtocol/XProtocol.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+#include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdOuc/XrdOucEnv.hh"
@@ -33,13 +35,19 @@
 #include "XrdCl/XrdClURL.hh"
 #include "XrdCl/XrdClFileStateHandler.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 #include <unordered_map>
 
 #include <fcntl.h>
 
+#ifndef O_DIRECT
+#define O_DIRECT 0
+#endif
+
 using namespace XrdPfc;
 
 namespace
@@ -67,6 +75,8 @@ File::File(const std::string& path, long long iOffset, long long iFileSize) :
    m_ios_in_detach(0),
    m_non_flushed_cnt(0),
    m_in_sync(false),
+   m_direct_io(false),
+   m_last_sync_time(0),
    m_detach_time_logged(false),
    m_in_shutdown(false),
    m_state_cond(0),
@@ -452,19 +462,49 @@ bool File::Open(XrdOucCacheIO *inputIO)
    // Create the data file itself.
    char size_str[32]; sprintf(size_str, "%lld", m_file_size);
    myEnv.Put("oss.asize",  size_str);
-   myEnv.Put("oss.cgroup", conf.m_data_space.c_str());
 
-   int res;
+   int res = -ENOSPC;
+
+   // New files go to the fast tier when there is one and it has room,
+   // files that exist stay where they are.
+   if (conf.is_fast_tier_set() && ! data_existed)
+   {
+      myEnv.Put("oss.cgroup", conf.m_fast_space.c_str());
+      res = myOss.Create(myUser, m_filename.c_str(), 0600, myEnv, XRDOSS_mkpath);
+      if (res != XrdOssOK)
+         TRACEF(Debug, tpfx << "Create in fast tier failed " << ERRNO_AND_ERRSTR(-res) << ", using data space");
+   }
+   if (res != XrdOssOK)
+   {
+      myEnv.Put("oss.cgroup", conf.m_data_space.c_str());
+      res = myOss.Create(myUser, m_filename.c_str(), 0600, myEnv, XRDOSS_mkpath);
+   }
 
-   if ((res = myOss.Create(myUser, m_filename.c_str(), 0600, myEnv, XRDOSS_mkpath)) != XrdOssOK)
+   if (res != XrdOssOK)
    {
       TRACEF(Error, tpfx << "Create failed " << ERRNO_AND_ERRSTR(-res));
       errno = -res;
       return false;
    }
 
+   // With pfc.directio the data file bypasses the page cache. File systems
+   // that do not support it refuse the open and get the file buffered.
+   const int dio_flag = conf.m_direct_io ? O_DIRECT : 0;
+
    m_data_file = myOss.newFile(myUser);
-   if ((res = m_data_file->Open(m_filename.c_str(), O_RDWR, 0600, myEnv)) != XrdOssOK)
+   res = m_data_file->Open(m_filename.c_str(), O_RDWR | dio_flag, 0600, myEnv);
+   if (res == -EINVAL && dio_flag)
+   {
+      TRACEF(Warning, tpfx << "Direct I/O not supported for data file, using the page cache");
+      res = m_data_file->Open(m_filename.c_str(), O_RDWR, 0600, myEnv);
+   }
+   else if (res == XrdOssOK)
+   {
+      m_direct_io = (dio_flag != 0);
+   }
+   m_last_sync_time = time(0);
+
+   if (res != XrdOssOK)
    {
       TRACEF(Error, tpfx << "Open failed " << ERRNO_AND_ERRSTR(-res));
       errno = -res;
@@ -731,7 +771,8 @@ Block* File::PrepareBlockRequest(int i, IO *io, void *req_id, bool prefetch)
    int blk_size, req_size;
    if (i == last_block) {
       blk_size = req_size = m_file_size - off;
-      if (cs_net && req_size & 0xFFF) req_size = (req_size & ~0xFFF) + 0x1000;
+      // Network checksums and direct writes both need whole pages.
+      if ((cs_net || m_direct_io) && req_size & 0xFFF) req_size = (req_size & ~0xFFF) + 0x1000;
    } else {
       blk_size = req_size = m_block_size;
    }
@@ -790,9 +831,66 @@ void File::ProcessBlockRequests(BlockList_t& blks)
 {
    // This *must not* be called with block_map locked.
 
-   for (BlockList_i bi = blks.begin(); bi != blks.end(); ++bi)
+   std::vector<std::vector<Block*>> runs;
+   BlockRunResponseHandler::MakeRuns(blks, cache()->RefConfiguration().m_maxFetchSize, runs);
+
+   for (std::vector<Block*> &run : runs)
+   {
+      if (run.size() == 1)
+      {
+         ProcessBlockRequest(run.front());
+      }
+      else
+      {
+         long long run_size = 0;
+         for (Block *b : run) run_size += b->get_size();
+         ProcessBlockRunRequest(run, run_size);
+      }
+   }
+}
+
+void File::ProcessBlockRunRequest(std::vector<Block*>& blks, int size)
+{
+   // This *must not* be called with block_map locked.
+
+   BlockRunResponseHandler *brh   = new BlockRunResponseHandler;
+   Block                   *first = blks.front();
+
+   brh->m_blocks.swap(blks);
+
+   TRACEF(Dump, "ProcessBlockRunRequest() idx=" << first->get_offset()/m_block_size << ", n_blocks=" <<
+          brh->m_blocks.size() << ", off=" << first->get_offset() << ", size=" << size <<
+          ", cksum_net=" << first->req_cksum_net() << ", resp_handler=" << (void*)brh);
+
+   if (first->req_cksum_net())
+   {
+      if ( ! (brh->m_buff = (char*) malloc(size)))
+      {
+         TRACEF(Warning, "ProcessBlockRunRequest() allocation of " << size << " bytes failed, requesting blocks one by one.");
+         for (Block *b : brh->m_blocks)
+            ProcessBlockRequest(b);
+         delete brh;
+         return;
+      }
+      first->get_io()->GetInput()->pgRead(*brh, brh->m_buff, first->get_offset(), size,
+                                          brh->m_cksum_vec, 0, &brh->m_n_cksum_errors);
+   }
+   else
    {
-      ProcessBlockRequest(*bi);
+      // Blocks larger than what a vector read segment can carry are split.
+      for (Block *b : brh->m_blocks)
+      {
+         for (int off = 0; off < b->get_size(); off += XrdProto::maxRVdsz)
+         {
+            XrdOucIOVec seg;
+            seg.offset = b->get_offset() + off;
+            seg.size   = std::min(b->get_size() - off, (int) XrdProto::maxRVdsz);
+            seg.info   = 0;
+            seg.data   = b->get_buff() + off;
+            brh->m_iovec.push_back(seg);
+         }
+      }
+      first->get_io()->GetInput()->ReadV(*brh, brh->m_iovec.data(), (int) brh->m_iovec.size());
    }
 }
 
@@ -819,11 +917,63 @@ void File::RequestBlocksDirect(IO *io, ReadRequest *read_req, std::vector<XrdOuc
 
 //------------------------------------------------------------------------------
 
+ssize_t File::ReadFromDisk(char *buff, long long off, int size)
+{
+   // Direct I/O needs the file offset, the size and the memory to be page
+   // aligned. Unaligned reads go through an aligned bounce buffer.
+
+   const long long pg_mask = XrdSys::PageSize - 1;
+
+   if ( ! m_direct_io || ((off | size | (long long) buff) & pg_mask) == 0)
+      return m_data_file->Read(buff, off, size);
+
+   const long long beg = off & ~pg_mask;
+   const long long end = (off + size + pg_mask) & ~pg_mask;
+   char *bounce;
+
+   if (posix_memalign((void**) &bounce, XrdSys::PageSize, end - beg))
+      return -ENOMEM;
+
+   ssize_t ret = m_data_file->Read(bounce, beg, end - beg);
+   if (ret > off - beg)
+   {
+      ret = std::min(ret - (ssize_t) (off - beg), (ssize_t) size);
+      memcpy(buff, bounce + (off - beg), ret);
+   }
+   else if (ret > 0)
+   {
+      ret = 0;
+   }
+
+   free(bounce);
+   return ret;
+}
+
+ssize_t File::ReadVFromDisk(XrdOucIOVec *ioVec, int n)
+{
+   // Same conventions as XrdOssDF::ReadV(), a short chunk is an error.
+
+   if ( ! m_direct_io)
+      return m_data_file->ReadV(ioVec, n);
+
+   ssize_t nbytes = 0;
+   for (int i = 0; i < n; ++i)
+   {
+      ssize_t ret = ReadFromDisk(ioVec[i].data, ioVec[i].offset, ioVec[i].size);
+      if (ret != ioVec[i].size)
+         return ret < 0 ? ret : -ESPIPE;
+      nbytes += ret;
+   }
+   return nbytes;
+}
+
+//------------------------------------------------------------------------------
+
 int File::ReadBlocksFromDisk(std::vector<XrdOucIOVec>& ioVec, int expected_size)
 {
    TRACEF(DumpXL, "ReadBlocksFromDisk() issuing ReadV for n_chunks = " << (int) ioVec.size() << ", total_size = " << expected_size);
 
-   long long rs = m_data_file->ReadV(ioVec.data(), (int) ioVec.size());
+   long long rs = ReadVFromDisk(ioVec.data(), (int) ioVec.size());
 
    if (rs < 0)
    {
@@ -863,7 +1013,7 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadR
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->Read(iUserBuff, iUserOff, iUserSize);
+      int ret = ReadFromDisk(iUserBuff, iUserOff, iUserSize);
       if (ret > 0) {
          XrdSysCondVarHelper _lck(m_state_cond);
          m_delta_stats.AddBytesHit(ret);
@@ -896,7 +1046,7 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
+      int ret = ReadVFromDisk(const_cast<XrdOucIOVec*>(readV), readVnum);
       if (ret > 0) {
          XrdSysCondVarHelper _lck(m_state_cond);
          m_delta_stats.AddBytesHit(ret);
@@ -1162,79 +1312,118 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
 // WriteBlock and Sync
 //==============================================================================
 
-void File::WriteBlockToDisk(Block* b)
+void File::WriteBlocksToDisk(std::vector<Block*>& blks)
 {
-   // write block buffer into disk file
-   long long   offset = b->m_offset - m_offset;
-   long long   size   = b->get_size();
-   ssize_t     retval;
-
-   if (m_cfi.IsCkSumCache())
-      if (b->has_cksums())
-         retval = m_data_file->pgWrite(b->get_buff(), offset, size, b->ref_cksum_vec().data(), 0);
-      else
-         retval = m_data_file->pgWrite(b->get_buff(), offset, size, 0, 0);
-   else
-      retval = m_data_file->Write(b->get_buff(), offset, size);
+   // Blocks are written in file order and their state is then updated under
+   // a single lock. With direct I/O the partial last block is written padded
+   // to a whole page and the data file is cut back to its proper size.
 
-   if (retval < size)
+   std::vector<bool> written(blks.size(), false);
+
+   for (size_t i = 0; i < blks.size(); ++i)
    {
-      if (retval < 0) {
-         TRACEF(Error, "WriteToDisk() write error " << retval);
-      } else {
-         TRACEF(Error, "WriteToDisk() incomplete block write ret=" << retval << " (should be " << size << ")");
+      Block      *b      = blks[i];
+      long long   offset = b->m_offset - m_offset;
+      long long   size   = b->get_size();
+      long long   wsize  = size;
+      ssize_t     retval;
+
+      if (m_direct_io && b->get_req_size() != size)
+      {
+         memset(b->get_buff() + size, 0, b->get_req_size() - size);
+         wsize = b->get_req_size();
       }
 
-      XrdSysCondVarHelper _lck(m_state_cond);
+      if (m_cfi.IsCkSumCache())
+         if (b->has_cksums())
+            retval = m_data_file->pgWrite(b->get_buff(), offset, size, b->ref_cksum_vec().data(), 0);
+         else
+            retval = m_data_file->pgWrite(b->get_buff(), offset, size, 0, 0);
+      else
+         retval = m_data_file->Write(b->get_buff(), offset, wsize);
 
-      dec_ref_count(b);
+      if (retval >= size && wsize != size)
+      {
+         int tret = m_data_file->Ftruncate(offset + size);
+         if (tret != XrdOssOK)
+         {
+            TRACEF(Error, "WriteToDisk() truncate after padded write failed " << tret);
+            retval = tret;
+         }
+      }
 
-      return;
-   }
+      if (retval < size)
+      {
+         if (retval < 0) {
+            TRACEF(Error, "WriteToDisk() write error " << retval);
+         } else {
+            TRACEF(Error, "WriteToDisk() incomplete block write ret=" << retval << " (should be " << size << ")");
+         }
+         continue;
+      }
 
-   const int blk_idx =  (b->m_offset - m_offset) / m_block_size;
+      // Set written bit.
+      TRACEF(Dump, "WriteToDisk() success set bit for block " <<  b->m_offset << " size=" <<  size);
 
-   // Set written bit.
-   TRACEF(Dump, "WriteToDisk() success set bit for block " <<  b->m_offset << " size=" <<  size);
+      written[i] = true;
+   }
+
+   const Configuration &conf = Cache::GetInstance().RefConfiguration();
 
    bool schedule_sync = false;
    {
       XrdSysCondVarHelper _lck(m_state_cond);
 
-      m_cfi.SetBitWritten(blk_idx);
-
-      if (b->m_prefetch)
+      for (size_t i = 0; i < blks.size(); ++i)
       {
-         m_cfi.SetBitPrefetch(blk_idx);
-      }
-      if (b->req_cksum_net() && ! b->has_cksums() && m_cfi.IsCkSumNet())
-      {
-         m_cfi.ResetCkSumNet();
-      }
+         if ( ! written[i])
+            continue;
 
-      // Set synced bit or stash block index if in actual sync.
-      // Synced state is only written out to cinfo file when data file is synced.
-      if (m_in_sync)
-      {
-         m_writes_during_sync.push_back(blk_idx);
-      }
-      else
-      {
-         m_cfi.SetBitSynced(blk_idx);
-         ++m_non_flushed_cnt;
-         if ((m_cfi.IsComplete() || m_non_flushed_cnt >= Cache::GetInstance().RefConfiguration().m_flushCnt) &&
-             ! m_in_shutdown)
+         Block     *b       = blks[i];
+         const int  blk_idx = (b->m_offset - m_offset) / m_block_size;
+
+         m_cfi.SetBitWritten(blk_idx);
+
+         if (b->m_prefetch)
+         {
+            m_cfi.SetBitPrefetch(blk_idx);
+         }
+         if (b->req_cksum_net() && ! b->has_cksums() && m_cfi.IsCkSumNet())
          {
-            schedule_sync     = true;
-            m_in_sync         = true;
-            m_non_flushed_cnt = 0;
+            m_cfi.ResetCkSumNet();
          }
+
+         // Set synced bit or stash block index if in actual sync.
+         // Synced state is only written out to cinfo file when data file is synced.
+         if (m_in_sync)
+         {
+            m_writes_during_sync.push_back(blk_idx);
+         }
+         else
+         {
+            m_cfi.SetBitSynced(blk_idx);
+            ++m_non_flushed_cnt;
+         }
+      }
+
+      // Buffered writes are synced every pfc.flush blocks, direct ones that
+      // do not linger in the page cache on a timer.
+      if ( ! m_in_sync && m_non_flushed_cnt > 0 && ! m_in_shutdown &&
+           (m_cfi.IsComplete() ||
+            (m_direct_io ? time(0) - m_last_sync_time >= conf.m_direct_io_sync_interval
+                         : m_non_flushed_cnt >= conf.m_flushCnt)))
+      {
+         schedule_sync     = true;
+         m_in_sync         = true;
+         m_non_flushed_cnt = 0;
       }
+
       // As soon as the reference count is decreased on the block, the
       // file object may be deleted.  Thus, to avoid holding both locks at a time,
       // we defer the ref count decrease until later if a sync is needed
       if (!schedule_sync) {
-         dec_ref_count(b);
+         for (Block *b : blks)
+            dec_ref_count(b);
       }
    }
 
@@ -1242,7 +1431,8 @@ void File::WriteBlockToDisk(Block* b)
    {
       cache()->ScheduleFileSync(this);
       XrdSysCondVarHelper _lck(m_state_cond);
-      dec_ref_count(b);
+      for (Block *b : blks)
+         dec_ref_count(b);
    }
 }
 
@@ -1252,7 +1442,10 @@ void File::Sync()
 {
    TRACEF(Dump, "Sync()");
 
-   int ret     = m_data_file->Fsync();
+   // Direct writes are not in the page cache, the device cache and the
+   // file size are all that is left to flush.
+   int fd      = m_direct_io ? m_data_file->getFD() : -1;
+   int ret     = fd >= 0 ? (fdatasync(fd) ? -errno : XrdOssOK) : m_data_file->Fsync();
    bool errorp = false;
    if (ret == XrdOssOK)
    {
@@ -1302,6 +1495,7 @@ void File::Sync()
       }
       written_while_in_sync = m_non_flushed_cnt = (int) m_writes_during_sync.size();
       m_writes_during_sync.clear();
+      m_last_sync_time = time(0);
 
       // If there were writes during sync and the file is now complete,
       // let us call Sync again without resetting the m_in_sync flag.
@@ -1485,13 +1679,13 @@ void File::FinalizeReadRequest(ReadRequest *rreq)
    delete rreq;
 }
 
-void File::ProcessBlockResponse(Block *b, int res)
+void File::ProcessBlockResponse(Block *b, int res, bool check_size)
 {
    static const char* tpfx = "ProcessBlockResponse ";
 
    TRACEF(Dump, tpfx << "block=" << b << ", idx=" << b->m_offset/m_block_size << ", off=" << b->m_offset << ", res=" << res);
 
-   if (res >= 0 && res != b->get_size())
+   if (check_size && res >= 0 && res != b->get_size())
    {
       // Incorrect number of bytes received, apparently size of the file on the remote
       // is different than what the cache expects it to be.
@@ -1673,31 +1867,29 @@ void File::Prefetch()
       }
 
       // Select block(s) to fetch.
-      for (int f = 0; f < m_num_blocks; ++f)
+      for (int f = m_cfi.FirstBlockNotWrittenInRng(0, m_num_blocks); f >= 0;
+               f = m_cfi.FirstBlockNotWrittenInRng(f + 1, m_num_blocks))
       {
-         if ( ! m_cfi.TestBitWritten(f))
-         {
-            int f_act = f + m_offset / m_block_size;
+         int f_act = f + m_offset / m_block_size;
 
-            BlockMap_i bi = m_block_map.find(f_act);
-            if (bi == m_block_map.end())
+         BlockMap_i bi = m_block_map.find(f_act);
+         if (bi == m_block_map.end())
+         {
+            Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
+            if (b)
             {
-               Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
-               if (b)
-               {
-                  TRACEF(Dump, "Prefetch take block " << f_act);
-                  blks.push_back(b);
-                  // Note: block ref_cnt not increased, it will be when placed into write queue.
+               TRACEF(Dump, "Prefetch take block " << f_act);
+               blks.push_back(b);
+               // Note: block ref_cnt not increased, it will be when placed into write queue.
 
-                  inc_prefetch_read_cnt(1);
-               }
-               else
-               {
-                  // This shouldn't happen as prefetching stops when RAM is 70% full.
-                  TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
-               }
-               break;
+               inc_prefetch_read_cnt(1);
+            }
+            else
+            {
+               // This shouldn't happen as prefetching stops when RAM is 70% full.
+               TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
             }
+            break;
          }
       }
 
@@ -1786,6 +1978,24 @@ void BlockResponseHandler::Done(int res)
 
 //------------------------------------------------------------------------------
 
+void BlockRunResponseHandler::Done(int res)
+{
+   File             *file = m_blocks.front()->get_file();
+   std::vector<int>  bres;
+
+   // A short read means that the remote file is smaller than expected. This
+   // is only reported with the first incomplete block so that the file gets
+   // unlinked once for the whole run.
+   int short_idx = Distribute(m_blocks, m_buff, m_cksum_vec, m_n_cksum_errors, res, bres);
+
+   for (size_t i = 0; i < m_blocks.size(); ++i)
+      file->ProcessBlockResponse(m_blocks[i], bres[i], (int) i == short_idx);
+
+   delete this;
+}
+
+//------------------------------------------------------------------------------
+
 void DirectResponseHandler::Done(int res)
 {
    m_mutex.Lock();
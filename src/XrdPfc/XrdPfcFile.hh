@@ -25,11 +25,13 @@
 #include "XrdOuc/XrdOucCache.hh"
 #include "XrdOuc/XrdOucIOVec.hh"
 
+#include <cstdlib>
 #include <functional>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class XrdJob;
 struct XrdOucIOVec;
@@ -38,6 +40,7 @@ namespace XrdPfc
 {
 class File;
 class BlockResponseHandler;
+class BlockRunResponseHandler;
 class DirectResponseHandler;
 class IO;
 
@@ -180,6 +183,39 @@ public:
 
 // ----------------------------------------------------------------
 
+// Handles a single remote request for a run of blocks that are adjacent in
+// the file. Without network checksums the data is read straight into the
+// blocks with a vector read; a pgRead lands in m_buff and is copied out.
+
+class BlockRunResponseHandler : public XrdOucCacheIOCB
+{
+public:
+   std::vector<Block*>      m_blocks;
+   std::vector<XrdOucIOVec> m_iovec;
+   std::vector<uint32_t>    m_cksum_vec;
+   char                    *m_buff = nullptr;
+   int                      m_n_cksum_errors = 0;
+
+   ~BlockRunResponseHandler() { free(m_buff); }
+
+   void Done(int result) override;
+
+   // Group blocks into runs that can be fetched with one request of at most
+   // max_fetch bytes; with max_fetch 0 every block is a run of its own.
+   static void MakeRuns(BlockList_t& blks, long long max_fetch,
+                        std::vector<std::vector<Block*>>& runs);
+
+   // Split the result of the run's request into the result of each block,
+   // copying the data and page checksums of a pgRead (buff is then not nil)
+   // into the blocks. Returns the index of the first block that was not read
+   // in full or -1.
+   static int Distribute(const std::vector<Block*>& blks, const char *buff,
+                         const std::vector<uint32_t>& cksum_vec, int n_cksum_errors,
+                         int result, std::vector<int>& bres);
+};
+
+// ----------------------------------------------------------------
+
 class DirectResponseHandler : public XrdOucCacheIOCB
 {
 public:
@@ -203,6 +239,7 @@ class File
 {
    friend class Cache;
    friend class BlockResponseHandler;
+   friend class BlockRunResponseHandler;
    friend class DirectResponseHandler;
 public:
    // Constructor, destructor, Open() and Close() are private.
@@ -250,7 +287,11 @@ public:
    //----------------------------------------------------------------------
    void Sync();
 
-   void WriteBlockToDisk(Block *b);
+   //----------------------------------------------------------------------
+   //! Write blocks taken from the write queue in one batch, all of them
+   //! belonging to this file and sorted by offset.
+   //----------------------------------------------------------------------
+   void WriteBlocksToDisk(std::vector<Block*>& blks);
 
    void Prefetch();
 
@@ -330,6 +371,8 @@ private:
    std::vector<int>  m_writes_during_sync;
    int  m_non_flushed_cnt;
    bool m_in_sync;
+   bool m_direct_io;          //!< data file is open with O_DIRECT
+   time_t m_last_sync_time;   //!< with direct I/O syncs are done on a timer
    bool m_detach_time_logged;
    bool m_in_shutdown;        //!< file is in emergency shutdown due to irrecoverable error or unlink request
 
@@ -389,10 +432,14 @@ private:
 
    // Read & ReadV
 
+   ssize_t ReadFromDisk (char *buff, long long off, int size);
+   ssize_t ReadVFromDisk(XrdOucIOVec *ioVec, int n);
+
    Block* PrepareBlockRequest(int i, IO *io, void *req_id, bool prefetch);
 
    void   ProcessBlockRequest (Block       *b);
    void   ProcessBlockRequests(BlockList_t& blks);
+   void   ProcessBlockRunRequest(std::vector<Block*>& blks, int size);
 
    void   RequestBlocksDirect(IO *io, ReadRequest *read_req, std::vector<XrdOucIOVec>& ioVec, int expected_size);
 
@@ -406,7 +453,7 @@ private:
    void ProcessBlockSuccess(Block *b, ChunkRequest &creq);
    void FinalizeReadRequest(ReadRequest *rreq);
 
-   void ProcessBlockResponse(Block *b, int res);
+   void ProcessBlockResponse(Block *b, int res, bool check_size = true);
 
    // Block management
 
@@ -72,6 +72,11 @@ private:
 
    void SetInput(XrdOucCacheIO*);
 
+   // Capability of a local client, managed by Cache under m_local_caps_mutex.
+   friend class Cache;
+
+   std::string m_local_cap;
+
    // Variables used by File to store IO-relates state. Managed under
    // File::m_state_cond mutex.
    friend class File;
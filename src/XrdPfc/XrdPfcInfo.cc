@@ -122,9 +122,10 @@ const int    Info::s_defaultVersion   = 4;
 
 Info::Info(XrdSysTrace* trace, bool prefetchBuffer) :
    m_trace(trace),
-   m_buff_synced(0), m_buff_written(0),  m_buff_prefetch(0),
+   m_buff_synced(0), m_buff_written(0),  m_buff_prefetch(0), m_buff_full(0),
    m_version(0),
    m_bitvecSizeInBits(0),
+   m_bitvecSizeInWords(0),
    m_missingBlocks(0),
    m_complete(false),
    m_hasPrefetchBuffer(prefetchBuffer),
@@ -136,6 +137,7 @@ Info::~Info()
    if (m_buff_synced)   free(m_buff_synced);
    if (m_buff_written)  free(m_buff_written);
    if (m_buff_prefetch) free(m_buff_prefetch);
+   if (m_buff_full)     free(m_buff_full);
    delete m_cksCalcMd5;
 }
 
@@ -143,15 +145,8 @@ Info::~Info()
 
 void Info::SetAllBitsSynced()
 {
-   // The following should be:
-   //   memset(m_buff_synced, 255, GetBitvecSizeInBytes());
-   // but GCC produces an overzealous 'possible argument transpose warning' and
-   // xrootd build uses warnings->errors escalation.
-   // This workaround can be removed for gcc >= 5.
-   // See also: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61294
-   const int nb = GetBitvecSizeInBytes();
-   for (int i = 0; i < nb; ++i)
-      m_buff_synced[i] = 255;
+   for (int w = 0; w < m_bitvecSizeInWords; ++w)
+      m_buff_synced[w] = ValidBits(w);
 
    m_complete = true;
 }
@@ -176,21 +171,21 @@ void Info::ResizeBits()
    if (m_buff_synced)   free(m_buff_synced);
    if (m_buff_written)  free(m_buff_written);
    if (m_buff_prefetch) free(m_buff_prefetch);
+   if (m_buff_full)     free(m_buff_full);
 
-   m_bitvecSizeInBits = (m_store.m_file_size - 1) / m_store.m_buffer_size + 1;
+   m_bitvecSizeInBits  = (m_store.m_file_size - 1) / m_store.m_buffer_size + 1;
+   m_bitvecSizeInWords = (m_bitvecSizeInBits + 63) / 64;
 
-   m_buff_written = (unsigned char*) malloc(GetBitvecSizeInBytes());
-   m_buff_synced  = (unsigned char*) malloc(GetBitvecSizeInBytes());
-   memset(m_buff_written, 0, GetBitvecSizeInBytes());
-   memset(m_buff_synced,  0, GetBitvecSizeInBytes());
+   m_buff_written = (uint64_t*) calloc(m_bitvecSizeInWords, sizeof(uint64_t));
+   m_buff_synced  = (uint64_t*) calloc(m_bitvecSizeInWords, sizeof(uint64_t));
+   m_buff_full    = (uint64_t*) calloc((m_bitvecSizeInWords + 63) / 64, sizeof(uint64_t));
 
    m_missingBlocks = m_bitvecSizeInBits;
    m_complete      = false;
 
    if (m_hasPrefetchBuffer)
    {
-      m_buff_prefetch = (unsigned char*) malloc(GetBitvecSizeInBytes());
-      memset(m_buff_prefetch, 0, GetBitvecSizeInBytes());
+      m_buff_prefetch = (uint64_t*) calloc(m_bitvecSizeInWords, sizeof(uint64_t));
    }
    else
    {
@@ -198,6 +193,92 @@ void Info::ResizeBits()
    }
 }
 
+//------------------------------------------------------------------------------
+// Word level queries of the download state
+//------------------------------------------------------------------------------
+
+int Info::CountBitsWrittenInRng(int firstIdx, int lastIdx) const
+{
+   const int fw = firstIdx >> 6;
+   const int lw = (lastIdx - 1) >> 6;
+   const uint64_t fmask = ~0ULL << (firstIdx & 63);
+   const uint64_t lmask = ~0ULL >> (63 - ((lastIdx - 1) & 63));
+
+   if (fw == lw) return __builtin_popcountll(m_buff_written[fw] & fmask & lmask);
+
+   int cnt = __builtin_popcountll(m_buff_written[fw] & fmask) +
+             __builtin_popcountll(m_buff_written[lw] & lmask);
+   for (int w = fw + 1; w < lw; ++w)
+      cnt += __builtin_popcountll(m_buff_written[w]);
+
+   return cnt;
+}
+
+int Info::FirstBlockNotWrittenInRng(int firstIdx, int lastIdx) const
+{
+   if (firstIdx >= lastIdx) return -1;
+
+   const int lw = (lastIdx - 1) >> 6;
+   int       w  = firstIdx >> 6;
+   uint64_t  missing = ~m_buff_written[w] & (~0ULL << (firstIdx & 63));
+
+   while ( ! missing)
+   {
+      // Use the summary to skip over the words that are fully written. The
+      // summary bits beyond the last word are never set.
+      if (++w > lw) return -1;
+
+      uint64_t partial = ~m_buff_full[w >> 6] & (~0ULL << (w & 63));
+      int      s       = w >> 6;
+      while ( ! partial)
+      {
+         if ((++s << 6) > lw) return -1;
+         partial = ~m_buff_full[s];
+      }
+      w = (s << 6) + __builtin_ctzll(partial);
+      if (w > lw) return -1;
+
+      missing = ~m_buff_written[w];
+   }
+
+   const int i = (w << 6) + __builtin_ctzll(missing);
+   return i < lastIdx ? i : -1;
+}
+
+void Info::UpdateFullWords()
+{
+   memset(m_buff_full, 0, ((m_bitvecSizeInWords + 63) / 64) * sizeof(uint64_t));
+
+   for (int w = 0; w < m_bitvecSizeInWords; ++w)
+      if (m_buff_written[w] == ValidBits(w))
+         m_buff_full[w >> 6] |= cfiBIT(w);
+}
+
+void Info::UpdateDownloadCompleteStatus()
+{
+   // Bits beyond the last block may come in set from a cinfo file.
+   if (m_bitvecSizeInWords)
+      m_buff_written[m_bitvecSizeInWords - 1] &= ValidBits(m_bitvecSizeInWords - 1);
+
+   UpdateFullWords();
+
+   m_missingBlocks = m_bitvecSizeInBits ? CountBlocksNotWrittenInRng(0, m_bitvecSizeInBits) : 0;
+   m_complete      = (m_missingBlocks == 0);
+}
+
+//------------------------------------------------------------------------------
+
+void Info::DiskOrder(uint64_t *buff) const
+{
+   // The cinfo file keeps block i in bit i%8 of byte i/8, which is how the
+   // words are laid out in memory on little endian hosts. This converts to
+   // and from that layout on big endian ones.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+   for (int w = 0; w < m_bitvecSizeInWords; ++w)
+      buff[w] = __builtin_bswap64(buff[w]);
+#endif
+}
+
 //------------------------------------------------------------------------------
 
 void Info::ResetCkSumCache()
@@ -272,17 +353,18 @@ bool Info::Write(XrdOssDF* fp, const char *dname, const char *fname)
 
    FpHelper w(fp, 0, m_trace, m_traceID, trace_pfx);
 
-   if (w.Write(s_defaultVersion) ||
-       w.Write(m_store) ||
-       w.Write(CalcCksumStore()) ||
-       w.WriteRaw(m_buff_synced, GetBitvecSizeInBytes()) ||
-       w.WriteRaw(m_astats.data(), m_store.m_astatSize * sizeof(AStat)) ||
-       w.Write(CalcCksumSyncedAndAStats()))
-   {
-      return false;
-   }
+   DiskOrder(m_buff_synced);
 
-   return true;
+   bool failed = w.Write(s_defaultVersion) ||
+                 w.Write(m_store) ||
+                 w.Write(CalcCksumStore()) ||
+                 w.WriteRaw(m_buff_synced, GetBitvecSizeInBytes()) ||
+                 w.WriteRaw(m_astats.data(), m_store.m_astatSize * sizeof(AStat)) ||
+                 w.Write(CalcCksumSyncedAndAStats());
+
+   DiskOrder(m_buff_synced);
+
+   return ! failed;
 }
 
 //------------------------------------------------------------------------------
@@ -345,7 +427,8 @@ bool Info::Read(XrdOssDF *fp, const char *dname, const char *fname)
       return false;
    }
 
-   memcpy(m_buff_written, m_buff_synced, GetBitvecSizeInBytes());
+   DiskOrder(m_buff_synced);
+   memcpy(m_buff_written, m_buff_synced, m_bitvecSizeInWords * sizeof(uint64_t));
 
    UpdateDownloadCompleteStatus();
 
@@ -506,11 +589,10 @@ bool Info::ReadV3(XrdOssDF* fp, off_t off, const char *dname, const char *fname)
    ResizeBits();
 
    if (r.ReadRaw(m_buff_synced, GetBitvecSizeInBytes())) return false;
-   memcpy(m_buff_written, m_buff_synced, GetBitvecSizeInBytes());
 
    char fileCksum[16], tmpCksum[16];
    if (r.ReadRaw(&fileCksum[0], 16)) return false;
-   CalcCksumMd5(&m_buff_synced[0], &tmpCksum[0]);
+   CalcCksumMd5((unsigned char*) m_buff_synced, &tmpCksum[0]);
 
    if (memcmp(&fileCksum[0], &tmpCksum[0], 16))
    {
@@ -518,6 +600,9 @@ bool Info::ReadV3(XrdOssDF* fp, off_t off, const char *dname, const char *fname)
       return false;
    }
 
+   DiskOrder(m_buff_synced);
+   memcpy(m_buff_written, m_buff_synced, m_bitvecSizeInWords * sizeof(uint64_t));
+
    // cache complete status
    UpdateDownloadCompleteStatus();
 
@@ -570,11 +655,10 @@ bool Info::ReadV2(XrdOssDF* fp, off_t off, const char *dname, const char *fname)
    ResizeBits();
 
    if (r.ReadRaw(m_buff_synced, GetBitvecSizeInBytes())) return false;
-   memcpy(m_buff_written, m_buff_synced, GetBitvecSizeInBytes());
 
    char fileCksum[16], tmpCksum[16];
    if (r.ReadRaw(&fileCksum[0], 16)) return false;
-   CalcCksumMd5(&m_buff_synced[0], &tmpCksum[0]);
+   CalcCksumMd5((unsigned char*) m_buff_synced, &tmpCksum[0]);
 
    if (memcmp(&fileCksum[0], &tmpCksum[0], 16))
    {
@@ -582,6 +666,9 @@ bool Info::ReadV2(XrdOssDF* fp, off_t off, const char *dname, const char *fname)
       return false;
    }
 
+   DiskOrder(m_buff_synced);
+   memcpy(m_buff_written, m_buff_synced, m_bitvecSizeInWords * sizeof(uint64_t));
+
    // cache complete status
    UpdateDownloadCompleteStatus();
 
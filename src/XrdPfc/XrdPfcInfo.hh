@@ -20,6 +20,7 @@
 
 #include "XrdPfcTypes.hh"
 
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <cassert>
@@ -195,6 +196,12 @@ public:
    //---------------------------------------------------------------------
    int CountBlocksNotWrittenInRng(int firstIdx, int lastIdx) const;
 
+   //---------------------------------------------------------------------
+   //! Find the first block in the given range that is not written
+   //! @return block index or -1 if all blocks in the range are written
+   //---------------------------------------------------------------------
+   int FirstBlockNotWrittenInRng(int firstIdx, int lastIdx) const;
+
    //---------------------------------------------------------------------
    //! Get size of download-state bit-vector in bytes.
    //---------------------------------------------------------------------
@@ -316,20 +323,29 @@ public:
 protected:
    XrdSysTrace*   m_trace;
 
+   // The state vectors hold the bit for block i in bit i%64 of word i/64,
+   // the little endian image of which is what the cinfo file stores.
    Store          m_store;
-   unsigned char *m_buff_synced;             //!< disk written state vector
-   unsigned char *m_buff_written;            //!< download state vector
-   unsigned char *m_buff_prefetch;           //!< prefetch statistics
+   uint64_t      *m_buff_synced;             //!< disk written state vector
+   uint64_t      *m_buff_written;            //!< download state vector
+   uint64_t      *m_buff_prefetch;           //!< prefetch statistics
+   uint64_t      *m_buff_full;               //!< bit per word of m_buff_written that has all its blocks written
    std::vector<AStat>  m_astats;             //!< access records
 
    int  m_version;
    int  m_bitvecSizeInBits;                  //!< cached
+   int  m_bitvecSizeInWords;                 //!< cached
    int  m_missingBlocks;                     //!< cached, updated in SetBitWritten()
    bool m_complete;                          //!< cached; if false, set to true when missingBlocks hit zero
    bool m_hasPrefetchBuffer;                 //!< constains current prefetch score
 
 private:
-   inline unsigned char cfiBIT(int n) const { return 1 << n; }
+   static uint64_t cfiBIT(int i) { return 1ULL << (i & 63); }
+
+   uint64_t ValidBits(int w) const;
+   int      CountBitsWrittenInRng(int firstIdx, int lastIdx) const;
+   void     DiskOrder(uint64_t *buff) const;
+   void     UpdateFullWords();
 
    // Reading functions for older cinfo file formats
    bool ReadV2(XrdOssDF* fp, off_t off, const char *dname, const char *fname);
@@ -342,21 +358,23 @@ private:
 
 inline bool Info::TestBitWritten(int i) const
 {
-   const int cn = i/8;
-   assert(cn < GetBitvecSizeInBytes());
+   const int w = i >> 6;
+   assert(w < m_bitvecSizeInWords);
 
-   const int off = i - cn*8;
-   return (m_buff_written[cn] & cfiBIT(off)) != 0;
+   return (m_buff_written[w] & cfiBIT(i)) != 0;
 }
 
 inline void Info::SetBitWritten(int i)
 {
-   const int cn = i/8;
-   assert(cn < GetBitvecSizeInBytes());
+   const int w = i >> 6;
+   assert(w < m_bitvecSizeInWords);
 
-   const int off = i - cn*8;
+   if (m_buff_written[w] & cfiBIT(i)) return;
 
-   m_buff_written[cn] |= cfiBIT(off);
+   m_buff_written[w] |= cfiBIT(i);
+
+   if (m_buff_written[w] == ValidBits(w))
+      m_buff_full[w >> 6] |= cfiBIT(w);
 
    if (--m_missingBlocks == 0)
       m_complete = true;
@@ -366,42 +384,44 @@ inline void Info::SetBitPrefetch(int i)
 {
    if (!m_buff_prefetch) return;
 
-   const int cn = i/8;
-   assert(cn < GetBitvecSizeInBytes());
+   const int w = i >> 6;
+   assert(w < m_bitvecSizeInWords);
 
-   const int off = i - cn*8;
-   m_buff_prefetch[cn] |= cfiBIT(off);
+   m_buff_prefetch[w] |= cfiBIT(i);
 }
 
 inline bool Info::TestBitPrefetch(int i) const
 {
    if (!m_buff_prefetch) return false;
 
-   const int cn = i/8;
-   assert(cn < GetBitvecSizeInBytes());
+   const int w = i >> 6;
+   assert(w < m_bitvecSizeInWords);
 
-   const int off = i - cn*8;
-   return (m_buff_prefetch[cn] & cfiBIT(off)) != 0;
+   return (m_buff_prefetch[w] & cfiBIT(i)) != 0;
 }
 
 inline void Info::SetBitSynced(int i)
 {
-   const int cn = i/8;
-   assert(cn < GetBitvecSizeInBytes());
+   const int w = i >> 6;
+   assert(w < m_bitvecSizeInWords);
 
-   const int off = i - cn*8;
-   m_buff_synced[cn] |= cfiBIT(off);
+   m_buff_synced[w] |= cfiBIT(i);
 }
 
 //------------------------------------------------------------------------------
 
-inline int Info::GetNDownloadedBlocks() const
+inline uint64_t Info::ValidBits(int w) const
 {
-   int cntd = 0;
-   for (int i = 0; i < m_bitvecSizeInBits; ++i)
-      if (TestBitWritten(i)) cntd++;
+   // All bits of a word are used except, possibly, for the last one.
+   const int rem = m_bitvecSizeInBits & 63;
+   return (w == m_bitvecSizeInWords - 1 && rem) ? (1ULL << rem) - 1 : ~0ULL;
+}
 
-   return cntd;
+//------------------------------------------------------------------------------
+
+inline int Info::GetNDownloadedBlocks() const
+{
+   return m_bitvecSizeInBits - m_missingBlocks;
 }
 
 inline long long Info::GetNDownloadedBytes() const
@@ -411,8 +431,8 @@ inline long long Info::GetNDownloadedBytes() const
 
 inline int Info::GetLastDownloadedBlock() const
 {
-   for (int i = m_bitvecSizeInBits - 1; i >= 0; --i)
-      if (TestBitWritten(i)) return i;
+   for (int w = m_bitvecSizeInWords - 1; w >= 0; --w)
+      if (m_buff_written[w]) return (w << 6) + 63 - __builtin_clzll(m_buff_written[w]);
 
    return -1;
 }
@@ -451,19 +471,9 @@ inline bool Info::IsComplete() const
 
 inline int Info::CountBlocksNotWrittenInRng(int firstIdx, int lastIdx) const
 {
-   // TODO rewrite to use full byte comparisons outside of edges ?
-   // Also, it seems to be always called with firstIdx = 0, lastIdx = m_bitvecSizeInBits.
-   int cnt = 0;
-   for (int i = firstIdx; i < lastIdx; ++i)
-      if (! TestBitWritten(i)) ++cnt;
+   if (firstIdx >= lastIdx) return 0;
 
-   return cnt;
-}
-
-inline void Info::UpdateDownloadCompleteStatus()
-{
-   m_missingBlocks = CountBlocksNotWrittenInRng(0, m_bitvecSizeInBits);
-   m_complete      = (m_missingBlocks == 0);
+   return lastIdx - firstIdx - CountBitsWrittenInRng(firstIdx, lastIdx);
 }
 
 inline long long Info::GetBufferSize() const
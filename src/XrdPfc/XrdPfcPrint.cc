@@ -89,11 +89,7 @@ void Print::printFileJson(const std::string& path)
       return;
    }
 
-   int cntd = 0;
-   for (int i = 0; i < cfi.GetNBlocks(); ++i)
-   {
-      if (cfi.TestBitWritten(i)) cntd++;
-   }
+   int cntd = cfi.GetNDownloadedBlocks();
    const Info::Store& store = cfi.RefStoredData();
    char  timeBuff[128];
    strftime(timeBuff, 128, "%c", localtime(&store.m_creationTime));
@@ -182,11 +178,7 @@ void Print::printFile(const std::string& path)
       return;
    }
 
-   int cntd = 0;
-   for (int i = 0; i < cfi.GetNBlocks(); ++i)
-   {
-      if (cfi.TestBitWritten(i)) cntd++;
-   }
+   int cntd = cfi.GetNDownloadedBlocks();
    const Info::Store& store = cfi.RefStoredData();
    char  timeBuff[128];
    strftime(timeBuff, 128, "%c", localtime(&store.m_creationTime));
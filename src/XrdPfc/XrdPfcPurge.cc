@@ -74,8 +74,11 @@ long long UnlinkPurgeStateFilesInMap(FPurgeState& purgeState, long long bytes_to
       // remove data file
       if (oss.Stat(dataPath.c_str(), &fstat) == XrdOssOK)
       {
-         st_blocks_to_remove -= it->second.nStBlocks;
-         deleted_st_blocks   += it->second.nStBlocks;
+         if (it->second.spacePurge)
+         {
+            st_blocks_to_remove -= it->second.nStBlocks;
+            deleted_st_blocks   += it->second.nStBlocks;
+         }
          ++deleted_file_count;
 
          oss.Unlink(dataPath.c_str());
@@ -125,6 +128,10 @@ void OldStylePurgeDriver(DataFsPurgeshot &ps)
             TRACE(Debug, trc_pfx << "PurgePin scanning dir " << ppit->path.c_str() << " to remove " << ppit->nBytesToRecover << " bytes");
 
             FPurgeState fps(ppit->nBytesToRecover, oss);
+            if (conf.is_fast_tier_set())
+            {
+               fps.setSkipSpace(conf.m_fast_space);
+            }
             bool scan_ok = fps.TraverseNamespace(ppit->path.c_str());
             if ( ! scan_ok) {
                TRACE(Warning, trc_pfx << "purge-pin scan of directory failed for " << ppit->path);
@@ -158,6 +165,10 @@ void OldStylePurgeDriver(DataFsPurgeshot &ps)
       {
          purgeState.setUVKeepMinTime(time(0) - conf.m_cs_UVKeep);
       }
+      if (conf.is_fast_tier_set())
+      {
+         purgeState.setSkipSpace(conf.m_fast_space);
+      }
 
       // Make a map of file paths, sorted by access time.
       bool scan_ok = purgeState.TraverseNamespace("/");
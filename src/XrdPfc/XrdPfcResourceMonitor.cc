@@ -392,6 +392,12 @@ void ResourceMonitor::heart_beat()
             m_purge_task_active = m_purge_task_complete = false;
          }
       }
+      if (m_tier_task_active) {
+         MutexHolder _lck(m_purge_task_cond);
+         if (m_tier_task_complete) {
+            m_tier_task_active = m_tier_task_complete = false;
+         }
+      }
 
       time_t queue_swap_time = time(0);
 
@@ -426,7 +432,7 @@ void ResourceMonitor::heart_beat()
          };
 
          // Potentially prune the empty leaf dirs even less frequently, once per hour, maybe?
-         bool purge_leaf_dirs = do_sshot_report && ! m_purge_task_active;
+         bool purge_leaf_dirs = do_sshot_report && ! m_purge_task_active && ! m_tier_task_active;
          m_fs_state.update_stats_and_usages(queue_swap_time, purge_leaf_dirs, unlink_foo);
 
          // This reporting into log/stdout is to be removed.
@@ -476,6 +482,11 @@ void ResourceMonitor::heart_beat()
          next_purge_check_time = now + s_purge_check_interval;
          if (do_purge_report) next_purge_report_time = now + s_purge_report_interval;
          if (do_purge_cold_files) next_purge_cold_files_time = now + s_purge_cold_files_interval;
+
+         if (conf.is_fast_tier_set())
+         {
+            perform_tier_check(do_purge_report, do_purge_report ? TRACE_Info : TRACE_Debug);
+         }
       }
 
    } // end while forever
@@ -568,6 +579,14 @@ void ResourceMonitor::update_vs_and_file_usage_info()
    }
    m_fs_state.m_meta_total = vsi.Total;
    m_fs_state.m_meta_used  = vsi.Total - vsi.Free;
+   if (conf.is_fast_tier_set()) {
+      if (m_oss.StatVS(&vsi, conf.m_fast_space.c_str(), 1) < 0) {
+         TRACE(Error, trc_pfx << "can't get StatVS for oss space '" << conf.m_fast_space << "'. This is a fatal error.");
+         _exit(1);
+      }
+      m_fs_state.m_fast_total = vsi.Total;
+      m_fs_state.m_fast_used  = vsi.Total - vsi.Free;
+   }
 }
 
 long long ResourceMonitor::get_file_usage_bytes_to_remove(const DataFsPurgeshot &ps, long long write_estimate, int tl)
@@ -688,6 +707,14 @@ void ResourceMonitor::perform_purge_check(bool purge_cold_files, int tl)
    DataFsPurgeshot &ps = *psp;
 
    ps.m_file_usage = 512ll * m_current_usage_in_st_blocks;
+   if (conf.is_fast_tier_set())
+   {
+      // Disk usage and watermarks refer to the data space, the fast space is kept in check by
+      // demotion. The fast space is assumed to have partitions of its own so its StatVS usage
+      // is what its files take up.
+      ps.m_file_usage -= std::min(ps.m_fast_used, ps.m_file_usage);
+      TRACE_INT(tl, trc_pfx << "File usage in data space " << ps.m_file_usage << ", in fast space " << ps.m_fast_used);
+   }
    // These are potentially wrong as cache might be writing over preallocated byte ranges.
    ps.m_estimated_writes_from_writeq = Cache::GetInstance().WritesSinceLastCall();
    // Can have another estimate based on eiter writes or st-blocks from purge-stats, once we have them.
@@ -734,6 +761,10 @@ void ResourceMonitor::perform_purge_check(bool purge_cold_files, int tl)
       TRACE(Warning, trc_pfx << "purge required but previous purge task is still active!");
       return;
    }
+   if (m_tier_task_active) {
+      TRACE(Warning, trc_pfx << "purge required but tier task is still active!");
+      return;
+   }
 
    TRACE(Info, trc_pfx << "scheduling purge task.");
 
@@ -819,6 +850,70 @@ void ResourceMonitor::perform_purge_task_cleanup()
    Cache::GetInstance().ClearPurgeProtectedSet();
 }
 
+//------------------------------------------------------------------------------
+// Fast tier -- demotion to the data space and promotion back.
+//------------------------------------------------------------------------------
+
+namespace XrdPfc
+{
+   void TierDriver(long long bytes_to_demote, long long bytes_to_promote);
+}
+
+void ResourceMonitor::perform_tier_check(bool promote, int tl)
+{
+   static const char *trc_pfx = "perform_tier_check() ";
+   const Configuration &conf = Cache::Conf();
+
+   long long used = m_fs_state.m_fast_used;
+
+   long long bytes_to_demote  = used > conf.m_fastUsageHWM ? used - conf.m_fastUsageLWM : 0;
+   long long bytes_to_promote = promote && conf.is_promotion_on() && used < conf.m_fastUsageLWM ?
+                                conf.m_fastUsageLWM - used : 0;
+
+   TRACE_INT(tl, trc_pfx << "Fast tier usage " << used << " of " << m_fs_state.m_fast_total
+                         << " B, bytes_to_demote = " << bytes_to_demote << ", bytes_to_promote = " << bytes_to_promote);
+
+   if ( ! bytes_to_demote && ! bytes_to_promote) {
+      return;
+   }
+   if (m_tier_task_active) {
+      TRACE(Debug, trc_pfx << "previous tier task is still active.");
+      return;
+   }
+   if (m_purge_task_active) {
+      TRACE(Info, trc_pfx << "tier task required but purge task is active, postponing.");
+      return;
+   }
+
+   m_tier_task_active = true;
+
+   struct TierDriverJob : public XrdJob
+   {
+      long long m_bytes_to_demote, m_bytes_to_promote;
+
+      TierDriverJob(long long btd, long long btp) :
+         XrdJob("XrdPfc::ResourceMonitor::TierDriver"),
+         m_bytes_to_demote(btd), m_bytes_to_promote(btp)
+      {}
+
+      void DoIt() override
+      {
+         TierDriver(m_bytes_to_demote, m_bytes_to_promote); // In XrdPfcTier.cc
+
+         ResourceMonitor &rm = Cache::ResMon();
+         {
+            MutexHolder _lck(rm.m_purge_task_cond);
+            rm.m_tier_task_complete = true;
+            rm.m_purge_task_cond.Signal();
+         }
+
+         delete this;
+      }
+   };
+
+   Cache::schedP->Schedule( new TierDriverJob(bytes_to_demote, bytes_to_promote) );
+}
+
 //==============================================================================
 // Main thread function, do initial test, then enter heart_beat().
 //==============================================================================
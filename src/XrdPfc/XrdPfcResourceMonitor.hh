@@ -250,6 +250,8 @@ public:
    // When m_purge_task_active == true, DirState entries are not removed from the tree to
    // allow purge thread to report cleared files directly via DirState ptr.
    // Note, DirState removal happens during stat propagation traversal.
+   bool           m_tier_task_active    {false}; // as above, for moves between the fast and data spaces
+   bool           m_tier_task_complete  {false};
 
    // Purge helpers etc.
    void update_vs_and_file_usage_info();
@@ -257,6 +259,8 @@ public:
 
    void perform_purge_task(DataFsPurgeshot &ps);
    void perform_purge_task_cleanup();
+
+   void perform_tier_check(bool promote, int tl);
 };
 
 }
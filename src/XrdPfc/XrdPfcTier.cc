@@ -0,0 +1,230 @@
+#include "XrdPfc.hh"
+#include "XrdPfcResourceMonitor.hh"
+#include "XrdPfcFsTraversal.hh"
+#include "XrdPfcInfo.hh"
+#include "XrdPfcTierState.hh"
+#include "XrdPfcTrace.hh"
+
+#include "XrdOss/XrdOss.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace
+{
+   XrdSysTrace* GetTrace() { return XrdPfc::Cache::GetInstance().GetTrace(); }
+   const char *m_traceID = "ResourceMonitor";
+}
+
+//==============================================================================
+// TierDriver
+//
+// Files live in the fast space or in the data space as a whole, this is how
+// oss spaces work. Reads go to whichever space holds the file, so all that is
+// needed is to move files between the spaces:
+// - demotion: when the fast space is above its high watermark the files with
+//   the oldest access time are moved to the data space until the low
+//   watermark is reached;
+// - promotion: when the fast space is below its low watermark, complete files
+//   in the data space that were accessed often enough within the promotion
+//   window are moved to the fast space, most accessed first.
+//==============================================================================
+namespace XrdPfc
+{
+
+// Feeds the files found in the namespace to the TierState. Only files in the
+// fast space are looked at for demotion; for promotion the access records of
+// recently accessed files in the data space are read as well.
+
+class TierScan
+{
+   XrdOss      &m_oss;
+   TierState   &m_ts;
+   std::string  m_fast_space;
+
+   int count_recent_accesses(FsTraversal &fst, const std::string &i_name, bool &is_complete)
+   {
+      int cnt = 0;
+      is_complete = false;
+
+      XrdOssDF *fh = nullptr;
+      if (fst.open_at_ro(i_name.c_str(), fh) != XrdOssOK)
+      {
+         fst.close_delete(fh);
+         return 0;
+      }
+
+      Info info(GetTrace(), false);
+      if (info.Read(fh, fst.m_current_path.c_str(), i_name.c_str()))
+      {
+         is_complete = info.IsComplete();
+
+         const time_t min_time = m_ts.promote_min_time();
+         for (const Info::AStat &as : info.RefAStats())
+         {
+            if (as.AttachTime >= min_time || as.DetachTime >= min_time)
+               cnt += 1 + as.NumMerged;
+         }
+      }
+      fst.close_delete(fh);
+
+      return cnt;
+   }
+
+   void check_file(FsTraversal &fst, const std::string &f_name, const FsTraversal::FilePairStat &fps)
+   {
+      const time_t atime = fps.stat_cinfo.st_mtime;
+
+      if (is_in_oss_space(m_oss, fst.m_current_path + f_name, m_fast_space))
+      {
+         m_ts.add_fast_file(fst.m_current_path, f_name, fps.stat_data, atime);
+      }
+      else if (m_ts.wants_data_file(atime))
+      {
+         bool is_complete;
+         int  nacc = count_recent_accesses(fst, f_name + Info::s_infoExtension, is_complete);
+
+         m_ts.add_data_file(fst.m_current_path, f_name, fps.stat_data, nacc, is_complete);
+      }
+   }
+
+   void process_dir_and_recurse(FsTraversal &fst)
+   {
+      for (auto it = fst.m_current_files.begin(); it != fst.m_current_files.end(); ++it)
+      {
+         if (it->second.has_both())
+            check_file(fst, it->first, it->second);
+      }
+
+      std::vector<std::string> dirs;
+      dirs.swap(fst.m_current_dirs);
+      for (auto &dname : dirs)
+      {
+         if (fst.cd_down(dname))
+         {
+            process_dir_and_recurse(fst);
+            fst.cd_up();
+         }
+      }
+   }
+
+public:
+   TierScan(XrdOss &oss, TierState &ts, const std::string &fast_space) :
+      m_oss(oss), m_ts(ts), m_fast_space(fast_space)
+   {}
+
+   bool TraverseNamespace(const char *root_path)
+   {
+      bool success_p = true;
+
+      FsTraversal fst(m_oss);
+      fst.m_protected_top_dirs.insert("pfc-stats");
+
+      if (fst.begin_traversal(root_path))
+      {
+         process_dir_and_recurse(fst);
+      }
+      else
+      {
+         success_p = false;
+      }
+      fst.end_traversal();
+
+      m_ts.finalize();
+
+      return success_p;
+   }
+};
+
+// -------------------------------------------------------------------------------------
+
+void TierDriver(long long bytes_to_demote, long long bytes_to_promote)
+{
+   static const char *trc_pfx = "TierDriver ";
+   auto &cache = Cache::GetInstance();
+   const auto &conf = Cache::Conf();
+   auto &resmon = Cache::ResMon();
+
+   time_t tier_start = time(0);
+
+   TierState ts(bytes_to_demote, bytes_to_promote, tier_start, conf.m_promoteWindow, conf.m_promoteMinAccesses);
+   TierScan  scan(*cache.GetOss(), ts, conf.m_fast_space);
+   if ( ! scan.TraverseNamespace("/"))
+   {
+      TRACE(Error, trc_pfx << "namespace traversal failed.");
+      return;
+   }
+
+   int n_demoted = 0, n_purged = 0, n_promoted = 0, n_busy = 0;
+   long long demoted_bytes = 0, promoted_bytes = 0;
+
+   for (auto it = ts.refDemoteMap().begin(); it != ts.refDemoteMap().end() && demoted_bytes < bytes_to_demote; ++it)
+   {
+      const TierState::Candidate &c = it->second;
+      bool purged = false;
+
+      // Partially cached files keep their holes when copied. Should the data
+      // space not be able to take a file, drop it instead.
+      int ret = cache.RelocateFile(c.path, conf.m_data_space);
+      if (ret == -ENOSPC)
+      {
+         ret = cache.UnlinkFile(c.path, true);
+         if (ret == 0)
+         {
+            resmon.register_file_purge(c.path, c.nStBlocks);
+            purged = true;
+            ++n_purged;
+         }
+      }
+      else if (ret == 0)
+      {
+         ++n_demoted;
+      }
+
+      if (ret == 0)
+      {
+         demoted_bytes += 512ll * c.nStBlocks;
+         TRACE(Dump, trc_pfx << (purged ? "purged " : "demoted ") << (c.is_sparse() ? "sparse file " : "")
+                             << c.path << ", time: " << it->first);
+      }
+      else if (ret == -EBUSY)
+      {
+         ++n_busy;
+      }
+      else
+      {
+         TRACE(Warning, trc_pfx << "failed moving " << c.path << " to space " << conf.m_data_space << ", err=" << ret);
+      }
+   }
+
+   for (auto &c : ts.refPromoteVec())
+   {
+      if (promoted_bytes >= bytes_to_promote) break;
+      if (promoted_bytes + c.size > bytes_to_promote) continue;
+
+      int ret = cache.RelocateFile(c.path, conf.m_fast_space);
+      if (ret == 0)
+      {
+         ++n_promoted;
+         promoted_bytes += c.size;
+         TRACE(Dump, trc_pfx << "promoted " << c.path << ", accesses: " << c.nAccesses);
+      }
+      else if (ret == -EBUSY)
+      {
+         ++n_busy;
+      }
+      else
+      {
+         TRACE(Warning, trc_pfx << "failed moving " << c.path << " to space " << conf.m_fast_space << ", err=" << ret);
+      }
+   }
+
+   TRACE(Info, trc_pfx << "Finished in " << time(0) - tier_start << " s, skipped " << n_busy << " active files.");
+   TRACE(Info, trc_pfx << "Demoted " << n_demoted << " files, purged " << n_purged << " not fitting the data space, "
+                       << demoted_bytes << " B in total.");
+   TRACE(Info, trc_pfx << "Promoted " << n_promoted << " files, " << promoted_bytes << " B in total.");
+}
+
+} // end namespace XrdPfc
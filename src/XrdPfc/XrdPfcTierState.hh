@@ -0,0 +1,146 @@
+#ifndef __XRDPFC_TIERSTATE_HH__
+#define __XRDPFC_TIERSTATE_HH__
+
+#include "XrdOss/XrdOss.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace XrdPfc
+{
+
+//------------------------------------------------------------------------------
+//! Check if the extended attributes returned by XrdOss::StatXA() place a file
+//! in the given oss space, i.e., if they hold "oss.cgroup=<space>".
+//------------------------------------------------------------------------------
+inline bool is_in_oss_space(const char *xattrs, const std::string &space)
+{
+   const char *cgp = strstr(xattrs, "oss.cgroup=");
+   if ( ! cgp) return false;
+   cgp += 11;
+   const char *end = strchr(cgp, '&');
+   size_t len = end ? (size_t) (end - cgp) : strlen(cgp);
+   return len == space.length() && space.compare(0, len, cgp, len) == 0;
+}
+
+//------------------------------------------------------------------------------
+//! Check if a data file lives in the given oss space.
+//------------------------------------------------------------------------------
+inline bool is_in_oss_space(XrdOss &oss, const std::string &path, const std::string &space)
+{
+   char buff[1024];
+   int  blen = sizeof(buff);
+
+   if (oss.StatXA(path.c_str(), buff, blen) != XrdOssOK) return false;
+   return is_in_oss_space(buff, space);
+}
+
+//------------------------------------------------------------------------------
+//! Selection of the files to be moved between the fast and the data space.
+//! The namespace traversal feeds every file to it, fast-space files with
+//! add_fast_file() and data-space files with add_data_file():
+//! - demotion candidates are the fast-space files with the oldest access time
+//!   that together hold at least the number of bytes to demote;
+//! - promotion candidates are the complete data-space files accessed at least
+//!   the minimum number of times within the promotion window, most accessed
+//!   first.
+//------------------------------------------------------------------------------
+class TierState
+{
+public:
+   struct Candidate
+   {
+      std::string path;       // data file
+      long long   nStBlocks;
+      long long   size;
+      int         nAccesses;
+
+      Candidate(const std::string &dname, const std::string &fname, const struct stat &fstat, int nacc) :
+         path(dname + fname), nStBlocks(fstat.st_blocks), size(fstat.st_size), nAccesses(nacc)
+      {}
+
+      bool is_sparse() const { return 512ll * nStBlocks < size; }
+   };
+
+   typedef std::multimap<time_t, Candidate> map_t;
+   typedef map_t::iterator                  map_i;
+
+private:
+   time_t    m_now;
+   int       m_promoteWindow;
+   int       m_promoteMinAccesses;
+
+   long long m_nStBlocksDemoteReq;
+   long long m_nStBlocksDemoteAccum = 0;
+   map_t     m_demoteMap;                 // fast-space files, oldest access first
+
+   bool      m_promote;
+   std::vector<Candidate> m_promoteVec;   // data-space files accessed often enough
+
+public:
+   TierState(long long bytes_to_demote, long long bytes_to_promote,
+             time_t now, int promote_window, int promote_min_accesses) :
+      m_now(now), m_promoteWindow(promote_window), m_promoteMinAccesses(promote_min_accesses),
+      m_nStBlocksDemoteReq(bytes_to_demote > 0 ? (bytes_to_demote >> 9) + 1ll : 0),
+      m_promote(bytes_to_promote > 0 && promote_min_accesses > 0)
+   {}
+
+   time_t promote_min_time() const { return m_now - m_promoteWindow; }
+
+   //! True if fast-space files are to be passed in at all.
+   bool wants_fast_files() const { return m_nStBlocksDemoteReq > 0; }
+
+   //! True if a data-space file last accessed at atime could be promoted,
+   //! i.e., if its access record should be read and passed in.
+   bool wants_data_file(time_t atime) const { return m_promote && atime >= promote_min_time(); }
+
+   void add_fast_file(const std::string &dname, const std::string &fname, const struct stat &fstat, time_t atime)
+   {
+      if ( ! wants_fast_files()) return;
+
+      if (m_nStBlocksDemoteAccum < m_nStBlocksDemoteReq || atime < m_demoteMap.rbegin()->first)
+      {
+         m_demoteMap.insert(std::make_pair(atime, Candidate(dname, fname, fstat, 0)));
+         m_nStBlocksDemoteAccum += fstat.st_blocks;
+
+         // remove newest files from map if necessary
+         while ( ! m_demoteMap.empty() &&
+                 m_nStBlocksDemoteAccum - m_demoteMap.rbegin()->second.nStBlocks >= m_nStBlocksDemoteReq)
+         {
+            m_nStBlocksDemoteAccum -= m_demoteMap.rbegin()->second.nStBlocks;
+            m_demoteMap.erase(--(m_demoteMap.rbegin().base()));
+         }
+      }
+   }
+
+   void add_data_file(const std::string &dname, const std::string &fname, const struct stat &fstat,
+                      int n_recent_accesses, bool is_complete)
+   {
+      // Partially cached files stay where they are, moving them would fill in the holes.
+      if (m_promote && is_complete && n_recent_accesses >= m_promoteMinAccesses)
+      {
+         m_promoteVec.push_back(Candidate(dname, fname, fstat, n_recent_accesses));
+      }
+   }
+
+   //! To be called once all files were passed in.
+   void finalize()
+   {
+      // Most accessed first.
+      std::stable_sort(m_promoteVec.begin(), m_promoteVec.end(),
+                       [](const Candidate &a, const Candidate &b) { return a.nAccesses > b.nAccesses; });
+   }
+
+   map_t&                  refDemoteMap()  { return m_demoteMap;  }
+   std::vector<Candidate>& refPromoteVec() { return m_promoteVec; }
+};
+
+}
+
+#endif
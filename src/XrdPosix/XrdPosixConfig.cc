@@ -232,6 +232,7 @@ bool XrdPosixConfig::initCCM(XrdOucPsx &parms)
 // optsf=<val> - optimize structured file: 1 = all, 0 = off, .<sfx> specific
 // optwr=1     - cache can be written to.
 // pagesz=n    - individual byte size of a page (can be suffized in k, m, g).
+// shards=n    - number of independent cache shards (default 1).
 //
 
 void XrdPosixConfig::initEnv(char *eData)
@@ -257,6 +258,10 @@ void XrdPosixConfig::initEnv(char *eData)
                                           myParms.minPages = Val;
                                          }
    initEnv(theEnv, "pagesz",    Val); if (Val >= 0) myParms.PageSize  = Val;
+   initEnv(theEnv, "shards",    Val); if (Val >  0)
+                                         {if (Val > 64) Val = 64;
+                                          myParms.Shards = Val;
+                                         }
 
 // Get Debug setting
 //
@@ -37,7 +37,9 @@
 #include <sys/uio.h>
 #include <sys/stat.h>
 
+#include "XrdOuc/XrdOucCacheFD.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
+#include "XrdOuc/XrdOucPgrwUtils.hh"
 #include "XrdOuc/XrdOucPrivateUtils.hh"
 #include "XrdPosix/XrdPosixCallBack.hh"
 #include "XrdPosix/XrdPosixConfig.hh"
@@ -48,6 +50,7 @@
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
 
+#include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPageSize.hh"
 #include "XrdSys/XrdSysTimer.hh"
@@ -65,6 +68,7 @@ extern XrdPosixStats    Stats;
 extern int              ddInterval;
 extern int              ddMaxTries;
 extern bool             autoPGRD;
+extern const char      *cacheFDPath;
 };
 
 namespace
@@ -122,7 +126,7 @@ XrdPosixFile::XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP,
                            int Opts)
              : XCio((XrdOucCacheIO *)this), PrepIO(0),
                mySize(0), myAtime(0), myCtime(0), myMtime(0), myRdev(0),
-               myInode(0), myMode(0), theCB(cbP), fLoc(0), cOpt(0),
+               myInode(0), myMode(0), theCB(cbP), fLoc(0), cacheFD(0), cOpt(0),
                isStream(Opts & isStrm ? 1 : 0)
 {
 // Handle path generation. This is trickt as we may have two namespaces. One
@@ -133,6 +137,20 @@ XrdPosixFile::XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP,
       else if (!XrdPosixXrootPath::P2L("file",path,fPath)) aOK = false;
               else if (!fPath) fPath = fOpen;
 
+// A co-located cache only passes the descriptor of a file to whoever opened
+// it through the cache, as proven by a capability sent along with the open.
+//
+   if (XrdPosixGlobals::cacheFDPath && !(Opts & isUpdt))
+      {char cap[XrdOucCacheFD::capSize+1];
+       if (!XrdOucCacheFD::NewCap(cap))
+          {std::string url(path);
+           url += (strchr(path, '?') ? '&' : '?');
+           url += "pfc.fdcap="; url += cap;
+           if (fPath != fOpen) free(fOpen);
+           fOpen = strdup(url.c_str());
+          }
+      }
+
 // Check for structured file check
 //
    if (sfSFX)
@@ -170,6 +188,10 @@ XrdPosixFile::~XrdPosixFile()
    if (fPath) free(fPath);
    if (fOpen != fPath) free(fOpen);
    if (fLoc)  free(fLoc);
+
+// Drop the descriptor of the locally cached file
+//
+   if (cacheFD) delete cacheFD;
 }
 
 /******************************************************************************/
@@ -303,6 +325,51 @@ void XrdPosixFile::DelayedDestroy(XrdPosixFile *fp)
    if (doPost) ddSem.Post();
 }
 
+/******************************************************************************/
+/* Private:                    c a c h e R e a d                              */
+/******************************************************************************/
+
+// Reads of blocks that a co-located cache told us it has are done directly on
+// the descriptor it passed. Anything else, including errors, goes the normal
+// way through the cache server.
+
+bool XrdPosixFile::cacheRead(char *buff, long long offs, int rlen, int &result)
+{
+   ssize_t bytes;
+
+   if (!cacheFD || !cacheFD->Covers(offs, rlen)) return false;
+
+   do {bytes = pread(cacheFD->FD(), buff, rlen, offs);}
+      while(bytes < 0 && errno == EINTR);
+   if (bytes < 0) return false;
+
+   result = static_cast<int>(bytes);
+   return true;
+}
+
+/******************************************************************************/
+/* Private:                   c a c h e R e a d V                             */
+/******************************************************************************/
+
+bool XrdPosixFile::cacheReadV(const XrdOucIOVec *readV, int n, int &result)
+{
+   int bytes, total = 0;
+
+   if (!cacheFD) return false;
+   for (int i = 0; i < n; i++)
+       if (!cacheFD->Covers(readV[i].offset, readV[i].size)) return false;
+
+// A readv must return all of the bytes or fail
+//
+   for (int i = 0; i < n; i++)
+       {if (!cacheRead(readV[i].data, readV[i].offset, readV[i].size, bytes)
+        ||  bytes != readV[i].size) return false;
+        total += bytes;
+       }
+   result = total;
+   return true;
+}
+
 /******************************************************************************/
 /*                                 C l o s e                                  */
 /******************************************************************************/
@@ -343,6 +410,11 @@ int XrdPosixFile::Fcntl(XrdOucCacheOp::Code opc, const std::string& args,
          {case XrdOucCacheOp::Code::QFinfo:
                        qCode = XrdCl::QueryCode::Code::FInfo;
                        break;
+          case XrdOucCacheOp::Code::QCgi:
+                       {const char *quest = index(fOpen, '?');
+                        resp = (quest ? quest+1 : "");
+                       }
+                       return 0;
           default:     resp = "Unsupported operation code.";
                        return -ENOTSUP;
          }
@@ -399,6 +471,12 @@ bool XrdPosixFile::Finalize(XrdCl::XRootDStatus *Status)
    else if (Stat(*Status)) ioP = (XrdOucCacheIO *)this;
    else return false;
 
+// A co-located cache may give us the cached file for reading. Deferred opens
+// do not qualify as we do not know the file size yet.
+//
+   if (XrdPosixGlobals::cacheFDPath && ioP == (XrdOucCacheIO *)this
+   &&  !(cOpt & XrdOucCache::optRW)) getCacheFD();
+
 // Setup the cache if it is to be used
 //
    if (XrdPosixGlobals::theCache)
@@ -439,6 +517,44 @@ int XrdPosixFile::Fstat(struct stat &buf)
    return 0;
 }
   
+/******************************************************************************/
+/* Private:                   g e t C a c h e F D                             */
+/******************************************************************************/
+
+void XrdPosixFile::getCacheFD()
+{
+   EPNAME("getCacheFD");
+   XrdOucCacheFD *cfdP;
+   XrdCl::URL url(fOpen);
+   std::string lfn = url.GetPath();
+   int rc;
+
+// Without a capability the cache would refuse us anyway
+//
+   auto capIt = url.GetParams().find("pfc.fdcap");
+   if (capIt == url.GetParams().end()) return;
+
+// The cache knows the file by the path of the url without the cgi
+//
+   if (lfn.empty() || lfn[0] != '/') lfn.insert(0, 1, '/');
+
+   cfdP = new XrdOucCacheFD;
+   if (!(rc = cfdP->Get(XrdPosixGlobals::cacheFDPath, lfn.c_str(),
+                        capIt->second.c_str())))
+      {if (cfdP->Size() == (long long)mySize)
+          {cacheFD = cfdP;
+           DEBUG("Reading " <<(cacheFD->Complete() ? "all" : "part") <<" of "
+                 <<obfuscateAuth(fOpen) <<" from the local cache");
+           return;
+          }
+       rc = -ESTALE;
+      }
+
+   DEBUG("No local cache access for " <<obfuscateAuth(fOpen) <<"; "
+         <<XrdSysE2T(-rc));
+   delete cfdP;
+}
+
 /******************************************************************************/
 /*                        H a n d l e R e s p o n s e                         */
 /******************************************************************************/
@@ -528,6 +644,17 @@ void XrdPosixFile::pgRead(XrdOucCacheIOCB       &iocb,
 {
    XrdCl::XRootDStatus Status;
    XrdPosixFileRH *rhP;
+   int bytes;
+
+// Read from the local cache, if possible, computing the checksums ourselves
+//
+   if (cacheRead(buff, offs, rlen, bytes))
+      {if (csfix) *csfix = 0;
+       if (bytes) XrdOucPgrwUtils::csCalc(buff, offs, bytes, csvec);
+          else csvec.clear();
+       iocb.Done(bytes);
+       return;
+      }
 
 // Allocate callback object. Note the response handler may do additional post
 // processing.
@@ -624,6 +751,11 @@ int XrdPosixFile::Read (char *Buff, long long Offs, int Len)
 {
    XrdCl::XRootDStatus Status;
    uint32_t bytes;
+   int lbytes;
+
+// Read from the local cache, if possible
+//
+   if (cacheRead(Buff, Offs, Len, lbytes)) return lbytes;
 
 // Handle automatic pgread
 //
@@ -651,6 +783,11 @@ void XrdPosixFile::Read (XrdOucCacheIOCB &iocb, char *buff, long long offs,
    XrdPosixFileRH *rhP;
    XrdPosixFileRH::ioType rhT;
    bool doPgRd = XrdPosixGlobals::autoPGRD;
+   int bytes;
+
+// Read from the local cache, if possible
+//
+   if (cacheRead(buff, offs, rlen, bytes)) {iocb.Done(bytes); return;}
 
 // Allocate correct callback object
 //
@@ -682,6 +819,10 @@ int XrdPosixFile::ReadV (const XrdOucIOVec *readV, int n)
    XrdCl::VectorReadInfo *vrInfo = 0;
    int nbytes = 0;
 
+// Read from the local cache, if possible
+//
+   if (cacheReadV(readV, n, nbytes)) return nbytes;
+
 // Copy in the vector (would be nice if we didn't need to do this)
 //
    chunkVec.reserve(n);
@@ -714,6 +855,10 @@ void XrdPosixFile::ReadV(XrdOucCacheIOCB &iocb, const XrdOucIOVec *readV, int n)
    XrdCl::ChunkList       chunkVec;
    int nbytes = 0;
 
+// Read from the local cache, if possible
+//
+   if (cacheReadV(readV, n, nbytes)) {iocb.Done(nbytes); return;}
+
 // Copy in the vector (would be nice if we didn't need to do this)
 //
    chunkVec.reserve(n);
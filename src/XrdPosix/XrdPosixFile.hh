@@ -52,6 +52,7 @@
 /*                    X r d P o s i x F i l e   C l a s s                     */
 /******************************************************************************/
 
+class XrdOucCacheFD;
 class XrdPosixCallBack;
 class XrdPosixPrepIO;
 
@@ -205,6 +206,10 @@ static const int isUpdt = 4;
 
 private:
 
+bool        cacheRead(char *buff, long long offs, int rlen, int &result);
+bool        cacheReadV(const XrdOucIOVec *readV, int n, int &result);
+void        getCacheFD();
+
 union {long long         currOffset;
        XrdPosixCallBack *theCB;
        XrdPosixFile     *nextFile;
@@ -213,6 +218,7 @@ union {long long         currOffset;
 char       *fPath;
 char       *fOpen;
 char       *fLoc;
+XrdOucCacheFD *cacheFD;
 union {int  cOpt; int numTries;};
 char        isStream;
 };
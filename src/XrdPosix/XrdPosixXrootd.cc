@@ -99,6 +99,7 @@ bool             p2lSRC    = false;
 bool             p2lSGI    = false;
 bool             autoPGRD  = false;
 bool             usingEC   = false;
+const char      *cacheFDPath = getenv("XRDPOSIX_CACHEFD");
 };
 
 int            XrdPosixXrootd::baseFD    = 0;
@@ -646,8 +647,8 @@ int XrdPosixXrootd::Open(const char *path, int oflags, mode_t mode,
 // Open the file (sync or async)
 //
    XrdPosixGlobals::Stats.Count((XrdPosixGlobals::Stats.X.Opens));
-   if (!cbP) Status = fp->clFile.Open((std::string)path, XOflags, XOmode);
-      else   Status = fp->clFile.Open((std::string)path, XOflags, XOmode,
+   if (!cbP) Status = fp->clFile.Open((std::string)fp->Origin(), XOflags, XOmode);
+      else   Status = fp->clFile.Open((std::string)fp->Origin(), XOflags, XOmode,
                                       (XrdCl::ResponseHandler *)fp);
 
 // If we failed, return the reason
@@ -32,6 +32,7 @@
 
 #include "XrdRmc/XrdRmc.hh"
 #include "XrdRmc/XrdRmcReal.hh"
+#include "XrdRmc/XrdRmcShards.hh"
   
 /******************************************************************************/
 /*                                C r e a t e                                 */
@@ -39,14 +40,15 @@
   
 XrdOucCache *XrdRmc::Create(Parms &ParmV, XrdOucCacheIO::aprParms *aprP)
 {
-   XrdRmcReal *cP;
+   XrdOucCache *cP;
    int rc;
 
 // We simply create a new instance of a real cache and return it. We do it this
 // way so that in the future new types of caches can be created using the same
-// interface.
+// interface. A sharded cache is simply a set of real caches.
 //
-   cP = new XrdRmcReal(rc, ParmV, aprP);
+   if (ParmV.Shards > 1) cP = new XrdRmcShards(rc, ParmV, aprP);
+      else               cP = new XrdRmcReal(rc, ParmV, aprP);
    if (rc) {delete cP; cP = 0; errno = rc;}
-   return (XrdOucCache *)cP;
+   return cP;
 }
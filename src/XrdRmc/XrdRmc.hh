@@ -87,6 +87,14 @@
            marked for single use only. This means that the moment data is
            delivered from the page, the page is recycled.
     15. Invalid options silently force the use of the default.
+    16. When Shards is greater than one, the cache is split into that many
+        independent caches, each with an equal portion of the cache size and
+        its own set of pre-read threads. Each attached CacheIO object uses
+        exactly one shard so that concurrent readers of different files do
+        not serialize on the same cache lock.
+    17. Automatic prereads adapt to sequential access. While a file is read
+        sequentially, the preread window doubles with each read (up to 64
+        pages ahead) and only pages not yet scheduled are preread.
 */
 
 class XrdRmc
@@ -104,12 +112,12 @@ struct Parms
        int       MaxFiles;  //!< Maximum number of files    (default 256 or 8K)
        int       Options;   //!< Options as defined below   (default r/o cache)
        short     minPages;  //!< Minimum number of pages    (default 256)
-       short     Reserve1;  //!< Reserved for future use
+       short     Shards;    //!< Number of independent shards (default 1)
        int       Reserve2;  //!< Reserved for future use
 
                  Parms() : CacheSize(104857600), PageSize(32768),
                            Max2Cache(0), MaxFiles(0), Options(0),
-                           minPages(0), Reserve1(0),  Reserve2(0) {}
+                           minPages(0), Shards(1),    Reserve2(0) {}
       };
 
 // Valid option values in Parms::Options
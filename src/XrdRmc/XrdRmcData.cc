@@ -65,6 +65,8 @@ XrdRmcData::XrdRmcData(XrdRmcReal *cP, XrdOucCacheIO *ioP,
    memset(prOpt,  0, sizeof(prOpt));
 
    prNSS      =-1;
+   prWEnd     =-1;
+   prWin      = 0;
    prRRNow    = 0;
    prStop     = 0;
    prNext     = prFree = 0;
@@ -123,7 +125,7 @@ bool XrdRmcData::Detach(XrdOucCacheIOCD &iocd)
 // Check if we should delete ourselves and if so add our stats to the cache
 //
    if (delOK)
-      {Cache->Statistics.Add(Statistics);
+      {Cache->Owner->Statistics.Add(Statistics);
        if (Cache->Lgs)
           {char sBuff[4096];
            snprintf(sBuff, sizeof(sBuff),
@@ -248,6 +250,36 @@ void XrdRmcData::Preread(aprParms &Parms)
       }
 }
 
+/******************************************************************************/
+/*                               p r A d a p t                                */
+/******************************************************************************/
+
+int XrdRmcData::prAdapt(long long segBeg, long long &segNxt, int rLen)
+{
+   XrdSysMutexHelper Monitor(&DMutex);
+   long long segCnt, segEnd, wMax = static_cast<long long>(prWMax)*SegSize;
+
+// If this read continues where the previous one ended, double the window.
+// Otherwise, start over by prereading as much as was just read.
+//
+   if (prNSS >= 0 && segBeg >= prNSS-1 && segBeg <= prNSS)
+      {if (prWin < wMax) prWin = (prWin*2 < wMax ? prWin*2 : wMax);}
+      else {prWin = rLen; prWEnd = -1;}
+   prNSS = segNxt;
+
+// Compute the end of the window. We only preread segments that were not
+// scheduled by a previous preread and only once at least half of the window
+// needs to be refilled. This keeps the number of queued prereads small.
+//
+   segCnt = (prWin + OffMask) >> SegShft;
+   if (segCnt < Apr.minPages) segCnt = Apr.minPages;
+   segEnd = segNxt + segCnt - 1;
+   if (segNxt <= prWEnd) segNxt = prWEnd + 1;
+   if (segEnd - segNxt + 1 < (segCnt + 1)/2) return 0;
+   prWEnd = segEnd;
+   return static_cast<int>((segEnd - segNxt + 1) << SegShft);
+}
+
 /******************************************************************************/
 /*                               Q u e u e P R                                */
 /******************************************************************************/
@@ -339,7 +371,7 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
    MrSw EnforceMrSw(rPLock, rPLopt);
    XrdOucCacheStats Now;
    char *cBuff, *Dest = Buff;
-   long long segOff, segNum = (Offs >> SegShft);
+   long long segOff, segNum = (Offs >> SegShft), segBeg = segNum;
    int noIO, rAmt, rGot, doPR = prAuto, rLeft = rLen;
 
 // Verify read length and offset
@@ -408,7 +440,9 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
 //
    if (doPR && cBuff)
       {EnforceMrSw.UnLock();
-       QueuePR(segNum, rLen, prLRU, 1);
+       segNum &= XrdRmcReal::Strip;
+       if ((rLen = prAdapt(segBeg, segNum, rLen)))
+          QueuePR(segNum, rLen, prLRU, 1);
       }
 
 // All done, if we ended fine, return amount read. If there is no page buffer
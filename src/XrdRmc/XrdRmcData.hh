@@ -70,6 +70,7 @@ int            Write(char  *Buffer, long long  Offset,  int  Length);
 
 private:
               ~XrdRmcData() {}
+int            prAdapt(long long segBeg, long long &segNxt, int rLen);
 void           QueuePR(long long SegOffs, int rLen, int prHow, int isAuto=0);
 int            Read (XrdOucCacheStats &Now,
                      char *Buffer, long long Offs, int Length);
@@ -125,7 +126,10 @@ static const int xqRW   = 2;
 XrdRmcReal::prTask prReq;
 XrdSysSemaphore    *prStop;
 
-long long        prNSS;          // Next Sequential Segment for maxi prereads
+long long        prNSS;          // Next Sequential Segment for auto prereads
+long long        prWEnd;         // Last segment in the auto preread window
+int              prWin;          // Current auto preread window in bytes
+static const int prWMax = 64;    // Maximum auto preread window in segments
 
 static const int prRRMax= 5;
 long long        prRR[prRRMax];  // Recent reads
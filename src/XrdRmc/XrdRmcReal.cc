@@ -57,7 +57,7 @@ void *XrdRmcRealPRXeq(void *parg)
   
 XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
                        XrdOucCacheIO::aprParms *aprP)
-                : XrdOucCache("rmc"),
+                : XrdOucCache("rmc"), Owner(this),
                   Slots(0), Slash(0), Base((char *)MAP_FAILED), Dbg(0), Lgs(0),
                   AZero(0), Attached(0), prFirst(0), prLast(0),
                   prReady(0), prStop(0), prNum(0)
@@ -178,7 +178,7 @@ XrdRmcReal::~XrdRmcReal()
 
 // Delete the slots
 //
-   delete Slots; Slots = 0;
+   delete [] Slots; Slots = 0;
 
 // Unmap cache memory and associated hash table
 //
@@ -39,6 +39,7 @@
 class XrdRmcReal : public XrdOucCache
 {
 friend class XrdRmcData;
+friend class XrdRmcShards;
 public:
 
 XrdOucCacheIO *Attach(XrdOucCacheIO *ioP, int Options=0);
@@ -85,6 +86,8 @@ static const long long MaxFO = 0x000007ffffffffffLL;  // Min 4K page -> 8TB-1
 
 XrdOucCacheIO::aprParms aprDefault; // Default automatic preread
 
+XrdOucCache     *Owner;       // Cache accumulating our statistics
+
 XrdSysMutex      CMutex;
 XrdRmcSlot     *Slots;       // 1-to-1 slot to memory map
 int             *Slash;       // Slot hash table
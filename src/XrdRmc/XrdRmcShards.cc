@@ -0,0 +1,84 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d R m c S h a r d s . c c                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+
+#include "XrdRmc/XrdRmcReal.hh"
+#include "XrdRmc/XrdRmcShards.hh"
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdRmcShards::XrdRmcShards(int &rc, XrdRmc::Parms &ParmV,
+                           XrdOucCacheIO::aprParms *aprP)
+                          : XrdOucCache("rmc"), numShards(0)
+{
+   XrdRmc::Parms shardParms = ParmV;
+   int n = (ParmV.Shards > maxShards ? maxShards : ParmV.Shards);
+
+// Each shard gets an equal portion of the cache. Every shard must still be
+// able to handle the maximum number of files as files are spread by hashing.
+//
+   if (n < 1) n = 1;
+   shardParms.Shards = 1;
+   shardParms.CacheSize = (ParmV.CacheSize > 0 ? ParmV.CacheSize : 104857600)/n;
+
+// Create all of the shards, they all report statistics to us
+//
+   for (int i = 0; i < n; i++)
+       {Shards[i] = new XrdRmcReal(rc, shardParms, aprP);
+        numShards++;
+        if (rc) return;
+        Shards[i]->Owner = this;
+       }
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdRmcShards::~XrdRmcShards()
+{
+// Each shard waits for its attached files to go away before it is deleted
+//
+   for (int i = 0; i < numShards; i++) delete Shards[i];
+}
+
+/******************************************************************************/
+/*                                A t t a c h                                 */
+/******************************************************************************/
+
+XrdOucCacheIO *XrdRmcShards::Attach(XrdOucCacheIO *ioP, int Opts)
+{
+// The same CacheIO object always lands in the same shard
+//
+   return Shards[Shard(ioP)]->Attach(ioP, Opts);
+}
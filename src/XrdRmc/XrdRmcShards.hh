@@ -0,0 +1,71 @@
+#ifndef __XRDRMCSHARDS_HH__
+#define __XRDRMCSHARDS_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d R m c S h a r d s . h h                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdint>
+
+#include "XrdRmc/XrdRmc.hh"
+
+/* This class defines a memory cache made of independent XrdRmcReal shards.
+   Each attached XrdOucCacheIO object is assigned to a single shard so that
+   files attached to different shards never contend on the same cache lock
+   nor on the same preread queue.
+*/
+
+class XrdRmcReal;
+
+class XrdRmcShards : public XrdOucCache
+{
+public:
+
+XrdOucCacheIO *Attach(XrdOucCacheIO *ioP, int Options=0);
+
+               XrdRmcShards(int                     &rc,
+                            XrdRmc::Parms          &Parms,
+                            XrdOucCacheIO::aprParms *aprP=0);
+
+              ~XrdRmcShards();
+
+static const int maxShards = 64;
+
+private:
+
+inline
+int       Shard(XrdOucCacheIO *ioP)
+               {uint64_t hVal = reinterpret_cast<uintptr_t>(ioP);
+                hVal = (hVal ^ (hVal >> 17)) * 0x9e3779b97f4a7c15ULL;
+                return static_cast<int>((hVal >> 32) % numShards);
+               }
+
+XrdRmcReal *Shards[maxShards];
+int         numShards;
+};
+#endif
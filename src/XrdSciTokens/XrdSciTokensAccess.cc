@@ -24,8 +24,10 @@
 #include "picojson.h"
 
 #include "scitokens/scitokens.h"
+#include "XrdSciTokens/XrdSciTokensCache.hh"
 #include "XrdSciTokens/XrdSciTokensHelper.hh"
 #include "XrdSciTokens/XrdSciTokensMon.hh"
+#include "XrdSciTokens/XrdSciTokensScopes.hh"
 
 // The status-quo to retrieve the default object is to copy/paste the
 // linker definition and invoke directly.
@@ -371,27 +373,9 @@ public:
 
     ~XrdAccRules() {}
 
-    bool apply(Access_Operation oper, std::string path) {
-      for (const auto & rule : m_rules) {
-        // Skip rules that don't match the current operation
-        if (rule.first != oper)
-          continue;
-
-        // If the rule allows any path, allow the operation
-        if (rule.second == "/")
-          return true;
-
-        // Allow operation if path is a subdirectory of the rule's path
-        if (is_subdirectory(rule.second, path)) {
-          return true;
-        } else {
-          // Allow stat and mkdir of parent directories to comply with WLCG token specs
-          if (oper == AOP_Stat || oper == AOP_Mkdir)
-            if (is_subdirectory(path, rule.second))
-              return true;
-        }
-      }
-      return false;
+    bool apply(Access_Operation oper, const char *path) const {
+      // Allow stat and mkdir of parent directories to comply with WLCG token specs
+      return m_scopes.Allowed(oper, path, oper == AOP_Stat || oper == AOP_Mkdir);
     }
 
     bool expired() const {return monotonic_time() > m_expiry_time;}
@@ -401,6 +385,7 @@ public:
         for (const auto &entry : rules) {
             m_rules.emplace_back(entry.first, entry.second);
         }
+        m_scopes.Compile(m_rules);
     }
 
     std::string get_username(const std::string &req_path) const
@@ -449,6 +434,7 @@ public:
 private:
     uint32_t m_authz_strategy;
     AccessRulesRaw m_rules;
+    XrdSciTokensScopes m_scopes;
     uint64_t m_expiry_time{0};
     const std::string m_username;
     const std::string m_token_subject;
@@ -520,16 +506,12 @@ public:
         std::shared_ptr<XrdAccRules> access_rules;
         uint64_t now = monotonic_time();
         Check(now);
-        {
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            const auto iter = m_map.find(authz);
-            if (iter != m_map.end() && !iter->second->expired()) {
-                access_rules = iter->second;
-            }
-        }
-        if (!access_rules) {
-            m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
-            try {
+        // Concurrent requests presenting the same new token share a single
+        // validation; only the thread doing it sees a miss.
+        bool cached;
+        try {
+            access_rules = m_map.Get(authz, [&]() -> std::shared_ptr<XrdAccRules> {
+                m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
                 uint64_t cache_expiry;
                 AccessRulesRaw rules;
                 std::string username;
@@ -538,23 +520,25 @@ public:
                 std::vector<MapRule> map_rules;
                 std::vector<std::string> groups;
                 uint32_t authz_strategy;
-                if (GenerateAcls(authz, cache_expiry, rules, username, token_subject, issuer, map_rules, groups, authz_strategy)) {
-                    access_rules.reset(new XrdAccRules(now + cache_expiry, username, token_subject, issuer, map_rules, groups, authz_strategy));
-                    access_rules->parse(rules);
-                } else {
+                if (!GenerateAcls(authz, cache_expiry, rules, username, token_subject, issuer, map_rules, groups, authz_strategy)) {
                     m_log.Log(LogMask::Warning, "Access", "Failed to generate ACLs for token");
-                    return OnMissing(Entity, path, oper, env);
+                    return nullptr;
                 }
+                std::shared_ptr<XrdAccRules> new_rules(new XrdAccRules(now + cache_expiry, username, token_subject, issuer, map_rules, groups, authz_strategy));
+                new_rules->parse(rules);
                 if (m_log.getMsgMask() & LogMask::Debug) {
-                    m_log.Log(LogMask::Debug, "Access", "New valid token", access_rules->str().c_str());
+                    m_log.Log(LogMask::Debug, "Access", "New valid token", new_rules->str().c_str());
                 }
-            } catch (std::exception &exc) {
-                m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
-                return OnMissing(Entity, path, oper, env);
-            }
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            m_map[authz] = access_rules;
-        } else if (m_log.getMsgMask() & LogMask::Debug) {
+                return new_rules;
+            }, &cached);
+        } catch (std::exception &exc) {
+            m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
+            return OnMissing(Entity, path, oper, env);
+        }
+        if (!access_rules) {
+            return OnMissing(Entity, path, oper, env);
+        }
+        if (cached && (m_log.getMsgMask() & LogMask::Debug)) {
             m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
         }
 
@@ -1371,16 +1355,7 @@ private:
         if (now <= m_next_clean) {return;}
 
         // Clean expired m_map entries
-        {
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            for (auto iter = m_map.begin(); iter != m_map.end(); ) {
-                if (iter->second->expired()) {
-                    iter = m_map.erase(iter);
-                } else {
-                    ++iter;
-                }
-            }
-        }
+        m_map.Purge();
         Reconfig();
 
         m_next_clean = monotonic_time() + m_expiry_secs;
@@ -1390,9 +1365,8 @@ private:
     pthread_rwlock_t m_config_lock;
     std::vector<std::string> m_audiences;
     std::vector<const char *> m_audiences_array;
-    std::map<std::string, std::shared_ptr<XrdAccRules>> m_map;
+    XrdSciTokensCache<XrdAccRules> m_map;
     std::mutex m_check_mutex;
-    std::mutex m_map_mutex;
     XrdAccAuthorize* m_chain;
     const std::string m_parms;
     std::vector<const char*> m_valid_issuers_array;
@@ -0,0 +1,208 @@
+#ifndef __XrdSciTokensCache_hh__
+#define __XrdSciTokensCache_hh__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d S c i T o k e n s C a c h e . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! A cache of validated tokens. The cache is split into independently locked
+//! shards selected by the digest of the token so that lookups of different
+//! tokens do not contend. Entries are located by digest but always compared
+//! against the full token before use.
+//!
+//! When several threads miss on the same token at the same time only one of
+//! them validates it; the others wait for and share its result. Failed
+//! validations are not cached.
+//!
+//! The cached type must provide "bool expired() const".
+//-----------------------------------------------------------------------------
+
+template<typename T>
+class XrdSciTokensCache
+{
+public:
+
+typedef std::shared_ptr<T> Value;
+
+//-----------------------------------------------------------------------------
+//! Find a token, validating it if need be.
+//!
+//! @param  token  The token.
+//! @param  load   Callable returning the Value for the token, or a null Value
+//!                if the token is not valid. It is called at most once for
+//!                all threads concurrently looking up the same token. Any
+//!                exception it throws is rethrown to all of them.
+//! @param  hit    When not null, set to true if the value was already cached
+//!                or was validated by another thread.
+//!
+//! @return The value for the token or a null Value if it is not valid.
+//-----------------------------------------------------------------------------
+
+template<typename Loader>
+Value Get(std::string_view token, Loader &&load, bool *hit=nullptr)
+{
+    size_t digest = std::hash<std::string_view>{}(token);
+    Shard &shard = *m_shards[digest % m_shards.size()];
+    std::shared_ptr<Flight> flight;
+    bool leader = false;
+
+    if (hit) *hit = true;
+
+    {
+        std::lock_guard<std::mutex> guard(shard.mtx);
+        auto range = shard.entries.equal_range(digest);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.token == token) {
+                if (!it->second.value->expired()) return it->second.value;
+                shard.entries.erase(it);
+                break;
+            }
+        }
+        auto frange = shard.flights.equal_range(digest);
+        for (auto it = frange.first; it != frange.second; ++it) {
+            if (it->second->token == token) {flight = it->second; break;}
+        }
+        if (!flight) {
+            flight = std::make_shared<Flight>(token);
+            shard.flights.emplace(digest, flight);
+            leader = true;
+        }
+    }
+
+    // Some other thread is validating this token, wait for its result
+    if (!leader) return flight->result.get();
+
+    // We validate the token and publish the result to everyone waiting
+    if (hit) *hit = false;
+    Value value;
+    try {
+        value = load();
+    } catch (...) {
+        Land(shard, digest, flight, nullptr);
+        flight->promise.set_exception(std::current_exception());
+        throw;
+    }
+    Land(shard, digest, flight, value);
+    flight->promise.set_value(value);
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+//! Remove all expired entries.
+//-----------------------------------------------------------------------------
+
+void Purge()
+{
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> guard(shard->mtx);
+        for (auto it = shard->entries.begin(); it != shard->entries.end(); ) {
+            if (it->second.value->expired()) it = shard->entries.erase(it);
+            else ++it;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Return the number of cached entries.
+//-----------------------------------------------------------------------------
+
+size_t Size()
+{
+    size_t total = 0;
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> guard(shard->mtx);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+//-----------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param  shards  The number of independently locked shards.
+//-----------------------------------------------------------------------------
+
+explicit XrdSciTokensCache(unsigned shards=16)
+{
+    if (!shards) shards = 1;
+    m_shards.reserve(shards);
+    for (unsigned i = 0; i < shards; i++) m_shards.emplace_back(new Shard);
+}
+
+~XrdSciTokensCache() {}
+
+private:
+
+struct Entry
+{
+    Entry(std::string_view tok, const Value &val) : token(tok), value(val) {}
+    std::string token;
+    Value       value;
+};
+
+struct Flight
+{
+    Flight(std::string_view tok) : token(tok), result(promise.get_future()) {}
+    std::string                     token;
+    std::promise<Value>             promise;
+    std::shared_future<Value>       result;
+};
+
+struct alignas(64) Shard
+{
+    std::mutex                                         mtx;
+    std::unordered_multimap<size_t, Entry>             entries;
+    std::unordered_multimap<size_t, std::shared_ptr<Flight>> flights;
+};
+
+// Retire a flight, caching its value if the token was valid
+void Land(Shard &shard, size_t digest, const std::shared_ptr<Flight> &flight,
+          const Value &value)
+{
+    std::lock_guard<std::mutex> guard(shard.mtx);
+    auto frange = shard.flights.equal_range(digest);
+    for (auto it = frange.first; it != frange.second; ++it) {
+        if (it->second == flight) {shard.flights.erase(it); break;}
+    }
+    if (value) shard.entries.emplace(digest, Entry(flight->token, value));
+}
+
+std::vector<std::unique_ptr<Shard>> m_shards;
+};
+#endif
@@ -0,0 +1,126 @@
+#ifndef __XrdSciTokensScopes_hh__
+#define __XrdSciTokensScopes_hh__
+/******************************************************************************/
+/*                                                                            */
+/*                 X r d S c i T o k e n s S c o p e s . h h                  */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "XrdAcc/XrdAccAuthorize.hh"
+
+//-----------------------------------------------------------------------------
+//! The path scopes granted by a token, compiled for matching. The scopes for
+//! each operation are kept sorted so that a request is matched by looking up
+//! each of its parent directories rather than by comparing it with every
+//! scope. A path matches a scope when it is the scope or lies beneath it.
+//-----------------------------------------------------------------------------
+
+class XrdSciTokensScopes
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Compile a list of (operation, path) scopes.
+//-----------------------------------------------------------------------------
+
+void Compile(const std::vector<std::pair<Access_Operation, std::string>> &rules)
+{
+    for (auto &ops : m_ops) {ops.all = false; ops.paths.clear();}
+    for (const auto &rule : rules) {
+        if (rule.first < 0 || rule.first > AOP_LastOp) continue;
+        OpScopes &ops = m_ops[rule.first];
+        if (rule.second == "/") ops.all = true;
+        else if (!rule.second.empty()) ops.paths.push_back(rule.second);
+    }
+    for (auto &ops : m_ops) {
+        std::sort(ops.paths.begin(), ops.paths.end());
+        ops.paths.erase(std::unique(ops.paths.begin(), ops.paths.end()),
+                        ops.paths.end());
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Check whether an operation on a path is allowed.
+//!
+//! @param  oper     The operation.
+//! @param  path     The path.
+//! @param  parents  When true, the operation is also allowed on the parent
+//!                  directories of any scope (used for stat and mkdir).
+//-----------------------------------------------------------------------------
+
+bool Allowed(Access_Operation oper, std::string_view path, bool parents) const
+{
+    if (oper < 0 || oper > AOP_LastOp) return false;
+    const OpScopes &ops = m_ops[oper];
+    if (ops.all) return true;
+    if (ops.paths.empty() || path.empty()) return false;
+
+    // A scope covers the path if it is the path itself, a prefix of the path
+    // ending just before a slash, or a prefix ending with a slash.
+    if (Has(ops, path)) return true;
+    for (size_t pos = path.find('/'); pos != std::string_view::npos;
+                pos = path.find('/', pos + 1)) {
+        if (pos && Has(ops, path.substr(0, pos))) return true;
+        if (Has(ops, path.substr(0, pos + 1))) return true;
+    }
+
+    // Otherwise, the path may be a parent directory of a scope
+    if (parents) {
+        auto it = std::lower_bound(ops.paths.begin(), ops.paths.end(), path);
+        for (; it != ops.paths.end() && !it->compare(0, path.size(), path); ++it) {
+            if (it->size() == path.size() || (*it)[path.size()] == '/'
+            ||  path.back() == '/') return true;
+        }
+    }
+    return false;
+}
+
+XrdSciTokensScopes() {}
+~XrdSciTokensScopes() {}
+
+private:
+
+struct OpScopes
+{
+    bool                     all = false;
+    std::vector<std::string> paths;
+};
+
+static bool Has(const OpScopes &ops, std::string_view path)
+{
+    return std::binary_search(ops.paths.begin(), ops.paths.end(), path);
+}
+
+OpScopes m_ops[AOP_LastOp + 1];
+};
+#endif
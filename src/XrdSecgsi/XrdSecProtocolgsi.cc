@@ -59,6 +59,7 @@
 
 #include "XrdSecgsi/XrdSecProtocolgsi.hh"
 #include "XrdSecgsi/XrdSecgsiOpts.hh"
+#include "XrdSecgsi/XrdSecgsiTicket.hh"
 
 /******************************************************************************/
 /*                 T r a c i n g  I n i t  O p t i o n s                      */
@@ -83,6 +84,7 @@ static const char *gsiClientSteps[] = {
    "kXGC_certreq",
    "kXGC_cert",
    "kXGC_sigpxy",
+   "kXGC_ticketack",
    "kXGC_reserved"
 };
 
@@ -91,6 +93,7 @@ static const char *gsiServerSteps[] = {
    "kXGS_init",
    "kXGS_cert",
    "kXGS_pxyreq",
+   "kXGS_ticket",
    "kXGS_reserved"
 };
 
@@ -178,6 +181,8 @@ int    XrdSecProtocolgsi::MonInfoOpt = 0;
 bool   XrdSecProtocolgsi::HashCompatibility = 1;
 bool   XrdSecProtocolgsi::TrustDNS = false;
 bool   XrdSecProtocolgsi::ShowDN = false;
+int    XrdSecProtocolgsi::TicketLife = 0;
+bool   XrdSecProtocolgsi::UseTickets = true;
 //
 // Crypto related info
 int  XrdSecProtocolgsi::ncrypt    = 0;                 // Number of factories
@@ -192,9 +197,12 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdSutCache  XrdSecProtocolgsi::cacheTkt(8,13);  // Client session tickets (Fibonacci-based sizes)
+XrdCryptoChainCache XrdSecProtocolgsi::cacheVerify; // Successful chain verifications
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
+XrdSecgsiTicket *XrdSecProtocolgsi::tktSeal = 0; // Session tickets sealing
 //
 // CA and CRL stacks
 GSIStack<XrdCryptoX509Chain>  XrdSecProtocolgsi::stackCA; // Stack of CA in use
@@ -929,6 +937,20 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
       const char *cmoninfo = (MonInfoOpt == 1) ? "DN" : "none";
       DEBUG("Monitor information options: "<<cmoninfo);
 
+      //
+      // Session tickets: the sealing keys are generated here and never leave
+      // this process
+      if (opt.tickets > 0) {
+         tktSeal = new XrdSecgsiTicket(cryptF[0]);
+         if (tktSeal->IsValid()) {
+            TicketLife = opt.tickets;
+            DEBUG("session tickets valid for "<<TicketLife<<" secs");
+         } else {
+            PRINT("WARNING: could not create session ticket keys: tickets disabled");
+            SafeDelete(tktSeal);
+         }
+      }
+
       // Make sure we have a calist as the client can't do anything without it.
       // If the cryptlist is empty the client will use the default one.
       //
@@ -1032,6 +1054,9 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
       if (opt.srvnames)
          SrvAllowedNames = opt.srvnames;
       //
+      // Session tickets
+      UseTickets = (opt.tickets != 0);
+      //
       // Notify
       TRACE(Authen, "using certificate file:         "<<UsrCert);
       TRACE(Authen, "using private key file:         "<<UsrKey);
@@ -1040,6 +1065,7 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
       TRACE(Authen, "proxy: depth of signature path: "<<DepLength);
       TRACE(Authen, "proxy: bits in key:             "<<DefBits);
       TRACE(Authen, "server cert: allowed names:     "<<SrvAllowedNames);
+      TRACE(Authen, "session tickets:                "<<(UseTickets ? "use" : "ignore"));
       if (!(PxyReqOpts & kOptsCreatePxy)) {
          TRACE(Authen, "allowing for pure cert/key authentication (no proxy) ");
       }
@@ -1588,6 +1614,14 @@ XrdSecCredentials *XrdSecProtocolgsi::getCredentials(XrdSecParameters *parm,
          return ErrC(ei,bpar,bmai,0, kGSErrCreateBucket,
                 XrdSutBuckStr(kXRS_clnt_opts),"global",stepstr);
       }
+      //
+      // Try resuming a previous session, if we hold a ticket for this server
+      if (hs->Options & kOptsTicket) {
+         String tmsg;
+         if (AddTicket(bpar, tmsg) != 0) {
+            DEBUG("no session ticket sent: "<<tmsg);
+         }
+      }
 
       //
       nextstep = kXGC_certreq;
@@ -1676,6 +1710,12 @@ XrdSecCredentials *XrdSecProtocolgsi::getCredentials(XrdSecParameters *parm,
       nextstep = kXGC_sigpxy;
       break;
 
+   case kXGS_ticket:
+      //
+      // The ticket was saved while parsing: just acknowledge
+      nextstep = kXGC_ticketack;
+      break;
+
    default:
       return ErrC(ei,bpar,bmai,0, kGSErrBadOpt,stepstr);
    }
@@ -1688,6 +1728,15 @@ XrdSecCredentials *XrdSecProtocolgsi::getCredentials(XrdSecParameters *parm,
                   kGSErrSerialBuffer,"main",stepstr);
    }
    //
+   // If we sent a ticket the server may accept it and end the handshake:
+   // from now on use the key derived from it. Should the server go for the
+   // full handshake, the key is replaced when processing its certificate.
+   if (hs->TktKey) {
+      SafeDelete(sessionKey);
+      sessionKey = hs->TktKey;
+      hs->TktKey = 0;
+   }
+   //
    // Serialize the global buffer
    char *bser = 0;
    int nser = bpar->Serialized(&bser,'f');
@@ -1854,9 +1903,21 @@ int XrdSecProtocolgsi::Authenticate(XrdSecCredentials *cred,
    switch (step) {
 
    case kXGC_certreq:
+      //
+      // The client resumed a previous session with a valid ticket: done
+      if (hs->Resumed) {
+         DEBUG("session resumed with ticket for: "<<(Entity.name ? Entity.name : "<none>"));
+         kS_rc = kgST_ok;
+         nextstep = kXGS_none;
+         break;
+      }
       //
       // Client required us to send our certificate and cipher DH public parameters:
       // add first this last one.
+      // Create the cipher for the agreement
+      if (!hs->Rcip && !(hs->Rcip = sessionCF->Cipher(hs->HasPad, 0,0,0)))
+         return ErrS(hs->ID,ei,bpar,bmai,0, kGSErrNoCipher,
+                                         "session",stepstr);
       // Extract buffer with public info for the cipher agreement
       if (!(bpub = hs->Rcip->Public(lpub))) 
          return ErrS(hs->ID,ei,bpar,bmai,0, kGSErrNoPublic,
@@ -2153,6 +2214,19 @@ int XrdSecProtocolgsi::Authenticate(XrdSecCredentials *cred,
             nextstep = kXGS_pxyreq;
          }
       }
+      //
+      // Hand a session ticket to clients accepting them: this costs a round
+      // trip now but saves the full handshake when they reconnect
+      if (kS_rc == kgST_ok && tktSeal && (hs->Options & kOptsTicket)
+                           && hs->RemVers >= XrdSecgsiVersTicket) {
+         String tmsg;
+         if (IssueTicket(bmai, tmsg) == 0) {
+            kS_rc = kgST_more;
+            nextstep = kXGS_ticket;
+         } else {
+            DEBUG("no session ticket issued: "<<tmsg);
+         }
+      }
 
       break;
 
@@ -2168,6 +2242,13 @@ int XrdSecProtocolgsi::Authenticate(XrdSecCredentials *cred,
       }
       break;
 
+   case kXGC_ticketack:
+      //
+      // The client saved its ticket: nothing to do after this
+      kS_rc = kgST_ok;
+      nextstep = kXGS_none;
+      break;
+
    default:
       return ErrS(hs->ID,ei,bpar,bmai,0, kGSErrBadOpt, stepstr);
    }
@@ -2314,6 +2395,7 @@ void gsiOptions::Print(XrdOucTrace *t)
       POPTS(t, " Proxy sign option: "<< sigpxy);
       POPTS(t, " Proxy delegation option: "<< dlgpxy);
       if (createpxy) POPTS(t, " Pure Cert/Key authentication allowed");
+      POPTS(t, " Session tickets: "<< (tickets ? "use" : "ignore"));
       POPTS(t, " Allowed server names: "<< (srvnames ? srvnames : "[*/]<target host name>[/*]"));
    } else {
       POPTS(t, " Certificate: " << (cert ? cert : XrdSecProtocolgsi::SrvCert));
@@ -2348,6 +2430,11 @@ void gsiOptions::Print(XrdOucTrace *t)
          if (vomsfunparms) POPTS(t, " VOMS extraction function parms: ignored (no VOMS extraction function defined)");
       }
       POPTS(t, " MonInfo option: "<< moninfo);
+      if (tickets > 0) {
+         POPTS(t, " Session tickets validity (secs): "<< tickets);
+      } else {
+         POPTS(t, " Session tickets: disabled");
+      }
       if (!hashcomp)
          POPTS(t, " Name hashing algorithm compatibility OFF");
       POPTS(t, " Show DN option: "<<showDN);
@@ -2438,6 +2525,9 @@ char *XrdSecProtocolgsiInit(const char mode,
       //                                     handshake fails.
       //             "XrdSecGSIUSEDEFAULTHASH" If this variable is set only the default
       //                                     name hashing algorithm is used
+      //             "XrdSecGSITICKETS"      Session tickets option [1]:
+      //                                       1 resume sessions with tickets issued by servers
+      //                                       0 always do the full handshake
 
       //
       opts.mode = mode;
@@ -2539,6 +2629,11 @@ char *XrdSecProtocolgsiInit(const char mode,
       if ((cenv = getenv("XrdSecGSITRUSTDNS")))
          opts.trustdns = (!strcmp(cenv, "0")) ? false : true;
 
+      // Session tickets
+      opts.tickets = 1;
+      if ((cenv = getenv("XrdSecGSITICKETS")))
+         opts.tickets = (!strcmp(cenv, "0")) ? 0 : 1;
+
       //
       // Setup the object with the chosen options
       rc = XrdSecProtocolgsi::Init(opts,erp);
@@ -2607,6 +2702,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       //              [-vomsfunparms:<voms_function_init_parameters>]
       //              [-defaulthash]
       //              [-trustdns:<0|1>]
+      //              [-tickets:<session_ticket_validity_in_secs>]
       //
       int debug = -1;
       String clist = "";
@@ -2639,6 +2735,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       int hashcomp = 1;
       int trustdns = false;
       int showDN = false;
+      int tickets = 0;
       char *op = 0;
       while (inParms.GetLine()) { 
          while ((op = inParms.GetToken())) {
@@ -2711,6 +2808,8 @@ char *XrdSecProtocolgsiInit(const char mode,
                trustdns = getOptVal(tdnsOpts, op+10);
             } else if (!strncmp(op, "-showdn:",8)) {
                showDN = getOptVal(tdnsOpts, op+8);
+            } else if (!strncmp(op, "-tickets:",9)) {
+               tickets = atoi(op+9);
             } else {
                PRINT("ignoring unknown switch: "<<op);
             }
@@ -2745,6 +2844,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       opts.hashcomp = hashcomp;
       opts.trustdns = (trustdns <= 0) ? false : true;
       opts.showDN = (showDN > 0) ? true : false;
+      opts.tickets = (tickets > 0) ? tickets : 0;
       if (clist.length() > 0)
          opts.clist = (char *)clist.c_str();
       if (certdir.length() > 0)
@@ -2882,7 +2982,7 @@ int XrdSecProtocolgsi::AddSerialized(char opt, kXR_int32 step, String ID,
    // allow to prove authenticity of counter part
    //
    // Generate new random tag and create a bucket
-   if (!(opt == 'c' && step == kXGC_sigpxy)) {
+   if (!(opt == 'c' && (step == kXGC_sigpxy || step == kXGC_ticketack))) {
       String RndmTag;
       XrdSutRndm::GetRndmTag(RndmTag);
       //
@@ -2973,6 +3073,11 @@ int XrdSecProtocolgsi::ParseClientInput(XrdSutBuffer *br, XrdSutBuffer **bm,
          if (ClientDoPxyreq(br, bm, cmsg) != 0)
             return -1;
          break;
+      case kXGS_ticket:
+         // Process message
+         if (ClientDoTicket(br, bm, cmsg) != 0)
+            return -1;
+         break;
       default:
          cmsg = "protocol error: unknown action: "; cmsg += step;
          return -1;
@@ -3030,6 +3135,12 @@ int XrdSecProtocolgsi::ClientDoInit(XrdSutBuffer *br, XrdSutBuffer **bm,
    // Set options
    hs->Options = PxyReqOpts;
    //
+   // Offer to use session tickets, unless proxies are to be delegated (they
+   // are not transferred when a session is resumed)
+   if (UseTickets && hs->RemVers >= XrdSecgsiVersTicket &&
+       !(PxyReqOpts & (kOptsDlgPxy | kOptsFwdPxy | kOptsSigReq)))
+      hs->Options |= kOptsTicket;
+   //
    // Extract list of crypto modules 
    String clist;
    ii = opts.find("c:");
@@ -3204,6 +3315,9 @@ int XrdSecProtocolgsi::ClientDoCert(XrdSutBuffer *br, XrdSutBuffer **bm,
       emsg = "cannot attach to ParseBucket function!";
       return -1;
    }
+   // Fingerprint the verification before the chain gets the new certificate
+   std::string vkey;
+   XrdCryptoChainCache::Key(sessionCF, bck, hs->Chain, hs->Crl, 0, vkey);
    // Parse bucket
    int nci = (*ParseBucket)(bck, hs->Chain);
    if (nci != 1) {
@@ -3213,13 +3327,7 @@ int XrdSecProtocolgsi::ClientDoCert(XrdSutBuffer *br, XrdSutBuffer **bm,
    }
    //
    // Verify the chain
-   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      emsg = "certificate chain verification failed: ";
-      emsg += hs->Chain->LastError();
-      return -1;
-   }
+   if (!VerifyChain(vkey, emsg)) return -1;
    //
    // Verify server identity using RFC2818 method
    //
@@ -3508,6 +3616,95 @@ int XrdSecProtocolgsi::ClientDoPxyreq(XrdSutBuffer *br, XrdSutBuffer **bm,
 
 }
 
+//_____________________________________________________________________________
+static bool TicketCheck(XrdSutCacheEntry *, void *) {
+
+   // Tickets are always replaced by the newest one
+   return false;
+}
+
+//_________________________________________________________________________
+int XrdSecProtocolgsi::ClientDoTicket(XrdSutBuffer *br, XrdSutBuffer **bm,
+                                      String &emsg)
+{
+   // Client side: process a kXGS_ticket message.
+   // Return 0 on success, -1 on error. If the case, a message is returned
+   // in cmsg. A ticket which cannot be saved is not an error.
+   EPNAME("ClientDoTicket");
+   XrdSutBucket *bckt = 0, *bcks = 0;
+
+   //
+   // Extract the main buffer
+   XrdSutBucket *bckm = 0;
+   if (!(bckm = br->GetBucket(kXRS_main))) {
+      emsg = "main buffer missing";
+      return -1;
+   }
+   //
+   // Decrypt the main buffer with the session cipher
+   if (!sessionKey || !(sessionKey->Decrypt(*bckm, useIV))) {
+      emsg = "error   with session cipher";
+      return -1;
+   }
+   //
+   // Deserialize main buffer
+   if (!((*bm) = new XrdSutBuffer(bckm->buffer,bckm->size))) {
+      emsg = "error deserializing main buffer";
+      return -1;
+   }
+   //
+   // Get the ticket and its secret; they are not needed any longer after this
+   if (!(bckt = (*bm)->GetBucket(kXRS_ticket)) ||
+       !(bcks = (*bm)->GetBucket(kXRS_ticket_auth))) {
+      NOTIFY("session ticket missing");
+      return 0;
+   }
+   //
+   // The secret comes as <expires>:<clen>:<ctype>:<secret>
+   String sec, exps, clens, ctype, secret;
+   bcks->ToString(sec);
+   int from = sec.tokenize(exps, 0, ':');
+   if (from != -1) from = sec.tokenize(clens, from, ':');
+   if (from != -1) from = sec.tokenize(ctype, from, ':');
+   if (from != -1) sec.tokenize(secret, from, ':');
+   if (!exps.isdigit() || !clens.isdigit() || ctype.length() <= 0
+                       || secret.length() <= 0) {
+      NOTIFY("malformed session ticket secret");
+      return 0;
+   }
+   //
+   // Save it in the cache for the next connections to this server
+   String chash;
+   if (!XrdSecgsiTicket::ChainHash(sessionCF, hs->PxyChain, chash)) {
+      NOTIFY("cannot hash the proxy chain: ticket not saved");
+      return 0;
+   }
+   String tag = TicketTag(chash);
+   XrdSutCERef ceref;
+   bool rdlock = false;
+   XrdSutCacheEntry *cent = cacheTkt.Get(tag.c_str(), rdlock, TicketCheck, 0);
+   if (!cent) {
+      NOTIFY("unable to get cache entry for ticket: "<<tag);
+      return 0;
+   }
+   ceref.Set(&(cent->rwmtx));
+   if (!rdlock) {
+      cent->buf1.SetBuf(bckt->buffer, bckt->size);
+      cent->buf2.SetBuf(secret.c_str(), secret.length() + 1);
+      cent->buf3.SetBuf(ctype.c_str(), ctype.length() + 1);
+      cent->cnt = clens.atoi();
+      cent->mtime = exps.atoi();
+      cent->status = kCE_ok;
+      DEBUG("session ticket saved for "<<tag<<" (expires: "<<cent->mtime<<")");
+   }
+   (*bm)->Deactivate(kXRS_ticket);
+   (*bm)->Deactivate(kXRS_ticket_auth);
+
+   //
+   // And we are done;
+   return 0;
+}
+
 //_________________________________________________________________________
 int XrdSecProtocolgsi::ParseServerInput(XrdSutBuffer *br, XrdSutBuffer **bm,
                                         String &cmsg)
@@ -3546,6 +3743,11 @@ int XrdSecProtocolgsi::ParseServerInput(XrdSutBuffer *br, XrdSutBuffer **bm,
          if (ServerDoSigpxy(br, bm, cmsg) != 0)
             return -1;
          break;
+      case kXGC_ticketack:
+         // Process message
+         if (ServerDoTicketack(br, bm, cmsg) != 0)
+            return -1;
+         break;
       default:
          cmsg = "protocol error: unknown action: "; cmsg += step;
          return -1;
@@ -3564,6 +3766,7 @@ int XrdSecProtocolgsi::ServerDoCertreq(XrdSutBuffer *br, XrdSutBuffer **bm,
    // Server side: process a kXGC_certreq message.
    // Return 0 on success, -1 on error. If the case, a message is returned
    // in cmsg.
+   EPNAME("ServerDoCertreq");
    XrdSutCERef ceref;
    XrdSutBucket *bck = 0;
    XrdSutBucket *bckm = 0;
@@ -3647,6 +3850,22 @@ int XrdSecProtocolgsi::ServerDoCertreq(XrdSutBuffer *br, XrdSutBuffer **bm,
    if (br->UnmarshalBucket(kXRS_clnt_opts, hs->Options) == 0)
       br->Deactivate(kXRS_clnt_opts);
 
+   //
+   // The client may try to resume a previous session with a ticket: if this
+   // fails we just go on with the full handshake
+   if (br->GetBucket(kXRS_ticket)) {
+      if (tktSeal) {
+         String tmsg;
+         if (ResumeSession(br, tmsg) == 0) {
+            hs->Resumed = true;
+         } else {
+            DEBUG("session ticket not accepted: "<<tmsg);
+         }
+      }
+      br->Deactivate(kXRS_ticket);
+      br->Deactivate(kXRS_ticket_auth);
+   }
+
    // We are done
    return 0;
 }
@@ -3844,6 +4063,9 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
       cmsg = "cannot attach to ParseBucket function!";
       return -1;
    }
+   // Fingerprint the verification before the chain gets the new certificates
+   std::string vkey;
+   XrdCryptoChainCache::Key(sessionCF, bck, hs->Chain, hs->Crl, 0, vkey);
    // Parse bucket
    int ncimin = (hs->Options & kOptsCreatePxy) ? 2 : 1;
    int nci = (*ParseBucket)(bck, hs->Chain);
@@ -3857,13 +4079,7 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
    }
    //
    // Verify the chain
-   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
-   }
+   if (!VerifyChain(vkey, cmsg)) return -1;
 
    //
    // Extract the client public key from the certificate
@@ -4151,6 +4367,282 @@ int XrdSecProtocolgsi::ServerDoSigpxy(XrdSutBuffer *br,  XrdSutBuffer **bm,
    return 0;
 }
 
+//_________________________________________________________________________
+int XrdSecProtocolgsi::ServerDoTicketack(XrdSutBuffer *br,  XrdSutBuffer **bm,
+                                         String &cmsg)
+{
+   // Server side: process a kXGC_ticketack message.
+   // Return 0 on success, -1 on error. If the case, a message is returned
+   // in cmsg.
+
+   //
+   // Extract the main buffer
+   XrdSutBucket *bckm = 0;
+   if (!(bckm = br->GetBucket(kXRS_main))) {
+      cmsg = "main buffer missing";
+      return -1;
+   }
+   //
+   // Decrypt the main buffer with the session cipher
+   if (!sessionKey || !(sessionKey->Decrypt(*bckm, useIV))) {
+      cmsg = "error decrypting main buffer with session cipher";
+      return -1;
+   }
+   //
+   // Deserialize main buffer
+   if (!((*bm) = new XrdSutBuffer(bckm->buffer,bckm->size))) {
+      cmsg = "error deserializing main buffer";
+      return -1;
+   }
+
+   // We are done
+   return 0;
+}
+
+//_________________________________________________________________________
+XrdOucString XrdSecProtocolgsi::TicketTag(const String &chash)
+{
+   // Tag of the client cache entry with the ticket for the current server
+   // and credentials
+
+   String tag(Entity.host ? Entity.host : "");
+   tag += ':';
+   tag += (Entity.addrInfo ? Entity.addrInfo->Port() : 0);
+   tag += '|';
+   tag += chash;
+   return tag;
+}
+
+//_________________________________________________________________________
+int XrdSecProtocolgsi::AddTicket(XrdSutBuffer *br, String &emsg)
+{
+   // Client side: add to br the ticket we hold for this server and proxy
+   // chain, if any, with a fresh authenticator. The session key to use if
+   // the server accepts the ticket is saved in hs->TktKey.
+   // Return 0 if a ticket was added, -1 otherwise (emsg says why).
+   XrdSecgsiTicket::Info ti;
+   String nonce, auth;
+
+   //
+   // Look for a ticket
+   if (!XrdSecgsiTicket::ChainHash(sessionCF, hs->PxyChain, ti.chash)) {
+      emsg = "cannot hash the proxy chain";
+      return -1;
+   }
+   String tag = TicketTag(ti.chash);
+   XrdSutCacheEntry *cent = cacheTkt.Get(tag.c_str());
+   if (!cent) {
+      emsg = "no ticket for "; emsg += tag;
+      return -1;
+   }
+   XrdSutCERef ceref;
+   ceref.Set(&(cent->rwmtx));
+   if (cent->status != kCE_ok || !cent->buf1.buf || !cent->buf2.buf
+                              || !cent->buf3.buf) {
+      emsg = "no valid ticket for "; emsg += tag;
+      return -1;
+   }
+   //
+   // Leave some margin to reach the server
+   if (cent->mtime <= hs->TimeStamp + TimeSkew) {
+      cent->status = kCE_expired;
+      emsg = "ticket expired";
+      return -1;
+   }
+   ti.secret = cent->buf2.buf;
+   ti.ctype = cent->buf3.buf;
+   ti.clen = cent->cnt;
+   ti.expires = cent->mtime;
+   //
+   // Authenticator and key for this session
+   XrdCryptoCipher *key = 0;
+   if (!XrdSecgsiTicket::Random(16, nonce) ||
+       !XrdSecgsiTicket::Authenticator(sessionCF, ti.secret, ti.chash,
+                                       (kXR_int32)hs->TimeStamp, nonce, auth) ||
+       !(key = XrdSecgsiTicket::SessionKey(sessionCF, ti, nonce))) {
+      emsg = "cannot create the ticket authenticator";
+      return -1;
+   }
+   char *tkt = new char[cent->buf1.len];
+   memcpy(tkt, cent->buf1.buf, cent->buf1.len);
+   if (br->AddBucket(tkt, cent->buf1.len, kXRS_ticket) != 0) {
+      delete[] tkt;
+      delete key;
+      emsg = "cannot add the ticket bucket";
+      return -1;
+   }
+   if (br->AddBucket(auth, kXRS_ticket_auth) != 0) {
+      br->Deactivate(kXRS_ticket);
+      delete key;
+      emsg = "cannot add the authenticator bucket";
+      return -1;
+   }
+   SafeDelete(hs->TktKey);
+   hs->TktKey = key;
+
+   // Done
+   return 0;
+}
+
+//_________________________________________________________________________
+int XrdSecProtocolgsi::IssueTicket(XrdSutBuffer *bm, String &emsg)
+{
+   // Server side: add to bm a ticket for the client just authenticated,
+   // together with the secret the client needs to use it.
+   // Return 0 on success, -1 otherwise (emsg says why).
+   XrdSecgsiTicket::Info ti;
+   XrdSutBucket *bck = 0;
+
+   //
+   // Resumed sessions carry no proxies nor credentials in raw form
+   if (PxyReqOpts & kOptsSrvReq) {
+      emsg = "delegated proxies requested";
+      return -1;
+   }
+   if (Entity.creds && Entity.credslen <= 0) {
+      emsg = "credentials in raw format";
+      return -1;
+   }
+   if (!sessionKey || !sessionKey->Type() || sessionCF->ID() != cryptID[0]) {
+      emsg = "session cipher not suitable";
+      return -1;
+   }
+   //
+   // Fill the ticket
+   if (!XrdSecgsiTicket::ChainHash(sessionCF, hs->Chain, ti.chash) ||
+       !XrdSecgsiTicket::Random(32, ti.secret)) {
+      emsg = "cannot create the ticket secrets";
+      return -1;
+   }
+   ti.ctype = sessionKey->Type();
+   ti.clen = sessionKey->Length();
+   //
+   // Not beyond the validity of the client proxy
+   ti.expires = hs->TimeStamp + TicketLife;
+   if (hs->Chain->End() && hs->Chain->End()->NotAfter() < ti.expires)
+      ti.expires = hs->Chain->End()->NotAfter();
+   if (ti.expires <= hs->TimeStamp + TimeSkew) {
+      emsg = "client proxy about to expire";
+      return -1;
+   }
+   std::string gmap;
+   ti.gmap = (Entity.eaAPI->Get("gridmap.name", gmap) ? 1 : 0);
+   if (Entity.name)         ti.name = Entity.name;
+   if (Entity.vorg)         ti.vorg = Entity.vorg;
+   if (Entity.role)         ti.role = Entity.role;
+   if (Entity.grps)         ti.grps = Entity.grps;
+   if (Entity.moninfo)      ti.moninfo = Entity.moninfo;
+   if (Entity.endorsements) ti.endorsements = Entity.endorsements;
+   if (Entity.creds)        ti.creds.assign(Entity.creds, 0, Entity.credslen - 1);
+   //
+   // Seal it and add it with the secret
+   if (!(bck = tktSeal->Seal(ti))) {
+      emsg = "cannot seal the ticket";
+      return -1;
+   }
+   if (bm->AddBucket(bck) != 0) {
+      delete bck;
+      emsg = "cannot add the ticket bucket";
+      return -1;
+   }
+   String sec;
+   sec.form("%d:%d:%s:%s", ti.expires, ti.clen, ti.ctype.c_str(), ti.secret.c_str());
+   if (bm->AddBucket(sec, kXRS_ticket_auth) != 0) {
+      emsg = "cannot add the ticket secret bucket";
+      return -1;
+   }
+
+   // Done
+   return 0;
+}
+
+//_________________________________________________________________________
+int XrdSecProtocolgsi::ResumeSession(XrdSutBuffer *br, String &emsg)
+{
+   // Server side: authenticate the client with the ticket and authenticator
+   // in br. On success the session key and the entity are set.
+   // Return 0 on success, -1 otherwise (emsg says why).
+   XrdSecgsiTicket::Info ti;
+   XrdSutBucket *bckt = br->GetBucket(kXRS_ticket);
+   XrdSutBucket *bcka = br->GetBucket(kXRS_ticket_auth);
+
+   if (!bckt || !bcka) {
+      emsg = "ticket or authenticator missing";
+      return -1;
+   }
+   if (sessionCF->ID() != cryptID[0]) {
+      emsg = "ticket not valid for crypto module "; emsg += hs->CryptoMod;
+      return -1;
+   }
+   //
+   // Check the ticket and the authenticator; the latter can be used once only
+   String auth, nonce;
+   bcka->ToString(auth);
+   if (!tktSeal->Open(bckt->buffer, bckt->size, ti, emsg)) return -1;
+   if (ti.expires <= hs->TimeStamp) {
+      emsg = "ticket expired";
+      return -1;
+   }
+   if (!XrdSecgsiTicket::CheckAuthenticator(sessionCF, ti, auth, hs->TimeStamp,
+                                            TimeSkew, nonce, emsg)) return -1;
+   if (!tktSeal->Fresh(auth.c_str(), 2*TimeSkew + 1)) {
+      emsg = "authenticator replayed";
+      return -1;
+   }
+   //
+   // Set the session key
+   XrdCryptoCipher *key = XrdSecgsiTicket::SessionKey(sessionCF, ti, nonce);
+   if (!key) {
+      emsg = "cannot derive the session key";
+      return -1;
+   }
+   SafeDelete(sessionKey);
+   sessionKey = key;
+   useIV = true;
+   //
+   // Restore the identity
+   if (ti.name.length() > 0)         Entity.name = strdup(ti.name.c_str());
+   if (ti.vorg.length() > 0)         Entity.vorg = strdup(ti.vorg.c_str());
+   if (ti.role.length() > 0)         Entity.role = strdup(ti.role.c_str());
+   if (ti.grps.length() > 0)         Entity.grps = strdup(ti.grps.c_str());
+   if (ti.moninfo.length() > 0)      Entity.moninfo = strdup(ti.moninfo.c_str());
+   if (ti.endorsements.length() > 0) Entity.endorsements = strdup(ti.endorsements.c_str());
+   if (ti.creds.length() > 0) {
+      Entity.creds = strdup(ti.creds.c_str());
+      Entity.credslen = ti.creds.length();
+   }
+   if (ti.gmap) Entity.eaAPI->Add("gridmap.name", "1", true);
+
+   // Done
+   return 0;
+}
+
+//_________________________________________________________________________
+bool XrdSecProtocolgsi::VerifyChain(const std::string &vkey, String &emsg)
+{
+   // Verify the chain in hs->Chain, unless the same chain has already been
+   // verified against the same CA and CRL (see XrdCryptoChainCache).
+   // Return true on success, false otherwise (emsg says why).
+   EPNAME("VerifyChain");
+
+   if (!vkey.empty() && cacheVerify.Find(vkey, hs->TimeStamp)
+                     && hs->Chain->Reorder() == 0) {
+      DEBUG("chain verification found in cache");
+      return 1;
+   }
+
+   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
+   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+   if (!(hs->Chain->Verify(ecode, &vopt))) {
+      emsg = "certificate chain verification failed: ";
+      emsg += hs->Chain->LastError();
+      return 0;
+   }
+   if (!vkey.empty())
+      cacheVerify.Add(vkey, XrdCryptoChainCache::Expiry(hs->Chain, hs->Crl));
+   return 1;
+}
+
 //__________________________________________________________________
 void XrdSecProtocolgsi::ErrF(XrdOucErrInfo *einfo, kXR_int32 ecode,
                              const char *msg1, const char *msg2,
@@ -4725,6 +5217,9 @@ int XrdSecProtocolgsi::GetCA(const char *cahash,
    if (chain) stackCA.Del(chain);
    if (crl) stackCRL->Del(crl);
 
+   // Drop also the chain verifications which have expired in the meantime
+   cacheVerify.Purge(timestamp);
+
    chain = 0;
    crl = 0;
    cent->buf1.buf = 0;
@@ -5024,8 +5519,8 @@ int XrdSecProtocolgsi::ParseCrypto(String clist)
                   ncrypt++;
                }
             }
-            // On servers the ref cipher should be defined at this point
-            hs->Rcip = sessionCF->Cipher(hs->HasPad, 0,0,0);
+            // On servers the ref cipher is created when the full handshake
+            // needs it: generating the DH parameters is expensive
             // we are done
             return 0;
          }
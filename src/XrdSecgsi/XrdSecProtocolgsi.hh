@@ -49,6 +49,7 @@
 #include "XrdSut/XrdSutRndm.hh"
 
 #include "XrdCrypto/XrdCryptoAux.hh"
+#include "XrdCrypto/XrdCryptoChainCache.hh"
 #include "XrdCrypto/XrdCryptoCipher.hh"
 #include "XrdCrypto/XrdCryptoFactory.hh"
 #include "XrdCrypto/XrdCryptoX509Crl.hh"
@@ -64,7 +65,7 @@ typedef XrdCryptogsiX509Chain X509Chain;
   
 #define XrdSecPROTOIDENT    "gsi"
 #define XrdSecPROTOIDLEN    sizeof(XrdSecPROTOIDENT)
-#define XrdSecgsiVERSION    10600
+#define XrdSecgsiVERSION    10700
 #define XrdSecNOIPCHK       0x0001
 #define XrdSecDEBUG         0x1000
 #define XrdCryptoMax        10
@@ -76,6 +77,8 @@ typedef XrdCryptogsiX509Chain X509Chain;
                                       // of server DH parameters 
 #define XrdSecgsiVersCertKey   10600  // Version at which started supporting
                                       // authentication with cert/key only
+#define XrdSecgsiVersTicket    10700  // Version at which started supporting
+                                      // session tickets
 
 //
 // Message codes either returned by server or included in buffers
@@ -91,6 +94,7 @@ enum kgsiClientSteps {
    kXGC_certreq     = 1000, // 1000: request server certificate
    kXGC_cert,               // 1001: packet with (proxy) certificate
    kXGC_sigpxy,             // 1002: packet with signed proxy certificate
+   kXGC_ticketack,          // 1003: acknowledgement of a session ticket
    kXGC_reserved            // 
 };
 
@@ -100,6 +104,7 @@ enum kgsiServerSteps {
    kXGS_init       = 2000,   // 2000: fake code used the first time 
    kXGS_cert,                // 2001: packet with certificate 
    kXGS_pxyreq,              // 2002: packet with proxy req to be signed 
+   kXGS_ticket,              // 2003: packet with a session ticket
    kXGS_reserved             //
 };
 
@@ -113,7 +118,8 @@ enum kgsiHandshakeOpts {
    kOptsDelChn     = 32,     // 0x0020: Delete chain
    kOptsPxCred     = 64,     // 0x0040: Save delegated proxies as credentials
    kOptsCreatePxy  = 128,    // 0x0080: Request a client proxy
-   kOptsDelPxy     = 256     // 0x0100: Delete the proxy PxyChain
+   kOptsDelPxy     = 256,    // 0x0100: Delete the proxy PxyChain
+   kOptsTicket     = 512     // 0x0200: Accept session tickets
 };
 
 // Error codes
@@ -212,6 +218,9 @@ public:
    int    moninfo; // [s] 0 do not look for; 1 use DN as default
    int    hashcomp; // [cs] 1 send hash names with both algorithms; 0 send only the default [1]
 
+   int    tickets; // [s] validity in secs of session tickets [0 => disabled]
+                   // [c] 1 use session tickets, 0 do not [1]
+
    bool   trustdns; // [cs] 'true' if DNS is trusted [true]
    bool   showDN;   // [cs] 'true' display the dn
 
@@ -225,12 +234,14 @@ public:
                   ogmap = 1; dlgpxy = 0; sigpxy = 1; srvnames = 0;
                   exppxy = 0; authzpxy = 0;
                   vomsat = 1; vomsfun = 0; vomsfunparms = 0; moninfo = 0;
-                  hashcomp = 1; trustdns = true; showDN = false; createpxy = 1;}
+                  hashcomp = 1; trustdns = true; showDN = false; createpxy = 1;
+                  tickets = 0;}
    virtual ~gsiOptions() { } // Cleanup inside XrdSecProtocolgsiInit
    void Print(XrdOucTrace *t); // Print summary of gsi option status
 };
 
 class XrdSecProtocolgsi;
+class XrdSecgsiTicket;
 class gsiHSVars;
 
 // From a proxy query
@@ -362,6 +373,8 @@ private:
    static bool             HashCompatibility;
    static bool             TrustDNS;
    static bool             ShowDN;
+   static int              TicketLife;
+   static bool             UseTickets;
    //
    // Crypto related info
    static int              ncrypt;                  // Number of factories
@@ -376,9 +389,12 @@ private:
    static XrdSutCache   cachePxy;  // Client proxies cache; 
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
+   static XrdSutCache   cacheTkt;  // Client session tickets cache
+   static XrdCryptoChainCache cacheVerify; // Successful chain verifications
    //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
+   static XrdSecgsiTicket *tktSeal;   // Session tickets sealing service
    //
    // CA and CRL stacks
    static GSIStack<XrdCryptoX509Chain>    stackCA; // Stack of CA in use
@@ -426,6 +442,8 @@ private:
                                String &cmsg);
    int            ClientDoPxyreq(XrdSutBuffer *br,  XrdSutBuffer **bm,
                                  String &cmsg);
+   int            ClientDoTicket(XrdSutBuffer *br,  XrdSutBuffer **bm,
+                                 String &cmsg);
 
    // Parsing received buffers: server
    int            ParseServerInput(XrdSutBuffer *br, XrdSutBuffer **bm,
@@ -436,6 +454,15 @@ private:
                                String &cmsg);
    int            ServerDoSigpxy(XrdSutBuffer *br,  XrdSutBuffer **bm,
                                  String &cmsg);
+   int            ServerDoTicketack(XrdSutBuffer *br,  XrdSutBuffer **bm,
+                                    String &cmsg);
+
+   // Session tickets
+   int            AddTicket(XrdSutBuffer *br, String &emsg);
+   int            IssueTicket(XrdSutBuffer *bm, String &emsg);
+   int            ResumeSession(XrdSutBuffer *br, String &emsg);
+   bool           VerifyChain(const std::string &vkey, String &emsg);
+   String         TicketTag(const String &chash);
 
    // Auxilliary functions
    int            ParseCrypto(String cryptlist);
@@ -522,12 +549,15 @@ public:
    int               Options;       // Handshake options;
    int               HashAlg;       // Hash algorithm of peer hash name;
    XrdSutBuffer     *Parms;         // Buffer with server parms on first iteration 
+   XrdCryptoCipher  *TktKey;        // Session key if the ticket is accepted
+   bool              Resumed;       // Session resumed from a ticket
 
    gsiHSVars() { Iter = 0; TimeStamp = -1; CryptoMod = "";
                  RemVers = -1; Rcip = 0; HasPad = 0;
                  Cbck = 0;
                  ID = ""; Cref = 0; Pent = 0; Chain = 0; Crl = 0; PxyChain = 0;
-                 RtagOK = 0; Tty = 0; LastStep = 0; Options = 0; HashAlg = 0; Parms = 0;}
+                 RtagOK = 0; Tty = 0; LastStep = 0; Options = 0; HashAlg = 0; Parms = 0;
+                 TktKey = 0; Resumed = false;}
 
    ~gsiHSVars() { SafeDelete(Cref);
                   if (Options & kOptsDelChn) {
@@ -552,6 +582,7 @@ public:
                      // are detected (and eventually removed) by QueryProxy
                      PxyChain = 0;
                   }
-                  SafeDelete(Parms); }
+                  SafeDelete(Parms);
+                  SafeDelete(TktKey); }
    void Dump(XrdSecProtocolgsi *p = 0);
 };
@@ -0,0 +1,469 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d S e c g s i T i c k e t . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "XrdSecgsi/XrdSecgsiTicket.hh"
+
+#include "XrdCrypto/XrdCryptoCipher.hh"
+#include "XrdCrypto/XrdCryptoFactory.hh"
+#include "XrdCrypto/XrdCryptoMsgDigest.hh"
+#include "XrdCrypto/XrdCryptoX509.hh"
+#include "XrdCrypto/XrdCryptoX509Chain.hh"
+#include "XrdSut/XrdSutAux.hh"
+#include "XrdSut/XrdSutBucket.hh"
+#include "XrdSut/XrdSutBuffer.hh"
+#include "XrdSys/XrdSysFD.hh"
+
+/******************************************************************************/
+/*                         L o c a l   D e f i n e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Version of the ticket format
+static const kXR_int32 tktVersion = 1;
+
+// Tag identifying the sealed buffer
+static const char *tktProto = "gsitkt";
+
+// Types of the buckets in the sealed buffer; these are private to the
+// server so they need not be registered with XrdSut (which reserves the
+// types 0, end-of-vector, and 1, inactive)
+enum tktBuckets {tktVers = 2, tktCHash, tktSecret, tktCType, tktCLen,
+                 tktExpires, tktGMap, tktName, tktVorg, tktRole, tktGrps,
+                 tktMonInfo, tktEndors, tktCreds
+                };
+
+// The cipher objects hold state so each thread works on its own copy. The
+// copy is made by importing the key: copy constructed ciphers are not ready
+// to be used.
+XrdCryptoCipher *CopyKey(XrdCryptoFactory *cf, XrdCryptoCipher *key)
+{
+   return cf->Cipher(key->Type(), key->Length(), (const char *)key->Buffer(),
+                     0, (const char *)0);
+}
+
+void AddString(XrdSutBuffer &buf, const XrdOucString &s, int type)
+{
+   // Empty buckets are not serialized consistently, so skip them
+   if (s.length() > 0) buf.AddBucket(s, type);
+}
+
+void GetString(XrdSutBuffer &buf, XrdOucString &s, int type)
+{
+   XrdSutBucket *bck = buf.GetBucket(type);
+   if (bck) bck->ToString(s);
+      else s = "";
+}
+
+// Compare two buffers in constant time
+bool SameMAC(const char *m1, const char *m2, int len)
+{
+   unsigned char diff = 0;
+   for (int i = 0; i < len; i++) diff |= (m1[i] ^ m2[i]);
+   return diff == 0;
+}
+
+// Fill a buffer with bytes from the system random source. We do not use
+// XrdSutRndm here as it is not meant to produce key material.
+bool RandomBytes(char *buf, int len)
+{
+   int fd, n, got = 0;
+
+   if ((fd = XrdSysFD_Open("/dev/urandom", O_RDONLY)) < 0) return false;
+   while (got < len)
+         {if ((n = read(fd, buf + got, len - got)) > 0) got += n;
+             else if (n < 0 && errno == EINTR) continue;
+             else break;
+         }
+   close(fd);
+   return got == len;
+}
+
+int PurgeNone(const char *, char *, void *) {return 0;}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdSecgsiTicket::XrdSecgsiTicket(XrdCryptoFactory *cf, const char *ctype)
+                : tCF(cf), tKey(0), rpPurge(0)
+{
+   XrdCryptoCipher *dflt;
+   char key[64];
+   int  klen;
+
+   // Find out the key length of the cipher and create it with a key of ours
+   //
+   memset(tMac, 0, sizeof(tMac));
+   if (!cf || !cf->SupportedCipher(ctype) || !(dflt = cf->Cipher(ctype)))
+      return;
+   klen = dflt->Length();
+   delete dflt;
+   if (klen <= 0 || klen > (int)sizeof(key)) return;
+
+   if (RandomBytes(key, klen) && RandomBytes(tMac, macLen))
+      tKey = cf->Cipher(ctype, klen, (const char *)key, 0, 0);
+   memset(key, 0, sizeof(key));
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSecgsiTicket::~XrdSecgsiTicket()
+{
+   if (tKey) delete tKey;
+   memset(tMac, 0, sizeof(tMac));
+}
+
+/******************************************************************************/
+/*                         A u t h e n t i c a t o r                          */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::Authenticator(XrdCryptoFactory *cf,
+                                    const XrdOucString &secret,
+                                    const XrdOucString &chash,
+                                    kXR_int32 tstamp,
+                                    const XrdOucString &nonce,
+                                    XrdOucString &auth)
+{
+   char mac[macLen], hmac[2*macLen+1];
+   XrdOucString data;
+
+   // The MAC covers the time stamp, the nonce and the chain hash, so that the
+   // authenticator is only valid for the chain the ticket was issued for
+   //
+   data.form("%d:%s:%s", tstamp, nonce.c_str(), chash.c_str());
+   if (!HMAC(cf, secret.c_str(), secret.length(),
+             data.c_str(), data.length(), mac)) return false;
+   XrdSutToHex(mac, macLen, hmac);
+   auth.form("%d:%s:%s", tstamp, nonce.c_str(), hmac);
+   return true;
+}
+
+/******************************************************************************/
+/*                    C h e c k A u t h e n t i c a t o r                     */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::CheckAuthenticator(XrdCryptoFactory *cf,
+                                         const Info &info,
+                                         const XrdOucString &auth,
+                                         time_t now, int skew,
+                                         XrdOucString &nonce,
+                                         XrdOucString &emsg)
+{
+   XrdOucString atok(auth), tstr, mine;
+   kXR_int32 tstamp;
+   int from = 0;
+
+   // Split the authenticator
+   //
+   if ((from = atok.tokenize(tstr, from, ':')) == -1
+   ||  (from = atok.tokenize(nonce, from, ':')) == -1
+   ||  tstr.length() <= 0 || nonce.length() <= 0)
+      {emsg = "malformed ticket authenticator"; return false;}
+   tstamp = atoi(tstr.c_str());
+
+   // The authenticator must be recent
+   //
+   if (tstamp < now - skew || tstamp > now + skew)
+      {emsg = "ticket authenticator time stamp out of range"; return false;}
+
+   // Recompute it and compare
+   //
+   if (!Authenticator(cf, info.secret, info.chash, tstamp, nonce, mine))
+      {emsg = "could not compute ticket authenticator"; return false;}
+   if (mine.length() != auth.length()
+   ||  !SameMAC(mine.c_str(), auth.c_str(), auth.length()))
+      {emsg = "ticket authenticator mismatch"; return false;}
+   return true;
+}
+
+/******************************************************************************/
+/*                             C h a i n H a s h                              */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::ChainHash(XrdCryptoFactory *cf,
+                                XrdCryptoX509Chain *chain,
+                                XrdOucString &chash)
+{
+   XrdCryptoMsgDigest *md;
+   XrdCryptoX509 *xp;
+   XrdOucString serial;
+   char hbuf[2*macLen+1];
+
+   if (!cf || !chain || !(xp = chain->End())) return false;
+   if (!(md = cf->MsgDigest("sha256"))) return false;
+
+   // Hash the subject, issuer, serial number and validity of the last
+   // certificate in the chain
+   //
+   serial = xp->SerialNumberString();
+   serial += ":"; serial += (int)xp->NotAfter();
+   if (xp->Subject()) md->Update(xp->Subject(), strlen(xp->Subject()) + 1);
+   if (xp->Issuer())  md->Update(xp->Issuer(),  strlen(xp->Issuer())  + 1);
+   md->Update(serial.c_str(), serial.length());
+   bool ok = (md->Final() == 0 && md->Length() <= macLen
+              && XrdSutToHex(md->Buffer(), md->Length(), hbuf) == 0);
+   if (ok) chash = hbuf;
+   delete md;
+   return ok;
+}
+
+/******************************************************************************/
+/*                                 F r e s h                                  */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::Fresh(const char *nonce, int life)
+{
+   XrdSysMutexHelper mHelp(rpMutex);
+   time_t now = time(0);
+
+   // Drop expired nonces every now and then so the cache stays small
+   //
+   if (now >= rpPurge)
+      {rpCache.Apply(PurgeNone, 0);
+       rpPurge = now + (life > 0 ? life : 1);
+      }
+
+   // Add returns the existing entry if the nonce was already seen
+   //
+   return rpCache.Add(nonce, 0, (life > 0 ? life : 1), Hash_data_is_key) == 0;
+}
+
+/******************************************************************************/
+/*                                  H M A C                                   */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::HMAC(XrdCryptoFactory *cf, const char *key, int klen,
+                           const char *data, int dlen, char *mac)
+{
+   static const int blkLen = 64;
+   XrdCryptoMsgDigest *md;
+   char kpad[blkLen], inner[macLen];
+   bool ok = false;
+
+   if (!cf || !(md = cf->MsgDigest("sha256"))) return false;
+
+   // Keys longer than the block size are hashed first
+   //
+   memset(kpad, 0, sizeof(kpad));
+   if (klen > blkLen)
+      {if (md->Update(key, klen) || md->Final() || md->Length() != macLen)
+          {delete md; return false;}
+       memcpy(kpad, md->Buffer(), macLen);
+      } else memcpy(kpad, key, klen);
+
+   // Inner hash over (key ^ ipad) | data
+   //
+   for (int i = 0; i < blkLen; i++) kpad[i] ^= 0x36;
+   if (!md->Reset("sha256") && !md->Update(kpad, blkLen)
+   &&  !md->Update(data, dlen) && !md->Final() && md->Length() == macLen)
+      {memcpy(inner, md->Buffer(), macLen);
+
+   // Outer hash over (key ^ opad) | inner
+   //
+       for (int i = 0; i < blkLen; i++) kpad[i] ^= (0x36 ^ 0x5c);
+       if (!md->Reset("sha256") && !md->Update(kpad, blkLen)
+       &&  !md->Update(inner, macLen) && !md->Final()
+       &&  md->Length() == macLen)
+          {memcpy(mac, md->Buffer(), macLen);
+           ok = true;
+          }
+      }
+
+   memset(kpad, 0, sizeof(kpad));
+   delete md;
+   return ok;
+}
+
+/******************************************************************************/
+/*                                  O p e n                                   */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::Open(const char *tkt, int tlen, Info &info,
+                           XrdOucString &emsg)
+{
+   XrdCryptoCipher *cip;
+   char mac[macLen];
+   kXR_int32 vers = 0;
+
+   if (!tKey) {emsg = "session tickets not available"; return false;}
+
+   // Verify the MAC before looking at anything else
+   //
+   if (tlen <= macLen) {emsg = "ticket too short"; return false;}
+   tlen -= macLen;
+   if (!HMAC(tCF, tMac, macLen, tkt, tlen, mac)
+   ||  !SameMAC(mac, tkt + tlen, macLen))
+      {emsg = "ticket not authentic"; return false;}
+
+   // Decrypt it with our own copy of the key
+   //
+   char *tbuf = new char[tlen];
+   memcpy(tbuf, tkt, tlen);
+   XrdSutBucket bck(tbuf, tlen, kXRS_ticket);
+   if (!(cip = CopyKey(tCF, tKey)))
+      {emsg = "could not copy ticket cipher"; return false;}
+   int rc = cip->Decrypt(bck, true);
+   delete cip;
+   if (rc <= 0) {emsg = "could not decrypt ticket"; return false;}
+
+   // Unpack the content
+   //
+   XrdSutBuffer buf(bck.buffer, bck.size);
+   if (strcmp(buf.GetProtocol(), tktProto)
+   ||  buf.UnmarshalBucket(tktVers, vers) || vers != tktVersion)
+      {emsg = "unsupported ticket format"; return false;}
+   if (buf.UnmarshalBucket(tktExpires, info.expires)
+   ||  buf.UnmarshalBucket(tktCLen, info.clen))
+      {emsg = "incomplete ticket"; return false;}
+   if (buf.UnmarshalBucket(tktGMap, info.gmap)) info.gmap = 0;
+   GetString(buf, info.chash,        tktCHash);
+   GetString(buf, info.secret,       tktSecret);
+   GetString(buf, info.ctype,        tktCType);
+   GetString(buf, info.name,         tktName);
+   GetString(buf, info.vorg,         tktVorg);
+   GetString(buf, info.role,         tktRole);
+   GetString(buf, info.grps,         tktGrps);
+   GetString(buf, info.moninfo,      tktMonInfo);
+   GetString(buf, info.endorsements, tktEndors);
+   GetString(buf, info.creds,        tktCreds);
+   if (info.chash.length() <= 0 || info.secret.length() <= 0
+   ||  info.ctype.length() <= 0)
+      {emsg = "incomplete ticket"; return false;}
+   return true;
+}
+
+/******************************************************************************/
+/*                                R a n d o m                                 */
+/******************************************************************************/
+
+bool XrdSecgsiTicket::Random(int len, XrdOucString &out)
+{
+   char *rbuf = new char[len], *hbuf = new char[2*len+1];
+   bool ok = RandomBytes(rbuf, len) && XrdSutToHex(rbuf, len, hbuf) == 0;
+
+   if (ok) out = hbuf;
+   memset(rbuf, 0, len);
+   delete [] rbuf;
+   delete [] hbuf;
+   return ok;
+}
+
+/******************************************************************************/
+/*                                  S e a l                                   */
+/******************************************************************************/
+
+XrdSutBucket *XrdSecgsiTicket::Seal(const Info &info)
+{
+   XrdCryptoCipher *cip;
+   XrdSutBucket *bck;
+   XrdSutBuffer buf(tktProto);
+   char *bser = 0;
+   int nser;
+
+   if (!tKey) return 0;
+
+   // Pack the content
+   //
+   buf.MarshalBucket(tktVers,    tktVersion);
+   buf.MarshalBucket(tktExpires, info.expires);
+   buf.MarshalBucket(tktCLen,    info.clen);
+   buf.MarshalBucket(tktGMap,    info.gmap);
+   AddString(buf, info.chash,        tktCHash);
+   AddString(buf, info.secret,       tktSecret);
+   AddString(buf, info.ctype,        tktCType);
+   AddString(buf, info.name,         tktName);
+   AddString(buf, info.vorg,         tktVorg);
+   AddString(buf, info.role,         tktRole);
+   AddString(buf, info.grps,         tktGrps);
+   AddString(buf, info.moninfo,      tktMonInfo);
+   AddString(buf, info.endorsements, tktEndors);
+   AddString(buf, info.creds,        tktCreds);
+   if ((nser = buf.Serialized(&bser)) <= 0) return 0;
+
+   // Encrypt it (the IV is prepended)
+   //
+   bck = new XrdSutBucket(bser, nser, kXRS_ticket);
+   if (!(cip = CopyKey(tCF, tKey)) || cip->Encrypt(*bck, true) <= 0)
+      {if (cip) delete cip;
+       delete bck;
+       return 0;
+      }
+   delete cip;
+
+   // Append the MAC
+   //
+   char *tbuf = new char[bck->size + macLen];
+   memcpy(tbuf, bck->buffer, bck->size);
+   if (!HMAC(tCF, tMac, macLen, tbuf, bck->size, tbuf + bck->size))
+      {delete [] tbuf;
+       delete bck;
+       return 0;
+      }
+   bck->Update(tbuf, bck->size + macLen);
+   return bck;
+}
+
+/******************************************************************************/
+/*                            S e s s i o n K e y                             */
+/******************************************************************************/
+
+XrdCryptoCipher *XrdSecgsiTicket::SessionKey(XrdCryptoFactory *cf,
+                                             const Info &info,
+                                             const XrdOucString &nonce)
+{
+   XrdCryptoCipher *cip;
+   XrdOucString data;
+   char key[2*macLen];
+
+   if (info.clen <= 0 || info.clen > (int)sizeof(key)) return 0;
+
+   // Expand the secret and the nonce into as many bytes as the key needs
+   //
+   for (int i = 0; i*macLen < info.clen; i++)
+       {data.form("key:%d:%s", i, nonce.c_str());
+        if (!HMAC(cf, info.secret.c_str(), info.secret.length(),
+                  data.c_str(), data.length(), key + i*macLen)) return 0;
+       }
+
+   cip = cf->Cipher(info.ctype.c_str(), info.clen, (const char *)key, 0, 0);
+   memset(key, 0, sizeof(key));
+   return cip;
+}
@@ -0,0 +1,246 @@
+#ifndef __SECGSI_TICKET_H__
+#define __SECGSI_TICKET_H__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d S e c g s i T i c k e t . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XProtocol/XPtypes.hh"
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucString.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCryptoCipher;
+class XrdCryptoFactory;
+class XrdCryptoX509Chain;
+class XrdSutBucket;
+
+/******************************************************************************/
+/*                       X r d S e c g s i T i c k e t                        */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! Session tickets allow a client that completed a full GSI handshake with a
+//! server to authenticate again to the same server in a single round trip,
+//! without exchanging and verifying certificates.
+//!
+//! At the end of a full handshake the server hands the client, over the
+//! encrypted channel, a random session secret and a ticket. The ticket holds
+//! the secret, the hash of the client proxy chain, the expiration time and the
+//! resulting identity, encrypted and authenticated with keys known only to
+//! the server. To resume, the client sends the ticket in its first message
+//! along with an authenticator: a time stamp and a nonce keyed with the
+//! session secret and bound to the hash of the chain the client now holds.
+//! The server accepts it if the ticket is intact and unexpired, the
+//! authenticator matches, is recent and has not been seen before. Both sides
+//! then derive the session key from the secret and the nonce.
+//-----------------------------------------------------------------------------
+
+class XrdSecgsiTicket
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! The information carried by a ticket.
+//-----------------------------------------------------------------------------
+
+struct Info
+{
+   XrdOucString chash;      // Hash of the client proxy chain
+   XrdOucString secret;     // Session secret (hex)
+   XrdOucString ctype;      // Type of the session cipher
+   kXR_int32    clen;       // Key length of the session cipher
+   kXR_int32    expires;    // Expiration time
+   kXR_int32    gmap;       // 1 if the name was obtained from the grid-map
+   XrdOucString name;
+   XrdOucString vorg;
+   XrdOucString role;
+   XrdOucString grps;
+   XrdOucString moninfo;
+   XrdOucString endorsements;
+   XrdOucString creds;
+
+   Info() : clen(0), expires(0), gmap(0) {}
+};
+
+//-----------------------------------------------------------------------------
+//! Seal a ticket (server side).
+//!
+//! @param  info   The information to seal.
+//!
+//! @return A bucket of type kXRS_ticket with the ticket or 0 on failure.
+//-----------------------------------------------------------------------------
+
+XrdSutBucket *Seal(const Info &info);
+
+//-----------------------------------------------------------------------------
+//! Open a ticket (server side).
+//!
+//! @param  tkt    The ticket.
+//! @param  tlen   The length of the ticket.
+//! @param  info   Filled with the information in the ticket.
+//! @param  emsg   Reason for failure.
+//!
+//! @return true if the ticket is authentic, false otherwise.
+//-----------------------------------------------------------------------------
+
+bool          Open(const char *tkt, int tlen, Info &info, XrdOucString &emsg);
+
+//-----------------------------------------------------------------------------
+//! Record a nonce, rejecting it if it was already seen (server side).
+//!
+//! @param  nonce  The nonce.
+//! @param  life   How long to remember it, in seconds.
+//!
+//! @return true if the nonce was not seen before.
+//-----------------------------------------------------------------------------
+
+bool          Fresh(const char *nonce, int life);
+
+//-----------------------------------------------------------------------------
+//! Compute the authenticator for a ticket (client side) or recompute it to
+//! check the one received (server side).
+//!
+//! @param  cf     The crypto factory.
+//! @param  secret The session secret.
+//! @param  chash  The hash of the client proxy chain.
+//! @param  tstamp The time stamp.
+//! @param  nonce  The nonce.
+//! @param  auth   Filled with the authenticator "<tstamp>:<nonce>:<mac>".
+//!
+//! @return true on success, false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool   Authenticator(XrdCryptoFactory *cf, const XrdOucString &secret,
+                            const XrdOucString &chash, kXR_int32 tstamp,
+                            const XrdOucString &nonce, XrdOucString &auth);
+
+//-----------------------------------------------------------------------------
+//! Check an authenticator against the information in a ticket (server side).
+//!
+//! @param  cf     The crypto factory.
+//! @param  info   The information in the ticket.
+//! @param  auth   The authenticator received.
+//! @param  now    The current time.
+//! @param  skew   The allowed time skew in seconds.
+//! @param  nonce  Filled with the nonce.
+//! @param  emsg   Reason for failure.
+//!
+//! @return true if the authenticator is valid, false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool   CheckAuthenticator(XrdCryptoFactory *cf, const Info &info,
+                                 const XrdOucString &auth, time_t now, int skew,
+                                 XrdOucString &nonce, XrdOucString &emsg);
+
+//-----------------------------------------------------------------------------
+//! Derive the session key of a resumed session.
+//!
+//! @param  cf     The crypto factory.
+//! @param  info   The ticket information (only secret, ctype and clen used).
+//! @param  nonce  The nonce of the authenticator.
+//!
+//! @return The session cipher or 0 on failure.
+//-----------------------------------------------------------------------------
+
+static XrdCryptoCipher *SessionKey(XrdCryptoFactory *cf, const Info &info,
+                                   const XrdOucString &nonce);
+
+//-----------------------------------------------------------------------------
+//! Compute the hash identifying a proxy chain. It covers the last
+//! certificate of the chain which is unique to each proxy.
+//!
+//! @param  cf     The crypto factory.
+//! @param  chain  The chain.
+//! @param  chash  Filled with the hash (hex).
+//!
+//! @return true on success, false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool   ChainHash(XrdCryptoFactory *cf, XrdCryptoX509Chain *chain,
+                        XrdOucString &chash);
+
+//-----------------------------------------------------------------------------
+//! Generate random bytes, encoded in hex.
+//!
+//! @param  len    The number of random bytes.
+//! @param  out    Filled with 2*len hex characters.
+//!
+//! @return true on success, false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool   Random(int len, XrdOucString &out);
+
+//-----------------------------------------------------------------------------
+//! Compute an HMAC-SHA256.
+//!
+//! @param  cf     The crypto factory.
+//! @param  key    The key.
+//! @param  klen   The key length.
+//! @param  data   The data.
+//! @param  dlen   The data length.
+//! @param  mac    Buffer of at least macLen bytes receiving the MAC.
+//!
+//! @return true on success, false otherwise.
+//-----------------------------------------------------------------------------
+
+static const int macLen = 32;
+
+static bool   HMAC(XrdCryptoFactory *cf, const char *key, int klen,
+                   const char *data, int dlen, char *mac);
+
+//-----------------------------------------------------------------------------
+//! Check whether the sealing keys could be created.
+//-----------------------------------------------------------------------------
+
+bool          IsValid() const {return tKey != 0;}
+
+//-----------------------------------------------------------------------------
+//! Constructor. The sealing keys are random, so tickets are only valid for
+//! the process that sealed them.
+//!
+//! @param  cf     The crypto factory.
+//! @param  ctype  The cipher used to encrypt tickets.
+//-----------------------------------------------------------------------------
+
+              XrdSecgsiTicket(XrdCryptoFactory *cf,
+                              const char *ctype = "aes-256-cbc");
+
+             ~XrdSecgsiTicket();
+
+private:
+
+XrdCryptoFactory *tCF;           // Crypto factory
+XrdCryptoCipher  *tKey;          // Key used to encrypt tickets
+char              tMac[macLen];  // Key used to authenticate tickets
+
+XrdSysMutex       rpMutex;       // Protects the replay cache
+XrdOucHash<char>  rpCache;       // Nonces seen recently
+time_t            rpPurge;       // Time of the next purge of rpCache
+};
+#endif
@@ -33,6 +33,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <vector>
 
 #include <sys/types.h>
 #include <pwd.h>
@@ -44,7 +46,9 @@
 #include "XrdSut/XrdSutAux.hh"
 
 #include "XrdCrypto/XrdCryptoAux.hh"
+#include "XrdCrypto/XrdCryptoCipher.hh"
 #include "XrdCrypto/XrdCryptoFactory.hh"
+#include "XrdCrypto/XrdCryptoRSA.hh"
 #include "XrdCrypto/XrdCryptoX509.hh"
 #include "XrdCrypto/XrdCryptoX509Req.hh"
 #include "XrdCrypto/XrdCryptoX509Chain.hh"
@@ -54,6 +58,7 @@
 
 #include "XrdCrypto/XrdCryptogsiX509Chain.hh"
 
+#include "XrdSecgsi/XrdSecgsiTicket.hh"
 #include "XrdSecgsi/XrdSecgsiTrace.hh"
 
 #include <openssl/x509v3.h>
@@ -74,6 +79,7 @@ int          CAnum = 0;
 XrdOucString CAcert[5];
 int          Dbg = 0;
 int          Help = 0;
+int          Bench = 0;
 
 //
 // For error logging and tracing
@@ -124,16 +130,125 @@ static void printHelp()
    printf("      X509_CERT_DIR   [/etc/grid-security/certificates/] CA certificates and CRL directories\n");
    printf(" \n");
    printf(" Usage:\n");
-   printf("      xrdgsitest [-v,--verbose] [-h,--help] \n");
+   printf("      xrdgsitest [-v,--verbose] [-h,--help] [-b,--bench <n>]\n");
    printf(" \n");
    printf("      -h, --help             Print this screen\n");
    printf("      -v, --verbose          Dump all details\n");
+   printf("      -b, --bench <n>        Time <n> server side handshakes, full and resumed\n");
+   printf("                             with a session ticket, and exit (no files needed)\n");
    printf(" \n");
    printf(" The output is a list of PASSED/FAILED test, interleaved with details when the verbose option\n");
    printf(" is chosen.\n");
    printf(" \n");
 }
 
+//
+// Time the crypto work done by a server to authenticate a client: the full
+// handshake (DH key generation and agreement, signature of our DH parameters
+// and verification of the client ones) and the resumption of a session with
+// a ticket. Certificate chain verification, which only the full handshake
+// needs, is not included.
+static int benchHandshakes(int n)
+{
+   typedef std::chrono::steady_clock Clock;
+   const char *cip = "aes-256-cbc";
+
+   pline("");
+   pline("Server side handshake cost");
+   pline("");
+
+   XrdCryptoRSA *srvK = gCryptoFactory->RSA(2048);
+   XrdCryptoRSA *cliK = gCryptoFactory->RSA(2048);
+   XrdCryptoCipher *cliC = gCryptoFactory->Cipher(true, 0, 0, 0, cip);
+   if (!srvK || !cliK || !cliC) {
+      pdots("Creating keys", 0);
+      return 1;
+   }
+   //
+   // Client DH parameters, signed as the client would do
+   int lpub = 0;
+   char *cpub = cliC->Public(lpub);
+   XrdSutBucket cbck(cpub, lpub, kXRS_cipher);
+   if (cliK->EncryptPrivate(cbck) <= 0) {
+      pdots("Signing client DH parameters", 0);
+      return 1;
+   }
+
+   //
+   // Full handshake
+   Clock::time_point t0 = Clock::now();
+   for (int i = 0; i < n; i++) {
+      XrdCryptoCipher *rcip = gCryptoFactory->Cipher(true, 0, 0, 0, cip);
+      int lspub = 0;
+      char *spub = rcip->Public(lspub);
+      XrdSutBucket sbck(spub, lspub, kXRS_cipher);
+      srvK->EncryptPrivate(sbck);
+      XrdSutBucket vbck(cbck);
+      if (cliK->DecryptPublic(vbck) <= 0
+      ||  !rcip->Finalize(true, vbck.buffer, vbck.size, cip)) {
+         pdots("Full handshake", 0);
+         return 1;
+      }
+      delete rcip;
+   }
+   double tfull = std::chrono::duration<double>(Clock::now() - t0).count();
+
+   //
+   // Resumption: the ticket and the authenticators are prepared in advance,
+   // as the clients would do
+   XrdSecgsiTicket tkt(gCryptoFactory);
+   XrdSecgsiTicket::Info ti;
+   XrdSutBucket *tbck = 0;
+   XrdOucString emsg;
+   ti.ctype = cip;
+   ti.clen = 32;
+   ti.expires = time(0) + 3600;
+   ti.name = "gsitest";
+   if (!XrdSecgsiTicket::Random(32, ti.chash) || !XrdSecgsiTicket::Random(32, ti.secret)
+   ||  !(tbck = tkt.Seal(ti))) {
+      pdots("Sealing a session ticket", 0);
+      return 1;
+   }
+   std::vector<XrdOucString> auths(n);
+   for (int i = 0; i < n; i++) {
+      XrdOucString nonce;
+      if (!XrdSecgsiTicket::Random(16, nonce)
+      ||  !XrdSecgsiTicket::Authenticator(gCryptoFactory, ti.secret, ti.chash,
+                                          time(0), nonce, auths[i])) {
+         pdots("Creating authenticators", 0);
+         return 1;
+      }
+   }
+   t0 = Clock::now();
+   for (int i = 0; i < n; i++) {
+      XrdSecgsiTicket::Info to;
+      XrdOucString nonce;
+      XrdCryptoCipher *key = 0;
+      if (!tkt.Open(tbck->buffer, tbck->size, to, emsg)
+      ||  !XrdSecgsiTicket::CheckAuthenticator(gCryptoFactory, to, auths[i],
+                                               time(0), 300, nonce, emsg)
+      ||  !tkt.Fresh(auths[i].c_str(), 601)
+      ||  !(key = XrdSecgsiTicket::SessionKey(gCryptoFactory, to, nonce))) {
+         pdots("Ticket resumption", 0);
+         if (emsg.length() > 0) printf("|| %s\n", emsg.c_str());
+         return 1;
+      }
+      delete key;
+   }
+   double ttkt = std::chrono::duration<double>(Clock::now() - t0).count();
+
+   printf("|| full handshake:     %10.1f handshakes/s per core\n", n / tfull);
+   printf("|| ticket resumption:  %10.1f handshakes/s per core\n", n / ttkt);
+   printf("|| speed-up:           %10.1f\n", tfull / ttkt);
+   pline("");
+
+   delete tbck;
+   delete cliC;
+   delete cliK;
+   delete srvK;
+   return 0;
+}
+
 int main( int argc, char **argv )
 {
    // Test implemented functionality
@@ -149,6 +264,9 @@ int main( int argc, char **argv )
       if (!strcmp(argv[i], "-vv")) Dbg = 2;
       // Help
       if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) Help = 1;
+      // Benchmark
+      if ((!strcmp(argv[i], "-b") || !strcmp(argv[i], "--bench")) && i+1 < argc)
+         Bench = atoi(argv[++i]);
    }
 
    // Print help if required
@@ -190,6 +308,10 @@ int main( int argc, char **argv )
    if (Dbg > 0)
       gCryptoFactory->SetTrace(cryptoTRACE_Debug);
 
+   //
+   // Benchmark only, if required
+   if (Bench > 0) exit(benchHandshakes(Bench));
+
    pline("");
    pline("Crypto functionality tests for GSI");
    pline("");
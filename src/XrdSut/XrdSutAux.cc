@@ -77,6 +77,8 @@ static const char *gXRSBucketTypes[] = {
    "kXRS_cipher_alg",
    "kXRS_md_alg",
    "kXRS_afsinfo",
+   "kXRS_ticket",
+   "kXRS_ticket_auth",
    "kXRS_reserved"
 };
 
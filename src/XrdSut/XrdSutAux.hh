@@ -82,6 +82,8 @@ enum kXRSBucketTypes {
    kXRS_cipher_alg,            // 3025    Cipher algorithm (list)
    kXRS_md_alg,                // 3026    MD algorithm (list)
    kXRS_afsinfo,               // 3027    AFS information
+   kXRS_ticket,                // 3028    Session ticket
+   kXRS_ticket_auth,           // 3029    Session ticket secret / authenticator
    kXRS_reserved               //         Reserved
 };
 
@@ -28,7 +28,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSut/XrdSutCacheEntry.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
@@ -48,7 +48,10 @@ typedef struct {
 
 class XrdSutCache {
 public:
-   XrdSutCache(int psize = 89, int size = 144, int load = 80) : table(psize, size, load) {}
+   // The table is split into 16 independently locked shards sharing the
+   // initial 'size' ('psize' is no longer used).
+   XrdSutCache(int psize = 89, int size = 144, int load = 80)
+              : table(nShards, size/nShards, load) {}
    virtual ~XrdSutCache() {}
 
    XrdSutCacheEntry *Get(const char *tag) {
@@ -59,11 +62,11 @@ public:
 
       XrdSutCacheEntry *cent = 0;
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Exclusive access to the part of the table holding the tag
+      XrdOucShardedHash<XrdSutCacheEntry>::Ref tab(table, tag);
 
       // Look for an entry
-      if (!(cent = table.Find(tag))) {
+      if (!(cent = tab->Find(tag))) {
          // none found
          return cent;
       }
@@ -90,11 +93,11 @@ public:
       rdlock = false;
       XrdSutCacheEntry *cent = 0;
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Exclusive access to the part of the table holding the tag
+      XrdOucShardedHash<XrdSutCacheEntry>::Ref tab(table, tag);
 
       // Look for an entry
-      if (!(cent = table.Find(tag))) {
+      if (!(cent = tab->Find(tag))) {
          // If none, create a new one and write-lock for validation
          cent = new XrdSutCacheEntry(tag);
          int status = 0;
@@ -105,7 +108,7 @@ public:
             return (XrdSutCacheEntry *)0;
          }
          // Register it in the table
-         table.Add(tag, cent);
+         tab->Add(tag, cent);
          return cent;
       }
 
@@ -147,8 +150,8 @@ public:
    inline void Reset() { return table.Purge(); }
 
 private:
-   XrdSysRecMutex         mtx;  // Protect access to table
-   XrdOucHash<XrdSutCacheEntry> table; // table with content
+   static const int nShards = 16;
+   XrdOucShardedHash<XrdSutCacheEntry> table; // table with content
 };
 
 #endif
@@ -0,0 +1,209 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d S y s H i s t o g r a m . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "XrdSys/XrdSysHistogram.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   O b j e c t s                          */
+/******************************************************************************/
+
+namespace
+{
+// Histograms may be statically constructed, so the list anchor must not
+// depend on the order of static initialization.
+//
+XrdSysMutex &histMutex() {static XrdSysMutex hMutex; return hMutex;}
+
+XrdSysHistogram *histFirst = 0;
+
+RAtomic_int      histStripe(0);
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdSysHistogram::XrdSysHistogram(const char *name)
+{
+// Atomics are not zero initialized, so do so now
+//
+   Count = 0;
+   TotUS = 0;
+   for (int i = 0; i < Buckets; i++) Hits[i] = 0;
+   for (int j = 0; j < stripeNum; j++)
+       {for (int i = 0; i < Buckets; i++) Stripes[j].Hits[i] = 0;
+        Stripes[j].TotUS = 0;
+       }
+   hName = (name ? strdup(name) : 0);
+
+// Add this histogram to the list of histograms
+//
+   XrdSysMutexHelper mHelp(histMutex());
+   Next = histFirst;
+   histFirst = this;
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSysHistogram::~XrdSysHistogram()
+{
+   XrdSysHistogram *hP, *pP = 0;
+
+// Remove ourselves from the list of histograms
+//
+   histMutex().Lock();
+   hP = histFirst;
+   while(hP && hP != this) {pP = hP; hP = hP->Next;}
+   if (hP)
+      {if (pP) pP->Next = Next;
+          else histFirst = Next;
+      }
+   histMutex().UnLock();
+
+   if (hName) free(hName);
+}
+
+/******************************************************************************/
+/*                                 M e r g e                                  */
+/******************************************************************************/
+
+void XrdSysHistogram::Merge()
+{
+   unsigned long long hits, totHits = 0, totUS = 0;
+
+// Sum up the stripes. The stripes are never reset so the merged values are
+// monotonically increasing counters, just like all other summary counters.
+//
+   for (int i = 0; i < Buckets; i++)
+       {hits = 0;
+        for (int j = 0; j < stripeNum; j++) hits += Stripes[j].Hits[i];
+        Hits[i] = hits;
+        totHits += hits;
+       }
+   for (int j = 0; j < stripeNum; j++) totUS += Stripes[j].TotUS;
+
+   Count = totHits;
+   TotUS = totUS;
+}
+
+/******************************************************************************/
+/*                              M e r g e A l l                               */
+/******************************************************************************/
+
+void XrdSysHistogram::MergeAll()
+{
+   XrdSysMutexHelper mHelp(histMutex());
+   XrdSysHistogram  *hP = histFirst;
+
+   while(hP) {hP->Merge(); hP = hP->Next;}
+}
+
+/******************************************************************************/
+/*                             N e w S t r i p e                              */
+/******************************************************************************/
+
+int XrdSysHistogram::NewStripe()
+{
+// Threads are assigned to stripes in a round-robin fashion
+//
+   return static_cast<unsigned int>(histStripe++) % stripeNum;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdSysHistogram::Stats(char *buff, int blen, int do_sync)
+{
+   static const char head[] = "<stats id=\"ltcy\">";
+   static const char tail[] = "</stats>";
+   static const int  hLen = sizeof(head)-1, tLen = sizeof(tail)-1;
+   XrdSysMutexHelper mHelp(histMutex());
+   XrdSysHistogram  *hP = histFirst;
+   char *bP, hBuff[1024];
+   int   n, hsz, bLast;
+
+// If no buffer, caller wants the maximum size we will generate
+//
+   if (!buff)
+      {n = hLen + tLen;
+       while(hP)
+            {if (hP->hName) n += 64 + strlen(hP->hName) + 21*(Buckets+2);
+             hP = hP->Next;
+            }
+       return n;
+      }
+
+// Make sure we have room for the minimal report
+//
+   if (blen <= hLen + tLen) return 0;
+   strcpy(buff, head);
+   bP = buff + hLen; blen -= hLen + tLen;
+
+// Format each named histogram that has observations. Trailing empty buckets
+// are not reported. A histogram that does not fit is skipped in its entirety.
+//
+   while(hP)
+        {if (hP->hName)
+            {hP->Merge();
+             if (hP->Count)
+                {bLast = Buckets-1;
+                 while(bLast > 0 && !hP->Hits[bLast]) bLast--;
+                 hsz = snprintf(hBuff, sizeof(hBuff),
+                                "<hist id=\"%s\"><n>%llu</n><us>%llu</us><b>",
+                                hP->hName, (unsigned long long)hP->Count,
+                                (unsigned long long)hP->TotUS);
+                 for (int i = 0; i <= bLast && hsz < (int)sizeof(hBuff); i++)
+                     hsz += snprintf(hBuff+hsz, sizeof(hBuff)-hsz,
+                                     (i ? " %llu" : "%llu"),
+                                     (unsigned long long)hP->Hits[i]);
+                 if (hsz < (int)sizeof(hBuff))
+                    hsz += snprintf(hBuff+hsz, sizeof(hBuff)-hsz,"</b></hist>");
+                 if (hsz < (int)sizeof(hBuff) && hsz < blen)
+                    {memcpy(bP, hBuff, hsz);
+                     bP += hsz; blen -= hsz;
+                    }
+                }
+            }
+         hP = hP->Next;
+        }
+
+// Finish up
+//
+   strcpy(bP, tail);
+   return (bP - buff) + tLen;
+}
@@ -0,0 +1,182 @@
+#ifndef __XRDSYSHISTOGRAM_HH__
+#define __XRDSYSHISTOGRAM_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d S y s H i s t o g r a m . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <ctime>
+
+#include "XrdSys/XrdSysRAtomic.hh"
+
+//-----------------------------------------------------------------------------
+//! XrdSysHistogram
+//!
+//! This class implements a low overhead latency histogram. Observations are
+//! recorded in microseconds into log2 buckets without taking any lock. Each
+//! thread is assigned to one of several cache line aligned stripes so that
+//! concurrent threads rarely touch the same counters. The stripes are only
+//! summed (i.e. merged) when the histogram is reported.
+//!
+//! Bucket 0 counts observations below 2us, bucket i counts observations in
+//! [2**i, 2**(i+1)) microseconds, and the last bucket counts everything else
+//! (i.e. 2**27us or about 134 seconds and above).
+//!
+//! All histograms are kept in a process wide list so that they can be merged
+//! in one go. Named histograms are also reported in the "ltcy" section of the
+//! summary statistics (see xrd.report). Unnamed histograms are only reported
+//! when registered via XrdMonRoll::Register().
+//-----------------------------------------------------------------------------
+
+class XrdSysHistogram
+{
+public:
+
+static const int Buckets = 28;
+
+//-----------------------------------------------------------------------------
+//! Record an observation.
+//!
+//! @param usec - the latency in microseconds.
+//-----------------------------------------------------------------------------
+
+inline
+void        Add(unsigned long long usec)
+               {int sNum = tStripe;
+                if (sNum < 0) sNum = tStripe = NewStripe();
+                Stripe& sP = Stripes[sNum];
+                sP.Hits[Bucket(usec)]++;
+                sP.TotUS += usec;
+               }
+
+//-----------------------------------------------------------------------------
+//! Return the bucket an observation falls into.
+//-----------------------------------------------------------------------------
+
+static inline
+int         Bucket(unsigned long long usec)
+                  {if (usec < 2) return 0;
+                   int bNum = 63 - __builtin_clzll(usec);
+                   return (bNum < Buckets ? bNum : Buckets-1);
+                  }
+
+//-----------------------------------------------------------------------------
+//! Merge the stripes into the reported values (i.e. Count, TotUS, and Hits).
+//! Merge() does so for this histogram and MergeAll() for every histogram.
+//-----------------------------------------------------------------------------
+
+void        Merge();
+
+static void MergeAll();
+
+//-----------------------------------------------------------------------------
+//! Return the histogram name (may be nil).
+//-----------------------------------------------------------------------------
+
+const char *Name() {return hName;}
+
+//-----------------------------------------------------------------------------
+//! Return a monotonic time stamp in microseconds.
+//-----------------------------------------------------------------------------
+
+static inline
+unsigned long long Now()
+                  {struct timespec ts;
+                   clock_gettime(CLOCK_MONOTONIC, &ts);
+                   return static_cast<unsigned long long>(ts.tv_sec)*1000000
+                        + ts.tv_nsec/1000;
+                  }
+
+//-----------------------------------------------------------------------------
+//! Format the statistics of all named histograms that have observations.
+//!
+//! @param buff    - the buffer to receive the XML statistics. When nil, the
+//!                  maximum length of the statistics is returned.
+//! @param blen    - the length of the buffer.
+//! @param do_sync - ignored, observations are never locked.
+//!
+//! @return the number of bytes placed in the buffer.
+//-----------------------------------------------------------------------------
+
+static int  Stats(char *buff, int blen, int do_sync=0);
+
+//-----------------------------------------------------------------------------
+//! The Timer class records the time from its construction to its destruction
+//! in the associated histogram. It is a no-op when the histogram is nil.
+//-----------------------------------------------------------------------------
+
+class Timer
+     {public:
+                Timer(XrdSysHistogram *hP) : histP(hP)
+                     {if (hP) tBeg = Now();}
+               ~Timer() {if (histP) histP->Add(Now() - tBeg);}
+      private:
+      XrdSysHistogram   *histP;
+      unsigned long long tBeg = 0;
+     };
+
+//-----------------------------------------------------------------------------
+//! The merged values. These are only updated by Merge() and are suitable for
+//! registration as XrdMonRoll items.
+//-----------------------------------------------------------------------------
+
+RAtomic_ullong Count;            // Number of observations
+RAtomic_ullong TotUS;            // Sum of all observations in microseconds
+RAtomic_ullong Hits[Buckets];    // Observations per bucket
+
+//-----------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param name  - the histogram name. When specified, the histogram is
+//!                included in the "ltcy" statistics section and the name
+//!                becomes its id. The name must consist of characters that
+//!                are valid in an XML attribute value and is copied.
+//-----------------------------------------------------------------------------
+
+            XrdSysHistogram(const char *name=0);
+
+           ~XrdSysHistogram();
+
+private:
+
+static int  NewStripe();
+
+static const int stripeNum = 16;
+
+struct alignas(64) Stripe
+      {RAtomic_ullong Hits[Buckets];
+       RAtomic_ullong TotUS;
+      };
+
+static inline thread_local int tStripe = -1;
+
+Stripe           Stripes[stripeNum];
+XrdSysHistogram *Next;
+char            *hName;
+};
+#endif
@@ -55,7 +55,7 @@ int XrdSysXAttr::Copy(const char *iPath, int iFD, const char *oPath, int oFD,
     // Get all of the attributes for the input
     //
        if ((maxSz = List(&aP, iPath, iFD, 1)) <= 0)
-          return maxSz == 0 || maxSz == -ENOTSUP;
+          return (maxSz == 0 || maxSz == -ENOTSUP ? 0 : maxSz);
 
     // Allocate a buffer to hold the largest attribute value (plus some)
     //
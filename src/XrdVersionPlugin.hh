@@ -106,6 +106,7 @@
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOfsAddPrepare              )\
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOfsFSctl                   )\
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOfsgetPrepare              )\
+        XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOfsTPCEngineGet            )\
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOssGetStorageSystem        )\
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOssAddStorageSystem2       )\
         XrdVERSIONPLUGIN_Rule(Required,  5,  0, XrdOssGetStorageSystem2       )\
@@ -232,6 +233,7 @@
         XrdVERSIONPLUGIN_Mapd(@logging,         XrdSysLogPInit                )\
         XrdVERSIONPLUGIN_Mapd(ofs.ctllib,       XrdOfsFSctl                   )\
         XrdVERSIONPLUGIN_Mapd(ofs.preplib,      XrdOfsgetPrepare              )\
+        XrdVERSIONPLUGIN_Mapd(ofs.tpc,          XrdOfsTPCEngineGet            )\
         XrdVERSIONPLUGIN_Mapd(ofs.osslib,       XrdOssGetStorageSystem2       )\
         XrdVERSIONPLUGIN_Mapd(oss.statlib,      XrdOssStatInfoInit2           )\
         XrdVERSIONPLUGIN_Mapd(pss.cachelib,     XrdOucGetCache2               )\
@@ -33,6 +33,8 @@
 #include <cstring>
 #include <strings.h>
 
+#include "Xrd/XrdMonRoll.hh"
+
 #include "XrdNet/XrdNetAddr.hh"
 
 #include "XrdOuc/XrdOuca2x.hh"
@@ -173,6 +175,11 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
 //
    if (!XrdXrootdMonitor::Init()) return false;
 
+// Report the monitoring packet counters in the summary report
+//
+   XrdMonRoll *mrollP = (XrdMonRoll *)xrootdEnv.GetPtr("XrdMonRoll*");
+   if (mrollP) XrdXrootdMonitor::Register(*mrollP);
+
 // Cleanup
 //
    if (MP->monDest[0]) MP->Exported();
@@ -31,9 +31,12 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <atomic>
 
 #include "XrdVersion.hh"
 
@@ -42,7 +45,9 @@
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 
+#include "Xrd/XrdMonRoll.hh"
 #include "Xrd/XrdScheduler.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
@@ -196,6 +201,253 @@ XrdScheduler  *Sched;     // System scheduler
 int            Window;
 };
 
+/******************************************************************************/
+/*          C l a s s   X r d X r o o t d M o n i t o r _ S e n d e r         */
+/******************************************************************************/
+
+// Packets are handed to a dedicated sender thread via a bounded lock-free
+// queue so that the threads producing monitoring records never wait on the
+// network. The sender ships whatever has accumulated as a single batch. When
+// the queue is full the packet is dropped and counted instead of blocking.
+//
+class XrdXrootdMonitor_Sender
+{
+public:
+
+static const int   qSize = 256;            // Must be a power of two
+static const int   bMax  = 64;             // Max packets per batch
+
+bool               Add(int mMode, const void *buff, int blen, bool setseq);
+
+bool               isRunning() {return Running;}
+
+void               Run();
+
+void               Ship(XrdNetMsg *netP, int mMode, int &seq,
+                        int *sNum, int sCnt);
+
+bool               Start();
+
+RAtomic_ullong     numSent;
+RAtomic_ullong     numDrop;
+
+      XrdXrootdMonitor_Sender() : numSent(0), numDrop(0), qSem(0),
+                                  enqPos(0), deqPos(0), lastDrop(0),
+                                  lastMsg(0), Running(false)
+                                 {for (unsigned int i = 0; i < qSize; i++)
+                                      {Slot[i].Seq = i; Slot[i].Buff = 0;
+                                       Slot[i].Bsize = 0;
+                                      }
+                                 }
+     ~XrdXrootdMonitor_Sender() {} // Never deleted
+
+static XrdSysMutex sendMutex;      // Serializes sends and sequence numbers
+static int         seq1;
+static int         seq2;
+
+private:
+
+struct QSlot
+      {std::atomic<unsigned int> Seq;
+       char                     *Buff;
+       int                       Bsize;
+       int                       Blen;
+       int                       mMode;
+       bool                      setSeq;
+      };
+
+XrdSysSemaphore           qSem;
+alignas(64)
+std::atomic<unsigned int> enqPos;
+alignas(64)
+unsigned int              deqPos;
+unsigned long long        lastDrop;
+time_t                    lastMsg;
+bool                      Running;
+QSlot                     Slot[qSize];
+};
+
+XrdSysMutex XrdXrootdMonitor_Sender::sendMutex;
+int         XrdXrootdMonitor_Sender::seq1 = 0;
+int         XrdXrootdMonitor_Sender::seq2 = 0;
+
+namespace XrdXrootdMonInfo
+{
+XrdXrootdMonitor_Sender monSender;
+
+void *MonSend(void *)
+{
+   monSender.Run();
+   return (void *)0;
+}
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+  
+bool XrdXrootdMonitor_Sender::Add(int mMode, const void *buff, int blen,
+                                  bool setseq)
+{
+   unsigned int pos = enqPos.load(std::memory_order_relaxed);
+   QSlot *sP;
+
+// Claim the next free slot. If there is none, the queue is full.
+//
+   while(true)
+        {sP = &Slot[pos & (qSize-1)];
+         unsigned int seq = sP->Seq.load(std::memory_order_acquire);
+         int dif = static_cast<int>(seq - pos);
+         if (!dif)
+            {if (enqPos.compare_exchange_weak(pos, pos+1,
+                                              std::memory_order_relaxed)) break;
+            }
+            else if (dif < 0) {numDrop++; return false;}
+                    else pos = enqPos.load(std::memory_order_relaxed);
+        }
+
+// We own the slot. Its buffer only grows so after a short while no further
+// allocations occur. A slot without data is published so it can be reclaimed.
+//
+   if (sP->Bsize < blen)
+      {free(sP->Buff);
+       if ((sP->Buff = (char *)malloc(blen))) sP->Bsize = blen;
+          else sP->Bsize = 0;
+      }
+   if (sP->Bsize < blen) {sP->Blen = 0; numDrop++;}
+      else {memcpy(sP->Buff, buff, blen);
+            sP->Blen   = blen;
+            sP->mMode  = mMode;
+            sP->setSeq = setseq && blen >= (int)sizeof(XrdXrootdMonHeader);
+           }
+
+// Publish the slot and wake up the sender
+//
+   sP->Seq.store(pos+1, std::memory_order_release);
+   qSem.Post();
+   return sP->Blen != 0;
+}
+  
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+  
+void XrdXrootdMonitor_Sender::Run()
+{
+#ifndef NODEBUG
+   const char *TraceID = "MonSend";
+#endif
+   int sNum[bMax], sCnt;
+
+do{qSem.Wait();
+
+// Gather all of the packets that are ready, up to the batch limit
+//
+   sCnt = 0;
+   while(sCnt < bMax)
+        {QSlot *sP = &Slot[deqPos & (qSize-1)];
+         if (sP->Seq.load(std::memory_order_acquire) != deqPos+1) break;
+         if (sP->Blen) sNum[sCnt++] = deqPos & (qSize-1);
+            else sP->Seq.store(deqPos+qSize, std::memory_order_release);
+         deqPos++;
+        }
+   if (!sCnt) continue;
+
+// Ship the batch to each destination
+//
+   sendMutex.Lock();
+   Ship(XrdXrootdMonitor::InetDest1, XrdXrootdMonitor::monMode1, seq1,
+        sNum, sCnt);
+   Ship(XrdXrootdMonitor::InetDest2, XrdXrootdMonitor::monMode2, seq2,
+        sNum, sCnt);
+   sendMutex.UnLock();
+   TRACE(DEBUG, sCnt <<" packets shipped");
+
+// Release the slots. They were claimed in order so we can release in order.
+//
+   for (int i = 0; i < sCnt; i++)
+       {QSlot *sP = &Slot[sNum[i]];
+        sP->Seq.store(sP->Seq.load(std::memory_order_relaxed)+qSize-1,
+                      std::memory_order_release);
+       }
+
+// Report any drops, though not too often
+//
+   unsigned long long nDrop = numDrop;
+   if (nDrop != lastDrop)
+      {time_t Now = time(0);
+       if (Now - lastMsg >= 60)
+          {char buff[64];
+           snprintf(buff, sizeof(buff), "%llu", nDrop - lastDrop);
+           eDest->Emsg("Monitor", buff, "packets dropped; send queue full.");
+           lastDrop = nDrop; lastMsg = Now;
+          }
+      }
+
+  } while(true);
+}
+  
+/******************************************************************************/
+/*                                  S h i p                                   */
+/******************************************************************************/
+  
+void XrdXrootdMonitor_Sender::Ship(XrdNetMsg *netP, int mMode, int &seq,
+                                   int *sNum, int sCnt)
+{
+   static const int hdrSZ = sizeof(XrdXrootdMonHeader);
+   XrdXrootdMonHeader mHdr[bMax];
+   struct iovec       ioV[bMax][2];
+   struct msghdr      mVec[bMax];
+   int mNum = 0, rc;
+
+// Construct the batch for this destination. Each destination has its own
+// packet sequence so the header is sent from a private copy.
+//
+   if (!netP) return;
+   for (int i = 0; i < sCnt; i++)
+       {QSlot *sP = &Slot[sNum[i]];
+        if (!(sP->mMode & mMode)) continue;
+        memset(&mVec[mNum], 0, sizeof(struct msghdr));
+        mVec[mNum].msg_iov = ioV[mNum];
+        if (!sP->setSeq)
+           {ioV[mNum][0].iov_base = sP->Buff;
+            ioV[mNum][0].iov_len  = sP->Blen;
+            mVec[mNum].msg_iovlen = 1;
+           } else {
+            memcpy(&mHdr[mNum], sP->Buff, hdrSZ);
+            mHdr[mNum].pseq = (seq++) & 0xff;
+            ioV[mNum][0].iov_base = &mHdr[mNum];
+            ioV[mNum][0].iov_len  = hdrSZ;
+            ioV[mNum][1].iov_base = sP->Buff + hdrSZ;
+            ioV[mNum][1].iov_len  = sP->Blen - hdrSZ;
+            mVec[mNum].msg_iovlen = 2;
+           }
+        mNum++;
+       }
+
+// Send off the batch
+//
+   if (mNum && (rc = netP->Send(mVec, mNum)) > 0) numSent += rc;
+}
+  
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+bool XrdXrootdMonitor_Sender::Start()
+{
+   pthread_t tid;
+   int rc;
+
+   if (Running) return true;
+   if ((rc = XrdSysThread::Run(&tid, MonSend, (void *)0, 0, "Monitor sender")))
+      {eDest->Emsg("Monitor", rc, "create monitor sender thread");
+       return false;
+      }
+   Running = true;
+   return true;
+}
+
 /******************************************************************************/
 /*            C l a s s   X r d X r o o t d M o n i t o r L o c k             */
 /******************************************************************************/
@@ -755,6 +1007,10 @@ int XrdXrootdMonitor::Init()
           }
       }
 
+// Start the sender thread so that packets are no longer sent inline
+//
+   if ((InetDest1 || InetDest2) && !monSender.Start()) return 0;
+
 // Now schedule the first identification record
 //
    if (Sched && monIdent >= 0) Sched->Schedule((XrdJob *)&MonIdent);
@@ -1191,6 +1447,22 @@ void XrdXrootdMonitor::Mark()
    lastWindow = localWindow;
 }
  
+/******************************************************************************/
+/*                              R e g i s t e r                               */
+/******************************************************************************/
+
+void XrdXrootdMonitor::Register(XrdMonRoll &mRoll)
+{
+   static std::vector<XrdMonRoll::Item> monSet =
+          {XrdMonRoll::Item("sent",    monSender.numSent),
+           XrdMonRoll::Item("dropped", monSender.numDrop)};
+
+// Report the packet counters only when packets are being queued
+//
+   if (monSender.isRunning())
+      mRoll.Register(XrdMonRoll::Protocol, "xrootd.mon", monSet);
+}
+
 /******************************************************************************/
 /*                                  S e n d                                   */
 /******************************************************************************/
@@ -1200,30 +1472,33 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 #ifndef NODEBUG
     const char *TraceID = "Monitor";
 #endif
-    static XrdSysMutex sendMutex;
-    static int seq1=0, seq2=0;
     XrdXrootdMonHeader *mHdr=0;
     int rc1, rc2;
 
+// Once the sender is running the packet is simply queued. Otherwise, send it
+// off immediately (this only happens during initialization).
+//
+   if (monSender.isRunning())
+      return (monSender.Add(monMode, buff, blen, setseq) ? 0 : 1);
+
 // If we are to set sequence numbers, recast the buffer. We are assured that
 // the buffer always starts with the standard monitor header.
 //
    if (setseq) mHdr = static_cast<XrdXrootdMonHeader*>(buff);
 
-    sendMutex.Lock();
+    XrdSysMutexHelper sendHelp(XrdXrootdMonitor_Sender::sendMutex);
     if (monMode & monMode1 && InetDest1)
-       {if (mHdr) mHdr->pseq = (seq1++) & 0xff;
+       {if (mHdr) mHdr->pseq = (XrdXrootdMonitor_Sender::seq1++) & 0xff;
         rc1  = InetDest1->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest1 <<" rc=" <<rc1);
        }
        else rc1 = 0;
     if (monMode & monMode2 && InetDest2)
-       {if (mHdr) mHdr->pseq = (seq2++) & 0xff;
+       {if (mHdr) mHdr->pseq = (XrdXrootdMonitor_Sender::seq2++) & 0xff;
         rc2  = InetDest2->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest2 <<" rc=" <<rc2);
        }
        else rc2 = 0;
-    sendMutex.UnLock();
 
     return (rc1 ? rc1 : rc2);
 }
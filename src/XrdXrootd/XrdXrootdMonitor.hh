@@ -70,6 +70,7 @@
 #define XROOTD_MON_FSXFR    8
 
 class XrdScheduler;
+class XrdMonRoll;
 class XrdNetMsg;
 class XrdXrootdMonFile;
   
@@ -83,6 +84,7 @@ public:
        class User;
 friend class User;
 friend class XrdXrootdMonFile;
+friend class XrdXrootdMonitor_Sender;
 
 // All values for Add_xx() must be passed in network byte order
 //
@@ -144,6 +146,8 @@ static int               Redirect() {return monREDR;}
 static int               Redirect(kXR_unt32  mID, const char *hName, int Port,
                                   const char opC, const char *Path);
 
+static void              Register(XrdMonRoll &mRoll);
+
 static int               Send(int mmode, void *buff, int size, bool setseq=true);
 
 static time_t            Tick();
@@ -45,6 +45,7 @@
 #include "XrdSfs/XrdSfsFlags.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysHistogram.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdTls/XrdTls.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
@@ -438,6 +439,11 @@ int XrdXrootdProtocol::Process(XrdLink *lp) // We ignore the argument here
   
 int XrdXrootdProtocol::Process2()
 {
+// Record how long it takes us to process this request. For requests that
+// complete asynchronously this only covers the synchronous portion.
+//
+   XrdSysHistogram::Timer reqTimer(SI->ReqHist(Request.header.requestid));
+
 // If we are verifying requests, see if this request needs to be verified
 //
    if (sigNeed)
@@ -31,6 +31,7 @@
   
 #include "Xrd/XrdStats.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysHistogram.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
  
@@ -72,6 +73,15 @@ AuthBad  = 0;     // Stats: Number of authentication failures
 aokSCnt  = 0;     // Stats: Number of signature successes
 badSCnt  = 0;     // Stats: Number of signature failures
 ignSCnt  = 0;     // Stats: Number of signature ignored
+
+// Allocate a latency histogram for each request code. These are reported in
+// the latency section of the summary statistics.
+//
+char hName[64];
+for (int i = 0; i < kXR_REQFENCE-kXR_auth; i++)
+    {snprintf(hName, sizeof(hName), "xrootd.%s", XProtocol::reqName(i+kXR_auth));
+     reqHist[i] = new XrdSysHistogram(hName);
+    }
 }
 
 /******************************************************************************/
@@ -151,6 +161,7 @@ int XrdXrootdStats::Stats(XrdXrootdResponse &resp, const char *opts)
                 {case 'a': xopts |= XRD_STATS_ALLX; break;
                  case 'b': xopts |= XRD_STATS_BUFF; break;    // b_uff
                  case 'd': xopts |= XRD_STATS_POLL; break;    // d_evice
+                 case 'h': xopts |= XRD_STATS_LTCY; break;    // h_istograms
                  case 'i': xopts |= XRD_STATS_INFO; break;    // i_nfo
 // Not yet       case 'J': xopts |= XRD_STATS_JSON; break;    // Want JSON
                  case 'l': xopts |= XRD_STATS_LINK; break;    // l_ink
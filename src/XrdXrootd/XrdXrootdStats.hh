@@ -29,11 +29,13 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include "XProtocol/XProtocol.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdOuc/XrdOucStats.hh"
 
 class XrdSfsFileSystem;
 class XrdStats;
+class XrdSysHistogram;
 class XrdXrootdResponse;
 
 class XrdXrootdStats : public XrdOucStats
@@ -68,6 +70,13 @@ int              aokSCnt;      // Stats: Number of signature successes
 int              badSCnt;      // Stats: Number of signature failures
 int              ignSCnt;      // Stats: Number of signature ignored
 
+// Return the latency histogram for a request code (nil if there is none)
+//
+XrdSysHistogram *ReqHist(kXR_unt16 reqID)
+                        {return (reqID >= kXR_auth && reqID < kXR_REQFENCE
+                                 ? reqHist[reqID - kXR_auth] : 0);
+                        }
+
 void             setFS(XrdSfsFileSystem *fsp) {fsP = fsp;}
 
 int              Stats(char *buff, int blen, int do_sync=0);
@@ -80,5 +89,6 @@ private:
 
 XrdSfsFileSystem *fsP;
 XrdStats *xstats;
+XrdSysHistogram  *reqHist[kXR_REQFENCE-kXR_auth];
 };
 #endif
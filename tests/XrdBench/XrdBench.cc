@@ -0,0 +1,184 @@
+/******************************************************************************/
+/*                                                                            */
+/* Runs the micro-benchmarks of XRootD's hot path primitives.                 */
+/*                                                                            */
+/* Usage: xrdbench [-l] [-q] [-j] [-f <match>] [-t <sec>] [-r <runs>]         */
+/*                 [-b <baseline> [-T <pct>]]                                 */
+/*                                                                            */
+/*   -l  list the benchmarks and exit                                         */
+/*   -q  quick mode, each benchmark runs once for a few milliseconds; this    */
+/*       only checks that everything works and is what ctest runs            */
+/*   -j  print one JSON object per benchmark instead of a table               */
+/*   -f  only run the benchmarks whose name contains <match>                  */
+/*   -t  minimum duration of a run (default 0.25 seconds)                     */
+/*   -r  number of runs, the fastest one is reported (default 3)              */
+/*   -b  compare against the JSON output of an earlier run and exit with 2    */
+/*       if a benchmark got slower by more than <pct> percent (default 10)   */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace XrdBench
+{
+std::vector<Case> &Cases()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+}
+
+using namespace XrdBench;
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+struct Result
+{
+    long long iters;
+    double    nsop;     // best nanoseconds per operation
+};
+
+double Time(const Case &bc, long long n)
+{
+    auto start = Clock::now();
+    bc.body(n);
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return secs.count();
+}
+
+// Warm up first so that one time setup is not measured. Then grow the
+// operation count until a run lasts a tenth of the wanted duration, scale it
+// to the full duration and keep the fastest of the runs.
+//
+Result Measure(const Case &bc, double minTime, int runs)
+{
+    Result res;
+    long long n = 1;
+    double secs;
+
+    bc.body(1);
+    while ((secs = Time(bc, n)) < minTime / 10 && n < (1LL << 40))
+          n *= (secs > 0 ? std::min(100.0, std::max(2.0, minTime/10/secs*1.5))
+                         : 100);
+    res.nsop  = secs * 1e9 / n;
+    if (runs && secs < minTime)
+       n = std::max(1LL, (long long)(n * minTime / std::max(secs, 1e-9)));
+
+    res.iters = n;
+    for (int i = 0; i < runs; i++)
+        res.nsop = std::min(res.nsop, Time(bc, n) * 1e9 / n);
+    return res;
+}
+
+// Baselines are read back from our own JSON output; only the name and the
+// time per operation matter.
+//
+bool Baseline(const char *path, std::map<std::string, double> &base)
+{
+    FILE *fp = fopen(path, "r");
+    char line[1024], name[512];
+    double nsop;
+
+    if (!fp) {fprintf(stderr, "xrdbench: unable to open %s; %s\n",
+                      path, strerror(errno));
+              return false;
+             }
+    while (fgets(line, sizeof(line), fp))
+          {const char *np = strstr(line, "\"name\":\"");
+           const char *tp = strstr(line, "\"ns_per_op\":");
+           if (!np || !tp
+           ||  sscanf(np + 8, "%511[^\"]", name) != 1
+           ||  sscanf(tp + 12, "%lf", &nsop) != 1) continue;
+           base[name] = nsop;
+          }
+    fclose(fp);
+    return true;
+}
+
+void Usage(const char *pgm)
+{
+    fprintf(stderr, "Usage: %s [-l] [-q] [-j] [-f <match>] [-t <sec>] "
+                    "[-r <runs>] [-b <baseline> [-T <pct>]]\n", pgm);
+    exit(1);
+}
+}
+
+int main(int argc, char **argv)
+{
+    std::map<std::string, double> base;
+    const char *match = 0, *basefn = 0;
+    double minTime = 0.25, tolerance = 10;
+    int runs = 3, slower = 0, c;
+    bool json = false, list = false;
+
+    while ((c = getopt(argc, argv, "b:f:jlqr:t:T:")) != -1)
+          switch(c)
+                {case 'b': basefn    = optarg;                  break;
+                 case 'f': match     = optarg;                  break;
+                 case 'j': json      = true;                    break;
+                 case 'l': list      = true;                    break;
+                 case 'q': minTime   = 0.002; runs = 0;         break;
+                 case 'r': runs      = atoi(optarg);            break;
+                 case 't': minTime   = atof(optarg);            break;
+                 case 'T': tolerance = atof(optarg);            break;
+                 default:  Usage(argv[0]);
+                }
+    if (optind < argc || minTime <= 0 || runs < 0) Usage(argv[0]);
+    if (basefn && !Baseline(basefn, base)) return 1;
+
+    std::vector<Case> &cases = Cases();
+    std::sort(cases.begin(), cases.end(),
+              [](const Case &a, const Case &b) {return a.name < b.name;});
+
+    if (!json && !list)
+       printf("%-36s %12s %12s %10s\n", "benchmark", "ns/op", "Mops/s", "MB/s");
+
+    for (const Case &bc : cases)
+        {if (match && !strstr(bc.name.c_str(), match)) continue;
+         if (list) {printf("%s\n", bc.name.c_str()); continue;}
+
+         Result res = Measure(bc, minTime, runs);
+         double mbs = (bc.bytes ? bc.bytes * 1e3 / res.nsop : 0);
+
+         const char *mark = "";
+         auto it = base.find(bc.name);
+         if (it != base.end() && res.nsop > it->second * (1 + tolerance/100))
+            {mark = " SLOWER"; slower++;
+             if (json) fprintf(stderr, "xrdbench: %s slower, %.2f ns/op "
+                               "instead of %.2f\n", bc.name.c_str(),
+                               res.nsop, it->second);
+            }
+
+         if (json)
+            printf("{\"name\":\"%s\",\"ns_per_op\":%.3f,\"ops_per_sec\":%.1f,"
+                   "\"bytes_per_op\":%lld,\"mb_per_sec\":%.2f,"
+                   "\"iterations\":%lld}\n", bc.name.c_str(), res.nsop,
+                   1e9 / res.nsop, bc.bytes, mbs, res.iters);
+            else {char mbuf[32] = "-";
+                  if (bc.bytes) snprintf(mbuf, sizeof(mbuf), "%.1f", mbs);
+                  printf("%-36s %12.2f %12.3f %10s%s\n", bc.name.c_str(),
+                         res.nsop, 1e3 / res.nsop, mbuf, mark);
+                 }
+         fflush(stdout);
+        }
+
+    if (slower)
+       {fprintf(stderr, "xrdbench: %d benchmark(s) slower than the baseline "
+                        "by more than %.1f%%\n", slower, tolerance);
+        return 2;
+       }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef __XRDBENCH_HH__
+#define __XRDBENCH_HH__
+/******************************************************************************/
+/*                                                                            */
+/* A minimal micro-benchmark harness. Each benchmark registers a body that    */
+/* performs its operation a given number of times; the driver in XrdBench.cc  */
+/* picks the count so that a run lasts long enough to be measured and keeps  */
+/* the best of a few runs.                                                    */
+/*                                                                            */
+/******************************************************************************/
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace XrdBench
+{
+// The body runs the operation n times. Anything that must exist before the
+// first operation is best kept in a function local static of the body as the
+// first (calibration) call then absorbs the setup.
+//
+typedef std::function<void(long long n)> Body;
+
+struct Case
+{
+    std::string name;    // group/operation/parameters
+    long long   bytes;   // bytes processed per operation, 0 if meaningless
+    Body        body;
+};
+
+std::vector<Case> &Cases();
+
+// Benchmarks register themselves with a file scope object:
+//
+//    static XrdBench::Add crc4k("crc32c/hw/4k", 4096, [](long long n) {...});
+//
+struct Add
+{
+    Add(const char *name, long long bytes, Body body)
+       {Cases().push_back(Case{name, bytes, body});}
+};
+
+// Keep the compiler from optimizing away a computed value.
+//
+template<class T>
+inline void Keep(const T &val)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(val) : "memory");
+#else
+    static volatile T sink; sink = val;
+#endif
+}
+}
+#endif
@@ -0,0 +1,82 @@
+/******************************************************************************/
+/*                                                                            */
+/* Checksums: the CRC32C used by pgread/pgwrite, the per page checksums of    */
+/* XrdOucPgrwUtils and the XrdCks calculators.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdCks/XrdCksCalcmd5.hh"
+#include "XrdOuc/XrdOucCRC32C.hh"
+#include "XrdOuc/XrdOucPgrwUtils.hh"
+
+#include <cstdint>
+#include <vector>
+
+using namespace XrdBench;
+
+namespace
+{
+const std::vector<char> &Data()
+{
+    static std::vector<char> data(4 * 1024 * 1024 + 4096);
+    static bool init = false;
+    if (!init)
+       {for (size_t i = 0; i < data.size(); i++) data[i] = char(i * 131 + i/4093);
+        init = true;
+       }
+    return data;
+}
+
+void Crc(long long n, size_t len, bool hw)
+{
+    const char *buff = Data().data();
+    uint32_t crc = 0;
+    for (long long i = 0; i < n; i++)
+        crc = (hw ? crc32c(crc, buff, len) : crc32c_sw(crc, buff, len));
+    Keep(crc);
+}
+
+// The offset is not page aligned for the unaligned variant so that the first
+// and last checksums cover partial pages, as they do for most client reads.
+//
+void PgCks(long long n, off_t offs, size_t len)
+{
+    const char *buff = Data().data();
+    std::vector<uint32_t> csvec(XrdOucPgrwUtils::csNum(offs, len));
+    for (long long i = 0; i < n; i++)
+        {XrdOucPgrwUtils::csCalc(buff, offs, len, csvec.data());
+         Keep(csvec[0]);
+        }
+}
+
+template<class Calc>
+void Cks(long long n, int len)
+{
+    Calc calc;
+    const char *buff = Data().data();
+    for (long long i = 0; i < n; i++) Keep(calc.Calc(buff, len));
+}
+
+Add crcHw4k   ("crc32c/hw/4k",       4096, [](long long n) {Crc(n, 4096, true);});
+Add crcHw1m   ("crc32c/hw/1m",    1 << 20, [](long long n) {Crc(n, 1 << 20, true);});
+Add crcSw4k   ("crc32c/sw/4k",       4096, [](long long n) {Crc(n, 4096, false);});
+Add crcSw1m   ("crc32c/sw/1m",    1 << 20, [](long long n) {Crc(n, 1 << 20, false);});
+
+Add pgAlign   ("pgrw/csCalc/1m",  1 << 20, [](long long n) {PgCks(n, 0, 1 << 20);});
+Add pgUnalign ("pgrw/csCalc/1m+1000",
+                                  1 << 20, [](long long n) {PgCks(n, 1000, 1 << 20);});
+
+Add cksAdler  ("cks/adler32/1m",  1 << 20,
+               [](long long n) {Cks<XrdCksCalcadler32>(n, 1 << 20);});
+Add cksCrc32  ("cks/crc32/1m",    1 << 20,
+               [](long long n) {Cks<XrdCksCalccrc32>(n, 1 << 20);});
+Add cksCrc32c ("cks/crc32c/1m",   1 << 20,
+               [](long long n) {Cks<XrdCksCalccrc32C>(n, 1 << 20);});
+Add cksMd5    ("cks/md5/1m",      1 << 20,
+               [](long long n) {Cks<XrdCksCalcmd5>(n, 1 << 20);});
+}
@@ -0,0 +1,94 @@
+/******************************************************************************/
+/*                                                                            */
+/* Hash tables: lookups and add/delete cycles of XrdOucHash and, for          */
+/* comparison, XrdOucFlatHash. The xrdouchash-bench program has the more      */
+/* thorough comparison including the multi-threaded variants.                 */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "XrdOuc/XrdOucFlatHash.hh"
+#include "XrdOuc/XrdOucHash.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace XrdBench;
+
+namespace
+{
+struct Item {int val;};
+
+const int nKeys = 100000;
+
+const std::vector<std::string> &Keys()
+{
+    static std::vector<std::string> keys;
+    if (keys.empty())
+       {char buff[64];
+        for (int i = 0; i < nKeys; i++)
+            {snprintf(buff, sizeof(buff), "/store/user/data/file%08d.root", i);
+             keys.push_back(buff);
+            }
+       }
+    return keys;
+}
+
+template<class Hash>
+Hash &Table()
+{
+    static Hash *hash = 0;
+    static Item  item;
+    if (!hash)
+       {hash = new Hash;
+        for (auto &key : Keys()) hash->Add(key.c_str(), &item, 0, Hash_keepdata);
+       }
+    return *hash;
+}
+
+// Hits walk the keys in a scattered order; misses look up the key suffixes
+// which hash all over the table but are never there.
+//
+template<class Hash>
+void Find(long long n, bool hit)
+{
+    Hash &hash = Table<Hash>();
+    const std::vector<std::string> &keys = Keys();
+    long long found = 0;
+
+    for (long long i = 0; i < n; i++)
+        {const char *key = keys[(i * 7919) % nKeys].c_str();
+         if (hash.Find(hit ? key : key + 1)) found++;
+        }
+    Keep(found);
+}
+
+template<class Hash>
+void AddDel(long long n)
+{
+    Hash &hash = Table<Hash>();
+    static Item item;
+    char buff[64];
+
+    for (long long i = 0; i < n; i++)
+        {snprintf(buff, sizeof(buff), "/tmp/new%lld", i & 1023);
+         hash.Add(buff, &item, 0, Hash_keepdata);
+         hash.Del(buff, Hash_keepdata);
+        }
+}
+
+Add hashHit      ("hash/XrdOucHash/find-hit",      0,
+                  [](long long n) {Find<XrdOucHash<Item>>(n, true);});
+Add hashMiss     ("hash/XrdOucHash/find-miss",     0,
+                  [](long long n) {Find<XrdOucHash<Item>>(n, false);});
+Add hashAddDel   ("hash/XrdOucHash/add-del",       0,
+                  [](long long n) {AddDel<XrdOucHash<Item>>(n);});
+Add flatHit      ("hash/XrdOucFlatHash/find-hit",  0,
+                  [](long long n) {Find<XrdOucFlatHash<Item>>(n, true);});
+Add flatMiss     ("hash/XrdOucFlatHash/find-miss", 0,
+                  [](long long n) {Find<XrdOucFlatHash<Item>>(n, false);});
+Add flatAddDel   ("hash/XrdOucFlatHash/add-del",   0,
+                  [](long long n) {AddDel<XrdOucFlatHash<Item>>(n);});
+}
@@ -0,0 +1,113 @@
+/******************************************************************************/
+/*                                                                            */
+/* Proxy file cache: the block bit vectors of XrdPfc::Info that are consulted */
+/* for every read and rescanned when files are opened or purged.              */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "XrdPfc/XrdPfcInfo.hh"
+#include "XrdSys/XrdSysTrace.hh"
+
+using namespace XrdBench;
+using XrdPfc::Info;
+
+namespace
+{
+const long long blkSize = 1024 * 1024;
+const int       nBlocks = 64 * 1024;   // 64 GB file in 1 MB blocks
+
+XrdSysTrace &Trace()
+{
+    static XrdSysTrace trace("xrdbench");
+    return trace;
+}
+
+// A file that is partially cached: runs of present blocks alternate with
+// runs of missing ones, as left behind by sparse reads.
+//
+Info &Partial()
+{
+    static Info *info = 0;
+    if (!info)
+       {info = new Info(&Trace(), true);
+        info->SetBufferSizeFileSizeAndCreationTime(blkSize, nBlocks * blkSize);
+        for (int i = 0; i < nBlocks; i++)
+            if ((i / 37) % 3 != 0) info->SetBitWritten(i);
+        info->UpdateDownloadCompleteStatus();
+       }
+    return *info;
+}
+
+void SetBits(long long n)
+{
+    Info info(&Trace(), true);
+    info.SetBufferSizeFileSizeAndCreationTime(blkSize, nBlocks * blkSize);
+    for (long long i = 0; i < n; i++)
+        {int blk = int(i % nBlocks);
+         info.SetBitWritten(blk);
+         info.SetBitPrefetch(blk);
+        }
+    Keep(info.IsComplete());
+}
+
+void TestBits(long long n)
+{
+    Info &info = Partial();
+    long long cnt = 0;
+    for (long long i = 0; i < n; i++)
+        if (info.TestBitWritten(int((i * 7919) % nBlocks))) cnt++;
+    Keep(cnt);
+}
+
+// The range counts are what a read spanning several blocks asks for.
+//
+void CountRange(long long n, int span)
+{
+    Info &info = Partial();
+    long long cnt = 0;
+    for (long long i = 0; i < n; i++)
+        {int first = int((i * 7919) % (nBlocks - span));
+         cnt += info.CountBlocksNotWrittenInRng(first, first + span);
+        }
+    Keep(cnt);
+}
+
+// Prefetching looks for the next missing block from where it last stopped.
+//
+void FirstMissing(long long n)
+{
+    Info &info = Partial();
+    long long cnt = 0;
+    int f = -1;
+    for (long long i = 0; i < n; i++)
+        {if ((f = info.FirstBlockNotWrittenInRng(f + 1, nBlocks)) < 0) f = -1;
+         cnt += f;
+        }
+    Keep(cnt);
+}
+
+// Scans of the whole vector are done on open, for statistics and purging.
+//
+void Scan(long long n)
+{
+    Info &info = Partial();
+    long long cnt = 0;
+    for (long long i = 0; i < n; i++)
+        {cnt += info.GetNDownloadedBlocks();
+         cnt += info.GetLastDownloadedBlock();
+         info.UpdateDownloadCompleteStatus();
+        }
+    Keep(cnt);
+}
+
+Add setBits   ("pfc/info/set-bit",               0, [](long long n) {SetBits(n);});
+Add testBits  ("pfc/info/test-bit",              0, [](long long n) {TestBits(n);});
+Add count8    ("pfc/info/count-missing/8blk",    0,
+               [](long long n) {CountRange(n, 8);});
+Add count256  ("pfc/info/count-missing/256blk",  0,
+               [](long long n) {CountRange(n, 256);});
+Add first     ("pfc/info/first-missing",         0, [](long long n) {FirstMissing(n);});
+Add scan64k   ("pfc/info/scan/64kblk",           0, [](long long n) {Scan(n);});
+}
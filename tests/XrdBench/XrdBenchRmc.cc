@@ -0,0 +1,105 @@
+/******************************************************************************/
+/*                                                                            */
+/* Memory cache: concurrent readers of different files going through the     */
+/* XrdRmc cache used by XrdPosix and the proxy, with and without shards.      */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "XrdRmc/XrdRmc.hh"
+
+#include <cerrno>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace XrdBench;
+
+namespace
+{
+const long long fSize = 2 * 1024 * 1024;   // per reader, all of them fit
+const int       rSize = 4096;
+
+// A synthetic source; after the first calibration run every read is a hit.
+//
+class MemIO : public XrdOucCacheIO
+{
+public:
+    MemIO(int fnum) : fNum(fnum) {}
+
+    bool        Detach(XrdOucCacheIOCD &iocd) override {return true;}
+    long long   FSize() override {return fSize;}
+    const char *Path() override {return "memio";}
+
+    int Read(char *buff, long long offs, int rlen) override
+       {if (offs >= fSize) return 0;
+        if (offs + rlen > fSize) rlen = fSize - offs;
+        for (int i = 0; i < rlen; i++) buff[i] = static_cast<char>(offs + i + fNum);
+        return rlen;
+       }
+
+    int Sync() override {return 0;}
+    int Trunc(long long offs) override {return -EROFS;}
+    int Write(char *buff, long long offs, int wlen) override {return -EROFS;}
+
+private:
+    int fNum;
+};
+
+class NoDetachCB : public XrdOucCacheIOCD
+{
+public:
+    void DetachDone() override {}
+};
+
+XrdOucCache *Cache(int shards)
+{
+    XrdRmc::Parms parms;
+    XrdOucCacheIO::aprParms apr;
+
+    parms.CacheSize = 64 * 1024 * 1024;
+    parms.PageSize  = 32 * 1024;
+    parms.Options   = XrdRmc::ioMTSafe;
+    parms.Shards    = shards;
+    apr.minPages    = 1;
+
+    return XrdRmc::Create(parms, &apr);
+}
+
+// Hammer the cache: each thread attaches its own file and does its share of
+// the n random reads.
+//
+void Hammer(long long n, int nthreads, int shards)
+{
+    static XrdOucCache *unsharded = Cache(1), *sharded = Cache(8);
+    XrdOucCache *cache = (shards > 1 ? sharded : unsharded);
+    std::vector<std::thread> threads;
+
+    auto worker = [cache](int t, long long count)
+    {
+        MemIO src(t);
+        XrdOucCacheIO *ioP = cache->Attach(&src, 0);
+        std::vector<char> buff(rSize);
+        std::mt19937_64 rng(t);
+        long long nRead = fSize / rSize, bytes = 0;
+
+        for (long long i = 0; i < count; i++)
+            bytes += ioP->Read(buff.data(), (long long)(rng() % nRead) * rSize, rSize);
+        Keep(bytes);
+
+        NoDetachCB iocd;
+        if (ioP != &src) ioP->Detach(iocd);
+    };
+
+    for (int t = 0; t < nthreads; t++)
+        threads.emplace_back(worker, t, n / nthreads);
+    for (auto &thread : threads) thread.join();
+}
+
+Add rmc1    ("xrdrmc/read/1thr/4k",          rSize, [](long long n) {Hammer(n,  1, 1);});
+Add rmc4    ("xrdrmc/read/4thr/4k",          rSize, [](long long n) {Hammer(n,  4, 1);});
+Add rmc16   ("xrdrmc/read/16thr/4k",         rSize, [](long long n) {Hammer(n, 16, 1);});
+Add rmcSh4  ("xrdrmc/read/4thr/8shard/4k",   rSize, [](long long n) {Hammer(n,  4, 8);});
+Add rmcSh16 ("xrdrmc/read/16thr/8shard/4k",  rSize, [](long long n) {Hammer(n, 16, 8);});
+}
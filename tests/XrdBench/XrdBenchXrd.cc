@@ -0,0 +1,119 @@
+/******************************************************************************/
+/*                                                                            */
+/* Network layer: obtaining and releasing I/O buffers and handing jobs to the */
+/* scheduler.                                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace XrdBench;
+
+namespace
+{
+/******************************************************************************/
+/*                               B u f f e r s                                */
+/******************************************************************************/
+
+// A thread only ever uses the magazine of the first buffer manager it sees,
+// so all benchmarks share one manager and turn the magazines off and on.
+//
+XrdBuffManager &BuffPool()
+{
+    static XrdBuffManager *bPool = new XrdBuffManager;
+    return *bPool;
+}
+
+// Each round obtains a few buffers before giving them back, the way a link
+// holds on to a buffer while a request is being processed.
+//
+void ObtainRelease(long long n, int bsz, int nthreads, bool magazines)
+{
+    XrdBuffManager &bPool = BuffPool();
+    std::vector<std::thread> threads;
+
+    bPool.Set(-1, -1, (magazines ? 8 : 0));
+
+    auto worker = [&bPool, bsz](long long count)
+    {
+        XrdBuffer *bp[4];
+        for (long long i = 0; i < count; i += 4)
+            {for (int k = 0; k < 4; k++) bp[k] = bPool.Obtain(bsz);
+             for (int k = 0; k < 4; k++) bPool.Release(bp[k]);
+            }
+    };
+
+    if (nthreads == 1) worker(n);
+       else {for (int t = 0; t < nthreads; t++)
+                 threads.emplace_back(worker, n / nthreads);
+             for (auto &thread : threads) thread.join();
+            }
+}
+
+Add bufMag4k   ("buffmgr/obtain-release/4k",   0,
+                [](long long n) {ObtainRelease(n, 4096,    1, true);});
+Add bufMag1m   ("buffmgr/obtain-release/1m",   0,
+                [](long long n) {ObtainRelease(n, 1 << 20, 1, true);});
+Add bufNoMag   ("buffmgr/obtain-release/nomag/64k", 0,
+                [](long long n) {ObtainRelease(n, 65536,   1, false);});
+Add bufMt      ("buffmgr/obtain-release/4thr/64k",  0,
+                [](long long n) {ObtainRelease(n, 65536,   4, true);});
+Add bufMtNoMag ("buffmgr/obtain-release/4thr/nomag/64k", 0,
+                [](long long n) {ObtainRelease(n, 65536,   4, false);});
+
+/******************************************************************************/
+/*                             S c h e d u l e r                              */
+/******************************************************************************/
+
+class CountJob : public XrdJob
+{
+public:
+void DoIt() override {if (--(*pending) == 0) done->Post();}
+
+     CountJob() : XrdJob("bench job"), pending(0), done(0) {}
+
+std::atomic<int> *pending;
+XrdSysSemaphore  *done;
+};
+
+XrdScheduler &Sched()
+{
+    static XrdScheduler *sched = 0;
+    if (!sched)
+       {sched = new XrdScheduler(8, 256, 0);
+        sched->Start();
+       }
+    return *sched;
+}
+
+// Jobs are scheduled in batches and the batch is waited for before its jobs
+// are reused; the time per operation includes running the (empty) job.
+//
+void Schedule(long long n, int batch)
+{
+    XrdScheduler &sched = Sched();
+    std::vector<CountJob> jobs(batch);
+    std::atomic<int> pending;
+    XrdSysSemaphore done(0);
+
+    for (auto &job : jobs) {job.pending = &pending; job.done = &done;}
+
+    for (long long i = 0; i < n; i += batch)
+        {pending = batch;
+         for (auto &job : jobs) sched.Schedule(&job);
+         done.Wait();
+        }
+}
+
+Add sched1  ("sched/schedule/batch1",  0, [](long long n) {Schedule(n, 1);});
+Add sched64 ("sched/schedule/batch64", 0, [](long long n) {Schedule(n, 64);});
+}
@@ -0,0 +1,89 @@
+/******************************************************************************/
+/*                                                                            */
+/* Client protocol: marshalling of requests and unmarshalling of responses    */
+/* in XrdCl::XRootDTransport.                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdBench.hh"
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XrdCl/XrdClXRootDTransport.hh"
+
+#include <arpa/inet.h>
+
+#include <cstring>
+
+using namespace XrdBench;
+using namespace XrdCl;
+
+namespace
+{
+// A marshalled request is unmarshalled again so that the next iteration
+// starts from the same message; each operation therefore is one round trip.
+//
+void ReadRequest(long long n)
+{
+    Message msg(sizeof(ClientReadRequest));
+    msg.Zero();
+    ClientReadRequest *req = (ClientReadRequest*)msg.GetBuffer();
+    req->requestid = kXR_read;
+    req->offset    = 123456789;
+    req->rlen      = 1 << 20;
+
+    for (long long i = 0; i < n; i++)
+        {XRootDTransport::MarshallRequest(&msg);
+         XRootDTransport::UnMarshallRequest(&msg);
+        }
+    Keep(req->rlen);
+}
+
+void ReadVRequest(long long n, int nchunks)
+{
+    Message msg(sizeof(ClientReadVRequest) + nchunks * sizeof(readahead_list));
+    msg.Zero();
+    ClientReadVRequest *req = (ClientReadVRequest*)msg.GetBuffer();
+    readahead_list *rdl = (readahead_list*)(req + 1);
+    req->requestid = kXR_readv;
+    req->dlen      = nchunks * sizeof(readahead_list);
+    for (int k = 0; k < nchunks; k++)
+        {rdl[k].rlen = 65536; rdl[k].offset = k * 1000000LL;}
+
+    for (long long i = 0; i < n; i++)
+        {XRootDTransport::MarshallRequest(&msg);
+         XRootDTransport::UnMarshallRequest(&msg);
+        }
+    Keep(rdl[0].rlen);
+}
+
+// Responses arrive in network order; each operation restores the wire image
+// and unmarshalls header and body.
+//
+void ErrorResponse(long long n)
+{
+    const char *emsg = "Unable to open /store/data/file.root; no such file";
+    ServerResponse wire;
+    int dlen = sizeof(kXR_int32) + strlen(emsg) + 1;
+    int wlen = sizeof(ServerResponseHeader) + dlen;
+
+    memset(&wire, 0, sizeof(wire));
+    wire.hdr.status = htons(kXR_error);
+    wire.hdr.dlen   = htonl(dlen);
+    wire.body.error.errnum = htonl(kXR_NotFound);
+    strcpy(wire.body.error.errmsg, emsg);
+
+    Message msg(wlen);
+    for (long long i = 0; i < n; i++)
+        {memcpy(msg.GetBuffer(), &wire, wlen);
+         XRootDTransport::UnMarshallHeader(msg);
+         XRootDTransport::UnMarshallBody(&msg, kXR_open);
+        }
+    Keep(((ServerResponse*)msg.GetBuffer())->body.error.errnum);
+}
+
+Add rdReq    ("xrdcl/marshall/read",      0, [](long long n) {ReadRequest(n);});
+Add rdvReq   ("xrdcl/marshall/readv/64",  0, [](long long n) {ReadVRequest(n, 64);});
+Add rdvReq1k ("xrdcl/marshall/readv/1024",0, [](long long n) {ReadVRequest(n, 1024);});
+Add errRsp   ("xrdcl/unmarshall/error",   0, [](long long n) {ErrorResponse(n);});
+}
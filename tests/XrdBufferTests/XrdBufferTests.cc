@@ -0,0 +1,180 @@
+#undef NDEBUG
+
+#include "Xrd/XrdBuffer.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+// A thread only gets a magazine for the first buffer manager it uses, so each
+// test does its work in threads of its own rather than in the main thread.
+template<typename F>
+void InThread(F func)
+{
+    std::thread thr(func);
+    thr.join();
+}
+
+// Return the value of the given element of the buffer manager statistics.
+long long Stat(XrdBuffManager &mgr, const char *tag)
+{
+    char buff[2048];
+    mgr.Stats(buff, sizeof(buff), 1);
+    std::string stats(buff), open = std::string("<") + tag + ">";
+    size_t pos = stats.find(open);
+    if (pos == std::string::npos) {return -1;}
+    return std::stoll(stats.substr(pos + open.size()));
+}
+
+}
+
+TEST(XrdBufferTests, MagazineHandsBackReleasedBuffer) {
+    XrdBuffManager mgr;
+    mgr.Set(-1, -1, 8, 0);
+
+    InThread([&]() {
+        XrdBuffer *bp = mgr.Obtain(4096);
+        ASSERT_NE(bp, nullptr);
+        mgr.Release(bp);
+        // The buffer sits in this thread's magazine and comes straight back
+        for (int idx = 0; idx < 10; idx++) {
+            XrdBuffer *bp2 = mgr.Obtain(4000);
+            EXPECT_EQ(bp2, bp);
+            mgr.Release(bp2);
+        }
+    });
+
+    // The profile of a magazine is accounted for when its thread goes away
+    EXPECT_EQ(Stat(mgr, "maghit"), 10);
+    EXPECT_EQ(Stat(mgr, "magmiss"), 1);
+    EXPECT_EQ(Stat(mgr, "buffs"), 1);
+}
+
+TEST(XrdBufferTests, ThreadExitDrainsMagazine) {
+    XrdBuffManager mgr;
+    mgr.Set(-1, -1, 8, 0);
+    std::set<XrdBuffer *> first, second;
+
+    InThread([&]() {
+        std::vector<XrdBuffer *> bufs;
+        for (int idx = 0; idx < 4; idx++) {bufs.push_back(mgr.Obtain(64 * 1024));}
+        for (auto bp : bufs) {first.insert(bp); mgr.Release(bp);}
+    });
+
+    // Another thread gets the very same buffers from the shared buckets
+    InThread([&]() {
+        std::vector<XrdBuffer *> bufs;
+        for (int idx = 0; idx < 4; idx++) {bufs.push_back(mgr.Obtain(64 * 1024));}
+        for (auto bp : bufs) {second.insert(bp); mgr.Release(bp);}
+    });
+
+    EXPECT_EQ(first.size(), 4u);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(Stat(mgr, "buffs"), 4);
+}
+
+TEST(XrdBufferTests, MagazineSpillsToBuckets) {
+    XrdBuffManager mgr;
+    mgr.Set(-1, -1, 4, 0);
+    std::vector<XrdBuffer *> bufs;
+
+    // Releasing more buffers than a magazine holds moves some to the buckets
+    // where other threads can get them while this one is still running.
+    std::thread holder([&]() {
+        for (int idx = 0; idx < 16; idx++) {bufs.push_back(mgr.Obtain(1024));}
+        for (auto bp : bufs) {mgr.Release(bp);}
+
+        std::set<XrdBuffer *> mine(bufs.begin(), bufs.end());
+        InThread([&]() {
+            XrdBuffer *bp = mgr.Obtain(1024);
+            EXPECT_EQ(mine.count(bp), 1u);
+            mgr.Release(bp);
+        });
+    });
+    holder.join();
+    EXPECT_EQ(Stat(mgr, "buffs"), 16);
+}
+
+TEST(XrdBufferTests, MagazinesOff) {
+    XrdBuffManager mgr;
+    mgr.Set(-1, -1, 0, 0);
+
+    InThread([&]() {
+        XrdBuffer *bp = mgr.Obtain(4096);
+        mgr.Release(bp);
+        EXPECT_EQ(mgr.Obtain(4096), bp);
+        mgr.Release(bp);
+    });
+    EXPECT_EQ(Stat(mgr, "maghit"), 0);
+    EXPECT_EQ(Stat(mgr, "magmiss"), 0);
+    EXPECT_EQ(Stat(mgr, "reqs"), 2);
+}
+
+TEST(XrdBufferTests, MagazinesOffByDefault) {
+    XrdBuffManager mgr;
+    mgr.Set(-1, -1);
+
+    InThread([&]() {
+        XrdBuffer *bp = mgr.Obtain(4096);
+        mgr.Release(bp);
+    });
+    EXPECT_EQ(Stat(mgr, "maghit"), 0);
+    EXPECT_EQ(Stat(mgr, "magmiss"), 0);
+    EXPECT_EQ(Stat(mgr, "reqs"), 1);
+}
+
+TEST(XrdBufferTests, ManagerGoneBeforeThreadExit) {
+    XrdBuffManager *mgr = new XrdBuffManager();
+    mgr->Set(-1, -1, 8, 0);
+    XrdSysSemaphore filled(0), deleted(0);
+
+    // The thread still holds buffers in its magazine when the manager goes
+    // away; on exit they must be freed without touching the manager.
+    std::thread thr([&]() {
+        for (int idx = 0; idx < 4; idx++) {mgr->Release(mgr->Obtain(8192));}
+        filled.Post();
+        deleted.Wait();
+    });
+    filled.Wait();
+    delete mgr;
+    deleted.Post();
+    thr.join();
+}
+
+#ifdef __linux__
+TEST(XrdBufferTests, HugePageBuffers) {
+    const int hugeSz = 2 * 1024 * 1024;
+
+    // Both transparent and explicit huge pages (the latter falling back to
+    // the former when none are reserved) give huge page aligned buffers.
+    for (int mode : {1, 2}) {
+        XrdBuffManager mgr;
+        mgr.Set(-1, -1, 0, mode);
+        InThread([&]() {
+            XrdBuffer *bp = mgr.Obtain(hugeSz);
+            ASSERT_NE(bp, nullptr);
+            EXPECT_EQ(bp->bsize, hugeSz);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(bp->buff) % hugeSz, 0u) << "mode " << mode;
+            memset(bp->buff, 0x5a, bp->bsize);
+            mgr.Release(bp);
+
+            // Smaller buffers are allocated the usual way
+            XrdBuffer *small = mgr.Obtain(64 * 1024);
+            ASSERT_NE(small, nullptr);
+            EXPECT_EQ(small->bsize, 64 * 1024);
+            memset(small->buff, 0xa5, small->bsize);
+            mgr.Release(small);
+        });
+        mgr.Set(-1, -1, -1, 0);
+    }
+}
+#endif
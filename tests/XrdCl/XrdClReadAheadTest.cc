@@ -0,0 +1,267 @@
+#undef NDEBUG
+
+#include "XrdCl/XrdClReadAhead.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  const uint64_t fileSize = 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  // The byte found at a given offset of the test file
+  //----------------------------------------------------------------------------
+  char ByteAt( uint64_t offset ) { return char( offset * 7 + offset / 251 ); }
+
+  //----------------------------------------------------------------------------
+  // Complete a fetch as the server would
+  //----------------------------------------------------------------------------
+  void Serve( const ReadAhead::Fetch &f )
+  {
+    uint32_t len = 0;
+    if( f.offset < fileSize )
+      len = std::min<uint64_t>( f.size, fileSize - f.offset );
+    for( uint32_t i = 0; i < len; ++i )
+      static_cast<char*>( f.buffer )[i] = ByteAt( f.offset + i );
+    AnyObject *obj = new AnyObject();
+    obj->Set( new ChunkInfo( f.offset, len, f.buffer ) );
+    f.handler->HandleResponse( new XRootDStatus(), obj );
+  }
+
+  //----------------------------------------------------------------------------
+  // Remember the reply to a pending read
+  //----------------------------------------------------------------------------
+  class Reply: public ResponseHandler
+  {
+    public:
+      Reply(): called( false ), length( 0 ) {}
+
+      void HandleResponse( XRootDStatus *st, AnyObject *rsp )
+      {
+        called = true;
+        status = *st;
+        ChunkInfo *chunk = 0;
+        if( rsp ) rsp->Get( chunk );
+        if( chunk ) length = chunk->length;
+        delete st;
+        delete rsp;
+      }
+
+      bool         called;
+      XRootDStatus status;
+      uint32_t     length;
+  };
+
+  bool Check( const std::vector<char> &buf, uint64_t offset, uint32_t length )
+  {
+    for( uint32_t i = 0; i < length; ++i )
+      if( buf[i] != ByteAt( offset + i ) ) return false;
+    return true;
+  }
+}
+
+TEST(ReadAheadTest, RandomReadsAreNotPrefetched)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 1024 * 1024 );
+  std::vector<char> buf( 4096 );
+  std::vector<ReadAhead::Fetch> fetches;
+  uint32_t length;
+
+  for( uint64_t off : { 500000, 12288, 700000, 4096, 300000 } )
+    EXPECT_EQ( ra->Read( off, 4096, buf.data(), 0, length, fetches ),
+               ReadAhead::Miss );
+  EXPECT_TRUE( fetches.empty() );
+  EXPECT_EQ( ra->GetStats().misses, 5u );
+}
+
+TEST(ReadAheadTest, SequentialReads)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 256 * 1024 );
+  std::vector<char> buf( 16 * 1024 );
+  uint32_t length;
+  int hits = 0;
+
+  for( uint64_t off = 0; off < fileSize; off += buf.size() )
+  {
+    std::vector<ReadAhead::Fetch> fetches;
+    ReadAhead::Result res = ra->Read( off, buf.size(), buf.data(), 0, length,
+                                      fetches );
+    ASSERT_NE( res, ReadAhead::Pending );
+    if( res == ReadAhead::Hit )
+    {
+      ++hits;
+      ASSERT_EQ( length, buf.size() );
+      ASSERT_TRUE( Check( buf, off, length ) );
+    }
+    for( auto &f : fetches ) Serve( f );
+    EXPECT_EQ( ra->InFlight(), 0u );
+  }
+
+  ReadAhead::Stats st = ra->GetStats();
+  EXPECT_EQ( st.misses, 2u );
+  EXPECT_EQ( hits, int( fileSize / buf.size() ) - 2 );
+  EXPECT_EQ( st.wasteBytes, 0u );
+  EXPECT_LE( st.fetchBytes, fileSize );
+}
+
+TEST(ReadAheadTest, PendingReadsAndEndOfFile)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 512 * 1024 );
+  std::vector<char> buf( 48 * 1024 );
+  std::vector<ReadAhead::Fetch> outstanding;
+  uint32_t length;
+  uint64_t off = 0;
+  uint64_t total = 0;
+
+  while( off < fileSize + buf.size() )
+  {
+    std::vector<ReadAhead::Fetch> fetches;
+    Reply reply;
+    ReadAhead::Result res = ra->Read( off, buf.size(), buf.data(), &reply,
+                                      length, fetches );
+    outstanding.insert( outstanding.end(), fetches.begin(), fetches.end() );
+    if( res == ReadAhead::Pending )
+    {
+      //------------------------------------------------------------------------
+      // Serve the fetches in order until the read is complete
+      //------------------------------------------------------------------------
+      while( !reply.called )
+      {
+        ASSERT_FALSE( outstanding.empty() );
+        Serve( outstanding.front() );
+        outstanding.erase( outstanding.begin() );
+      }
+      ASSERT_TRUE( reply.status.IsOK() );
+      length = reply.length;
+    }
+    else if( res == ReadAhead::Miss )
+      length = std::min<uint64_t>( buf.size(), fileSize - std::min( off, fileSize ) );
+    ASSERT_TRUE( Check( buf, off, res == ReadAhead::Miss ? 0 : length ) );
+    total += length;
+    off   += buf.size();
+  }
+  for( auto &f : outstanding ) Serve( f );
+
+  EXPECT_EQ( total, fileSize );
+  ReadAhead::Stats st = ra->GetStats();
+  EXPECT_GT( st.waits, 0u );
+  EXPECT_GT( st.maxWindow, 128u * 1024 );
+  EXPECT_EQ( ra->InFlight(), 0u );
+}
+
+TEST(ReadAheadTest, StridedReads)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 256 * 1024 );
+  std::vector<char> buf( 1000 );
+  uint32_t length;
+  int hits = 0;
+
+  for( uint64_t off = 100; off + buf.size() < fileSize; off += 10000 )
+  {
+    std::vector<ReadAhead::Fetch> fetches;
+    ReadAhead::Result res = ra->Read( off, buf.size(), buf.data(), 0, length,
+                                      fetches );
+    ASSERT_NE( res, ReadAhead::Pending );
+    if( res == ReadAhead::Hit )
+    {
+      ++hits;
+      ASSERT_TRUE( Check( buf, off, length ) );
+    }
+    for( auto &f : fetches )
+    {
+      EXPECT_EQ( f.size, buf.size() );
+      Serve( f );
+    }
+  }
+
+  ReadAhead::Stats st = ra->GetStats();
+  EXPECT_EQ( st.misses, 4u );
+  EXPECT_EQ( st.wasteBytes, 0u );
+  EXPECT_GT( hits, 90 );
+}
+
+TEST(ReadAheadTest, StridedFetchesInFlight)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 1024 * 1024 );
+  std::vector<char> buf( 10 );
+  uint32_t length;
+  std::vector<ReadAhead::Fetch> outstanding;
+  std::vector<std::unique_ptr<Reply>> replies;
+
+  // small records and a server that does not answer: the window alone
+  // would allow thousands of fetches
+  for( uint64_t off = 0; off < 100 * 20; off += 20 )
+  {
+    std::vector<ReadAhead::Fetch> fetches;
+    replies.emplace_back( new Reply() );
+    ra->Read( off, buf.size(), buf.data(), replies.back().get(), length,
+              fetches );
+    outstanding.insert( outstanding.end(), fetches.begin(), fetches.end() );
+    EXPECT_LE( ra->InFlight(), uint32_t( ReadAhead::MaxStridedFetches ) );
+  }
+  EXPECT_EQ( outstanding.size(), size_t( ReadAhead::MaxStridedFetches ) );
+
+  for( auto &f : outstanding )
+    Serve( f );
+  EXPECT_EQ( ra->InFlight(), 0u );
+}
+
+TEST(ReadAheadTest, FailedFetch)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 256 * 1024 );
+  std::vector<char> buf( 4096 );
+  std::vector<ReadAhead::Fetch> fetches;
+  uint32_t length;
+
+  for( uint64_t off = 0; off < 2 * buf.size(); off += buf.size() )
+    ra->Read( off, buf.size(), buf.data(), 0, length, fetches );
+  ASSERT_FALSE( fetches.empty() );
+
+  Reply reply;
+  std::vector<ReadAhead::Fetch> more;
+  EXPECT_EQ( ra->Read( 2 * buf.size(), buf.size(), buf.data(), &reply, length,
+                       more ), ReadAhead::Pending );
+  EXPECT_EQ( ra->Waiting(), 1u );
+  ra->Failed( fetches.front(), XRootDStatus( stError, errSocketError ) );
+  ASSERT_TRUE( reply.called );
+  EXPECT_EQ( reply.status.code, errSocketError );
+  EXPECT_EQ( ra->Waiting(), 0u );
+
+  for( size_t i = 1; i < fetches.size(); ++i ) Serve( fetches[i] );
+  for( auto &f : more ) Serve( f );
+  EXPECT_EQ( ra->InFlight(), 0u );
+}
+
+TEST(ReadAheadTest, EmptyReads)
+{
+  auto ra = std::make_shared<ReadAhead>( 64 * 1024, 256 * 1024 );
+  std::vector<char> buf( 1000 );
+  std::vector<ReadAhead::Fetch> fetches;
+  uint32_t length;
+
+  // Empty reads at a constant stride are not a pattern to follow
+  for( uint64_t off = 0; off < 10 * 10000; off += 10000 )
+    EXPECT_EQ( ra->Read( off, 0, buf.data(), 0, length, fetches ),
+               ReadAhead::Miss );
+  EXPECT_TRUE( fetches.empty() );
+
+  // nor do they break one
+  int hits = 0;
+  for( uint64_t off = 0; off < 10 * buf.size(); off += buf.size() )
+  {
+    std::vector<ReadAhead::Fetch> more;
+    if( ra->Read( off, buf.size(), buf.data(), 0, length, more ) == ReadAhead::Hit )
+      ++hits;
+    ra->Read( off + buf.size(), 0, buf.data(), 0, length, more );
+    for( auto &f : more ) Serve( f );
+  }
+  EXPECT_EQ( hits, 8 );
+  EXPECT_EQ( ra->InFlight(), 0u );
+}
@@ -114,6 +114,20 @@ TEST(URLTest, RemoteURLs)
   EXPECT_EQ(params["mgm.replicahead"], "1");
 }
 
+TEST(URLTest, SubStreams)
+{
+  XrdCl::URL plain("root://host1:123//path");
+  XrdCl::URL strm("root://host1:123//path?xrdcl.streams=4");
+  EXPECT_EQ(plain.GetSubStreams(), 0);
+  EXPECT_EQ(strm.GetSubStreams(), 5);
+  EXPECT_EQ(XrdCl::URL("root://host1:123//path?xrdcl.streams=x").GetSubStreams(), 0);
+  EXPECT_EQ(XrdCl::URL("root://host1:123//path?xrdcl.streams=0").GetSubStreams(), 0);
+
+  // a different number of streams needs a channel of its own
+  EXPECT_NE(plain.GetChannelId(), strm.GetChannelId());
+  EXPECT_EQ(strm.GetChannelId(), XrdCl::URL("root://host1:123//other?xrdcl.streams=4").GetChannelId());
+}
+
 TEST(URLTest, InvalidURLs)
 {
   const char *invalid_urls[] = {
@@ -0,0 +1,255 @@
+#undef NDEBUG
+
+#include "XrdCl/XrdClZipCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Compressible test data and its raw deflate stream
+  //----------------------------------------------------------------------------
+  struct Member
+  {
+    Member( size_t size )
+    {
+      std::mt19937 gen( 1234 );
+      const char *words[] = { "event ", "track ", "vertex ", "muon ", "jet ",
+                              "0.125 ", "42 ", "\n", "cluster ", "energy " };
+      while( data.size() < size )
+      {
+        const char *w = words[gen() % 10];
+        data.insert( data.end(), w, w + strlen( w ) );
+      }
+      data.resize( size );
+      Compress();
+    }
+
+    Member( const std::vector<char> &content ) : data( content )
+    {
+      Compress();
+    }
+
+    void Compress()
+    {
+      size_t size = data.size();
+
+      z_stream strm;
+      memset( &strm, 0, sizeof( strm ) );
+      deflateInit2( &strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                    Z_DEFAULT_STRATEGY );
+      compressed.resize( deflateBound( &strm, size ) );
+      strm.next_in   = (Bytef*)data.data();
+      strm.avail_in  = size;
+      strm.next_out  = (Bytef*)compressed.data();
+      strm.avail_out = compressed.size();
+      deflate( &strm, Z_FINISH );
+      compressed.resize( strm.total_out );
+      deflateEnd( &strm );
+    }
+
+    ZipCache::member_t Identity() const
+    {
+      ZipCache::member_t member;
+      member.csize = compressed.size();
+      member.usize = data.size();
+      member.crc32 = crc32( 0, (const Bytef*)data.data(), data.size() );
+      return member;
+    }
+
+    std::vector<char> data;
+    std::vector<char> compressed;
+  };
+
+  //----------------------------------------------------------------------------
+  // Serves fetches of compressed data, immediately or when asked to
+  //----------------------------------------------------------------------------
+  struct Source
+  {
+    Source( const Member &m, ZipCache &c, bool deferred ):
+      member( m ), cache( c ), deferred( deferred ), lowest( ~0ULL ),
+      fetched( 0 ) {}
+
+    ZipCache::fetch_t Fetch()
+    {
+      return [this]( uint64_t off, uint32_t size )
+      {
+        lowest = std::min( lowest, off );
+        fetched += size;
+        if( deferred ) pending.emplace_back( off, size );
+        else Serve( off, size );
+      };
+    }
+
+    void Serve( uint64_t off, uint32_t size )
+    {
+      ZipCache::buffer_t buff( member.compressed.begin() + off,
+                               member.compressed.begin() + off + size );
+      cache.QueueRsp( XRootDStatus(), off, std::move( buff ) );
+    }
+
+    // serve the pending fetches, last one first
+    void Flush()
+    {
+      while( !pending.empty() )
+      {
+        auto f = pending.back();
+        pending.pop_back();
+        Serve( f.first, f.second );
+      }
+    }
+
+    const Member                                &member;
+    ZipCache                                    &cache;
+    bool                                         deferred;
+    uint64_t                                     lowest;
+    uint64_t                                     fetched;
+    std::vector<std::pair<uint64_t, uint32_t>>   pending;
+  };
+
+  class Reply: public ResponseHandler
+  {
+    public:
+      Reply(): called( false ), length( 0 ) {}
+
+      void HandleResponse( XRootDStatus *st, AnyObject *rsp )
+      {
+        called = true;
+        status = *st;
+        ChunkInfo *chunk = 0;
+        if( rsp ) rsp->Get( chunk );
+        if( chunk ) length = chunk->length;
+        delete st;
+        delete rsp;
+      }
+
+      bool         called;
+      XRootDStatus status;
+      uint32_t     length;
+  };
+
+  //----------------------------------------------------------------------------
+  // Read from the cache and check the data
+  //----------------------------------------------------------------------------
+  void Read( ZipCache &cache, Source &src, uint64_t offset, uint32_t size )
+  {
+    std::vector<char> buf( size );
+    Reply reply;
+    cache.QueueReq( offset, size, buf.data(), &reply );
+    src.Flush();
+    ASSERT_TRUE( reply.called );
+    ASSERT_TRUE( reply.status.IsOK() ) << reply.status.ToString();
+    uint32_t expected = std::min<uint64_t>( size, src.member.data.size() - offset );
+    ASSERT_EQ( reply.length, expected );
+    ASSERT_TRUE( std::equal( buf.begin(), buf.begin() + expected,
+                             src.member.data.begin() + offset ) )
+      << "offset " << offset;
+  }
+}
+
+TEST(ZipCacheTest, SequentialReads)
+{
+  Member m( 3 * 1024 * 1024 );
+  ZipCache cache;
+  Source src( m, cache, true );
+  cache.Init( m.compressed.size(), 65536, 0, src.Fetch() );
+  for( uint64_t off = 0; off < m.data.size(); off += 100000 )
+    Read( cache, src, off, 100000 );
+}
+
+TEST(ZipCacheTest, RandomReadsWithoutIndex)
+{
+  Member m( 2 * 1024 * 1024 );
+  ZipCache cache;
+  Source src( m, cache, false );
+  cache.Init( m.compressed.size(), 65536, 0, src.Fetch() );
+  for( uint64_t off : { 1500000, 200000, 1900000, 1900100, 0, 2097000 } )
+    Read( cache, src, off, 4000 );
+}
+
+TEST(ZipCacheTest, RandomReadsWithIndex)
+{
+  const uint64_t span = 512 * 1024;
+  Member m( 8 * 1024 * 1024 );
+  ZipCache cache;
+  Source src( m, cache, true );
+  cache.Init( m.compressed.size(), 65536, span, src.Fetch() );
+
+  // first pass builds the index
+  for( uint64_t off = 0; off < m.data.size(); off += 1024 * 1024 )
+    Read( cache, src, off, 1024 * 1024 );
+
+  // random reads restart at the nearest access point
+  std::mt19937 gen( 42 );
+  for( int i = 0; i < 50; ++i )
+  {
+    uint64_t off = gen() % m.data.size();
+    src.fetched = 0;
+    Read( cache, src, off, 10000 );
+    // only the data from the nearest access point on has to be inflated
+    EXPECT_LT( src.fetched, m.compressed.size() / 4 ) << "offset " << off;
+  }
+}
+
+TEST(ZipCacheTest, ExportImportIndex)
+{
+  const uint64_t span = 256 * 1024;
+  Member m( 4 * 1024 * 1024 );
+  ZipCache::buffer_t index;
+  {
+    ZipCache cache;
+    Source src( m, cache, false );
+    cache.Init( m.compressed.size(), 65536, span, src.Fetch() );
+    Read( cache, src, m.data.size() - 1000, 1000 );
+    cache.ExportIndex( m.Identity(), index );
+  }
+  EXPECT_GT( index.size(), 4u * 32768 );
+
+  ZipCache cache;
+  Source src( m, cache, false );
+  ASSERT_TRUE( cache.ImportIndex( m.Identity(), index ) );
+  cache.Init( m.compressed.size(), 65536, 0, src.Fetch() );
+  Read( cache, src, m.data.size() - 1000, 1000 );
+  EXPECT_GT( src.lowest, m.compressed.size() / 2 );
+  Read( cache, src, 1000000, 1000 );
+
+  ZipCache::buffer_t truncated( index.begin(), index.end() - 1 );
+  ZipCache other;
+  EXPECT_FALSE( other.ImportIndex( m.Identity(), truncated ) );
+}
+
+TEST(ZipCacheTest, StaleIndex)
+{
+  const uint64_t span = 256 * 1024;
+  Member m( 4 * 1024 * 1024 );
+  ZipCache::buffer_t index;
+  {
+    ZipCache cache;
+    Source src( m, cache, false );
+    cache.Init( m.compressed.size(), 65536, span, src.Fetch() );
+    Read( cache, src, m.data.size() - 1000, 1000 );
+    cache.ExportIndex( m.Identity(), index );
+  }
+
+  // the member has been rewritten with the same size but other content
+  Member other( 4 * 1024 * 1024 );
+  std::reverse( other.data.begin(), other.data.end() );
+  other = Member( other.data );
+
+  ZipCache cache;
+  Source src( other, cache, false );
+  EXPECT_FALSE( cache.ImportIndex( other.Identity(), index ) );
+  cache.Init( other.compressed.size(), 65536, 0, src.Fetch() );
+
+  // the stale index is not used, the member is inflated from its beginning
+  Read( cache, src, other.data.size() - 1000, 1000 );
+  EXPECT_EQ( src.lowest, 0u );
+  Read( cache, src, 1000000, 1000 );
+}
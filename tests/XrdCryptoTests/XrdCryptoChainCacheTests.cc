@@ -0,0 +1,88 @@
+#include "XrdCrypto/XrdCryptoChainCache.hh"
+
+#include <ctime>
+#include <string>
+
+#include <gtest/gtest.h>
+
+// Keys land in the shard selected by their first byte modulo 16, so "a", "q"
+// and "A" share a shard while "b" does not.
+
+TEST(XrdCryptoChainCacheTests, Hit)
+{
+    XrdCryptoChainCache cache;
+    time_t now = time(0);
+
+    EXPECT_FALSE(cache.Find("a", now));
+    cache.Add("a", now + 3600);
+    EXPECT_TRUE(cache.Find("a", now));
+    EXPECT_FALSE(cache.Find("b", now));
+    EXPECT_EQ(cache.Num(), 1);
+
+    // Adding again only moves the expiration
+    cache.Add("a", now + 7200);
+    EXPECT_EQ(cache.Num(), 1);
+    EXPECT_TRUE(cache.Find("a", now + 3600));
+}
+
+TEST(XrdCryptoChainCacheTests, Expiry)
+{
+    XrdCryptoChainCache cache;
+    time_t now = time(0);
+
+    cache.Add("a", now + 10);
+    cache.Add("b", now + 100);
+
+    // A verification is no longer valid once the expiration is reached and
+    // the entry is dropped when found expired
+    EXPECT_TRUE(cache.Find("a", now + 9));
+    EXPECT_FALSE(cache.Find("a", now + 10));
+    EXPECT_EQ(cache.Num(), 1);
+    EXPECT_FALSE(cache.Find("a", now));
+
+    cache.Add("a", now + 10);
+    cache.Purge(now + 50);
+    EXPECT_EQ(cache.Num(), 1);
+    EXPECT_TRUE(cache.Find("b", now + 50));
+    cache.Purge(now + 100);
+    EXPECT_EQ(cache.Num(), 0);
+
+    // Without certificates nor CRL there is nothing to bound the validity
+    EXPECT_EQ(XrdCryptoChainCache::Expiry(0, 0), 0);
+}
+
+TEST(XrdCryptoChainCacheTests, Eviction)
+{
+    time_t now = time(0);
+
+    // One entry per shard: a new key replaces the one in its shard only
+    XrdCryptoChainCache small(16);
+    small.Add("a", now + 3600);
+    small.Add("b", now + 3600);
+    small.Add("q", now + 3600);
+    EXPECT_FALSE(small.Find("a", now));
+    EXPECT_TRUE(small.Find("q", now));
+    EXPECT_TRUE(small.Find("b", now));
+    EXPECT_EQ(small.Num(), 2);
+
+    // Two entries per shard: expired entries are evicted first
+    XrdCryptoChainCache cache(32);
+    cache.Add("a", now - 1);
+    cache.Add("q", now + 3600);
+    cache.Add("A", now + 3600);
+    EXPECT_TRUE(cache.Find("q", now));
+    EXPECT_TRUE(cache.Find("A", now));
+    EXPECT_EQ(cache.Num(), 2);
+
+    // Re-adding a cached key never evicts
+    cache.Add("q", now + 7200);
+    EXPECT_TRUE(cache.Find("A", now));
+    EXPECT_EQ(cache.Num(), 2);
+}
+
+TEST(XrdCryptoChainCacheTests, KeyNeedsAChain)
+{
+    std::string key;
+    EXPECT_FALSE(XrdCryptoChainCache::Key(0, 0, 0, 0, 0, key));
+    EXPECT_TRUE(key.empty());
+}
@@ -29,6 +29,8 @@
 #include "XrdEc/XrdEcStrmWriter.hh"
 #include "XrdEc/XrdEcReader.hh"
 #include "XrdEc/XrdEcObjCfg.hh"
+#include "XrdEc/XrdEcConfig.hh"
+#include "XrdEc/XrdEcThreadPool.hh"
 
 #include "XrdCl/XrdClMessageUtils.hh"
 
@@ -39,6 +41,7 @@
 #include <string>
 #include <memory>
 #include <limits>
+#include <thread>
 
 #include <unistd.h>
 #include <cstdio>
@@ -107,6 +110,30 @@ class XrdEcTests : public ::testing::Test
 		CleanUp();
     }
 
+    inline void HedgedReadTest()
+    {
+      // create the data and stripe directories
+      Init( true );
+      // run the test
+      AlignedWriteRaw();
+      // read with one slow stripe
+      SlowStripeReadVerify();
+      // clean up the data directory
+      CleanUp();
+    }
+
+    inline void PersistentSlowStripeTest()
+    {
+      // create the data and stripe directories
+      Init( true );
+      // run the test
+      AlignedWriteRaw();
+      // read many times with one stripe that stays slow
+      PersistentSlowStripeBudget();
+      // clean up the data directory
+      CleanUp();
+    }
+
     inline void AlignedWrite1MissingTestImpl( bool usecrc32c )
     {
       // initialize directories
@@ -189,6 +216,12 @@ class XrdEcTests : public ::testing::Test
 
     void IllegalVectorRead(uint32_t randomSeed);
 
+    void SlowStripeReadVerify();
+
+    void PercentileHedgeBudget();
+
+    void PersistentSlowStripeBudget();
+
     void CleanUp();
 
     inline void ReadVerifyAll()
@@ -284,6 +317,21 @@ TEST_F(XrdEcTests, IllegalVectorReadTest)
   IllegalVectorReadTest();
 }
 
+TEST_F(XrdEcTests, HedgedReadTest)
+{
+  HedgedReadTest();
+}
+
+TEST_F(XrdEcTests, PercentileHedgeBudgetTest)
+{
+  PercentileHedgeBudget();
+}
+
+TEST_F(XrdEcTests, PersistentSlowStripeTest)
+{
+  PersistentSlowStripeTest();
+}
+
 TEST_F(XrdEcTests, AlignedWrite1MissingTest)
 {
   AlignedWrite1MissingTest();
@@ -415,6 +463,166 @@ void XrdEcTests::CorruptedReadVerify()
 
 }
 
+//------------------------------------------------------------------------------
+// Reader with an artificial delay of all reads from one placement
+//------------------------------------------------------------------------------
+class SlowReader : public Reader
+{
+  public:
+    SlowReader( ObjCfg &objcfg ) : Reader( objcfg ) { }
+
+    std::string               slowurl;
+    std::chrono::milliseconds delay;
+
+  protected:
+    void IssueRead( const std::string &url, std::function<void()> rdfunc ) override
+    {
+      if( url == slowurl )
+        ThreadPool::Instance().ExecuteAfter( delay, rdfunc );
+      else
+        rdfunc();
+    }
+};
+
+void XrdEcTests::PercentileHedgeBudget()
+{
+  objcfg.reset( new ObjCfg( "test.txt", nbdata, nbparity, chsize, false, true ) );
+  Config &cfg = Config::Instance();
+  Reader reader( *objcfg );
+
+  // percentile alone: no hedging until the window is filled, then the
+  // percentile of the recorded response times
+  cfg.hedge_budget     = std::chrono::milliseconds( 0 );
+  cfg.hedge_percentile = 90;
+  EXPECT_EQ( reader.HedgeBudget().count(), 0 );
+  for( size_t i = 0; i < Reader::latwnd; ++i )
+    reader.RecordLatency( std::chrono::milliseconds( i < Reader::latwnd / 2 ? 2 : 30 ) );
+  EXPECT_EQ( reader.HedgeBudget().count(), 30 );
+
+  // with a fixed budget as well it acts as the lower bound
+  cfg.hedge_budget = std::chrono::milliseconds( 50 );
+  EXPECT_EQ( reader.HedgeBudget().count(), 50 );
+
+  cfg.hedge_budget     = std::chrono::milliseconds( 0 );
+  cfg.hedge_percentile = 0;
+  EXPECT_EQ( reader.HedgeBudget().count(), 0 );
+}
+
+void XrdEcTests::SlowStripeReadVerify()
+{
+  const std::chrono::milliseconds delay( 2000 );
+  Config &cfg = Config::Instance();
+  cfg.hedge_budget = std::chrono::milliseconds( 20 );
+
+  SlowReader reader( *objcfg );
+  // open the data object
+  XrdCl::SyncResponseHandler handler1;
+  reader.Open( &handler1 );
+  handler1.WaitForResponse();
+  XrdCl::XRootDStatus *status = handler1.GetStatus();
+  EXPECT_XRDST_OK( *status );
+  delete status;
+
+  // make the placement holding the 1st stripe of the 1st block slow
+  std::string fn  = objcfg->GetFileName( 0, 0 );
+  reader.slowurl = reader.urlmap[fn];
+  reader.delay   = delay;
+
+  // read the 1st block, the slow stripe should be reconstructed from parity
+  uint32_t rdlen = objcfg->datasize;
+  std::unique_ptr<char[]> rdbuff( new char[rdlen] );
+  auto start = std::chrono::steady_clock::now();
+  XrdCl::SyncResponseHandler h;
+  reader.Read( 0, rdlen, rdbuff.get(), &h, 0 );
+  h.WaitForResponse();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  status = h.GetStatus();
+  EXPECT_XRDST_OK( *status );
+  delete status;
+  auto rsp = h.GetResponse();
+  XrdCl::ChunkInfo *ch = nullptr;
+  rsp->Get( ch );
+  ASSERT_TRUE(ch != nullptr);
+  std::string result( reinterpret_cast<char*>( ch->buffer ), ch->length );
+  std::string expected( rawdata.data(), rdlen );
+  EXPECT_EQ( result, expected );
+  EXPECT_LT( elapsed, delay / 2 );
+  delete rsp;
+
+  // let the straggler finish before we close the data object
+  std::this_thread::sleep_for( delay );
+  cfg.hedge_budget = std::chrono::milliseconds( 0 );
+
+  XrdCl::SyncResponseHandler handler2;
+  reader.Close( &handler2 );
+  handler2.WaitForResponse();
+  status = handler2.GetStatus();
+  EXPECT_XRDST_OK( *status );
+  delete status;
+}
+
+void XrdEcTests::PersistentSlowStripeBudget()
+{
+  const std::chrono::milliseconds delay( 100 );
+  Config &cfg = Config::Instance();
+  cfg.hedge_budget     = std::chrono::milliseconds( 10 );
+  cfg.hedge_percentile = 75;
+
+  SlowReader reader( *objcfg );
+  // open the data object
+  XrdCl::SyncResponseHandler handler1;
+  reader.Open( &handler1 );
+  handler1.WaitForResponse();
+  XrdCl::XRootDStatus *status = handler1.GetStatus();
+  EXPECT_XRDST_OK( *status );
+  delete status;
+
+  // the placement holding the 1st stripe of the 1st block stays slow
+  std::string fn  = objcfg->GetFileName( 0, 0 );
+  reader.slowurl = reader.urlmap[fn];
+  reader.delay   = delay;
+
+  // alternate between the 1st and the 2nd block so that each read loads
+  // the stripes again, until the response time window has been refilled
+  uint32_t rdlen = objcfg->datasize;
+  std::unique_ptr<char[]> rdbuff( new char[rdlen] );
+  for( size_t i = 0; i < Reader::latwnd / 2; ++i )
+  {
+    uint64_t offset = ( i % 2 ) * rdlen;
+    XrdCl::SyncResponseHandler h;
+    reader.Read( offset, rdlen, rdbuff.get(), &h, 0 );
+    h.WaitForResponse();
+    status = h.GetStatus();
+    EXPECT_XRDST_OK( *status );
+    delete status;
+    auto rsp = h.GetResponse();
+    XrdCl::ChunkInfo *ch = nullptr;
+    rsp->Get( ch );
+    ASSERT_TRUE(ch != nullptr);
+    std::string result( reinterpret_cast<char*>( ch->buffer ), ch->length );
+    std::string expected( rawdata.data() + offset, rdlen );
+    EXPECT_EQ( result, expected );
+    delete rsp;
+  }
+
+  // the hedged stragglers count as well, hence the budget has to stay
+  // well above the response time of the healthy stripes rather than
+  // shrink down to the lower bound
+  EXPECT_GE( reader.HedgeBudget().count(), ( delay / 2 ).count() );
+
+  // let the stragglers finish before we close the data object
+  std::this_thread::sleep_for( 2 * delay );
+  cfg.hedge_budget     = std::chrono::milliseconds( 0 );
+  cfg.hedge_percentile = 0;
+
+  XrdCl::SyncResponseHandler handler2;
+  reader.Close( &handler2 );
+  handler2.WaitForResponse();
+  status = handler2.GetStatus();
+  EXPECT_XRDST_OK( *status );
+  delete status;
+}
+
 void XrdEcTests::VerifyVectorRead(uint32_t seed){
 	  Reader reader( *objcfg );
 	  // open the data object
@@ -5,6 +5,7 @@
 #include "XrdHttp/XrdHttpChecksumHandler.hh"
 #include "XrdHttp/XrdHttpReadRangeHandler.hh"
 #include "XrdHttp/XrdHttpHeaderUtils.hh"
+#include "XrdHttp/XrdHttpMetrics.hh"
 #include "XrdHttpCors/XrdHttpCorsHandler.hh"
 #include <exception>
 #include <gtest/gtest.h>
@@ -686,6 +687,54 @@ TEST(XrdHttpTests, parseWantReprDigest) {
   }
 }
 
+// Content-Range of a partial upload -> {valid, {first, last}}
+static inline const std::pair<std::string,std::pair<bool,std::pair<long long,long long>>> putContentRanges[] {
+  {"bytes 0-9/10",            {true,  {0, 9}}},
+  {"bytes 10-19/*",           {true,  {10, 19}}},
+  {"  BYTES 4096-8191/10000\r\n", {true,  {4096, 8191}}},
+  {"bytes 5-5/6",             {true,  {5, 5}}},
+  // The range overlaps the end of the file
+  {"bytes 0-10/10",           {false, {-1, -1}}},
+  {"bytes 8-15/10",           {false, {-1, -1}}},
+  // The range is reversed
+  {"bytes 9-0/10",            {false, {-1, -1}}},
+  // Unsatisfied-range form, not valid for an upload
+  {"bytes */10",              {false, {-1, -1}}},
+  {"bytes */*",               {false, {-1, -1}}},
+  // Malformed values
+  {"",                        {false, {-1, -1}}},
+  {"bytes",                   {false, {-1, -1}}},
+  {"bits 0-9/10",             {false, {-1, -1}}},
+  {"bytes 0-9",               {false, {-1, -1}}},
+  {"bytes 0/9-10",            {false, {-1, -1}}},
+  {"bytes -1-9/10",           {false, {-1, -1}}},
+  {"bytes 0--9/10",           {false, {-1, -1}}},
+  {"bytes 0-9/10abc",         {false, {-1, -1}}},
+  {"bytes 0-9/",              {false, {-1, -1}}},
+  {"bytes 0 - 9/10",          {false, {-1, -1}}},
+  {"bytes 0-99999999999999999999/*", {false, {-1, -1}}},
+};
+
+TEST(XrdHttpTests, parseContentRange) {
+  for(const auto & [input, expected]: putContentRanges) {
+    long long first = -1, last = -1;
+    ASSERT_EQ(expected.first, XrdHttpHeaderUtils::parseContentRange(input, first, last)) << input;
+    ASSERT_EQ(expected.second, std::make_pair(first, last)) << input;
+  }
+}
+
+TEST(XrdHttpTests, parseContentRangeOverlappingUploads) {
+  // Ranges of different uploads may overlap; each one is valid on its own and
+  // is written at its own offset
+  long long first1, last1, first2, last2;
+  ASSERT_TRUE(XrdHttpHeaderUtils::parseContentRange("bytes 0-4095/8192", first1, last1));
+  ASSERT_TRUE(XrdHttpHeaderUtils::parseContentRange("bytes 2048-8191/8192", first2, last2));
+  ASSERT_EQ(0, first1);
+  ASSERT_EQ(4095, last1);
+  ASSERT_EQ(2048, first2);
+  ASSERT_EQ(8191, last2);
+}
+
 static inline const std::pair<std::string,std::pair<bool,std::vector<uint8_t>>> hexDigestToBinary [] {
   {"deadbeef", {true,std::vector<uint8_t>{0xde, 0xad, 0xbe, 0xef}}},
   {"DEADBEEF", {true,std::vector<uint8_t>{0xde, 0xad, 0xbe, 0xef}}},
@@ -762,3 +811,33 @@ TEST(XrdHttpTests, base64DecodeEncodeHex) {
     ASSERT_EQ(b64ToH.first,output);
   }
 }
+
+TEST(XrdHttpTests, metricsConvert) {
+  const std::string xml =
+    "<statistics tod=\"1\" ver=\"v5\" src=\"host:1094\">"
+    "<stats id=\"info\"><host>host</host><port>1094</port></stats>"
+    "<stats id=\"sched\"><jobs>5</jobs><idle>2</idle></stats>"
+    "<stats id=\"ltcy\"><hist id=\"xrootd.open\"><n>3</n><us>7</us>"
+    "<b>1 0 2</b></hist></stats>"
+    "<stats id=\"myplugin\"><vals><item>4</item><item>6</item></vals></stats>"
+    "</statistics>";
+  char out[4096];
+  int n = XrdHttpMetrics::Convert(xml.c_str(), xml.size(), out, sizeof(out));
+  std::string metrics(out, n);
+
+  ASSERT_EQ(std::string::npos, metrics.find("xrd_info_host"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_info_port 1094\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_sched_jobs 5\nxrd_sched_idle 2\n"));
+  ASSERT_NE(std::string::npos, metrics.find("# TYPE xrd_ltcy_seconds histogram\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_ltcy_seconds_bucket{op=\"xrootd_open\",le=\"2e-06\"} 1\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_ltcy_seconds_bucket{op=\"xrootd_open\",le=\"8e-06\"} 3\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_ltcy_seconds_bucket{op=\"xrootd_open\",le=\"+Inf\"} 3\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_ltcy_seconds_count{op=\"xrootd_open\"} 3\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_ltcy_seconds_sum{op=\"xrootd_open\"} 0.000007\n"));
+  ASSERT_NE(std::string::npos, metrics.find("xrd_myplugin_vals_0 4\nxrd_myplugin_vals_1 6\n"));
+  ASSERT_EQ(metrics.size() - 6, metrics.rfind("# EOF\n"));
+
+  // Metrics that do not fit are dropped but the output stays well formed
+  n = XrdHttpMetrics::Convert(xml.c_str(), xml.size(), out, 40);
+  ASSERT_EQ("xrd_info_port 1094\n# EOF\n", std::string(out, n));
+}
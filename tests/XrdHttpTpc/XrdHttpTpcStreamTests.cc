@@ -0,0 +1,166 @@
+#undef NDEBUG
+
+#include "XrdHttpTpc/XrdHttpTpcStream.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+// A file that keeps what is written to it in memory.
+class MemoryFile : public XrdSfsFile {
+public:
+    MemoryFile(std::vector<char> &data, off_t fail_at = -1)
+        : m_writes(0), m_writevs(0), m_stores(0), m_closed(false),
+          m_data(data), m_fail_at(fail_at) {}
+
+    int open(const char *, XrdSfsFileOpenMode, mode_t, const XrdSecEntity *,
+             const char *) override {return SFS_OK;}
+    int close() override {m_closed = true; return SFS_OK;}
+    using XrdSfsFile::fctl;
+    int fctl(const int, const char *, XrdOucErrInfo &) override {return SFS_ERROR;}
+    const char *FName() override {return "memory";}
+    int getMmap(void **, off_t &) override {return SFS_ERROR;}
+    XrdSfsXferSize read(XrdSfsFileOffset, XrdSfsXferSize) override {return 0;}
+    XrdSfsXferSize read(XrdSfsFileOffset, char *, XrdSfsXferSize) override {return SFS_ERROR;}
+    int read(XrdSfsAio *) override {return ENOTSUP;}
+    int write(XrdSfsAio *) override {return ENOTSUP;}
+    int stat(struct stat *) override {return SFS_ERROR;}
+    int sync() override {return SFS_OK;}
+    int sync(XrdSfsAio *) override {return ENOTSUP;}
+    int truncate(XrdSfsFileOffset) override {return SFS_ERROR;}
+    int getCXinfo(char cxtype[4], int &cxrsz) override {cxrsz = 0; return SFS_OK;}
+
+    XrdSfsXferSize write(XrdSfsFileOffset offset, const char *buffer,
+                         XrdSfsXferSize size) override {
+        m_writes++;
+        return Store(offset, buffer, size);
+    }
+
+    XrdSfsXferSize writev(XrdOucIOVec *writeV, int wdvCnt) override {
+        m_writevs++;
+        XrdSfsXferSize total = 0;
+        for (int idx = 0; idx < wdvCnt; idx++) {
+            XrdSfsXferSize rc = Store(writeV[idx].offset, writeV[idx].data,
+                                      writeV[idx].size);
+            if (rc < 0) {return rc;}
+            total += rc;
+        }
+        return total;
+    }
+
+    int m_writes;
+    int m_writevs;
+    int m_stores;  // Contiguous pieces written, one per write or iovec element
+    bool m_closed;
+
+private:
+    XrdSfsXferSize Store(off_t offset, const char *buffer, size_t size) {
+        // Pretend to be a slow disk so the queue fills up.
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        m_stores++;
+        if (m_fail_at >= 0 && offset + static_cast<off_t>(size) > m_fail_at) {
+            error.setErrInfo(EIO, "simulated disk failure");
+            return SFS_ERROR;
+        }
+        if (m_data.size() < static_cast<size_t>(offset) + size) {m_data.resize(offset + size);}
+        memcpy(&m_data[offset], buffer, size);
+        return size;
+    }
+
+    std::vector<char> &m_data;
+    off_t m_fail_at;
+};
+
+std::vector<char> MakeSource(size_t size) {
+    std::vector<char> source(size);
+    for (size_t idx = 0; idx < size; idx++) {
+        source[idx] = static_cast<char>(idx * 13 + idx / 1021);
+    }
+    return source;
+}
+
+// Send the source in chunks, delivering each group of streams out of order
+// as the multi-stream transfers would.
+bool Transfer(TPC::Stream &stream, const std::vector<char> &source, size_t chunk) {
+    std::vector<off_t> offsets;
+    for (size_t off = 0; off < source.size(); off += chunk) {offsets.push_back(off);}
+    for (size_t idx = 0; idx + 1 < offsets.size(); idx += 2) {
+        std::swap(offsets[idx], offsets[idx + 1]);
+    }
+    for (off_t off : offsets) {
+        size_t size = std::min(chunk, source.size() - off);
+        if (stream.Write(off, &source[off], size, false) != static_cast<ssize_t>(size)) {
+            return false;
+        }
+    }
+    return stream.Write(source.size(), nullptr, 0, true) >= 0;
+}
+
+}
+
+class XrdHttpTpcStreamTests : public Test {
+protected:
+    XrdHttpTpcStreamTests() : m_log(&m_logger, "tpc_") {}
+
+    XrdSysLogger m_logger;
+    XrdSysError m_log;
+};
+
+TEST_F(XrdHttpTpcStreamTests, WriteBehindKeepsTheData) {
+    for (size_t write_behind : {size_t(0), size_t(64 * 1024), size_t(16 * 1024 * 1024)}) {
+        std::vector<char> source = MakeSource(3 * 1024 * 1024 + 12345);
+        std::vector<char> data;
+        MemoryFile *file = new MemoryFile(data);
+        TPC::Stream stream(std::unique_ptr<XrdSfsFile>(file), 4, 64 * 1024, m_log,
+                           write_behind);
+        ASSERT_TRUE(Transfer(stream, source, 64 * 1024)) << stream.GetErrorMessage();
+        ASSERT_TRUE(stream.Finalize()) << stream.GetErrorMessage();
+        EXPECT_TRUE(file->m_closed);
+        EXPECT_TRUE(data == source) << "write_behind " << write_behind;
+        if (!write_behind) {EXPECT_EQ(file->m_writevs, 0);}
+    }
+}
+
+TEST_F(XrdHttpTpcStreamTests, WriteBehindReportsErrors) {
+    std::vector<char> source = MakeSource(4 * 1024 * 1024);
+    std::vector<char> data;
+    MemoryFile *file = new MemoryFile(data, 1024 * 1024);
+    TPC::Stream stream(std::unique_ptr<XrdSfsFile>(file), 4, 64 * 1024, m_log,
+                       256 * 1024);
+    // The failure is seen either by a later write or when finalizing.
+    bool ok = Transfer(stream, source, 64 * 1024);
+    ok = stream.Finalize() && ok;
+    EXPECT_FALSE(ok);
+    EXPECT_NE(stream.GetErrorMessage().find("simulated disk failure"), std::string::npos)
+        << stream.GetErrorMessage();
+}
+
+TEST_F(XrdHttpTpcStreamTests, WriteBehindGathersSmallWrites) {
+    const size_t chunk = 16 * 1024;
+    std::vector<char> source = MakeSource(4 * 1024 * 1024);
+    std::vector<char> data;
+    MemoryFile *file = new MemoryFile(data);
+    TPC::Stream stream(std::unique_ptr<XrdSfsFile>(file), 4, 64 * 1024, m_log,
+                       16 * 1024 * 1024);
+    // In order writes, as from a single stream, go straight to the queue.
+    for (size_t off = 0; off < source.size(); off += chunk) {
+        ASSERT_EQ(stream.Write(off, &source[off], chunk, true), static_cast<ssize_t>(chunk))
+            << stream.GetErrorMessage();
+    }
+    ASSERT_TRUE(stream.Finalize()) << stream.GetErrorMessage();
+    EXPECT_TRUE(data == source);
+    // They are copied into 1MB buffers rather than queued one by one.
+    EXPECT_LE(file->m_stores, 8) << "stores " << file->m_stores;
+}
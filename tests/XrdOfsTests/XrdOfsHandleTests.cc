@@ -0,0 +1,131 @@
+#undef NDEBUG
+
+#include "XrdOfs/XrdOfsHandle.hh"
+#include "XrdOfs/XrdOfsStats.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+extern XrdOfsStats OfsStats;
+
+namespace {
+
+const int numThreads = 16;
+
+// Open a path, check that we got the right handle, and close it again.
+// Returns the number of links the handle had while we held it.
+int OpenClose(const std::string &path, int opts, std::atomic<int> &failures)
+{
+    XrdOfsHandle *hP;
+    int retc, links;
+
+    if (XrdOfsHandle::Alloc(path.c_str(), opts, &hP)) {failures++; return 0;}
+    if (path != hP->Name()) failures++;
+    links = hP->Usage();
+    if (links < 1) failures++;
+    hP->Retire(retc);
+    return links;
+}
+
+int Handles()
+{
+    OfsStats.sdMutex.Lock();
+    int n = OfsStats.Data.numHandles;
+    OfsStats.sdMutex.UnLock();
+    return n;
+}
+
+}
+
+TEST(XrdOfsHandleTests, DistinctPaths) {
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    int before = Handles();
+
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([t, &failures]() {
+            for (int i = 0; i < 20000; i++) {
+                std::string path = "/distinct/" + std::to_string(t) + "/"
+                                 + std::to_string(i % 500);
+                if (OpenClose(path, (i & 1 ? XrdOfsHandle::opRW : 0),
+                              failures) != 1) failures++;
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(Handles(), before);
+}
+
+TEST(XrdOfsHandleTests, SharedPaths) {
+    std::atomic<int> failures(0), shared(0);
+    std::vector<std::thread> threads;
+    std::vector<XrdOfsHandle *> held;
+    int retc, before = Handles();
+
+    // Keep each path open so that every thread attaches to the same handles
+    for (int i = 0; i < 8; i++) {
+        XrdOfsHandle *hP;
+        std::string path = "/shared/" + std::to_string(i);
+        ASSERT_EQ(XrdOfsHandle::Alloc(path.c_str(), 0, &hP), 0);
+        hP->UnLock();
+        held.push_back(hP);
+    }
+
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([t, &failures, &shared]() {
+            for (int i = 0; i < 20000; i++) {
+                std::string path = "/shared/" + std::to_string((i + t) % 8);
+                if (OpenClose(path, 0, failures) > 1) shared++;
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(shared.load(), numThreads * 20000);
+    for (auto hP : held) {
+        hP->Lock();
+        EXPECT_EQ(hP->Usage(), 1);
+        EXPECT_EQ(hP->Retire(retc), 0);
+    }
+    EXPECT_EQ(Handles(), before);
+}
+
+TEST(XrdOfsHandleTests, MixedOpenClose) {
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    int retc, before = Handles();
+
+    // Threads race to be the first to open and the last to close a path
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([t, &failures]() {
+            for (int i = 0; i < 20000; i++) {
+                std::string path = "/mixed/" + std::to_string((i * 7 + t) % 64);
+                OpenClose(path, XrdOfsHandle::opRW, failures);
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(Handles(), before);
+
+    // The read/only and read/write handles of a path are distinct
+    XrdOfsHandle *roP, *rwP;
+    ASSERT_EQ(XrdOfsHandle::Alloc("/mixed/0", 0, &roP), 0);
+    ASSERT_EQ(XrdOfsHandle::Alloc("/mixed/0", XrdOfsHandle::opRW, &rwP), 0);
+    EXPECT_NE(roP, rwP);
+    EXPECT_EQ(roP->Usage(), 1);
+    EXPECT_EQ(rwP->Usage(), 1);
+    EXPECT_EQ(roP->Retire(retc), 0);
+    EXPECT_EQ(rwP->Retire(retc), 0);
+    EXPECT_EQ(Handles(), before);
+}
@@ -0,0 +1,132 @@
+#undef NDEBUG
+
+#include "XrdOfs/XrdOfsTPCEngine.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+// Loads the xrdcl engine plugin the way "ofs.tpc engine xrdcl" does and
+// copies files in a scratch directory with it.
+class XrdOfsTPCEngineTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {
+        char base[] = "/tmp/xrdofstpc_XXXXXX";
+        ASSERT_NE(mkdtemp(base), nullptr);
+        dir = base;
+
+        libHandle = dlopen(TPC_ENGINE_LIB, RTLD_NOW);
+        ASSERT_NE(libHandle, nullptr) << dlerror();
+        auto getEngine = reinterpret_cast<XrdOfsTPCEngineGet_t>(
+                         dlsym(libHandle, "XrdOfsTPCEngineGet"));
+        ASSERT_NE(getEngine, nullptr);
+        engine = getEngine(&eDest, 0);
+        ASSERT_NE(engine, nullptr);
+    }
+
+    void TearDown() override {
+        for (auto fn : {"src", "dst"}) {unlink((dir + "/" + fn).c_str());}
+        rmdir(dir.c_str());
+        delete engine;
+    }
+
+    std::string MakeSource(size_t size) {
+        std::string data(size, 0);
+        for (size_t idx = 0; idx < size; idx++) {data[idx] = static_cast<char>(idx * 7 + idx / 4096);}
+        std::ofstream(dir + "/src", std::ios::binary) << data;
+        return data;
+    }
+
+    std::string ReadTarget() {
+        std::string data;
+        char buff[65536];
+        ssize_t rlen;
+        int fd = open((dir + "/dst").c_str(), O_RDONLY);
+        if (fd < 0) {return data;}
+        while ((rlen = read(fd, buff, sizeof(buff))) > 0) {data.append(buff, rlen);}
+        close(fd);
+        return data;
+    }
+
+    int Copy(const char *cks = nullptr, int strm = 0) {
+        src = "file://" + dir + "/src";
+        dst = dir + "/dst";
+        XrdOfsTPCEngine::Xfr xfr{};
+        xfr.Src   = src.c_str();
+        xfr.Dst   = dst.c_str();
+        xfr.Cks   = cks;
+        xfr.Tid   = "test";
+        xfr.Strm  = strm;
+        xfr.Stop  = &stop;
+        xfr.Bytes = &bytes;
+        xfr.eBuff = eBuff;
+        xfr.eBlen = sizeof(eBuff);
+        *eBuff = 0;
+        return engine->Copy(xfr);
+    }
+
+    XrdSysLogger logger{2, 0};
+    XrdSysError eDest{&logger, "tpctest"};
+    void *libHandle = nullptr;
+    XrdOfsTPCEngine *engine = nullptr;
+    std::string dir, src, dst;
+    std::atomic<bool> stop{false};
+    std::atomic<long long> bytes{0};
+    char eBuff[1024];
+};
+
+}
+
+TEST_F(XrdOfsTPCEngineTest, LocalCopy) {
+    std::string data = MakeSource(3 * 1024 * 1024 + 123);
+    ASSERT_EQ(Copy(), 0) << eBuff;
+    EXPECT_EQ(ReadTarget(), data);
+    EXPECT_EQ(bytes.load(), static_cast<long long>(data.size()));
+}
+
+TEST_F(XrdOfsTPCEngineTest, LocalCopyOverwrites) {
+    std::ofstream(dir + "/dst") << "stale content that is longer than the source";
+    std::string data = MakeSource(10);
+    ASSERT_EQ(Copy(), 0) << eBuff;
+    EXPECT_EQ(ReadTarget(), data);
+}
+
+TEST_F(XrdOfsTPCEngineTest, LocalCopyWithChecksum) {
+    std::string data = MakeSource(1024 * 1024);
+    ASSERT_EQ(Copy("adler32"), 0) << eBuff;
+    EXPECT_EQ(ReadTarget(), data);
+}
+
+TEST_F(XrdOfsTPCEngineTest, LocalCopyWithStreams) {
+    std::string data = MakeSource(1024 * 1024);
+    ASSERT_EQ(Copy(nullptr, 4), 0) << eBuff;
+    EXPECT_EQ(ReadTarget(), data);
+}
+
+TEST_F(XrdOfsTPCEngineTest, MissingSource) {
+    EXPECT_EQ(Copy(), ENOENT);
+    EXPECT_NE(*eBuff, 0);
+    EXPECT_NE(access((dir + "/dst").c_str(), F_OK), 0);
+}
+
+TEST_F(XrdOfsTPCEngineTest, Cancelled) {
+    MakeSource(1024 * 1024);
+    stop = true;
+    EXPECT_EQ(Copy(), ECANCELED);
+    EXPECT_NE(*eBuff, 0);
+}
@@ -0,0 +1,207 @@
+#undef NDEBUG
+
+#include "XrdOss/XrdOssCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+const long long GB = 1024LL * 1024 * 1024;
+
+// A partition whose free space is whatever the test says it is.
+XrdOssCache_FSData *FakePartition(long long freeSpace, dev_t devID)
+{
+    STATFS_t fsbuff;
+    memset(&fsbuff, 0, sizeof(fsbuff));
+    fsbuff.FS_BLKSZ = 4096;
+    fsbuff.f_blocks = 1024 * GB / 4096;
+    fsbuff.f_bavail = freeSpace / 4096;
+    return new XrdOssCache_FSData("/fake", fsbuff, devID);
+}
+
+// A space whose allocation paths live in fake partitions. Each one gets a
+// unique name as the cache objects are never freed (the cache keeps pointers
+// to them) and so spaces cannot be redefined.
+struct Space {
+    Space(const char *prefix, const std::vector<long long> &freeSpace) {
+        static int seq = 0;
+        static dev_t devID = 1000;
+        name = prefix + std::to_string(seq++);
+        char base[] = "/tmp/xrdosscache_XXXXXX";
+        if (!mkdtemp(base)) {return;}
+        dir = base;
+
+        for (size_t idx = 0; idx < freeSpace.size(); idx++) {
+            std::string path = dir + "/" + std::to_string(idx);
+            if (mkdir(path.c_str(), 0700)) {return;}
+            int retc;
+            XrdOssCache_FS *fsp = new XrdOssCache_FS(retc, name.c_str(), path.c_str(),
+                                                     XrdOssCache_FS::None);
+            if (retc) {return;}
+            fsp->fsdata = FakePartition(freeSpace[idx], devID++);
+            fs.push_back(fsp);
+        }
+    }
+
+    ~Space() {
+        for (size_t idx = 0; idx < fs.size(); idx++) {
+            rmdir((dir + "/" + std::to_string(idx)).c_str());
+        }
+        if (!dir.empty()) {rmdir(dir.c_str());}
+    }
+
+    std::string name;
+    std::string dir;
+    std::vector<XrdOssCache_FS *> fs;
+};
+
+// Allocate files of the given size from many threads at once until the space
+// fills up, returning the number of files each partition received.
+std::map<XrdOssCache_FS *, int> Burst(const Space &space, long long size,
+                                      int threads, int files)
+{
+    std::map<XrdOssCache_FS *, int> counts;
+    std::vector<std::vector<XrdOssCache_FS *>> chosen(threads);
+    std::vector<std::thread> workers;
+
+    for (int tid = 0; tid < threads; tid++) {
+        workers.emplace_back([&, tid]() {
+            char pfn[1024];
+            for (int idx = 0; idx < files; idx++) {
+                XrdOssCache::allocInfo aInfo("/burst/file", pfn, sizeof(pfn));
+                aInfo.cgName = space.name.c_str();
+                aInfo.cgSize = size;
+                if (XrdOssCache::Alloc(aInfo) >= 0) {
+                    chosen[tid].push_back(aInfo.cgFSp);
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {worker.join();}
+    for (auto &vec : chosen) {
+        for (auto fsp : vec) {counts[fsp]++;}
+    }
+    return counts;
+}
+
+}
+
+TEST(XrdOssCacheTests, BurstDoesNotOverfill) {
+    const long long size = 64 * 1024 * 1024;
+    std::vector<long long> freeSpace = {1 * GB, 3 * GB, 2 * GB + 12345,
+                                        5 * GB, 7 * GB / 2, 10 * GB};
+    Space space("fill", freeSpace);
+    auto &fsVec = space.fs;
+    ASSERT_EQ(fsVec.size(), freeSpace.size());
+    XrdOssCache::Init(0, 0, 0);
+
+    auto counts = Burst(space, size, 16, 100);
+
+    // Every partition must be filled up to, but never beyond, its free space.
+    for (size_t idx = 0; idx < fsVec.size(); idx++) {
+        EXPECT_EQ(counts[fsVec[idx]], freeSpace[idx] / size) << "partition " << idx;
+        EXPECT_LE(fsVec[idx]->fsdata->rsvd.load(), freeSpace[idx]);
+        EXPECT_LT(fsVec[idx]->fsdata->Avail(), size);
+    }
+}
+
+TEST(XrdOssCacheTests, BurstIsSpread) {
+    const long long size = GB;
+    std::vector<long long> freeSpace(8, 200 * GB);
+    Space space("spread", freeSpace);
+    auto &fsVec = space.fs;
+    ASSERT_EQ(fsVec.size(), freeSpace.size());
+    XrdOssCache::Init(0, 0, 0);
+
+    // Half of the space is allocated; no partition may stand out.
+    auto counts = Burst(space, size, 8, 100);
+    int total = 0;
+    for (auto fsp : fsVec) {
+        EXPECT_GE(counts[fsp], 90);
+        EXPECT_LE(counts[fsp], 110);
+        total += counts[fsp];
+    }
+    EXPECT_EQ(total, 800);
+}
+
+TEST(XrdOssCacheTests, RoundRobin) {
+    std::vector<long long> freeSpace(4, 100 * GB);
+    Space space("robin", freeSpace);
+    auto &fsVec = space.fs;
+    ASSERT_EQ(fsVec.size(), freeSpace.size());
+    XrdOssCache::Init(0, 0, 100);
+
+    auto counts = Burst(space, GB, 1, 40);
+    for (auto fsp : fsVec) {EXPECT_EQ(counts[fsp], 10);}
+    XrdOssCache::Init(0, 0, 0);
+}
+
+TEST(XrdOssCacheTests, RefreshRetiresReservations) {
+    XrdOssCache_FSData *fsdp = FakePartition(10 * GB, 900);
+
+    ASSERT_TRUE(fsdp->Reserve(4 * GB));
+    ASSERT_TRUE(fsdp->Reserve(4 * GB));
+    EXPECT_FALSE(fsdp->Reserve(4 * GB));
+    EXPECT_EQ(fsdp->Avail(), 2 * GB);
+
+    // statfs only sees 2GB written so far; the rest of the 8GB reservation
+    // is still outstanding but ages by half.
+    fsdp->Refresh(8 * GB);
+    EXPECT_EQ(fsdp->rsvd.load(), 3 * GB);
+    EXPECT_EQ(fsdp->Avail(), 5 * GB);
+
+    // Once everything shows up as used, the reservation is gone.
+    fsdp->Refresh(2 * GB);
+    EXPECT_EQ(fsdp->rsvd.load(), 0);
+    EXPECT_EQ(fsdp->Avail(), 2 * GB);
+
+    // Releasing a reservation never drives it negative.
+    ASSERT_TRUE(fsdp->Reserve(GB));
+    fsdp->Refresh(2 * GB);
+    fsdp->Release(GB);
+    EXPECT_EQ(fsdp->rsvd.load(), 0);
+    delete fsdp;
+}
+
+TEST(XrdOssCacheTests, RefreshRacesWithRelease) {
+    XrdOssCache_FSData *fsdp = FakePartition(100 * GB, 901);
+    std::atomic<bool> done{false};
+    bool negative = false;
+
+    // Reservations come and go while the scanner keeps aging them; whatever
+    // the interleaving, the outstanding reservation may never go negative.
+    std::thread scanner([&]() {
+        while (!done) {
+            fsdp->Refresh(100 * GB);
+            if (fsdp->rsvd.load() < 0) {negative = true;}
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int tid = 0; tid < 8; tid++) {
+        workers.emplace_back([&]() {
+            for (int idx = 0; idx < 20000; idx++) {
+                if (fsdp->Reserve(GB)) {fsdp->Release(GB);}
+            }
+        });
+    }
+    for (auto &worker : workers) {worker.join();}
+    done = true;
+    scanner.join();
+
+    EXPECT_FALSE(negative);
+    EXPECT_EQ(fsdp->rsvd.load(), 0);
+    delete fsdp;
+}
@@ -0,0 +1,68 @@
+#undef NDEBUG
+
+#include "XrdOss/XrdOssCopy.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace testing;
+
+namespace {
+
+// Copies within one filesystem are done with a hard link, so the target has
+// to be on another one.
+const char *srcDir = "/tmp";
+const char *dstDir = "/dev/shm";
+
+std::string ReadAll(const std::string &path)
+{
+    std::string data;
+    char buff[65536];
+    ssize_t rlen;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {return data;}
+    while ((rlen = read(fd, buff, sizeof(buff))) > 0) {data.append(buff, rlen);}
+    close(fd);
+    return data;
+}
+
+}
+
+TEST(XrdOssCopyTests, SparseFileKeepsHoles) {
+    struct stat sbuf, dbuf;
+    if (stat(srcDir, &sbuf) || stat(dstDir, &dbuf) || sbuf.st_dev == dbuf.st_dev) {
+        GTEST_SKIP() << "no second filesystem to copy to";
+    }
+
+    std::string src = std::string(srcDir) + "/xrdosscopy_src_" + std::to_string(getpid());
+    std::string dst = std::string(dstDir) + "/xrdosscopy_dst_" + std::to_string(getpid());
+    const off_t fileSize = 8 * 1024 * 1024;
+    std::string block(4096, 'x');
+
+    // Two blocks of data separated by holes and a trailing hole, as left
+    // behind in a cache by sparse reads.
+    int fd = open(src.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, block.data(), block.size(), 0), (ssize_t) block.size());
+    ASSERT_EQ(pwrite(fd, block.data(), block.size(), 3 * 1024 * 1024), (ssize_t) block.size());
+    ASSERT_EQ(ftruncate(fd, fileSize), 0);
+    close(fd);
+
+    int ofd = open(dst.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    ASSERT_GE(ofd, 0);
+    EXPECT_EQ(XrdOssCopy::Copy(src.c_str(), dst.c_str(), ofd), fileSize);
+
+    ASSERT_EQ(stat(dst.c_str(), &dbuf), 0);
+    EXPECT_EQ(dbuf.st_size, fileSize);
+    EXPECT_LT(dbuf.st_blocks * 512, fileSize / 4);
+    EXPECT_EQ(ReadAll(dst), ReadAll(src));
+
+    unlink(src.c_str());
+    unlink(dst.c_str());
+}
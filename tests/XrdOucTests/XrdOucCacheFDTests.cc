@@ -0,0 +1,288 @@
+#include "XrdOuc/XrdOucCacheFD.hh"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const char *Cap = "0123456789abcdef0123456789abcdef";
+
+// Wire layout of the messages, see XrdOucCacheFD.hh
+struct RawRequest
+{
+  char    magic[8];
+  int32_t pathLen;
+  int32_t capLen;
+};
+
+struct RawResponse
+{
+  char    magic[8];
+  int32_t rc;
+  int32_t mapLen;
+  int64_t fileSize;
+  int64_t blockSize;
+};
+
+const char Magic[8] = {'x','r','d','c','f','d','2','\0'};
+
+class XrdOucCacheFDTests : public ::testing::Test
+{
+protected:
+  int sv[2] = {-1, -1};   // sv[0] is the client, sv[1] the cache
+  int dataFD = -1;
+
+  void SetUp() override
+  {
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+    char tmpl[] = "/tmp/xrdouccachefd-XXXXXX";
+    dataFD = mkstemp(tmpl);
+    ASSERT_GE(dataFD, 0);
+    unlink(tmpl);
+    std::string data(10000, 'x');
+    for (size_t i = 0; i < data.size(); i++) data[i] = 'a' + i % 26;
+    ASSERT_EQ(write(dataFD, data.data(), data.size()), (ssize_t) data.size());
+  }
+
+  void TearDown() override
+  {
+    for (int fd : {sv[0], sv[1], dataFD})
+      if (fd >= 0) close(fd);
+  }
+
+  void Raw(const void *buff, size_t len)
+  {
+    ASSERT_EQ(write(sv[1], buff, len), (ssize_t) len);
+  }
+
+  void RawHeader(int32_t rc, int32_t mapLen, int64_t fileSize, int64_t blockSize,
+                 const char *magic = Magic)
+  {
+    RawResponse rsp;
+    memset(&rsp, 0, sizeof(rsp));
+    memcpy(rsp.magic, magic, sizeof(rsp.magic));
+    rsp.rc        = rc;
+    rsp.mapLen    = mapLen;
+    rsp.fileSize  = fileSize;
+    rsp.blockSize = blockSize;
+    Raw(&rsp, sizeof(rsp));
+  }
+
+  // Replies with the data file, 10000 bytes in blocks of 1000, and gets it.
+  int GetWithMap(XrdOucCacheFD &cfd, const std::vector<unsigned char> &map)
+  {
+    int rc = XrdOucCacheFD::Send(sv[1], 0, dataFD, 10000, 1000,
+                                 map.empty() ? 0 : map.data(), map.size());
+    if (rc) return rc;
+    return cfd.Get(sv[0], "/store/file", Cap);
+  }
+};
+}
+
+TEST_F(XrdOucCacheFDTests, RoundTrip)
+{
+  // The cache can answer before it reads the request as the socket buffers it all.
+  std::vector<unsigned char> map = {0xff, 0x02};  // blocks 0-7 and 9
+  XrdOucCacheFD cfd;
+  ASSERT_EQ(GetWithMap(cfd, map), 0);
+
+  char path[XrdOucCacheFD::maxPath];
+  char cap[XrdOucCacheFD::capSize + 1];
+  ASSERT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), 0);
+  EXPECT_STREQ(path, "/store/file");
+  EXPECT_STREQ(cap, Cap);
+
+  ASSERT_GE(cfd.FD(), 0);
+  EXPECT_NE(cfd.FD(), dataFD);
+  EXPECT_EQ(cfd.Size(), 10000);
+  EXPECT_FALSE(cfd.Complete());
+
+  char buff[4];
+  ASSERT_EQ(pread(cfd.FD(), buff, sizeof(buff), 26), 4);
+  EXPECT_EQ(std::string(buff, 4), "abcd");
+
+  // A second descriptor can not be taken on the same object.
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EBUSY);
+}
+
+TEST_F(XrdOucCacheFDTests, CompleteFile)
+{
+  XrdOucCacheFD cfd;
+  ASSERT_EQ(GetWithMap(cfd, {}), 0);
+  EXPECT_TRUE(cfd.Complete());
+  EXPECT_TRUE(cfd.Covers(0, 10000));
+  EXPECT_TRUE(cfd.Covers(9999, 1000000));
+}
+
+TEST_F(XrdOucCacheFDTests, RcOnlyReply)
+{
+  XrdOucCacheFD cfd;
+  ASSERT_EQ(XrdOucCacheFD::Send(sv[1], -EREMOTE), 0);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EREMOTE);
+  EXPECT_LT(cfd.FD(), 0);
+  EXPECT_FALSE(cfd.Covers(0, 1));
+
+  // Positive codes are turned into -errno as well.
+  RawHeader(EACCES, 0, 0, 0);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EACCES);
+
+  // A success without a descriptor is reported as such.
+  ASSERT_EQ(XrdOucCacheFD::Send(sv[1], 0, -1), 0);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EBADF);
+
+  // A success header that comes without a descriptor is not accepted.
+  RawHeader(0, 0, 10000, 1000);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPROTO);
+  EXPECT_LT(cfd.FD(), 0);
+}
+
+TEST_F(XrdOucCacheFDTests, MalformedResponse)
+{
+  XrdOucCacheFD cfd;
+
+  const char bad[8] = {'x','r','d','c','f','d','1','\0'};
+  RawHeader(0, 0, 10000, 1000, bad);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPROTO);
+
+  // Short header, then the cache goes away.
+  RawResponse rsp;
+  memcpy(rsp.magic, Magic, sizeof(rsp.magic));
+  Raw(&rsp, 12);
+  shutdown(sv[1], SHUT_WR);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPIPE);
+  EXPECT_LT(cfd.FD(), 0);
+}
+
+TEST_F(XrdOucCacheFDTests, OversizedMap)
+{
+  XrdOucCacheFD cfd;
+
+  // Send() does not check the map, Get() refuses it before reading it.
+  RawHeader(0, XrdOucCacheFD::maxMap + 1, 10000, 1000);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPROTO);
+  EXPECT_LT(cfd.FD(), 0);
+}
+
+TEST_F(XrdOucCacheFDTests, InconsistentMap)
+{
+  XrdOucCacheFD cfd;
+
+  // Ten blocks do not fit into one byte of map.
+  EXPECT_EQ(GetWithMap(cfd, {0xff}), -EPROTO);
+  EXPECT_LT(cfd.FD(), 0);
+
+  // Map without a block size.
+  unsigned char map[2] = {0xff, 0xff};
+  ASSERT_EQ(XrdOucCacheFD::Send(sv[1], 0, dataFD, 10000, 0, map, 2), 0);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPROTO);
+
+  // Negative file size.
+  ASSERT_EQ(XrdOucCacheFD::Send(sv[1], 0, dataFD, -1, 1000), 0);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", Cap), -EPROTO);
+}
+
+TEST_F(XrdOucCacheFDTests, BadArguments)
+{
+  XrdOucCacheFD cfd;
+  std::string longPath(XrdOucCacheFD::maxPath, '/');
+
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", "0123"), -EINVAL);
+  EXPECT_EQ(cfd.Get(sv[0], "/store/file", nullptr), -EINVAL);
+  EXPECT_EQ(cfd.Get(sv[0], "", Cap), -EINVAL);
+  EXPECT_EQ(cfd.Get(sv[0], longPath.c_str(), Cap), -ENAMETOOLONG);
+  EXPECT_EQ(cfd.Get("/no/such/xrdouccachefd.sock", "/store/file", Cap), -ENOENT);
+
+  char cap[XrdOucCacheFD::capSize + 1], cap2[XrdOucCacheFD::capSize + 1];
+  ASSERT_EQ(XrdOucCacheFD::NewCap(cap), 0);
+  ASSERT_EQ(XrdOucCacheFD::NewCap(cap2), 0);
+  EXPECT_EQ(strlen(cap), (size_t) XrdOucCacheFD::capSize);
+  EXPECT_EQ(strspn(cap, "0123456789abcdef"), (size_t) XrdOucCacheFD::capSize);
+  EXPECT_STRNE(cap, cap2);
+}
+
+TEST_F(XrdOucCacheFDTests, MalformedRequest)
+{
+  char path[64];
+  char cap[XrdOucCacheFD::capSize + 1];
+
+  auto request = [&](const char *magic, int32_t pathLen, int32_t capLen)
+  {
+    RawRequest req;
+    memcpy(req.magic, magic, sizeof(req.magic));
+    req.pathLen = pathLen;
+    req.capLen  = capLen;
+    ASSERT_EQ(write(sv[0], &req, sizeof(req)), (ssize_t) sizeof(req));
+  };
+
+  const char bad[8] = {'x','r','d','c','f','d','1','\0'};
+  request(bad, 5, XrdOucCacheFD::capSize);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPROTO);
+
+  request(Magic, 0, XrdOucCacheFD::capSize);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPROTO);
+
+  request(Magic, XrdOucCacheFD::maxPath, XrdOucCacheFD::capSize);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPROTO);
+
+  // The capability is required.
+  request(Magic, 5, 0);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPROTO);
+
+  request(Magic, sizeof(path), XrdOucCacheFD::capSize);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -ENAMETOOLONG);
+
+  // Embedded null in the path.
+  request(Magic, 5, XrdOucCacheFD::capSize);
+  ASSERT_EQ(write(sv[0], "/a\0bc", 5), 5);
+  ASSERT_EQ(write(sv[0], Cap, XrdOucCacheFD::capSize), (ssize_t) XrdOucCacheFD::capSize);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPROTO);
+
+  // Nothing arrives in time.
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap, 10), -ETIMEDOUT);
+
+  // Truncated request.
+  request(Magic, 5, XrdOucCacheFD::capSize);
+  ASSERT_EQ(write(sv[0], "/abcd", 5), 5);
+  shutdown(sv[0], SHUT_WR);
+  EXPECT_EQ(XrdOucCacheFD::Recv(sv[1], path, sizeof(path), cap), -EPIPE);
+}
+
+TEST_F(XrdOucCacheFDTests, Covers)
+{
+  // Blocks of 1000 bytes, 0-7 and 9 are cached, 8 is not.
+  XrdOucCacheFD cfd;
+  ASSERT_EQ(GetWithMap(cfd, {0xff, 0x02}), 0);
+
+  EXPECT_TRUE (cfd.Covers(0, 1000));
+  EXPECT_TRUE (cfd.Covers(0, 8000));     // ends right before block 8
+  EXPECT_FALSE(cfd.Covers(0, 8001));
+  EXPECT_FALSE(cfd.Covers(7999, 2));
+  EXPECT_FALSE(cfd.Covers(8500, 10));
+  EXPECT_TRUE (cfd.Covers(9000, 1000));
+  EXPECT_TRUE (cfd.Covers(9500, 5000));  // past the end is cut off
+  EXPECT_TRUE (cfd.Covers(9999, 0x7fffffffffffffffLL));
+  EXPECT_FALSE(cfd.Covers(8999, 0x7fffffffffffffffLL));
+
+  // Empty ranges and ranges at or past the end read as zero bytes.
+  EXPECT_TRUE (cfd.Covers(8500, 0));
+  EXPECT_TRUE (cfd.Covers(10000, 100));
+  EXPECT_TRUE (cfd.Covers(0x7fffffffffffffffLL, 0x7fffffffffffffffLL));
+
+  EXPECT_FALSE(cfd.Covers(-1, 10));
+  EXPECT_FALSE(cfd.Covers(0, -1));
+
+  // Nothing is covered without a descriptor.
+  XrdOucCacheFD none;
+  EXPECT_FALSE(none.Covers(0, 0));
+}
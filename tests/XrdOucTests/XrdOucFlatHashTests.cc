@@ -0,0 +1,178 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucFlatHash.hh"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class XrdOucFlatHashTests : public ::testing::Test {};
+
+namespace
+{
+struct Item
+{
+    Item(int v, int *d=0) : val(v), dead(d) {}
+   ~Item() {if (dead) (*dead)++;}
+    int  val;
+    int *dead;
+};
+
+std::string Key(int i)
+{
+    char buff[32];
+    snprintf(buff, sizeof(buff), "/some/path/key%d", i);
+    return buff;
+}
+
+int CountOdd(const char *, Item *item, void *arg)
+{
+    if (item->val & 1) (*static_cast<int *>(arg))++;
+    return 0;
+}
+
+int DropOdd(const char *, Item *item, void *)
+{
+    return (item->val & 1 ? -1 : 0);
+}
+
+int FindVal(const char *, Item *item, void *arg)
+{
+    return (item->val == *static_cast<int *>(arg) ? 1 : 0);
+}
+}
+
+TEST(XrdOucFlatHashTests, AddFindDel)
+{
+    XrdOucFlatHash<Item> hash(16);
+    const int n = 5000;
+    int dead = 0;
+
+    for (int i = 0; i < n; i++)
+        ASSERT_EQ(hash.Add(Key(i).c_str(), new Item(i, &dead)), nullptr);
+    ASSERT_EQ(hash.Num(), n);
+
+    for (int i = 0; i < n; i++) {
+        Item *item = hash.Find(Key(i).c_str());
+        ASSERT_NE(item, nullptr);
+        ASSERT_EQ(item->val, i);
+    }
+    ASSERT_EQ(hash.Find("/not/there"), nullptr);
+
+    // Adding an existing key returns the old item and keeps it
+    Item extra(-1);
+    Item *old = hash.Add(Key(7).c_str(), &extra);
+    ASSERT_NE(old, nullptr);
+    ASSERT_EQ(old->val, 7);
+
+    // Deleting every other key leaves the others reachable
+    for (int i = 0; i < n; i += 2) ASSERT_EQ(hash.Del(Key(i).c_str()), 0);
+    ASSERT_EQ(dead, n/2);
+    ASSERT_EQ(hash.Del(Key(0).c_str()), -ENOENT);
+    ASSERT_EQ(hash.Num(), n/2);
+    for (int i = 0; i < n; i++) {
+        Item *item = hash.Find(Key(i).c_str());
+        if (i & 1) {ASSERT_NE(item, nullptr); ASSERT_EQ(item->val, i);}
+           else ASSERT_EQ(item, nullptr);
+    }
+
+    // Reinsert over the deleted slots
+    for (int i = 0; i < n; i += 2)
+        ASSERT_EQ(hash.Add(Key(i).c_str(), new Item(i, &dead)), nullptr);
+    ASSERT_EQ(hash.Num(), n);
+
+    hash.Purge();
+    ASSERT_EQ(hash.Num(), 0);
+    ASSERT_EQ(dead, n/2 + n);
+}
+
+TEST(XrdOucFlatHashTests, Options)
+{
+    XrdOucFlatHash<Item> hash;
+    int dead = 0;
+
+    // Replacement deletes the old data
+    hash.Add("a", new Item(1, &dead));
+    ASSERT_EQ(hash.Rep("a", new Item(2, &dead)), nullptr);
+    ASSERT_EQ(dead, 1);
+    ASSERT_EQ(hash.Find("a")->val, 2);
+
+    // Counted entries need as many deletions as additions
+    hash.Add("c", new Item(3, &dead), 0, Hash_count);
+    Item dup(4);
+    ASSERT_EQ(hash.Add("c", &dup, 0, Hash_count)->val, 3);
+    ASSERT_EQ(hash.Del("c"), 0);
+    ASSERT_NE(hash.Find("c"), nullptr);
+    ASSERT_EQ(hash.Del("c"), 0);
+    ASSERT_EQ(hash.Find("c"), nullptr);
+
+    // Kept data is not deleted
+    Item kept(5, &dead);
+    hash.Add("k", &kept, 0, Hash_keepdata);
+    ASSERT_EQ(hash.Del("k"), 0);
+    ASSERT_EQ(dead, 2);
+
+    // Expired entries are not found
+    time_t ktime;
+    hash.Add("e", new Item(6, &dead), -10);
+    ASSERT_EQ(hash.Find("e", &ktime), nullptr);
+    ASSERT_EQ(ktime, 0);
+    hash.Add("l", new Item(7, &dead), 3600);
+    ASSERT_NE(hash.Find("l", &ktime), nullptr);
+    ASSERT_GT(ktime, time(0));
+
+    // Data may be the key itself
+    XrdOucFlatHash<char> names;
+    names.Add("name", 0, 0, Hash_data_is_key);
+    ASSERT_STREQ(names.Find("name"), "name");
+}
+
+TEST(XrdOucFlatHashTests, Apply)
+{
+    XrdOucFlatHash<Item> hash;
+    int odd = 0, val = 42;
+
+    for (int i = 0; i < 100; i++) hash.Add(Key(i).c_str(), new Item(i));
+    hash.Apply(CountOdd, &odd);
+    ASSERT_EQ(odd, 50);
+    ASSERT_EQ(hash.Apply(FindVal, &val)->val, 42);
+
+    hash.Apply(DropOdd, 0);
+    ASSERT_EQ(hash.Num(), 50);
+    odd = 0;
+    hash.Apply(CountOdd, &odd);
+    ASSERT_EQ(odd, 0);
+}
+
+TEST(XrdOucFlatHashTests, Sharded)
+{
+    XrdOucShardedHash<Item> hash(8);
+    const int nThreads = 8, n = 2000;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < nThreads; t++) {
+        threads.emplace_back([&hash, t]() {
+            for (int i = 0; i < n; i++) {
+                int v = t*n + i;
+                hash.Add(Key(v).c_str(), new Item(v));
+                Item *item = hash.Find(Key(v).c_str());
+                if (!item || item->val != v) abort();
+                if (i & 1) hash.Del(Key(v).c_str());
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    ASSERT_EQ(hash.Num(), nThreads*n/2);
+
+    {
+        XrdOucShardedHash<Item>::Ref tab(hash, "x");
+        ASSERT_EQ(tab->Find("x"), nullptr);
+        tab->Add("x", new Item(-1));
+    }
+    ASSERT_EQ(hash.Find("x")->val, -1);
+    hash.Purge();
+    ASSERT_EQ(hash.Num(), 0);
+}
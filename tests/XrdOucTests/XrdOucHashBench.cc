@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*                                                                            */
+/* Compares the insert and lookup throughput of XrdOucHash, XrdOucFlatHash    */
+/* and, with several threads, of a mutex protected XrdOucHash and            */
+/* XrdOucShardedHash.                                                          */
+/*                                                                            */
+/* Usage: xrdouchash-bench [<nkeys> [<nthreads>]]                             */
+/*                                                                            */
+/******************************************************************************/
+
+#include "XrdOuc/XrdOucFlatHash.hh"
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Item {int val;};
+
+typedef std::chrono::steady_clock Clock;
+
+double Rate(int ops, Clock::time_point start)
+{
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return ops / secs.count() / 1e6;
+}
+
+// Each measurement is the best of a few runs to filter out noise.
+//
+const int Runs = 3;
+
+template<class Hash>
+void Single(const char *name, const std::vector<std::string> &keys, int rounds)
+{
+    std::vector<Item> items(keys.size());
+    size_t n = keys.size();
+    double ins = 0, hit = 0, miss = 0;
+
+    for (int run = 0; run < Runs; run++)
+        {Hash hash;
+         long found = 0;
+
+         auto start = Clock::now();
+         for (size_t i = 0; i < n; i++)
+             hash.Add(keys[i].c_str(), &items[i], 0, Hash_keepdata);
+         ins = std::max(ins, Rate(n, start));
+
+         start = Clock::now();
+         for (int r = 0; r < rounds; r++)
+             for (size_t i = 0; i < n; i++)
+                 if (hash.Find(keys[(i * 7919) % n].c_str())) found++;
+         hit = std::max(hit, Rate(n * rounds, start));
+
+         start = Clock::now();
+         for (int r = 0; r < rounds; r++)
+             for (size_t i = 0; i < n; i++)
+                 if (hash.Find(keys[i].c_str() + 1)) found++;
+         miss = std::max(miss, Rate(n * rounds, start));
+         if (found != (long)n * rounds) abort();
+        }
+
+    printf("%-22s %10.2f %10.2f %10.2f\n", name, ins, hit, miss);
+}
+
+struct LockedHash
+{
+    Item *Find(const char *key)
+         {XrdSysMutexHelper mHelp(mtx); return hash.Find(key);}
+    void  Add(const char *key, Item *item)
+         {XrdSysMutexHelper mHelp(mtx); hash.Add(key, item, 0, Hash_keepdata);}
+    XrdSysMutex      mtx;
+    XrdOucHash<Item> hash;
+};
+
+struct ShardedHash
+{
+    Item *Find(const char *key) {return hash.Find(key);}
+    void  Add(const char *key, Item *item)
+         {hash.Add(key, item, 0, Hash_keepdata);}
+    XrdOucShardedHash<Item> hash;
+};
+
+template<class Hash>
+void Multi(const char *name, const std::vector<std::string> &keys,
+           int rounds, int nthreads)
+{
+    std::vector<Item> items(keys.size());
+    size_t n = keys.size();
+    double ins = 0, hit = 0;
+
+    for (int run = 0; run < Runs; run++)
+        {Hash hash;
+         std::vector<std::thread> threads;
+
+         auto start = Clock::now();
+         for (int t = 0; t < nthreads; t++)
+             threads.emplace_back([&, t]() {
+                 for (size_t i = t; i < n; i += nthreads)
+                     hash.Add(keys[i].c_str(), &items[i]);
+             });
+         for (auto &thread : threads) thread.join();
+         ins = std::max(ins, Rate(n, start));
+         threads.clear();
+
+         start = Clock::now();
+         for (int t = 0; t < nthreads; t++)
+             threads.emplace_back([&, t]() {
+                 long found = 0;
+                 for (int r = 0; r < rounds; r++)
+                     for (size_t i = 0; i < n; i++)
+                         if (hash.Find(keys[(i * 7919 + t) % n].c_str())) found++;
+                 if (found != (long)n * rounds) abort();
+             });
+         for (auto &thread : threads) thread.join();
+         hit = std::max(hit, Rate(n * rounds * nthreads, start));
+        }
+
+    printf("%-22s %10.2f %10.2f %10s\n", name, ins, hit, "-");
+}
+}
+
+int main(int argc, char **argv)
+{
+    int nkeys    = (argc > 1 ? atoi(argv[1]) : 100000);
+    int nthreads = (argc > 2 ? atoi(argv[2]) : 8);
+    int rounds;
+    std::vector<std::string> keys;
+    char buff[64];
+
+    if (nkeys <= 0 || nthreads <= 0)
+       {fprintf(stderr, "Usage: %s [<nkeys> [<nthreads>]]\n", argv[0]);
+        return 1;
+       }
+
+    rounds = (nkeys < 500000 ? 5000000 / nkeys : 10);
+    for (int i = 0; i < nkeys; i++)
+        {snprintf(buff, sizeof(buff), "/store/user/data/file%08d.root", i);
+         keys.push_back(buff);
+        }
+
+    printf("%d keys, million operations per second\n", nkeys);
+    printf("%-22s %10s %10s %10s\n", "table", "insert", "hit", "miss");
+    Single<XrdOucHash<Item>>    ("XrdOucHash",     keys, rounds);
+    Single<XrdOucFlatHash<Item>>("XrdOucFlatHash", keys, rounds);
+
+    printf("\n%d threads\n", nthreads);
+    Multi<LockedHash> ("XrdOucHash+mutex",  keys, rounds, nthreads);
+    Multi<ShardedHash>("XrdOucShardedHash", keys, rounds, nthreads);
+    return 0;
+}
@@ -315,6 +315,18 @@ TEST(XrdOucUtilsTests, RedactToken_AuthHeader)
   }
 }
 
+TEST(XrdOucUtilsTests, RedactToken_CacheFDCap)
+{
+  const std::string cap = "0123456789abcdef0123456789abcdef";
+
+  ASSERT_EQ(obfuscateAuth("root://proxy//store/file?pfc.fdcap=" + cap),
+            "root://proxy//store/file?pfc.fdcap=REDACTED");
+  ASSERT_EQ(obfuscateAuth("/store/file?scitag.flow=44&pfc.fdcap=" + cap + "&authz=abc"),
+            "/store/file?scitag.flow=44&pfc.fdcap=REDACTED&authz=REDACTED");
+  ASSERT_EQ(obfuscateAuth("/store/file?pfcXfdcap=" + cap),
+            "/store/file?pfcXfdcap=" + cap);
+}
+
 TEST(XrdOucUtilsTests, caseInsensitiveFind) {
   {
     std::map<std::string, std::string> map;
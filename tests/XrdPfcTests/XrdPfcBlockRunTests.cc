@@ -0,0 +1,163 @@
+#include "XrdPfc/XrdPfcFile.hh"
+#include "XProtocol/XProtocol.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace XrdPfc;
+
+namespace
+{
+const int BlkSz = 1024 * 1024;
+
+// Blocks of a file whose IO objects are only compared, never used.
+class BlockRunTest : public ::testing::Test
+{
+protected:
+   IO *io1 = reinterpret_cast<IO*>(&ioTag[0]);
+   IO *io2 = reinterpret_cast<IO*>(&ioTag[1]);
+
+   ~BlockRunTest() override
+   {
+      for (Block *b : blocks) { free(b->get_buff()); delete b; }
+   }
+
+   Block* MakeBlock(long long idx, IO *io, bool cks = false, int size = BlkSz, int rsize = -1)
+   {
+      char *buf = (char*) malloc(size);
+      memset(buf, 0, size);
+      blocks.push_back(new Block(nullptr, io, nullptr, buf, idx * BlkSz, size,
+                                 rsize < 0 ? size : rsize, false, cks));
+      return blocks.back();
+   }
+
+   int Distribute(const std::vector<Block*>& run, int res, std::vector<int>& bres)
+   {
+      return BlockRunResponseHandler::Distribute(run, nullptr, {}, 0, res, bres);
+   }
+
+   std::vector<std::vector<Block*>> Runs(BlockList_t blks, long long max_fetch)
+   {
+      std::vector<std::vector<Block*>> runs;
+      BlockRunResponseHandler::MakeRuns(blks, max_fetch, runs);
+      return runs;
+   }
+
+   char ioTag[2];
+   std::vector<Block*> blocks;
+};
+}
+
+TEST_F(BlockRunTest, AdjacentBlocksMakeOneRun)
+{
+   BlockList_t blks { MakeBlock(0, io1), MakeBlock(1, io1), MakeBlock(2, io1) };
+   auto runs = Runs(blks, 8 * BlkSz);
+   ASSERT_EQ(runs.size(), 1u);
+   EXPECT_EQ(runs[0], std::vector<Block*>(blks.begin(), blks.end()));
+}
+
+TEST_F(BlockRunTest, RunsAreSplit)
+{
+   Block *b0 = MakeBlock(0, io1), *b1 = MakeBlock(1, io1);
+   Block *b3 = MakeBlock(3, io1);                    // gap before
+   Block *b4 = MakeBlock(4, io2);                    // different io
+   Block *b5 = MakeBlock(5, io2, true);              // checksums wanted
+   Block *b6 = MakeBlock(6, io2, true);
+   Block *b7 = MakeBlock(7, io2, true, 1000, 4096);  // last block, rounded up
+   auto runs = Runs({ b0, b1, b3, b4, b5, b6, b7 }, 8 * BlkSz);
+
+   std::vector<std::vector<Block*>> expected { { b0, b1 }, { b3 }, { b4 }, { b5, b6 }, { b7 } };
+   EXPECT_EQ(runs, expected);
+}
+
+TEST_F(BlockRunTest, RunsAreCapped)
+{
+   BlockList_t blks;
+   for (int i = 0; i < 7; ++i) blks.push_back(MakeBlock(i, io1));
+
+   auto runs = Runs(blks, 3 * BlkSz);
+   ASSERT_EQ(runs.size(), 3u);
+   EXPECT_EQ(runs[0].size(), 3u);
+   EXPECT_EQ(runs[1].size(), 3u);
+   EXPECT_EQ(runs[2].size(), 1u);
+
+   // Blocks bigger than a vector read segment count as several segments;
+   // their buffers are not needed to make the runs.
+   const int big = 4 * XrdProto::maxRVdsz;
+   blks.clear();
+   for (int i = 0; i < XrdProto::maxRvecsz; ++i)
+   {
+      blocks.push_back(new Block(nullptr, io1, nullptr, nullptr, (long long) i * big, big, big, false, false));
+      blks.push_back(blocks.back());
+   }
+   runs = Runs(blks, 1LL << 40);
+   ASSERT_EQ(runs.size(), 4u);
+   for (auto &run : runs) EXPECT_EQ((int) run.size(), XrdProto::maxRvecsz / 4);
+}
+
+TEST_F(BlockRunTest, MaxFetchZeroFetchesBlocksOneByOne)
+{
+   BlockList_t blks { MakeBlock(0, io1), MakeBlock(1, io1), MakeBlock(2, io1) };
+   auto runs = Runs(blks, 0);
+   ASSERT_EQ(runs.size(), 3u);
+   for (auto &run : runs) EXPECT_EQ(run.size(), 1u);
+}
+
+TEST_F(BlockRunTest, DistributeFullRead)
+{
+   std::vector<Block*> run { MakeBlock(0, io1, true), MakeBlock(1, io1, true), MakeBlock(2, io1, true) };
+
+   // The pgRead lands in the staging buffer with one checksum per page.
+   const int size  = 3 * BlkSz;
+   const int pages = size / XrdSys::PageSize;
+   std::vector<char>     buff(size);
+   std::vector<uint32_t> cksums;
+   for (int i = 0; i < size; ++i) buff[i] = (char) (i / XrdSys::PageSize);
+   for (int i = 0; i < pages; ++i) cksums.push_back(1000 + i);
+
+   std::vector<int> bres;
+   EXPECT_EQ(BlockRunResponseHandler::Distribute(run, buff.data(), cksums, 2, size, bres), -1);
+   EXPECT_EQ(bres, std::vector<int>(3, BlkSz));
+
+   const int bpages = BlkSz / XrdSys::PageSize;
+   for (int n = 0; n < 3; ++n)
+   {
+      Block *b = run[n];
+      EXPECT_EQ(memcmp(b->get_buff(), buff.data() + n * BlkSz, BlkSz), 0) << "block " << n;
+      ASSERT_EQ((int) b->ref_cksum_vec().size(), bpages) << "block " << n;
+      EXPECT_EQ(b->ref_cksum_vec().front(), 1000u + n * bpages);
+      EXPECT_EQ(b->ref_cksum_vec().back(), 1000u + (n + 1) * bpages - 1);
+   }
+   EXPECT_EQ(run[0]->get_n_cksum_errors(), 2);
+   EXPECT_EQ(run[1]->get_n_cksum_errors(), 0);
+}
+
+TEST_F(BlockRunTest, DistributeShortRead)
+{
+   std::vector<Block*> run { MakeBlock(0, io1), MakeBlock(1, io1), MakeBlock(2, io1), MakeBlock(3, io1) };
+
+   // Only the first block and part of the second were received; the size
+   // mismatch is to be reported once, with the second block.
+   std::vector<int> bres;
+   EXPECT_EQ(Distribute(run, BlkSz + 100, bres), 1);
+   EXPECT_EQ(bres, (std::vector<int>{ BlkSz, 100, 0, 0 }));
+
+   EXPECT_EQ(Distribute(run, 2 * BlkSz, bres), 2);
+   EXPECT_EQ(bres, (std::vector<int>{ BlkSz, BlkSz, 0, 0 }));
+
+   EXPECT_EQ(Distribute(run, 0, bres), 0);
+   EXPECT_EQ(bres, (std::vector<int>{ 0, 0, 0, 0 }));
+}
+
+TEST_F(BlockRunTest, DistributeError)
+{
+   std::vector<Block*> run { MakeBlock(0, io1), MakeBlock(1, io1) };
+
+   std::vector<int> bres;
+   EXPECT_EQ(Distribute(run, -EIO, bres), -1);
+   EXPECT_EQ(bres, (std::vector<int>{ -EIO, -EIO }));
+}
@@ -0,0 +1,170 @@
+#include "XrdPfc/XrdPfcInfo.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdSys/XrdSysTrace.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace XrdPfc;
+
+namespace
+{
+// A cinfo file kept in memory.
+class MemoryDF : public XrdOssDF
+{
+public:
+   int Close(long long *retsz = 0) override { return 0; }
+
+   ssize_t Read(void *buffer, off_t offset, size_t size) override
+   {
+      if (offset >= (off_t) m_data.size()) return 0;
+      size = std::min(size, m_data.size() - offset);
+      memcpy(buffer, &m_data[offset], size);
+      return size;
+   }
+
+   ssize_t Write(const void *buffer, off_t offset, size_t size) override
+   {
+      if (m_data.size() < offset + size) m_data.resize(offset + size);
+      memcpy(&m_data[offset], buffer, size);
+      return size;
+   }
+
+   std::vector<unsigned char> m_data;
+};
+
+class PfcInfoTest : public ::testing::Test
+{
+protected:
+   PfcInfoTest() : m_trace("PfcInfoTest") {}
+
+   void Fill(Info &info, std::vector<bool> &ref, int nblocks, double density, int seed)
+   {
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> dist(0, 1);
+
+      info.SetBufferSizeFileSizeAndCreationTime(1024, nblocks * 1024LL - 100);
+      ref.assign(nblocks, false);
+      for (int i = 0; i < nblocks; ++i)
+      {
+         // Runs of written blocks so that whole words fill up
+         if (dist(gen) < density || (i > 0 && ref[i - 1] && dist(gen) < 0.9))
+         {
+            info.SetBitWritten(i);
+            ref[i] = true;
+         }
+      }
+   }
+
+   XrdSysTrace m_trace;
+};
+
+int RefFirstMissing(const std::vector<bool> &ref, int first, int last)
+{
+   for (int i = first; i < last; ++i)
+      if ( ! ref[i]) return i;
+   return -1;
+}
+}
+
+TEST_F(PfcInfoTest, WordQueriesMatchBitByBit)
+{
+   for (int nblocks : { 1, 63, 64, 65, 4095, 4096, 4097, 100003 })
+   {
+      for (double density : { 0.0, 0.3, 0.999, 1.0 })
+      {
+         Info info(&m_trace);
+         std::vector<bool> ref;
+         Fill(info, ref, nblocks, density, nblocks);
+
+         int written = 0, last = -1;
+         for (int i = 0; i < nblocks; ++i)
+            if (ref[i]) { ++written; last = i; }
+
+         ASSERT_EQ(info.GetNBlocks(), nblocks);
+         EXPECT_EQ(info.GetNDownloadedBlocks(), written);
+         EXPECT_EQ(info.GetLastDownloadedBlock(), last);
+         EXPECT_EQ(info.IsComplete(), written == nblocks);
+         EXPECT_EQ(info.CountBlocksNotWrittenInRng(0, nblocks), nblocks - written);
+
+         std::mt19937 gen(17);
+         for (int k = 0; k < 200; ++k)
+         {
+            int first = gen() % nblocks;
+            int end   = first + 1 + gen() % (nblocks - first);
+            int cnt   = 0;
+            for (int i = first; i < end; ++i)
+               if ( ! ref[i]) ++cnt;
+            ASSERT_EQ(info.CountBlocksNotWrittenInRng(first, end), cnt)
+               << nblocks << " [" << first << ", " << end << ")";
+            ASSERT_EQ(info.FirstBlockNotWrittenInRng(first, end),
+                      RefFirstMissing(ref, first, end))
+               << nblocks << " [" << first << ", " << end << ")";
+         }
+
+         // Walking the missing blocks as prefetching does
+         int walked = 0;
+         for (int f = info.FirstBlockNotWrittenInRng(0, nblocks); f >= 0;
+                  f = info.FirstBlockNotWrittenInRng(f + 1, nblocks))
+         {
+            ASSERT_FALSE(ref[f]);
+            ++walked;
+         }
+         EXPECT_EQ(walked, nblocks - written);
+
+         // Setting a block twice must not change the count
+         if (last >= 0)
+         {
+            info.SetBitWritten(last);
+            EXPECT_EQ(info.GetNDownloadedBlocks(), written);
+         }
+      }
+   }
+}
+
+TEST_F(PfcInfoTest, CinfoFileLayout)
+{
+   const int nblocks = 1000;
+   Info info(&m_trace);
+   std::vector<bool> ref;
+   Fill(info, ref, nblocks, 0.4, 3);
+   for (int i = 0; i < nblocks; ++i)
+      if (ref[i]) info.SetBitSynced(i);
+
+   MemoryDF file;
+   ASSERT_TRUE(info.Write(&file, "/test/", "file"));
+
+   // The synced vector follows the version, the store and its checksum with
+   // block i in bit i%8 of byte i/8.
+   const size_t off = sizeof(int) + sizeof(Info::Store) + sizeof(uint32_t);
+   ASSERT_GE(file.m_data.size(), off + (nblocks + 7) / 8);
+   for (int i = 0; i < nblocks; ++i)
+      ASSERT_EQ((file.m_data[off + i / 8] >> (i % 8)) & 1, ref[i] ? 1 : 0) << i;
+
+   Info back(&m_trace);
+   ASSERT_TRUE(back.Read(&file, "/test/", "file"));
+   EXPECT_EQ(back.GetNDownloadedBlocks(), info.GetNDownloadedBlocks());
+   for (int i = 0; i < nblocks; ++i)
+      ASSERT_EQ(back.TestBitWritten(i), ref[i]) << i;
+}
+
+TEST_F(PfcInfoTest, AllBitsSynced)
+{
+   const int nblocks = 130;
+   Info info(&m_trace);
+   info.SetBufferSizeFileSizeAndCreationTime(1024, nblocks * 1024LL);
+   info.SetAllBitsSynced();
+
+   MemoryDF file;
+   ASSERT_TRUE(info.Write(&file, "/test/", "file"));
+
+   Info back(&m_trace);
+   ASSERT_TRUE(back.Read(&file, "/test/", "file"));
+   EXPECT_TRUE(back.IsComplete());
+   EXPECT_EQ(back.GetNDownloadedBlocks(), nblocks);
+   EXPECT_EQ(back.GetLastDownloadedBlock(), nblocks - 1);
+   EXPECT_EQ(back.FirstBlockNotWrittenInRng(0, nblocks), -1);
+}
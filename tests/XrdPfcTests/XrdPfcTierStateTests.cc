@@ -0,0 +1,132 @@
+#include "XrdPfc/XrdPfcTierState.hh"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace XrdPfc;
+
+namespace
+{
+const time_t Now = 1000000;
+
+struct stat MakeStat(long long size, long long blocks = -1)
+{
+   struct stat st = {};
+   st.st_size   = size;
+   st.st_blocks = blocks < 0 ? (size + 511) / 512 : blocks;
+   return st;
+}
+}
+
+TEST(TierStateTest, OssSpaceFromXattrs)
+{
+   EXPECT_TRUE (is_in_oss_space("oss.cgroup=fast", "fast"));
+   EXPECT_TRUE (is_in_oss_space("oss.cgroup=fast&oss.used=100", "fast"));
+   EXPECT_TRUE (is_in_oss_space("oss.asize=10&oss.cgroup=fast&", "fast"));
+   EXPECT_FALSE(is_in_oss_space("oss.cgroup=faster", "fast"));
+   EXPECT_FALSE(is_in_oss_space("oss.cgroup=fas", "fast"));
+   EXPECT_FALSE(is_in_oss_space("oss.cgroup=public", "fast"));
+   EXPECT_FALSE(is_in_oss_space("oss.cgroup=&oss.used=100", "fast"));
+   EXPECT_FALSE(is_in_oss_space("oss.used=100", "fast"));
+   EXPECT_FALSE(is_in_oss_space("", "fast"));
+}
+
+TEST(TierStateTest, DemotesOldestFirst)
+{
+   // 3 MB to demote out of five 1 MB files.
+   TierState ts(3 * 1024 * 1024 - 1, 0, Now, 3600, 2);
+   ASSERT_TRUE(ts.wants_fast_files());
+
+   ts.add_fast_file("/d/", "e", MakeStat(1024 * 1024), Now - 10);
+   ts.add_fast_file("/d/", "a", MakeStat(1024 * 1024), Now - 50);
+   ts.add_fast_file("/d/", "c", MakeStat(1024 * 1024), Now - 30);
+   ts.add_fast_file("/d/", "d", MakeStat(1024 * 1024), Now - 20);
+   ts.add_fast_file("/d/", "b", MakeStat(1024 * 1024), Now - 40);
+   ts.finalize();
+
+   std::string paths;
+   for (auto &p : ts.refDemoteMap()) paths += p.second.path + " ";
+   EXPECT_EQ(paths, "/d/a /d/b /d/c ");
+   EXPECT_TRUE(ts.refPromoteVec().empty());
+}
+
+TEST(TierStateTest, DemotesEnoughBlocks)
+{
+   // A single big old file covers the request, the newer small ones are dropped again.
+   TierState ts(2 * 1024 * 1024, 0, Now, 3600, 2);
+
+   ts.add_fast_file("/", "small1", MakeStat(4096), Now - 10);
+   ts.add_fast_file("/", "small2", MakeStat(4096), Now - 20);
+   ts.add_fast_file("/", "big",    MakeStat(8 * 1024 * 1024), Now - 100);
+   ts.add_fast_file("/", "small3", MakeStat(4096), Now - 5);
+   ts.finalize();
+
+   ASSERT_EQ(ts.refDemoteMap().size(), 1u);
+   EXPECT_EQ(ts.refDemoteMap().begin()->second.path, "/big");
+   EXPECT_EQ(ts.refDemoteMap().begin()->first, Now - 100);
+}
+
+TEST(TierStateTest, NoDemotionRequested)
+{
+   TierState ts(0, 0, Now, 3600, 2);
+   EXPECT_FALSE(ts.wants_fast_files());
+
+   ts.add_fast_file("/", "f", MakeStat(1024), Now - 100);
+   ts.finalize();
+
+   EXPECT_TRUE(ts.refDemoteMap().empty());
+}
+
+TEST(TierStateTest, SparseCandidate)
+{
+   TierState ts(1, 0, Now, 3600, 2);
+
+   ts.add_fast_file("/", "sparse", MakeStat(1024 * 1024, 8), Now - 100);
+   ts.finalize();
+
+   ASSERT_EQ(ts.refDemoteMap().size(), 1u);
+   EXPECT_TRUE(ts.refDemoteMap().begin()->second.is_sparse());
+   EXPECT_FALSE(TierState::Candidate("/", "f", MakeStat(1024 * 1024), 0).is_sparse());
+}
+
+TEST(TierStateTest, PromotesMostAccessedFirst)
+{
+   TierState ts(0, 1024 * 1024 * 1024, Now, 3600, 3);
+
+   ts.add_data_file("/", "few",     MakeStat(1024), 2, true);
+   ts.add_data_file("/", "some",    MakeStat(1024), 5, true);
+   ts.add_data_file("/", "many",    MakeStat(1024), 9, true);
+   ts.add_data_file("/", "partial", MakeStat(1024), 20, false);
+   ts.add_data_file("/", "min",     MakeStat(1024), 3, true);
+   ts.add_data_file("/", "some2",   MakeStat(1024), 5, true);
+   ts.finalize();
+
+   std::string paths;
+   for (auto &c : ts.refPromoteVec()) paths += c.path + " ";
+   EXPECT_EQ(paths, "/many /some /some2 /min ");
+   EXPECT_TRUE(ts.refDemoteMap().empty());
+}
+
+TEST(TierStateTest, PromotionWindow)
+{
+   TierState ts(0, 1024 * 1024, Now, 3600, 2);
+
+   EXPECT_EQ(ts.promote_min_time(), Now - 3600);
+   EXPECT_TRUE (ts.wants_data_file(Now));
+   EXPECT_TRUE (ts.wants_data_file(Now - 3600));
+   EXPECT_FALSE(ts.wants_data_file(Now - 3601));
+}
+
+TEST(TierStateTest, PromotionOff)
+{
+   TierState no_bytes(0, 0, Now, 3600, 2);
+   EXPECT_FALSE(no_bytes.wants_data_file(Now));
+   no_bytes.add_data_file("/", "f", MakeStat(1024), 10, true);
+   EXPECT_TRUE(no_bytes.refPromoteVec().empty());
+
+   TierState no_accesses(0, 1024 * 1024, Now, 3600, 0);
+   EXPECT_FALSE(no_accesses.wants_data_file(Now));
+   no_accesses.add_data_file("/", "f", MakeStat(1024), 10, true);
+   EXPECT_TRUE(no_accesses.refPromoteVec().empty());
+}
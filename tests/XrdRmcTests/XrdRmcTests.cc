@@ -0,0 +1,144 @@
+#include "XrdRmc/XrdRmc.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A synthetic, thread-safe data source: the content of every byte is derived
+// from its offset and the file number so reads can be verified.
+//------------------------------------------------------------------------------
+class MemIO : public XrdOucCacheIO
+{
+public:
+    MemIO(int fnum, long long fsize) : fNum(fnum), fSize(fsize), nReads(0) {}
+
+    bool        Detach(XrdOucCacheIOCD &iocd) override { return true; }
+    long long   FSize() override { return fSize; }
+    const char *Path() override { return "memio"; }
+
+    int Read(char *buff, long long offs, int rlen) override
+    {
+        nReads++;
+        if (offs >= fSize) return 0;
+        if (offs + rlen > fSize) rlen = fSize - offs;
+        for (int i = 0; i < rlen; i++) buff[i] = Byte(fNum, offs + i);
+        return rlen;
+    }
+
+    int Sync() override { return 0; }
+    int Trunc(long long offs) override { return -EROFS; }
+    int Write(char *buff, long long offs, int wlen) override { return -EROFS; }
+
+    static char Byte(int fnum, long long offs)
+    {
+        return static_cast<char>((offs * 31 + (offs >> 12) + fnum) & 0xff);
+    }
+
+    const int         fNum;
+    const long long   fSize;
+    std::atomic<long> nReads;
+};
+
+class NoDetachCB : public XrdOucCacheIOCD
+{
+public:
+    void DetachDone() override {}
+};
+
+//------------------------------------------------------------------------------
+// Run concurrent readers against a cache, each reading its own file, and
+// count the reads that did not return the expected data.
+//------------------------------------------------------------------------------
+void Hammer(XrdOucCache *cache, int nThreads, long long fSize, int rSize,
+           bool sequential, std::atomic<long> &errors)
+{
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < nThreads; t++)
+        readers.emplace_back([=, &errors]() {
+            MemIO src(t, fSize);
+            XrdOucCacheIO *ioP = cache->Attach(&src, 0);
+            std::vector<char> buff(rSize);
+            std::mt19937_64 rng(t);
+            long long nRead = fSize / rSize;
+
+            for (long long i = 0; i < nRead; i++)
+            {
+                long long offs = (sequential ? i : (long long)(rng() % nRead)) * rSize;
+                int rc = ioP->Read(buff.data(), offs, rSize);
+                if (rc != rSize) { errors++; continue; }
+                for (int j = 0; j < rSize; j += 509)
+                    if (buff[j] != MemIO::Byte(t, offs + j)) { errors++; break; }
+            }
+
+            NoDetachCB iocd;
+            if (ioP != &src) ioP->Detach(iocd);
+        });
+
+    for (auto &r : readers) r.join();
+}
+
+XrdOucCache *MakeCache(int shards, bool preread)
+{
+    XrdRmc::Parms parms;
+    XrdOucCacheIO::aprParms apr;
+
+    parms.CacheSize = 64 * 1024 * 1024;
+    parms.PageSize  = 32 * 1024;
+    parms.Options   = XrdRmc::ioMTSafe | (preread ? XrdRmc::canPreRead : 0);
+    parms.Shards    = shards;
+    apr.minPages    = 1;
+
+    return XrdRmc::Create(parms, &apr);
+}
+}
+
+TEST(XrdRmcTests, ConcurrentReaders)
+{
+    XrdOucCache *cache = MakeCache(1, false);
+    ASSERT_NE(cache, nullptr);
+
+    std::atomic<long> errors(0);
+    Hammer(cache, 16, 16 * 1024 * 1024, 4096, false, errors);
+    EXPECT_EQ(errors.load(), 0);
+
+    delete cache;
+}
+
+TEST(XrdRmcTests, ConcurrentReadersSharded)
+{
+    XrdOucCache *cache = MakeCache(8, false);
+    ASSERT_NE(cache, nullptr);
+
+    std::atomic<long> errors(0);
+    Hammer(cache, 16, 16 * 1024 * 1024, 4096, false, errors);
+    EXPECT_EQ(errors.load(), 0);
+
+    delete cache;
+}
+
+TEST(XrdRmcTests, SequentialPreread)
+{
+    for (int shards : {1, 8})
+    {
+        XrdOucCache *cache = MakeCache(shards, true);
+        ASSERT_NE(cache, nullptr);
+
+        std::atomic<long> errors(0);
+        Hammer(cache, 16, 16 * 1024 * 1024, 4096, true, errors);
+        EXPECT_EQ(errors.load(), 0);
+
+        // All statistics end up in the cache the files were attached to
+        EXPECT_GT(cache->Statistics.X.BytesPead, 0);
+        EXPECT_GT(cache->Statistics.X.HitsPR, 0);
+
+        delete cache;
+    }
+}
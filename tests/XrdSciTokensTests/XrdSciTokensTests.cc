@@ -0,0 +1,164 @@
+#include "XrdSciTokens/XrdSciTokensCache.hh"
+#include "XrdSciTokens/XrdSciTokensScopes.hh"
+#include "XrdOuc/XrdOucPrivateUtils.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Rules
+{
+    Rules(int v, bool exp=false) : value(v), isExpired(exp) {}
+    bool expired() const {return isExpired;}
+    int  value;
+    bool isExpired;
+};
+
+typedef std::vector<std::pair<Access_Operation, std::string>> RawRules;
+
+// The matching done before the scopes were compiled
+bool Reference(const RawRules &rules, Access_Operation oper, const std::string &path)
+{
+    for (const auto &rule : rules) {
+        if (rule.first != oper) continue;
+        if (rule.second == "/") return true;
+        if (is_subdirectory(rule.second, path)) return true;
+        if ((oper == AOP_Stat || oper == AOP_Mkdir) && is_subdirectory(path, rule.second))
+            return true;
+    }
+    return false;
+}
+}
+
+//------------------------------------------------------------------------------
+// Compiled scopes must decide exactly as the linear rule walk did.
+//------------------------------------------------------------------------------
+TEST(XrdSciTokensScopes, MatchesReference)
+{
+    const char *parts[] = {"a", "ab", "b", "store", "user", ""};
+    std::mt19937 rng(7);
+    auto randPath = [&]() {
+        std::string path;
+        int depth = rng() % 4;
+        for (int i = 0; i < depth; i++) {path += '/'; path += parts[rng() % 6];}
+        if (rng() % 5 == 0) path += '/';
+        return path.empty() ? std::string("/") : path;
+    };
+    const Access_Operation ops[] = {AOP_Read, AOP_Stat, AOP_Mkdir, AOP_Update};
+
+    for (int trial = 0; trial < 200; trial++) {
+        RawRules rules;
+        int nrules = rng() % 6;
+        for (int i = 0; i < nrules; i++) {
+            std::string path = randPath();
+            if (path == "/" && rng() % 4) path = "/store";
+            rules.emplace_back(ops[rng() % 4], path);
+        }
+        XrdSciTokensScopes scopes;
+        scopes.Compile(rules);
+        for (int i = 0; i < 50; i++) {
+            Access_Operation oper = ops[rng() % 4];
+            std::string path = randPath();
+            bool parents = (oper == AOP_Stat || oper == AOP_Mkdir);
+            EXPECT_EQ(Reference(rules, oper, path), scopes.Allowed(oper, path, parents))
+                << "oper=" << oper << " path=" << path;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Basic caching, expiry and failure handling.
+//------------------------------------------------------------------------------
+TEST(XrdSciTokensCache, Basic)
+{
+    XrdSciTokensCache<Rules> cache(4);
+    int loads = 0;
+    bool hit;
+
+    auto v1 = cache.Get("tok1", [&]() {loads++; return std::make_shared<Rules>(1);}, &hit);
+    ASSERT_TRUE(v1);
+    EXPECT_FALSE(hit);
+    auto v2 = cache.Get("tok1", [&]() {loads++; return std::make_shared<Rules>(2);}, &hit);
+    EXPECT_TRUE(hit);
+    EXPECT_EQ(1, v2->value);
+    EXPECT_EQ(1, loads);
+
+    // Invalid tokens are not cached
+    auto bad = cache.Get("bad", [&]() {loads++; return std::shared_ptr<Rules>();});
+    EXPECT_FALSE(bad);
+    cache.Get("bad", [&]() {loads++; return std::shared_ptr<Rules>();});
+    EXPECT_EQ(3, loads);
+
+    // Expired entries are replaced and purged
+    v1->isExpired = true;
+    auto v3 = cache.Get("tok1", [&]() {loads++; return std::make_shared<Rules>(3);});
+    EXPECT_EQ(3, v3->value);
+    EXPECT_EQ(1u, cache.Size());
+    v3->isExpired = true;
+    cache.Purge();
+    EXPECT_EQ(0u, cache.Size());
+
+    // Exceptions reach the caller and nothing is cached
+    EXPECT_THROW(cache.Get("tok2", []() -> std::shared_ptr<Rules> {throw std::runtime_error("x");}),
+                 std::runtime_error);
+    EXPECT_EQ(0u, cache.Size());
+}
+
+//------------------------------------------------------------------------------
+// Many threads presenting the same new token must result in one validation,
+// and so must many threads presenting a mix of tokens.
+//------------------------------------------------------------------------------
+TEST(XrdSciTokensCache, SingleFlight)
+{
+    const int nThreads = 32;
+    XrdSciTokensCache<Rules> cache;
+    std::atomic<int> loads{0}, ready{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < nThreads; i++) {
+        threads.emplace_back([&]() {
+            ready++;
+            while (ready < nThreads) std::this_thread::yield();
+            auto v = cache.Get("same-token", [&]() {
+                loads++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return std::make_shared<Rules>(42);
+            });
+            EXPECT_TRUE(v && v->value == 42);
+        });
+    }
+    for (auto &t : threads) t.join();
+    EXPECT_EQ(1, loads.load());
+
+    // Each thread looks up tokens from a shared pool, where a validation
+    // takes a while: every token is still validated only once.
+    const int nTokens = 64, nLookups = 2000;
+    std::vector<std::string> tokens;
+    for (int i = 0; i < nTokens; i++)
+        tokens.push_back("header.payload-" + std::to_string(i) + std::string(600, 'x') + ".sig");
+    XrdSciTokensCache<Rules> pool;
+    loads = 0;
+    threads.clear();
+    for (int i = 0; i < nThreads; i++) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < nLookups; j++) {
+                auto v = pool.Get(tokens[(i + j) % nTokens], [&]() {
+                    loads++;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    return std::make_shared<Rules>(j);
+                });
+                if (!v) ADD_FAILURE();
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    EXPECT_EQ(nTokens, loads.load());
+    EXPECT_EQ(static_cast<size_t>(nTokens), pool.Size());
+}
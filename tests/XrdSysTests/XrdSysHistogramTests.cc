@@ -0,0 +1,61 @@
+#include "XrdSys/XrdSysHistogram.hh"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(XrdSysHistogramTests, Buckets)
+{
+    EXPECT_EQ(XrdSysHistogram::Bucket(0), 0);
+    EXPECT_EQ(XrdSysHistogram::Bucket(1), 0);
+    EXPECT_EQ(XrdSysHistogram::Bucket(2), 1);
+    EXPECT_EQ(XrdSysHistogram::Bucket(3), 1);
+    EXPECT_EQ(XrdSysHistogram::Bucket(4), 2);
+    EXPECT_EQ(XrdSysHistogram::Bucket(1023), 9);
+    EXPECT_EQ(XrdSysHistogram::Bucket(1024), 10);
+    EXPECT_EQ(XrdSysHistogram::Bucket(~0ULL), XrdSysHistogram::Buckets - 1);
+}
+
+TEST(XrdSysHistogramTests, ConcurrentMerge)
+{
+    XrdSysHistogram hist;
+    std::vector<std::thread> threads;
+    const int nThreads = 32, nAdds = 10000;
+
+    for (int t = 0; t < nThreads; t++)
+        threads.emplace_back([&hist, t]() {
+            for (int i = 0; i < nAdds; i++) hist.Add(t < 16 ? 5 : 5000);
+        });
+    for (auto &t : threads) t.join();
+
+    XrdSysHistogram::MergeAll();
+    EXPECT_EQ((unsigned long long)hist.Count, (unsigned long long)nThreads * nAdds);
+    EXPECT_EQ((unsigned long long)hist.TotUS, 16ULL * nAdds * 5 + 16ULL * nAdds * 5000);
+    EXPECT_EQ((unsigned long long)hist.Hits[XrdSysHistogram::Bucket(5)], 16ULL * nAdds);
+    EXPECT_EQ((unsigned long long)hist.Hits[XrdSysHistogram::Bucket(5000)], 16ULL * nAdds);
+}
+
+TEST(XrdSysHistogramTests, Stats)
+{
+    XrdSysHistogram named("test.op"), unnamed;
+    char buff[4096];
+
+    { XrdSysHistogram::Timer timer(&named); }
+    named.Add(3);
+    unnamed.Add(3);
+
+    int n = XrdSysHistogram::Stats(buff, sizeof(buff));
+    ASSERT_GT(n, 0);
+    ASSERT_LE(n, XrdSysHistogram::Stats(0, 0));
+
+    std::string stats(buff, n);
+    EXPECT_EQ(stats.find("<stats id=\"ltcy\">"), 0u);
+    EXPECT_NE(stats.find("<hist id=\"test.op\"><n>2</n>"), std::string::npos);
+    EXPECT_EQ(stats.rfind("</stats>"), stats.size() - 8);
+
+    // A buffer too small for the histogram still yields a well formed section
+    n = XrdSysHistogram::Stats(buff, 40);
+    EXPECT_EQ(std::string(buff, n), "<stats id=\"ltcy\"></stats>");
+}